@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+namespace react::benchmark {
+
+// Keeps the optimizer from discarding values computed inside a timed region.
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+// Runs fn `repetitions` times and returns the best wall time in nanoseconds.
+template<typename Fn>
+double measureBestNs(std::size_t repetitions, Fn&& fn) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+  return best;
+}
+
+inline void printHeader(const char* title) {
+  std::printf("\n== %s ==\n", title);
+}
+
+inline void printRow(const char* label, std::size_t n, double totalNs, std::size_t ops) {
+  std::printf(
+    "%-36s n=%-8zu total=%10.3f ms  %8.2f ns/op\n",
+    label,
+    n,
+    totalNs / 1e6,
+    ops == 0 ? 0.0 : totalNs / static_cast<double>(ops));
+}
+
+} // namespace react::benchmark
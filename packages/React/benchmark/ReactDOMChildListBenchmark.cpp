@@ -0,0 +1,182 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactReconciler/ReactHostConfig.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "test/TestRuntime.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kRows = 10000;
+constexpr std::size_t kRepetitions = 3;
+
+using Instances = std::vector<std::shared_ptr<ReactDOMInstance>>;
+
+// What HostInterface did before the sibling list: a vector of children,
+// scanned on every insert and removal
+struct LegacyParent {
+  std::vector<std::shared_ptr<ReactDOMInstance>> children;
+
+  void erase(const ReactDOMInstance* child) {
+    children.erase(
+        std::remove_if(
+            children.begin(),
+            children.end(),
+            [&](const std::shared_ptr<ReactDOMInstance>& candidate) {
+              return candidate.get() == child;
+            }),
+        children.end());
+  }
+
+  void insertBefore(const std::shared_ptr<ReactDOMInstance>& child, const ReactDOMInstance* before) {
+    erase(child.get());
+    auto it = std::find_if(
+        children.begin(),
+        children.end(),
+        [&](const std::shared_ptr<ReactDOMInstance>& candidate) {
+          return candidate.get() == before;
+        });
+    children.insert(it, child);
+  }
+};
+
+// A keyed list reversed one move at a time: each step takes the last row to
+// the front of the part not yet reversed, as the sync reconciler would
+void reverseLegacy(LegacyParent& parent, const Instances& rows) {
+  for (std::size_t index = 0; index + 1 < rows.size(); ++index) {
+    parent.insertBefore(rows[rows.size() - 1], rows[index].get());
+  }
+}
+
+void reverseList(HostInterface& hostInterface, const std::shared_ptr<ReactDOMInstance>& parent, const Instances& rows) {
+  for (std::size_t index = 0; index + 1 < rows.size(); ++index) {
+    hostInterface.insertHostChildBefore(parent, rows[rows.size() - 1], rows[index]);
+  }
+}
+
+// The hydration cursor step before sibling links: find the parent, cast it,
+// scan its children for the current node
+ReactDOMInstance* legacyNextSibling(const LegacyParent& parent, const ReactDOMInstance* current) {
+  bool foundCurrent = false;
+  for (const auto& sibling : parent.children) {
+    if (foundCurrent) {
+      return sibling.get();
+    }
+    if (sibling.get() == current) {
+      foundCurrent = true;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  namespace jsi = facebook::jsi;
+
+  react::test::TestRuntime runtime;
+  react::HostInterface hostInterface;
+  jsi::Object props(runtime);
+
+  Instances rows;
+  for (std::size_t row = 0; row < kRows; ++row) {
+    rows.push_back(hostInterface.createHostInstance(runtime, "tr", props));
+  }
+
+  LegacyParent legacy;
+  auto parent = hostInterface.createHostInstance(runtime, "tbody", props);
+  auto parentComponent = std::static_pointer_cast<react::ReactDOMComponent>(parent);
+  auto resetLegacy = [&]() {
+    legacy.children = rows;
+  };
+  auto resetList = [&]() {
+    for (const auto& row : rows) {
+      hostInterface.appendHostChild(parent, row);
+    }
+  };
+
+  printHeader("Reverse a keyed 10k-row list, one move per row");
+  const double legacyReverseNs = measureBestNs(kRepetitions, [&]() {
+    resetLegacy();
+    reverseLegacy(legacy, rows);
+  });
+  printRow("vector scans (before)", kRows, legacyReverseNs, kRows);
+  const double listReverseNs = measureBestNs(kRepetitions, [&]() {
+    resetList();
+    reverseList(hostInterface, parent, rows);
+  });
+  printRow("sibling list", kRows, listReverseNs, kRows);
+  std::printf("  speedup %.1fx\n", legacyReverseNs / listReverseNs);
+
+  printHeader("Remove every other row of a 10k-row list");
+  const double legacyRemoveNs = measureBestNs(kRepetitions, [&]() {
+    resetLegacy();
+    for (std::size_t row = 0; row < kRows; row += 2) {
+      legacy.erase(rows[row].get());
+    }
+  });
+  printRow("vector scans (before)", kRows / 2, legacyRemoveNs, kRows / 2);
+  const double listRemoveNs = measureBestNs(kRepetitions, [&]() {
+    resetList();
+    for (std::size_t row = 0; row < kRows; row += 2) {
+      hostInterface.removeHostChild(parent, rows[row]);
+    }
+  });
+  printRow("sibling list", kRows / 2, listRemoveNs, kRows / 2);
+  std::printf("  speedup %.1fx\n", legacyRemoveNs / listRemoveNs);
+
+  printHeader("Iterate a 10k-row list in order");
+  resetLegacy();
+  resetList();
+  constexpr std::size_t kPasses = 100;
+  const double legacyIterateNs = measureBestNs(kRepetitions, [&]() {
+    for (std::size_t pass = 0; pass < kPasses; ++pass) {
+      for (const auto& child : legacy.children) {
+        doNotOptimize(child.get());
+      }
+    }
+  });
+  printRow("vector", kRows * kPasses, legacyIterateNs, kRows * kPasses);
+  const double listIterateNs = measureBestNs(kRepetitions, [&]() {
+    for (std::size_t pass = 0; pass < kPasses; ++pass) {
+      for (const auto& child : parentComponent->children) {
+        doNotOptimize(child.get());
+      }
+    }
+  });
+  printRow("sibling list", kRows * kPasses, listIterateNs, kRows * kPasses);
+
+  printHeader("Hydration cursor over a 10k-row container");
+  react::ReactRuntime reactRuntime;
+  const double legacyCursorNs = measureBestNs(kRepetitions, [&]() {
+    const react::ReactDOMInstance* cursor = legacy.children.front().get();
+    while (cursor != nullptr) {
+      doNotOptimize(cursor);
+      cursor = legacyNextSibling(legacy, cursor);
+    }
+  });
+  printRow("scan parent per step (before)", kRows, legacyCursorNs, kRows);
+  const double cursorNs = measureBestNs(kRepetitions, [&]() {
+    void* cursor = react::hostconfig::getFirstHydratableChildWithinContainer(reactRuntime, parent.get());
+    while (cursor != nullptr) {
+      doNotOptimize(cursor);
+      cursor = react::hostconfig::getNextHydratableSibling(reactRuntime, cursor);
+    }
+  });
+  printRow("sibling links", kRows, cursorNs, kRows);
+  std::printf("  speedup %.1fx\n", legacyCursorNs / cursorNs);
+  return 0;
+}
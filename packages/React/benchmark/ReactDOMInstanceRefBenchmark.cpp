@@ -0,0 +1,166 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "test/TestRuntime.h"
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kRows = 10000;
+constexpr std::size_t kRepetitions = 5;
+
+// What a commit paid per mutation before intrusive handles: shared_ptr by
+// value through ReactRuntime and HostInterface, a dynamic_pointer_cast per
+// argument and a weak_ptr parent to set, clear and lock. The child list
+// underneath is today's, so only the handle traffic differs.
+struct LegacyRow {
+  std::shared_ptr<ReactDOMInstance> instance;
+  std::weak_ptr<ReactDOMInstance> parent;
+};
+
+struct LegacyHost {
+  void appendHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child, LegacyRow& row) {
+    auto parentComponent = std::dynamic_pointer_cast<ReactDOMComponent>(parent);
+    auto childComponent = std::dynamic_pointer_cast<ReactDOMComponent>(child);
+    if (!parentComponent || parentComponent->isTextInstance() || !childComponent) {
+      return;
+    }
+    parentComponent->children.push_back(ReactDOMInstanceRef(child.get()));
+    row.parent = parent;
+  }
+
+  void removeHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child, LegacyRow& row) {
+    auto parentComponent = std::dynamic_pointer_cast<ReactDOMComponent>(parent);
+    auto childComponent = std::dynamic_pointer_cast<ReactDOMComponent>(child);
+    if (!parentComponent || !childComponent) {
+      return;
+    }
+    parentComponent->children.erase(*child);
+    row.parent.reset();
+  }
+};
+
+struct LegacyRuntime {
+  LegacyHost host;
+
+  void appendChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child, LegacyRow& row) {
+    host.appendHostChild(std::move(parent), std::move(child), row);
+  }
+
+  void removeChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child, LegacyRow& row) {
+    host.removeHostChild(std::move(parent), std::move(child), row);
+  }
+};
+
+// Attach every row unless it is already under the table, then detach them
+// all: the reconciler's parent check plus one mutation each way
+void churnLegacy(LegacyRuntime& runtime, const std::shared_ptr<ReactDOMInstance>& table, std::vector<LegacyRow>& rows) {
+  for (LegacyRow& row : rows) {
+    auto attachedParent = row.parent.lock();
+    if (!attachedParent || attachedParent.get() != table.get()) {
+      runtime.appendChild(table, row.instance, row);
+    }
+  }
+  for (LegacyRow& row : rows) {
+    runtime.removeChild(table, row.instance, row);
+  }
+}
+
+void churnHandles(ReactRuntime& runtime, const ReactDOMInstanceRef& table, const std::vector<ReactDOMInstanceRef>& rows) {
+  for (const ReactDOMInstanceRef& row : rows) {
+    if (row->parent() != table.get()) {
+      runtime.appendChild(table, row);
+    }
+  }
+  for (const ReactDOMInstanceRef& row : rows) {
+    runtime.removeChild(table, row);
+  }
+}
+
+// Callers still on the shared_ptr API; each argument becomes a handle
+void churnSharedViews(
+    ReactRuntime& runtime,
+    const std::shared_ptr<ReactDOMInstance>& table,
+    const std::vector<std::shared_ptr<ReactDOMInstance>>& rows) {
+  for (const auto& row : rows) {
+    if (row->getParent() != table) {
+      runtime.appendChild(table, row);
+    }
+  }
+  for (const auto& row : rows) {
+    runtime.removeChild(table, row);
+  }
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  namespace jsi = facebook::jsi;
+
+  // The runtime's worker pool makes the process multi-threaded, after which
+  // every shared_ptr copy is an atomic read-modify-write
+  std::thread([]() {}).join();
+
+  react::test::TestRuntime runtime;
+  auto hostInterface = std::make_shared<react::HostInterface>();
+  react::ReactRuntime reactRuntime;
+  reactRuntime.setHostInterface(hostInterface);
+  jsi::Object props(runtime);
+
+  const react::ReactDOMInstanceRef table = reactRuntime.createInstanceRef(runtime, "tbody", props);
+  const std::shared_ptr<react::ReactDOMInstance> tableView = table.share();
+  std::vector<react::ReactDOMInstanceRef> rows;
+  std::vector<std::shared_ptr<react::ReactDOMInstance>> rowViews;
+  std::vector<LegacyRow> legacyRows;
+  for (std::size_t row = 0; row < kRows; ++row) {
+    rows.push_back(reactRuntime.createInstanceRef(runtime, "tr", props));
+    rowViews.push_back(rows.back().share());
+    legacyRows.push_back({rowViews.back(), {}});
+  }
+
+  printHeader("Attach and detach 10k rows (parent check + 2 mutations per row)");
+  LegacyRuntime legacyRuntime;
+  const double legacyNs = measureBestNs(kRepetitions, [&]() {
+    churnLegacy(legacyRuntime, tableView, legacyRows);
+  });
+  printRow("shared_ptr by value + weak_ptr parent (before)", kRows, legacyNs, kRows * 2);
+  const double handleNs = measureBestNs(kRepetitions, [&]() {
+    churnHandles(reactRuntime, table, rows);
+  });
+  printRow("intrusive handles by reference", kRows, handleNs, kRows * 2);
+  const double viewNs = measureBestNs(kRepetitions, [&]() {
+    churnSharedViews(reactRuntime, tableView, rowViews);
+  });
+  printRow("shared_ptr callers through the adapter", kRows, viewNs, kRows * 2);
+  std::printf("  speedup %.1fx (adapter %.1fx)\n", legacyNs / handleNs, legacyNs / viewNs);
+
+  printHeader("Copy and drop a host handle, 10k times");
+  const double sharedCopyNs = measureBestNs(kRepetitions, [&]() {
+    for (const auto& rowView : rowViews) {
+      std::shared_ptr<react::ReactDOMInstance> copy = rowView;
+      doNotOptimize(copy);
+    }
+  });
+  printRow("std::shared_ptr", kRows, sharedCopyNs, kRows);
+  const double handleCopyNs = measureBestNs(kRepetitions, [&]() {
+    for (const auto& row : rows) {
+      react::ReactDOMInstanceRef copy = row;
+      doNotOptimize(copy);
+    }
+  });
+  printRow("ReactDOMInstanceRef", kRows, handleCopyNs, kRows);
+  return 0;
+}
@@ -0,0 +1,279 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
+#include "ReactReconciler/ReactHostConfig.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "test/TestRuntime.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kRows = 2000;
+constexpr std::size_t kRepetitions = 5;
+
+// A table row with a dozen props, one of which changes per update
+jsi::Object makeRowProps(jsi::Runtime& runtime, std::size_t row, std::size_t version, const jsi::Object& onClick) {
+  jsi::Object props(runtime);
+  const std::string suffix = std::to_string(row);
+  props.setProperty(runtime, "id", jsi::String::createFromUtf8(runtime, "row-" + suffix));
+  props.setProperty(runtime, "className", jsi::String::createFromUtf8(runtime, version % 2 == 0 ? "row" : "row selected"));
+  props.setProperty(runtime, "title", jsi::String::createFromUtf8(runtime, "Row number " + suffix));
+  props.setProperty(runtime, "role", jsi::String::createFromUtf8(runtime, "row"));
+  props.setProperty(runtime, "ariaRowIndex", static_cast<double>(row));
+  props.setProperty(runtime, "tabIndex", -1.0);
+  props.setProperty(runtime, "hidden", false);
+  props.setProperty(runtime, "draggable", true);
+  props.setProperty(runtime, "dataKey", jsi::String::createFromUtf8(runtime, "key-" + suffix));
+  props.setProperty(runtime, "dataGroup", jsi::String::createFromUtf8(runtime, "group-" + std::to_string(row % 16)));
+  props.setProperty(runtime, "lang", jsi::String::createFromUtf8(runtime, "en"));
+  props.setProperty(runtime, "onClick", onClick);
+  return props;
+}
+
+// The diff prepareUpdate did before snapshots: both objects walked through
+// JSI, names re-looked-up per access, strings compared as UTF-8 copies
+bool legacyValuesEqual(jsi::Runtime& runtime, const jsi::Value& a, const jsi::Value& b) {
+  if ((a.isUndefined() && b.isUndefined()) || (a.isNull() && b.isNull())) {
+    return true;
+  }
+  if (a.isBool() && b.isBool()) {
+    return a.getBool() == b.getBool();
+  }
+  if (a.isNumber() && b.isNumber()) {
+    return a.getNumber() == b.getNumber();
+  }
+  if (a.isString() && b.isString()) {
+    return a.getString(runtime).utf8(runtime) == b.getString(runtime).utf8(runtime);
+  }
+  return false;
+}
+
+jsi::Value legacyPrepareUpdate(jsi::Runtime& runtime, const jsi::Object& prevProps, const jsi::Object& nextProps) {
+  jsi::Object payload(runtime);
+  jsi::Object attributes(runtime);
+  bool hasChanges = false;
+
+  jsi::Array nextNames = nextProps.getPropertyNames(runtime);
+  for (std::size_t index = 0; index < nextNames.size(runtime); ++index) {
+    const std::string name = nextNames.getValueAtIndex(runtime, index).getString(runtime).utf8(runtime);
+    jsi::Value nextValue = nextProps.getProperty(runtime, name.c_str());
+    jsi::Value prevValue = prevProps.getProperty(runtime, name.c_str());
+    if (!legacyValuesEqual(runtime, prevValue, nextValue)) {
+      attributes.setProperty(runtime, name.c_str(), jsi::Value(runtime, nextValue));
+      hasChanges = true;
+    }
+  }
+
+  std::vector<std::string> removed;
+  jsi::Array prevNames = prevProps.getPropertyNames(runtime);
+  for (std::size_t index = 0; index < prevNames.size(runtime); ++index) {
+    const std::string name = prevNames.getValueAtIndex(runtime, index).getString(runtime).utf8(runtime);
+    if (!nextProps.hasProperty(runtime, name.c_str())) {
+      removed.push_back(name);
+    }
+  }
+  if (!removed.empty()) {
+    jsi::Array removedArray(runtime, removed.size());
+    for (std::size_t index = 0; index < removed.size(); ++index) {
+      removedArray.setValueAtIndex(runtime, index, jsi::String::createFromUtf8(runtime, removed[index]));
+    }
+    payload.setProperty(runtime, "removedAttributes", removedArray);
+    hasChanges = true;
+  }
+  if (!hasChanges) {
+    return jsi::Value::undefined();
+  }
+  payload.setProperty(runtime, "attributes", attributes);
+  return jsi::Value(runtime, payload);
+}
+
+// The renderRootSync path diffed the name-keyed maps it extracted instead,
+// then rebuilt a props object from the old map for commitUpdate
+bool legacyMapDiff(
+    jsi::Runtime& runtime,
+    const std::unordered_map<std::string, jsi::Value>& prevProps,
+    const std::unordered_map<std::string, jsi::Value>& nextProps,
+    jsi::Object& payload) {
+  jsi::Object attributes(runtime);
+  bool hasChanges = false;
+  for (const auto& [name, nextValue] : nextProps) {
+    auto iter = prevProps.find(name);
+    if (iter == prevProps.end() || !legacyValuesEqual(runtime, iter->second, nextValue)) {
+      attributes.setProperty(runtime, name.c_str(), jsi::Value(runtime, nextValue));
+      hasChanges = true;
+    }
+  }
+  if (hasChanges) {
+    payload.setProperty(runtime, "attributes", attributes);
+  }
+  std::vector<std::string> removed;
+  for (const auto& entry : prevProps) {
+    if (nextProps.find(entry.first) == nextProps.end()) {
+      removed.push_back(entry.first);
+    }
+  }
+  if (!removed.empty()) {
+    jsi::Array removedArray(runtime, removed.size());
+    for (std::size_t index = 0; index < removed.size(); ++index) {
+      removedArray.setValueAtIndex(runtime, index, jsi::String::createFromUtf8(runtime, removed[index]));
+    }
+    payload.setProperty(runtime, "removedAttributes", removedArray);
+    hasChanges = true;
+  }
+  if (hasChanges) {
+    jsi::Object oldProps(runtime);
+    for (const auto& [name, value] : prevProps) {
+      oldProps.setProperty(runtime, name.c_str(), jsi::Value(runtime, value));
+    }
+    doNotOptimize(oldProps);
+  }
+  return hasChanges;
+}
+
+std::unordered_map<std::string, jsi::Value> toPropsMap(jsi::Runtime& runtime, const jsi::Object& props) {
+  std::unordered_map<std::string, jsi::Value> map;
+  jsi::Array names = props.getPropertyNames(runtime);
+  for (std::size_t index = 0; index < names.size(runtime); ++index) {
+    const std::string name = names.getValueAtIndex(runtime, index).getString(runtime).utf8(runtime);
+    map.emplace(name, props.getProperty(runtime, name.c_str()));
+  }
+  return map;
+}
+
+// What commitHostUpdate did with it: clone the new props object, then copy
+// every prop into the instance's name-keyed map
+void legacyCommitUpdate(
+    jsi::Runtime& runtime,
+    const jsi::Object& nextProps,
+    std::unordered_map<std::string, jsi::Value>& instanceProps) {
+  jsi::Object clone(runtime);
+  jsi::Array names = nextProps.getPropertyNames(runtime);
+  for (std::size_t index = 0; index < names.size(runtime); ++index) {
+    const std::string name = names.getValueAtIndex(runtime, index).getString(runtime).utf8(runtime);
+    clone.setProperty(runtime, name.c_str(), jsi::Value(runtime, nextProps.getProperty(runtime, name.c_str())));
+  }
+  instanceProps.clear();
+  jsi::Array cloneNames = clone.getPropertyNames(runtime);
+  for (std::size_t index = 0; index < cloneNames.size(runtime); ++index) {
+    const std::string name = cloneNames.getValueAtIndex(runtime, index).getString(runtime).utf8(runtime);
+    instanceProps.emplace(name, jsi::Value(runtime, clone.getProperty(runtime, name.c_str())));
+  }
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  namespace jsi = facebook::jsi;
+
+  react::test::TestRuntime runtime;
+  auto hostInterface = std::make_shared<react::HostInterface>();
+  react::ReactRuntime reactRuntime;
+  reactRuntime.setHostInterface(hostInterface);
+  jsi::Object onClick(runtime);
+
+  std::vector<std::vector<jsi::Object>> versions(2);
+  for (std::size_t version = 0; version < versions.size(); ++version) {
+    for (std::size_t row = 0; row < kRows; ++row) {
+      versions[version].push_back(makeRowProps(runtime, row, version, onClick));
+    }
+  }
+
+  std::vector<std::shared_ptr<react::ReactDOMInstance>> instances;
+  for (std::size_t row = 0; row < kRows; ++row) {
+    instances.push_back(hostInterface->createHostInstance(runtime, "tr", versions[0][row]));
+  }
+
+  // renderRootSync reads each element's props once while extracting it;
+  // this section starts after that read, from the maps the old code built
+  // and the snapshots the new code builds
+  printHeader("Diff + commit 2k rows, 12 props, 1 changed, props already read");
+  std::vector<std::vector<std::unordered_map<std::string, jsi::Value>>> versionMaps(2);
+  std::vector<std::vector<react::PropSnapshot>> versionSnapshots(2);
+  for (std::size_t version = 0; version < versions.size(); ++version) {
+    for (std::size_t row = 0; row < kRows; ++row) {
+      versionMaps[version].push_back(toPropsMap(runtime, versions[version][row]));
+      versionSnapshots[version].push_back(react::PropSnapshot::fromObject(runtime, versions[version][row]));
+    }
+  }
+
+  std::vector<std::unordered_map<std::string, jsi::Value>> legacyProps(kRows);
+  std::size_t version = 0;
+  const double legacyExtractedNs = measureBestNs(kRepetitions, [&]() {
+    const std::size_t from = version % 2;
+    const std::size_t to = 1 - from;
+    for (std::size_t row = 0; row < kRows; ++row) {
+      jsi::Object payload(runtime);
+      if (legacyMapDiff(runtime, versionMaps[from][row], versionMaps[to][row], payload)) {
+        legacyCommitUpdate(runtime, versions[to][row], legacyProps[row]);
+      }
+      doNotOptimize(payload);
+    }
+    ++version;
+  });
+  printRow("map diff + JSI payload (before)", kRows, legacyExtractedNs, kRows);
+
+  react::PropUpdatePayload payload;
+  const double nativeExtractedNs = measureBestNs(kRepetitions, [&]() {
+    const std::size_t to = 1 - version % 2;
+    for (std::size_t row = 0; row < kRows; ++row) {
+      auto component = std::static_pointer_cast<react::ReactDOMComponent>(instances[row]);
+      payload.clear();
+      if (react::diffPropSnapshots(runtime, component->getPropSnapshot(), versionSnapshots[to][row], payload)) {
+        reactRuntime.commitPropUpdate(instances[row], payload);
+      }
+      doNotOptimize(payload);
+    }
+    ++version;
+  });
+  printRow("snapshot diff + binary payload", kRows, nativeExtractedNs, kRows);
+  std::printf("  speedup %.1fx\n", legacyExtractedNs / nativeExtractedNs);
+
+  // What a fiber update pays: the previous snapshot is cached on the fiber,
+  // but the next props are read through JSI inside the timed region
+  printHeader("Update 2k rows, 12 props, 1 changed, reading props through JSI");
+  const double legacyNs = measureBestNs(kRepetitions, [&]() {
+    const std::size_t from = version % 2;
+    const std::size_t to = 1 - from;
+    for (std::size_t row = 0; row < kRows; ++row) {
+      jsi::Value legacyPayload = legacyPrepareUpdate(runtime, versions[from][row], versions[to][row]);
+      if (!legacyPayload.isUndefined()) {
+        legacyCommitUpdate(runtime, versions[to][row], legacyProps[row]);
+      }
+      doNotOptimize(legacyPayload);
+    }
+    ++version;
+  });
+  printRow("JSI diff + JSI payload (before)", kRows, legacyNs, kRows);
+
+  const double nativeNs = measureBestNs(kRepetitions, [&]() {
+    const std::size_t to = 1 - version % 2;
+    for (std::size_t row = 0; row < kRows; ++row) {
+      react::PropSnapshot next = react::PropSnapshot::fromObject(runtime, versions[to][row]);
+      auto component = std::static_pointer_cast<react::ReactDOMComponent>(instances[row]);
+      payload.clear();
+      if (react::hostconfig::prepareUpdate(reactRuntime, runtime, component->getPropSnapshot(), next, payload)) {
+        react::hostconfig::commitUpdate(reactRuntime, instances[row], payload);
+      }
+      doNotOptimize(payload);
+    }
+    ++version;
+  });
+  printRow("snapshot + diff + binary payload", kRows, nativeNs, kRows);
+  std::printf("  speedup %.1fx\n", legacyNs / nativeNs);
+
+  return 0;
+}
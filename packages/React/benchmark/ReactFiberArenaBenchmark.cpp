@@ -0,0 +1,121 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberArena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kFibers = 50000;
+constexpr std::size_t kFanOut = 8;
+constexpr std::size_t kRepetitions = 7;
+
+// Builds a kFanOut-ary tree breadth first, the way a mount creates fibers
+react::FiberNode* mountTree(std::vector<react::FiberNode*>& created) {
+  created.clear();
+  react::FiberNode* root = react::createFiber(react::WorkTag::HostRoot);
+  created.push_back(root);
+  for (std::size_t index = 1; index < kFibers; ++index) {
+    react::FiberNode* parent = created[(index - 1) / kFanOut];
+    react::FiberNode* fiber = react::createFiber(react::WorkTag::HostComponent);
+    fiber->returnFiber = parent;
+    fiber->index = static_cast<std::uint32_t>((index - 1) % kFanOut);
+    if (fiber->index == 0) {
+      parent->child = fiber;
+    } else {
+      created.back()->sibling = fiber;
+    }
+    created.push_back(fiber);
+  }
+  return root;
+}
+
+// Depth-first walk in beginWork/completeWork order
+std::uint64_t traverse(react::FiberNode* root) {
+  std::uint64_t sum = 0;
+  react::FiberNode* node = root;
+  while (node != nullptr) {
+    sum += node->index + static_cast<std::uint64_t>(node->flags);
+    if (node->child != nullptr) {
+      node = node->child;
+      continue;
+    }
+    while (node != nullptr && node->sibling == nullptr) {
+      node = node->returnFiber;
+    }
+    if (node != nullptr) {
+      node = node->sibling;
+    }
+  }
+  return sum;
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+
+  std::vector<react::FiberNode*> created;
+  created.reserve(kFibers);
+
+  printHeader("Mount 50k fibers");
+  const double heapMountNs = measureBestNs(kRepetitions, [&]() {
+    mountTree(created);
+    doNotOptimize(created.back());
+    for (react::FiberNode* fiber : created) {
+      delete fiber;
+    }
+  });
+  printRow("heap (new/delete)", kFibers, heapMountNs, kFibers);
+
+  const double arenaMountNs = measureBestNs(kRepetitions, [&]() {
+    react::FiberArena arena;
+    react::FiberArenaScope scope(&arena);
+    mountTree(created);
+    doNotOptimize(created.back());
+  });
+  printRow("arena (bulk release)", kFibers, arenaMountNs, kFibers);
+
+  printHeader("Traverse 50k fibers");
+  {
+    // Interleave other allocations so heap fibers scatter like a real app's
+    std::vector<std::vector<char>> noise;
+    react::FiberNode* root = react::createFiber(react::WorkTag::HostRoot);
+    created.assign(1, root);
+    for (std::size_t index = 1; index < kFibers; ++index) {
+      noise.emplace_back(48 + (index % 7) * 16);
+      react::FiberNode* parent = created[(index - 1) / kFanOut];
+      react::FiberNode* fiber = react::createFiber(react::WorkTag::HostComponent);
+      fiber->returnFiber = parent;
+      fiber->index = static_cast<std::uint32_t>((index - 1) % kFanOut);
+      if (fiber->index == 0) {
+        parent->child = fiber;
+      } else {
+        created.back()->sibling = fiber;
+      }
+      created.push_back(fiber);
+    }
+    std::uint64_t sum = 0;
+    const double heapWalkNs = measureBestNs(kRepetitions, [&]() { sum += traverse(root); });
+    printRow("heap, fragmented", kFibers, heapWalkNs, kFibers);
+    for (react::FiberNode* fiber : created) {
+      delete fiber;
+    }
+
+    react::FiberArena arena;
+    react::FiberArenaScope scope(&arena);
+    react::FiberNode* arenaRoot = mountTree(created);
+    const double arenaWalkNs = measureBestNs(kRepetitions, [&]() { sum += traverse(arenaRoot); });
+    printRow("arena", kFibers, arenaWalkNs, kFibers);
+    doNotOptimize(sum);
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberChild.h"
+#include "ReactRuntime/ReactJSXRuntime.h"
+#include "test/TestRuntime.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kRepetitions = 5;
+
+// Keyed <li> elements for the given key numbers
+jsi::Array makeChildren(react::test::TestRuntime& runtime, const std::vector<std::size_t>& keys) {
+  jsi::Array children = runtime.makeArray(keys.size());
+  const jsi::Value type(runtime, jsi::String::createFromUtf8(runtime, "li"));
+  for (std::size_t index = 0; index < keys.size(); ++index) {
+    auto element = react::jsx::jsx(
+        runtime,
+        type,
+        jsi::Value(runtime, jsi::Object(runtime)),
+        jsi::Value(runtime, jsi::String::createFromUtf8(runtime, std::to_string(keys[index]))));
+    children.setValueAtIndex(runtime, index, react::jsx::createJsxHostValue(runtime, element));
+  }
+  return children;
+}
+
+void runCase(
+    react::test::TestRuntime& runtime,
+    const char* label,
+    react::FiberNode* currentFirstChild,
+    const std::vector<std::size_t>& nextKeys) {
+  const jsi::Value children(runtime, makeChildren(runtime, nextKeys));
+  const double ns = measureBestNs(kRepetitions, [&]() {
+    react::FiberNode workInProgress;
+    react::FiberNode* first = react::reconcileChildFibers(
+        nullptr, runtime, currentFirstChild, workInProgress, children, react::DefaultLane);
+    doNotOptimize(first);
+  });
+  printRow(label, nextKeys.size(), ns, nextKeys.size());
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+
+  for (std::size_t count : {std::size_t{1000}, std::size_t{10000}, std::size_t{100000}}) {
+    react::test::TestRuntime runtime;
+    std::vector<std::size_t> keys(count);
+    std::iota(keys.begin(), keys.end(), 0);
+
+    react::FiberNode parent;
+    const jsi::Value mountChildren(runtime, makeChildren(runtime, keys));
+    react::FiberNode* current =
+        react::mountChildFibers(nullptr, runtime, parent, mountChildren, react::DefaultLane);
+
+    printHeader(("Reconcile " + std::to_string(count) + " keyed children").c_str());
+    runCase(runtime, "unchanged", current, keys);
+
+    std::vector<std::size_t> appended = keys;
+    appended.push_back(count);
+    runCase(runtime, "append one", current, appended);
+
+    std::vector<std::size_t> truncated(keys.begin(), keys.end() - 1);
+    runCase(runtime, "remove last", current, truncated);
+
+    std::vector<std::size_t> prepended{count};
+    prepended.insert(prepended.end(), keys.begin(), keys.end());
+    runCase(runtime, "prepend one", current, prepended);
+
+    std::vector<std::size_t> reversed(keys.rbegin(), keys.rend());
+    runCase(runtime, "reverse", current, reversed);
+
+    std::vector<std::size_t> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+    runCase(runtime, "shuffle", current, shuffled);
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactReconciler/ReactFiber.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kFibers = 50000;
+constexpr std::size_t kFanOut = 8;
+constexpr std::size_t kRepetitions = 9;
+
+// FiberNode as it was laid out before the hot/cold split
+struct LegacyFiberNode {
+  react::WorkTag tag{react::WorkTag::IndeterminateComponent};
+  std::string key{};
+  const void* elementType{nullptr};
+  const void* type{nullptr};
+  void* stateNode{nullptr};
+
+  LegacyFiberNode* returnFiber{nullptr};
+  LegacyFiberNode* child{nullptr};
+  LegacyFiberNode* sibling{nullptr};
+  std::uint32_t index{0};
+
+  void* ref{nullptr};
+  void* refCleanup{nullptr};
+
+  void* pendingProps{nullptr};
+  void* memoizedProps{nullptr};
+  void* updateQueue{nullptr};
+  void* memoizedState{nullptr};
+  std::unique_ptr<react::FiberNode::Dependencies> dependencies{};
+
+  react::TypeOfMode mode{react::NoMode};
+
+  react::FiberFlags flags{react::NoFlags};
+  react::FiberFlags subtreeFlags{react::NoFlags};
+  std::vector<LegacyFiberNode*> deletions{};
+
+  react::Lanes lanes{react::NoLanes};
+  react::Lanes childLanes{react::NoLanes};
+
+  LegacyFiberNode* alternate{nullptr};
+
+  std::unique_ptr<facebook::jsi::Value> updatePayload{};
+
+  double actualDuration{0.0};
+  double actualStartTime{0.0};
+  double selfBaseDuration{0.0};
+  double treeBaseDuration{0.0};
+};
+
+// Links nodes[0] as the root of a tree where every parent has `fanOut`
+// children; fanOut == 1 gives a single deep chain.
+template<typename Node>
+void linkTree(std::vector<Node>& nodes, std::size_t fanOut) {
+  for (std::size_t index = 1; index < nodes.size(); ++index) {
+    Node& fiber = nodes[index];
+    Node& parent = nodes[(index - 1) / fanOut];
+    fiber.tag = react::WorkTag::HostComponent;
+    fiber.returnFiber = &parent;
+    fiber.index = static_cast<std::uint32_t>((index - 1) % fanOut);
+    fiber.lanes = (index % 17 == 0) ? react::DefaultLane : react::NoLanes;
+    if (fiber.index == 0) {
+      parent.child = &fiber;
+    } else {
+      nodes[index - 1].sibling = &fiber;
+    }
+  }
+}
+
+// The bailout walk of a render pass: every fiber's tag, flags and lanes are
+// checked, nothing else is read.
+template<typename Node>
+std::uint64_t traverse(Node* root) {
+  std::uint64_t sum = 0;
+  Node* node = root;
+  while (node != nullptr) {
+    sum += static_cast<std::uint64_t>(node->tag) + node->flags + node->subtreeFlags + node->lanes + node->childLanes;
+    if (node->child != nullptr) {
+      node = node->child;
+      continue;
+    }
+    while (node != nullptr && node->sibling == nullptr) {
+      node = node->returnFiber;
+    }
+    if (node != nullptr) {
+      node = node->sibling;
+    }
+  }
+  return sum;
+}
+
+template<typename Node>
+double measureTraversal(std::size_t fanOut) {
+  std::vector<Node> nodes(kFibers);
+  linkTree(nodes, fanOut);
+  std::uint64_t sum = 0;
+  const double ns = measureBestNs(kRepetitions, [&]() { sum += traverse(&nodes[0]); });
+  doNotOptimize(sum);
+  return ns;
+}
+
+void compareLayouts(const char* title, std::size_t fanOut) {
+  printHeader(title);
+  const double legacyNs = measureTraversal<LegacyFiberNode>(fanOut);
+  printRow("legacy layout", kFibers, legacyNs, kFibers);
+  const double splitNs = measureTraversal<react::FiberNode>(fanOut);
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "hot/cold split (x%.2f)", legacyNs / splitNs);
+  printRow(label, kFibers, splitNs, kFibers);
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+
+  std::printf(
+      "sizeof(FiberNode): legacy=%zu split=%zu cold=%zu\n",
+      sizeof(LegacyFiberNode),
+      sizeof(react::FiberNode),
+      sizeof(react::FiberNode::ColdData));
+
+  compareLayouts("Traverse 50k fibers, deep chain", 1);
+  compareLayouts("Traverse 50k fibers, wide tree (fan-out 8)", kFanOut);
+
+  return 0;
+}
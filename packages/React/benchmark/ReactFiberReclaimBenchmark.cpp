@@ -0,0 +1,86 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberArena.h"
+#include "ReactReconciler/ReactFiberReclaim.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kCycles = 1000000;
+constexpr std::size_t kCyclesPerIdle = 64;
+constexpr std::size_t kRepetitions = 3;
+
+// A row with two cells and its alternate, deleted from `parent` right away
+react::FiberNode* mountRow(react::FiberNode& parent) {
+  react::FiberNode* row = react::createFiber(react::WorkTag::HostComponent);
+  react::FiberNode* first = react::createFiber(react::WorkTag::HostComponent);
+  react::FiberNode* second = react::createFiber(react::WorkTag::HostComponent);
+  row->returnFiber = &parent;
+  row->child = first;
+  first->returnFiber = row;
+  first->sibling = second;
+  second->returnFiber = row;
+  react::createWorkInProgress(row, nullptr);
+  parent.child = row;
+  return row;
+}
+
+struct CycleResult {
+  std::size_t peakLiveFibers{0};
+  std::size_t slabCount{0};
+};
+
+CycleResult runCycles(bool reclaim) {
+  auto arena = std::make_shared<react::FiberArena>();
+  react::FiberArenaScope scope(arena.get());
+  react::FiberReclaimQueue queue;
+  react::FiberNode* parent = react::createFiber(react::WorkTag::HostComponent);
+
+  for (std::size_t cycle = 0; cycle < kCycles; ++cycle) {
+    react::FiberNode* row = mountRow(*parent);
+    parent->addDeletion(row);
+    parent->child = nullptr;
+    queue.detachDeletions(*parent, arena);
+    if (reclaim && (cycle + 1) % kCyclesPerIdle == 0) {
+      queue.reclaimAll();
+    }
+    if (!reclaim) {
+      // Without the queue a deleted subtree stays in the arena until reset
+      queue = react::FiberReclaimQueue();
+    }
+  }
+  queue.reclaimAll();
+
+  CycleResult result;
+  result.peakLiveFibers = arena->stats().peakLiveFibers;
+  result.slabCount = arena->stats().slabCount;
+  return result;
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+
+  printHeader("Mount/unmount 1M rows (4 fibers each)");
+  for (bool reclaim : {false, true}) {
+    CycleResult result;
+    const double ns = measureBestNs(kRepetitions, [&]() {
+      result = runCycles(reclaim);
+      doNotOptimize(result);
+    });
+    printRow(reclaim ? "reclaim every 64 cycles" : "leak until arena reset", kCycles, ns, kCycles);
+    std::printf("  peak live fibers=%zu slabs=%zu\n", result.peakLiveFibers, result.slabCount);
+  }
+
+  return 0;
+}
@@ -0,0 +1,155 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactHostMutationBuffer.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "test/TestRuntime.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+// 1000 rows of nine cells plus the row itself: a 10k-node mount
+constexpr std::size_t kRows = 1000;
+constexpr std::size_t kCellsPerRow = 9;
+constexpr std::size_t kNodes = kRows * (kCellsPerRow + 1);
+constexpr std::size_t kRepetitions = 5;
+
+struct MountTree {
+  std::shared_ptr<ReactDOMInstance> root;
+  std::vector<std::shared_ptr<ReactDOMInstance>> rows;
+  std::vector<std::shared_ptr<ReactDOMInstance>> cells;
+};
+
+MountTree createTree(jsi::Runtime& runtime, ReactRuntime& reactRuntime) {
+  MountTree tree;
+  jsi::Object props(runtime);
+  tree.root = reactRuntime.createInstance(runtime, "table", props);
+  tree.rows.reserve(kRows);
+  tree.cells.reserve(kRows * kCellsPerRow);
+  for (std::size_t row = 0; row < kRows; ++row) {
+    tree.rows.push_back(reactRuntime.createInstance(runtime, "tr", props));
+    for (std::size_t cell = 0; cell < kCellsPerRow; ++cell) {
+      tree.cells.push_back(reactRuntime.createInstance(runtime, "td", props));
+    }
+  }
+  return tree;
+}
+
+// Children first, then the row into the table, the order completeWork and
+// the sync reconciler attach them in
+void mountTree(ReactRuntime& reactRuntime, const MountTree& tree) {
+  for (std::size_t row = 0; row < kRows; ++row) {
+    for (std::size_t cell = 0; cell < kCellsPerRow; ++cell) {
+      reactRuntime.appendChild(tree.rows[row], tree.cells[row * kCellsPerRow + cell]);
+    }
+    reactRuntime.appendChild(tree.root, tree.rows[row]);
+  }
+}
+
+jsi::Object makeCellProps(jsi::Runtime& runtime, std::size_t index) {
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "className", jsi::String::createFromUtf8(runtime, "cell"));
+  props.setProperty(runtime, "tabIndex", static_cast<double>(index % 8));
+  return props;
+}
+
+void createAndMount(jsi::Runtime& runtime, ReactRuntime& reactRuntime, const std::vector<jsi::Object>& cellProps) {
+  jsi::Object rowProps(runtime);
+  auto root = reactRuntime.createInstance(runtime, "table", rowProps);
+  for (std::size_t row = 0; row < kRows; ++row) {
+    auto rowInstance = reactRuntime.createInstance(runtime, "tr", rowProps);
+    for (std::size_t cell = 0; cell < kCellsPerRow; ++cell) {
+      auto cellInstance = reactRuntime.createInstance(runtime, "td", cellProps[cell]);
+      reactRuntime.appendChild(rowInstance, cellInstance);
+    }
+    reactRuntime.appendChild(root, rowInstance);
+  }
+  doNotOptimize(root);
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  namespace jsi = facebook::jsi;
+
+  react::test::TestRuntime runtime;
+  auto hostInterface = std::make_shared<react::HostInterface>();
+  react::ReactRuntime reactRuntime;
+  reactRuntime.setHostInterface(hostInterface);
+
+  // Every repetition mounts a tree nothing has been attached to yet
+  auto makeTrees = [&]() {
+    std::vector<MountTree> trees;
+    for (std::size_t index = 0; index < kRepetitions; ++index) {
+      trees.push_back(createTree(runtime, reactRuntime));
+    }
+    return trees;
+  };
+
+  printHeader("Mount 10k nodes, instances already created");
+  std::vector<MountTree> trees = makeTrees();
+  std::size_t next = 0;
+  const double directNs = measureBestNs(kRepetitions, [&]() {
+    mountTree(reactRuntime, trees[next++]);
+  });
+  printRow("direct host calls", kNodes, directNs, kNodes);
+
+  trees = makeTrees();
+  next = 0;
+  double recordNs = 0.0;
+  const double recordedNs = measureBestNs(kRepetitions, [&]() {
+    reactRuntime.beginRecordingMutations();
+    const auto start = std::chrono::steady_clock::now();
+    mountTree(reactRuntime, trees[next++]);
+    recordNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    reactRuntime.flushRecordedMutations();
+  });
+  printRow("record + apply in one pass", kNodes, recordedNs, kNodes);
+  printRow("  recording only (commit thread)", kNodes, recordNs, kNodes);
+  std::printf("  direct / recorded %.2fx\n", directNs / recordedNs);
+
+  trees = makeTrees();
+  next = 0;
+  std::size_t wireBytes = 0;
+  const double serializedNs = measureBestNs(kRepetitions, [&]() {
+    reactRuntime.beginRecordingMutations();
+    mountTree(reactRuntime, trees[next++]);
+    auto buffer = reactRuntime.takeRecordedMutations();
+    const std::vector<std::uint8_t> wire = buffer->serialize();
+    wireBytes = wire.size();
+    doNotOptimize(wire);
+  });
+  printRow("record + serialize", kNodes, serializedNs, kNodes);
+  std::printf("  %zu bytes on the wire\n", wireBytes);
+
+  printHeader("Create and mount 10k nodes, 2 props per cell");
+  std::vector<jsi::Object> cellProps;
+  for (std::size_t cell = 0; cell < kCellsPerRow; ++cell) {
+    cellProps.push_back(makeCellProps(runtime, cell));
+  }
+  const double directMountNs = measureBestNs(kRepetitions, [&]() {
+    createAndMount(runtime, reactRuntime, cellProps);
+  });
+  printRow("direct host calls", kNodes, directMountNs, kNodes);
+
+  const double recordedMountNs = measureBestNs(kRepetitions, [&]() {
+    reactRuntime.beginRecordingMutations();
+    createAndMount(runtime, reactRuntime, cellProps);
+    reactRuntime.flushRecordedMutations();
+  });
+  printRow("record + apply in one pass", kNodes, recordedMountNs, kNodes);
+  std::printf("  direct / recorded %.2fx\n", directMountNs / recordedMountNs);
+  return 0;
+}
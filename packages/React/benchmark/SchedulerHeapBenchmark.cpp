@@ -0,0 +1,156 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactScheduler/SchedulerIndexedMinHeap.h"
+#include "ReactScheduler/SchedulerMinHeap.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+struct BenchNode : HeapNode {
+  bool cancelled{false};
+};
+
+constexpr std::size_t kRepetitions = 5;
+
+// Mirrors how ReactScheduler keys tasks: expiration-ish sortIndex with ties.
+std::vector<BenchNode> makeNodes(std::size_t count, std::uint32_t seed) {
+  std::vector<BenchNode> nodes(count);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(0, 10000);
+  for (std::size_t i = 0; i < count; ++i) {
+    nodes[i].id = i + 1;
+    nodes[i].sortIndex = static_cast<double>(dist(rng));
+  }
+  return nodes;
+}
+
+void resetNodes(std::vector<BenchNode>& nodes) {
+  for (auto& node : nodes) {
+    node.heapIndex = kInvalidHeapIndex;
+    node.cancelled = false;
+  }
+}
+
+// Binary heap baseline: cancellation leaves tombstones that are skipped on pop.
+BenchNode* popLive(SchedulerMinHeap<BenchNode>& heap) {
+  while (BenchNode* node = heap.pop()) {
+    if (!node->cancelled) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+BenchNode* popLive(SchedulerIndexedMinHeap<BenchNode>& heap) {
+  return heap.pop();
+}
+
+void cancel(SchedulerMinHeap<BenchNode>&, BenchNode& node) {
+  node.cancelled = true;
+}
+
+void cancel(SchedulerIndexedMinHeap<BenchNode>& heap, BenchNode& node) {
+  heap.remove(&node);
+}
+
+template<typename Heap>
+double runPushPop(std::vector<BenchNode>& nodes) {
+  return measureBestNs(kRepetitions, [&]() {
+    resetNodes(nodes);
+    Heap heap;
+    for (auto& node : nodes) {
+      heap.push(&node);
+    }
+    while (BenchNode* node = popLive(heap)) {
+      doNotOptimize(node);
+    }
+  });
+}
+
+template<typename Heap>
+double runPushCancelHalfPop(std::vector<BenchNode>& nodes, const std::vector<std::size_t>& cancelOrder) {
+  return measureBestNs(kRepetitions, [&]() {
+    resetNodes(nodes);
+    Heap heap;
+    for (auto& node : nodes) {
+      heap.push(&node);
+    }
+    for (std::size_t i = 0; i < cancelOrder.size() / 2; ++i) {
+      cancel(heap, nodes[cancelOrder[i]]);
+    }
+    while (BenchNode* node = popLive(heap)) {
+      doNotOptimize(node);
+    }
+  });
+}
+
+// Steady state: keep ~n/2 tasks queued while pushing, cancelling and popping.
+template<typename Heap>
+double runSteadyMix(std::vector<BenchNode>& nodes, const std::vector<std::size_t>& cancelOrder) {
+  return measureBestNs(kRepetitions, [&]() {
+    resetNodes(nodes);
+    Heap heap;
+    const std::size_t half = nodes.size() / 2;
+    for (std::size_t i = 0; i < half; ++i) {
+      heap.push(&nodes[i]);
+    }
+    std::size_t cancelCursor = 0;
+    for (std::size_t i = half; i < nodes.size(); ++i) {
+      heap.push(&nodes[i]);
+      if ((i & 1) == 0) {
+        while (cancelCursor < cancelOrder.size() && cancelOrder[cancelCursor] > i) {
+          ++cancelCursor;
+        }
+        if (cancelCursor < cancelOrder.size()) {
+          BenchNode& victim = nodes[cancelOrder[cancelCursor++]];
+          if (!victim.cancelled) {
+            cancel(heap, victim);
+            victim.cancelled = true;
+          }
+        }
+      } else {
+        doNotOptimize(popLive(heap));
+      }
+    }
+    while (BenchNode* node = popLive(heap)) {
+      doNotOptimize(node);
+    }
+  });
+}
+
+void runForSize(std::size_t n) {
+  std::vector<BenchNode> nodes = makeNodes(n, 42);
+  std::vector<std::size_t> cancelOrder(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    cancelOrder[i] = i;
+  }
+  std::shuffle(cancelOrder.begin(), cancelOrder.end(), std::mt19937(1337));
+
+  using Binary = SchedulerMinHeap<BenchNode>;
+  using Indexed = SchedulerIndexedMinHeap<BenchNode>;
+
+  printRow("push+pop       binary", n, runPushPop<Binary>(nodes), 2 * n);
+  printRow("push+pop       indexed4", n, runPushPop<Indexed>(nodes), 2 * n);
+  printRow("push+cancel50%+pop binary", n, runPushCancelHalfPop<Binary>(nodes, cancelOrder), 2 * n + n / 2);
+  printRow("push+cancel50%+pop indexed4", n, runPushCancelHalfPop<Indexed>(nodes, cancelOrder), 2 * n + n / 2);
+  printRow("steady mix     binary", n, runSteadyMix<Binary>(nodes, cancelOrder), 2 * n);
+  printRow("steady mix     indexed4", n, runSteadyMix<Indexed>(nodes, cancelOrder), 2 * n);
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  printHeader("SchedulerMinHeap (binary, tombstones) vs SchedulerIndexedMinHeap (4-ary, indexed)");
+  for (std::size_t n : {1000u, 10000u, 100000u}) {
+    runForSize(n);
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactScheduler/ReactScheduler.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> gAllocationCount{0};
+
+} // namespace
+
+// Count every global allocation so steady-state scheduling can be checked for
+// zero heap traffic per task.
+void* operator new(std::size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kRounds = 20;
+
+struct RoundResult {
+  double ns{0.0};
+  std::uint64_t allocations{0};
+};
+
+// Schedules n small tasks (captures fit std::function's inline buffer),
+// cancels every fourth one, then drains the scheduler.
+RoundResult runRound(ReactScheduler& scheduler, std::size_t n, std::vector<TaskHandle>& handles, std::uint64_t& sink) {
+  handles.clear();
+  const std::uint64_t allocationsBefore = gAllocationCount.load(std::memory_order_relaxed);
+  const double ns = measureBestNs(1, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto priority = static_cast<SchedulerPriority>(1 + (i % 5));
+      handles.push_back(scheduler.scheduleTask(priority, [&sink]() { ++sink; }));
+    }
+    for (std::size_t i = 0; i < handles.size(); i += 4) {
+      scheduler.cancelTask(handles[i]);
+    }
+    scheduler.flushAllTasks();
+  });
+  return RoundResult{ns, gAllocationCount.load(std::memory_order_relaxed) - allocationsBefore};
+}
+
+void runForSize(std::size_t n) {
+  ReactScheduler scheduler;
+  std::vector<TaskHandle> handles;
+  handles.reserve(n);
+  std::uint64_t sink = 0;
+
+  const RoundResult warmup = runRound(scheduler, n, handles, sink);
+
+  double bestNs = warmup.ns;
+  std::uint64_t steadyAllocations = 0;
+  for (std::size_t round = 1; round < kRounds; ++round) {
+    const RoundResult result = runRound(scheduler, n, handles, sink);
+    bestNs = std::min(bestNs, result.ns);
+    steadyAllocations += result.allocations;
+  }
+  doNotOptimize(sink);
+
+  const auto& stats = scheduler.taskPoolStats();
+  printRow("schedule+cancel25%+flush warmup", n, warmup.ns, n);
+  printRow("schedule+cancel25%+flush steady", n, bestNs, n);
+  std::printf(
+    "  warmup allocs/task=%.4f  steady allocs/task=%.4f  blocks=%zu capacity=%zu peakLive=%zu\n",
+    static_cast<double>(warmup.allocations) / static_cast<double>(n),
+    static_cast<double>(steadyAllocations) / static_cast<double>(n * (kRounds - 1)),
+    stats.blockCount,
+    stats.capacity,
+    stats.peakLiveCount);
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  printHeader("ReactScheduler slab task pool");
+  for (std::size_t n : {1000u, 10000u, 100000u}) {
+    runForSize(n);
+  }
+  return 0;
+}
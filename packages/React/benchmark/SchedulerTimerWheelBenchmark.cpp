@@ -0,0 +1,165 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactScheduler/SchedulerIndexedMinHeap.h"
+#include "ReactScheduler/SchedulerTaskPool.h"
+#include "ReactScheduler/SchedulerTimerWheel.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kRepetitions = 5;
+constexpr double kHorizonMs = 60000.0;
+constexpr double kFrameMs = 16.0;
+
+using Heap = SchedulerIndexedMinHeap<SchedulerTask>;
+
+// Pending timers spread over a minute, like debounced effects and retries.
+std::vector<SchedulerTask*> makeTimers(SchedulerTaskPool& pool, std::size_t count, std::uint32_t seed) {
+  std::vector<SchedulerTask*> tasks(count);
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> dist(1.0, kHorizonMs);
+  for (std::size_t i = 0; i < count; ++i) {
+    SchedulerTask* task = pool.acquire();
+    task->id = i + 1;
+    task->startTime = dist(rng);
+    task->sortIndex = task->startTime;
+    tasks[i] = task;
+  }
+  return tasks;
+}
+
+void insert(Heap& heap, SchedulerTask* task) {
+  heap.push(task);
+}
+
+void insert(SchedulerTimerWheel& wheel, SchedulerTask* task) {
+  wheel.insert(task);
+}
+
+void cancel(Heap& heap, SchedulerTask* task) {
+  heap.remove(task);
+}
+
+void cancel(SchedulerTimerWheel& wheel, SchedulerTask* task) {
+  wheel.remove(task);
+}
+
+// Mirrors ReactScheduler::advanceTimers for each backend.
+std::size_t expire(Heap& heap, double now, std::vector<SchedulerTask*>& expired) {
+  expired.clear();
+  SchedulerTask* timer = heap.peek();
+  while (timer != nullptr && timer->startTime <= now) {
+    expired.push_back(heap.pop());
+    timer = heap.peek();
+  }
+  return expired.size();
+}
+
+std::size_t expire(SchedulerTimerWheel& wheel, double now, std::vector<SchedulerTask*>& expired) {
+  expired.clear();
+  wheel.advance(now, expired);
+  return expired.size();
+}
+
+template<typename Queue>
+double runInsert(const std::vector<SchedulerTask*>& tasks) {
+  return measureBestNs(kRepetitions, [&]() {
+    Queue queue;
+    for (SchedulerTask* task : tasks) {
+      insert(queue, task);
+    }
+    doNotOptimize(queue.size());
+    queue.clear();
+  });
+}
+
+template<typename Queue>
+double runInsertCancelHalf(const std::vector<SchedulerTask*>& tasks, const std::vector<std::size_t>& cancelOrder) {
+  return measureBestNs(kRepetitions, [&]() {
+    Queue queue;
+    for (SchedulerTask* task : tasks) {
+      insert(queue, task);
+    }
+    for (std::size_t i = 0; i < cancelOrder.size() / 2; ++i) {
+      cancel(queue, tasks[cancelOrder[i]]);
+    }
+    doNotOptimize(queue.size());
+    queue.clear();
+  });
+}
+
+// Insert everything, then drain one 16ms frame at a time.
+template<typename Queue>
+double runFrameExpiry(const std::vector<SchedulerTask*>& tasks) {
+  std::vector<SchedulerTask*> expired;
+  expired.reserve(tasks.size());
+  return measureBestNs(kRepetitions, [&]() {
+    Queue queue;
+    for (SchedulerTask* task : tasks) {
+      insert(queue, task);
+    }
+    std::size_t total = 0;
+    for (double now = 0.0; now <= kHorizonMs + kFrameMs; now += kFrameMs) {
+      total += expire(queue, now, expired);
+    }
+    doNotOptimize(total);
+  });
+}
+
+// Keep the backlog at n while rescheduling (cancel + insert) a timer per op,
+// the pattern of debounced updates that keep pushing their deadline out.
+template<typename Queue>
+double runReschedule(const std::vector<SchedulerTask*>& tasks, const std::vector<std::size_t>& cancelOrder) {
+  return measureBestNs(kRepetitions, [&]() {
+    Queue queue;
+    for (SchedulerTask* task : tasks) {
+      insert(queue, task);
+    }
+    for (std::size_t index : cancelOrder) {
+      SchedulerTask* task = tasks[index];
+      cancel(queue, task);
+      insert(queue, task);
+    }
+    doNotOptimize(queue.size());
+    queue.clear();
+  });
+}
+
+void runForSize(std::size_t n) {
+  SchedulerTaskPool pool;
+  const std::vector<SchedulerTask*> tasks = makeTimers(pool, n, 42);
+  std::vector<std::size_t> cancelOrder(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    cancelOrder[i] = i;
+  }
+  std::shuffle(cancelOrder.begin(), cancelOrder.end(), std::mt19937(1337));
+
+  using Wheel = SchedulerTimerWheel;
+
+  printRow("insert             heap", n, runInsert<Heap>(tasks), n);
+  printRow("insert             wheel", n, runInsert<Wheel>(tasks), n);
+  printRow("insert+cancel50%   heap", n, runInsertCancelHalf<Heap>(tasks, cancelOrder), n + n / 2);
+  printRow("insert+cancel50%   wheel", n, runInsertCancelHalf<Wheel>(tasks, cancelOrder), n + n / 2);
+  printRow("reschedule         heap", n, runReschedule<Heap>(tasks, cancelOrder), 2 * n);
+  printRow("reschedule         wheel", n, runReschedule<Wheel>(tasks, cancelOrder), 2 * n);
+  printRow("insert+16ms expiry heap", n, runFrameExpiry<Heap>(tasks), 2 * n);
+  printRow("insert+16ms expiry wheel", n, runFrameExpiry<Wheel>(tasks), 2 * n);
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+  printHeader("Timer queue: SchedulerIndexedMinHeap vs SchedulerTimerWheel (1ms tick)");
+  for (std::size_t n : {1000u, 10000u, 100000u}) {
+    runForSize(n);
+  }
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactScheduler/SchedulerWorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kInstances = 8192;
+constexpr std::size_t kPropsPerInstance = 24;
+constexpr std::size_t kRepetitions = 5;
+
+// Native stand-in for a host instance's prop snapshot
+using PropSnapshot = std::vector<std::pair<std::string, std::string>>;
+
+std::vector<PropSnapshot> makeSnapshots(std::uint64_t seed) {
+  std::vector<PropSnapshot> snapshots(kInstances);
+  for (std::size_t instance = 0; instance < kInstances; ++instance) {
+    PropSnapshot& props = snapshots[instance];
+    props.reserve(kPropsPerInstance);
+    for (std::size_t prop = 0; prop < kPropsPerInstance; ++prop) {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      props.emplace_back("attribute-" + std::to_string(prop), "value-" + std::to_string((seed >> 33) % 4));
+    }
+  }
+  return snapshots;
+}
+
+std::size_t diffSnapshots(const PropSnapshot& prev, const PropSnapshot& next) {
+  std::size_t changes = 0;
+  for (std::size_t prop = 0; prop < next.size(); ++prop) {
+    if (prev[prop].first != next[prop].first || prev[prop].second != next[prop].second) {
+      ++changes;
+    }
+  }
+  return changes;
+}
+
+std::size_t diffRange(
+    const std::vector<PropSnapshot>& prev,
+    const std::vector<PropSnapshot>& next,
+    std::size_t begin,
+    std::size_t end) {
+  std::size_t changes = 0;
+  for (std::size_t index = begin; index < end; ++index) {
+    changes += diffSnapshots(prev[index], next[index]);
+  }
+  return changes;
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react::benchmark;
+
+  const auto prev = makeSnapshots(1);
+  const auto next = makeSnapshots(2);
+
+  printHeader("Native prop diff across host instances");
+  std::size_t expected = 0;
+  const double serialNs = measureBestNs(kRepetitions, [&]() {
+    expected = diffRange(prev, next, 0, kInstances);
+    doNotOptimize(expected);
+  });
+  printRow("serial", kInstances, serialNs, kInstances);
+
+  const std::size_t hardwareThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1; threads <= hardwareThreads; threads *= 2) {
+    react::SchedulerWorkerPool pool(threads);
+    const double poolNs = measureBestNs(kRepetitions, [&]() {
+      std::atomic<std::size_t> changes{0};
+      react::SchedulerWorkGroup group(pool);
+      group.parallelFor(kInstances, 64, [&](std::size_t begin, std::size_t end) {
+        changes.fetch_add(diffRange(prev, next, begin, end), std::memory_order_relaxed);
+      });
+      group.wait();
+      if (changes.load() != expected) {
+        std::printf("mismatch: %zu != %zu\n", changes.load(), expected);
+      }
+    });
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "pool threads=%zu (x%.2f)", threads, serialNs / poolNs);
+    printRow(label, kInstances, poolNs, kInstances);
+  }
+
+  return 0;
+}
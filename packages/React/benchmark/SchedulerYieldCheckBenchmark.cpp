@@ -0,0 +1,106 @@
+#include "BenchmarkUtils.h"
+
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactScheduler/ReactScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace react::benchmark {
+
+namespace {
+
+constexpr std::size_t kSlices = 100;
+constexpr double kSliceMs = 5.0;
+
+// Stand-in for a cheap host fiber: a few dozen ns of dependent work.
+std::uint64_t performCheapUnit(std::uint64_t state) {
+  for (int i = 0; i < 8; ++i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+  }
+  return state;
+}
+
+double steadyMs() {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+  const std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+  return sorted[index];
+}
+
+// Mirrors workLoopConcurrentByScheduler: one yield check per unit of work,
+// routed through ReactRuntime to the scheduler backend.
+void runMode(const char* label, const SchedulerYieldCheckConfig& config) {
+  auto scheduler = std::make_shared<ReactScheduler>();
+  scheduler->setYieldCheckConfig(config);
+  ReactRuntime runtime;
+  runtime.setScheduler(scheduler);
+
+  std::vector<double> overshootUs;
+  overshootUs.reserve(kSlices);
+  std::uint64_t units = 0;
+  std::uint64_t state = 1;
+  double workMs = 0.0;
+
+  for (std::size_t slice = 0; slice < kSlices; ++slice) {
+    runtime.scheduleTask(SchedulerPriority::NormalPriority, [&]() {
+      const double start = steadyMs();
+      while (!runtime.shouldYield()) {
+        state = performCheapUnit(state);
+        ++units;
+      }
+      const double elapsed = steadyMs() - start;
+      workMs += elapsed;
+      overshootUs.push_back(std::max(elapsed - kSliceMs, 0.0) * 1000.0);
+    });
+    while (runtime.performWorkUntilDeadline()) {
+    }
+  }
+  doNotOptimize(state);
+
+  std::sort(overshootUs.begin(), overshootUs.end());
+  const SchedulerYieldSampler::Stats& stats = scheduler->yieldCheckStats();
+  std::printf(
+      "%-26s %7.2f M fibers/s  clock reads/check=%.4f  overshoot us p50=%6.2f p90=%6.2f p99=%6.2f max=%7.2f\n",
+      label,
+      static_cast<double>(units) / workMs / 1000.0,
+      stats.checks == 0 ? 0.0 : static_cast<double>(stats.samples) / static_cast<double>(stats.checks),
+      percentile(overshootUs, 0.5),
+      percentile(overshootUs, 0.9),
+      percentile(overshootUs, 0.99),
+      overshootUs.back());
+}
+
+} // namespace
+
+} // namespace react::benchmark
+
+int main() {
+  using namespace react;
+  using namespace react::benchmark;
+  printHeader("shouldYield clock sampling (5ms slices, cheap units)");
+
+  SchedulerYieldCheckConfig everyCheck;
+  runMode("every check, steady_clock", everyCheck);
+
+  SchedulerYieldCheckConfig sampled;
+  sampled.sampled = true;
+  runMode("sampled, steady_clock", sampled);
+
+  if (SchedulerClock::isTscAvailable()) {
+    SchedulerYieldCheckConfig tsc;
+    tsc.clock = SchedulerClockSource::Tsc;
+    runMode("every check, tsc", tsc);
+    tsc.sampled = true;
+    runMode("sampled, tsc", tsc);
+  } else {
+    std::printf("invariant TSC not available; tsc modes skipped\n");
+  }
+  return 0;
+}
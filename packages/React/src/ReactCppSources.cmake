@@ -1,12 +1,15 @@
 set(_REACT_CPP_SRC_DIR ${CMAKE_CURRENT_LIST_DIR})
 
 set(REACT_CPP_SOURCE_FILES
+    ${_REACT_CPP_SRC_DIR}/ReactDOM/client/ReactDOMChildList.cpp
     ${_REACT_CPP_SRC_DIR}/ReactDOM/client/ReactDOMComponent.cpp
     ${_REACT_CPP_SRC_DIR}/ReactDOM/client/ReactDOMDiffProperties.cpp
     ${_REACT_CPP_SRC_DIR}/ReactDOM/client/ReactDOMInstance.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactDOM/client/ReactDOMPropertyPayload.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberConcurrentUpdates.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactCapturedValue.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiber.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberArena.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberAsyncAction.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberCommitEffects.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberHooks.cpp
@@ -15,7 +18,6 @@ set(REACT_CPP_SOURCE_FILES
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberCallUserSpace.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberClassUpdateQueue.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberNewContext.cpp
-    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberStack.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberSuspenseContext.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberHydrationContext.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberHydrationContext_ext.cpp
@@ -24,19 +26,40 @@ set(REACT_CPP_SOURCE_FILES
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactProfilerTimer.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberRootScheduler.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberChild.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberKeyMap.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberReclaim.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberRootPool.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberRootScheduleIndex.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberTreeContext.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberTypeDescriptor.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactHostConfig.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactWakeable.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactUpdateQueue.cpp
     ${_REACT_CPP_SRC_DIR}/ReactReconciler/ReactFiberWorkLoop.cpp
     ${_REACT_CPP_SRC_DIR}/ReactRuntime/ReactHostInterface.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactRuntime/ReactHostMutationBuffer.cpp
     ${_REACT_CPP_SRC_DIR}/ReactRuntime/ReactJSXRuntime.cpp
     ${_REACT_CPP_SRC_DIR}/ReactRuntime/ReactRuntime.cpp
     ${_REACT_CPP_SRC_DIR}/ReactRuntime/ReactWasmBridge.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/ReactScheduler.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerClock.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerCoordinator.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerMetrics.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerTaskPool.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerTimeSlice.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerTimerWheel.cpp
+    ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerWorkerPool.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactOwnerStackReset.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactGlobalError.cpp
+    ${_REACT_CPP_SRC_DIR}/shared/ReactKeyTable.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactSharedInternals.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactSymbols.cpp
     ${_REACT_CPP_SRC_DIR}/../../jsi/jsi/jsi.cpp
     ${_REACT_CPP_SRC_DIR}/../../jsi/jsi/jsilib-posix.cpp
 )
+
+if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    list(APPEND REACT_CPP_SOURCE_FILES
+        ${_REACT_CPP_SRC_DIR}/ReactScheduler/SchedulerEpollLoop.cpp
+    )
+endif()
@@ -0,0 +1,100 @@
+#include "ReactDOM/client/ReactDOMChildList.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace react {
+
+ReactDOMChildList::~ReactDOMChildList() {
+  clear();
+}
+
+const ReactDOMInstanceRef& ReactDOMChildList::back() const {
+  if (last_ == nullptr || last_->previousSibling_ == nullptr) {
+    return first_;
+  }
+  return last_->previousSibling_->nextSibling_;
+}
+
+const ReactDOMInstanceRef& ReactDOMChildList::operator[](std::size_t index) const {
+  if (index >= size_) {
+    throw std::out_of_range("ReactDOMChildList index out of range");
+  }
+  const ReactDOMInstanceRef* slot = &first_;
+  for (; index > 0; --index) {
+    slot = &(*slot)->nextSibling_;
+  }
+  return *slot;
+}
+
+void ReactDOMChildList::push_back(ReactDOMInstanceRef child) {
+  insert(nullptr, std::move(child));
+}
+
+void ReactDOMChildList::insert(const ReactDOMInstance* before, ReactDOMInstanceRef child) {
+  if (!child || child.get() == before) {
+    return;
+  }
+  detach(*child);
+
+  ReactDOMInstance& node = *child;
+  node.childList_ = this;
+  ++size_;
+
+  if (before == nullptr || before->childList_ != this) {
+    node.previousSibling_ = last_;
+    ReactDOMInstanceRef& slot = last_ != nullptr ? last_->nextSibling_ : first_;
+    slot = std::move(child);
+    last_ = &node;
+    return;
+  }
+
+  ReactDOMInstance* previous = before->previousSibling_;
+  ReactDOMInstanceRef& slot = previous != nullptr ? previous->nextSibling_ : first_;
+  node.previousSibling_ = previous;
+  node.nextSibling_ = std::move(slot);
+  node.nextSibling_->previousSibling_ = &node;
+  slot = std::move(child);
+}
+
+void ReactDOMChildList::erase(ReactDOMInstance& child) {
+  if (child.childList_ != this) {
+    return;
+  }
+
+  ReactDOMInstance* previous = child.previousSibling_;
+  ReactDOMInstanceRef& slot = previous != nullptr ? previous->nextSibling_ : first_;
+  // Keeps the child alive until it is unlinked; the caller may hold the
+  // only other reference
+  ReactDOMInstanceRef removed = std::move(slot);
+  slot = std::move(child.nextSibling_);
+  if (slot) {
+    slot->previousSibling_ = previous;
+  } else {
+    last_ = previous;
+  }
+  child.previousSibling_ = nullptr;
+  child.childList_ = nullptr;
+  --size_;
+}
+
+void ReactDOMChildList::clear() {
+  // Unlinked one at a time so a long list does not free itself recursively
+  ReactDOMInstanceRef current = std::move(first_);
+  while (current) {
+    ReactDOMInstanceRef next = std::move(current->nextSibling_);
+    current->previousSibling_ = nullptr;
+    current->childList_ = nullptr;
+    current = std::move(next);
+  }
+  last_ = nullptr;
+  size_ = 0;
+}
+
+void ReactDOMChildList::detach(ReactDOMInstance& child) {
+  if (child.childList_ != nullptr) {
+    child.childList_->erase(child);
+  }
+}
+
+} // namespace react
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "ReactDOM/client/ReactDOMInstance.h"
+
+#include <cstddef>
+#include <iterator>
+
+namespace react {
+
+/**
+ * Children of a host component, as an intrusive doubly-linked sibling list
+ *
+ * The links live on the instances: each child owns its next sibling and
+ * points back at its previous one and at the list holding it, and through
+ * the list at its parent. Appending, inserting before a known child and
+ * removing a child are O(1) and never scan; forward iteration follows the
+ * owning links and hands out `const ReactDOMInstanceRef&`.
+ */
+class ReactDOMChildList {
+public:
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ReactDOMInstanceRef;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      return *slot_;
+    }
+
+    pointer operator->() const {
+      return slot_;
+    }
+
+    const_iterator& operator++() {
+      slot_ = (*slot_)->nextSibling_ ? &(*slot_)->nextSibling_ : nullptr;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return slot_ == other.slot_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return slot_ != other.slot_;
+    }
+
+  private:
+    friend class ReactDOMChildList;
+
+    explicit const_iterator(const value_type* slot)
+      : slot_(slot) {}
+
+    // The owning pointer to the current child; null at the end
+    const value_type* slot_{nullptr};
+  };
+
+  ReactDOMChildList() = default;
+  ReactDOMChildList(const ReactDOMChildList&) = delete;
+  ReactDOMChildList& operator=(const ReactDOMChildList&) = delete;
+  ~ReactDOMChildList();
+
+  const_iterator begin() const {
+    return const_iterator(first_ ? &first_ : nullptr);
+  }
+
+  const_iterator end() const {
+    return const_iterator();
+  }
+
+  std::size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const ReactDOMInstanceRef& front() const {
+    return first_;
+  }
+
+  const ReactDOMInstanceRef& back() const;
+
+  // Walks from the front; for tests and debugging
+  const ReactDOMInstanceRef& operator[](std::size_t index) const;
+
+  bool contains(const ReactDOMInstance& child) const {
+    return child.childList_ == this;
+  }
+
+  // Each of these first takes `child` out of whatever list held it
+  void push_back(ReactDOMInstanceRef child);
+  // Appends when `before` is null or not in this list
+  void insert(const ReactDOMInstance* before, ReactDOMInstanceRef child);
+
+  // No-op when `child` is not in this list
+  void erase(ReactDOMInstance& child);
+  void clear();
+
+  // Takes `child` out of whichever list holds it
+  static void detach(ReactDOMInstance& child);
+
+private:
+  friend class ReactDOMInstance;
+
+  ReactDOMInstanceRef first_{};
+  // The component these are the children of; null for a standalone list
+  ReactDOMInstance* owner_{nullptr};
+  ReactDOMInstance* last_{nullptr};
+  std::size_t size_{0};
+};
+
+} // namespace react
@@ -2,14 +2,6 @@
 
 namespace react {
 
-namespace {
-
-facebook::jsi::Value cloneValue(facebook::jsi::Runtime& runtime, const facebook::jsi::Value& value) {
-  return facebook::jsi::Value(runtime, value);
-}
-
-} // namespace
-
 ReactDOMComponent::ReactDOMComponent(
     std::string type,
     facebook::jsi::Runtime& runtime,
@@ -19,6 +11,7 @@ ReactDOMComponent::ReactDOMComponent(
     : type_(std::move(type)),
       isTextInstance_(isTextInstance),
       textContent_(std::move(textContent)) {
+  setChildList(&children);
   setProps(runtime, props);
 }
 
@@ -30,7 +23,14 @@ const std::string& ReactDOMComponent::getType() const noexcept {
   return type_;
 }
 
-const std::unordered_map<std::string, facebook::jsi::Value>& ReactDOMComponent::getProps() const noexcept {
+const std::unordered_map<std::string, facebook::jsi::Value>& ReactDOMComponent::getProps() const {
+  if (isPropsMapStale_) {
+    rebuildPropsMap();
+  }
+  return propsMap_;
+}
+
+const PropSnapshot& ReactDOMComponent::getPropSnapshot() const noexcept {
   return props_;
 }
 
@@ -39,7 +39,22 @@ const std::string& ReactDOMComponent::getTextContent() const noexcept {
 }
 
 void ReactDOMComponent::setProps(facebook::jsi::Runtime& runtime, const facebook::jsi::Object& props) {
-  rebuildPropsMap(runtime, props);
+  runtime_ = &runtime;
+  props_ = PropSnapshot::fromObject(runtime, props);
+  isPropsMapStale_ = true;
+}
+
+void ReactDOMComponent::applyPropUpdate(const PropUpdatePayload& payload) {
+  if (payload.empty()) {
+    return;
+  }
+  applyPropUpdatePayload(payload, props_);
+  isPropsMapStale_ = true;
+}
+
+void ReactDOMComponent::replacePropSnapshot(PropSnapshot props) {
+  props_ = std::move(props);
+  isPropsMapStale_ = true;
 }
 
 void ReactDOMComponent::setTextContent(std::string text) {
@@ -54,21 +69,15 @@ std::string ReactDOMComponent::debugDescription() const {
   return "<" + type_ + ">";
 }
 
-void ReactDOMComponent::rebuildPropsMap(
-    facebook::jsi::Runtime& runtime,
-    const facebook::jsi::Object& props) {
-  props_.clear();
-
-  auto names = props.getPropertyNames(runtime);
-  const size_t length = names.size(runtime);
-  for (size_t index = 0; index < length; ++index) {
-    auto nameValue = names.getValueAtIndex(runtime, index);
-    if (!nameValue.isString()) {
-      continue;
-    }
-    const auto name = nameValue.getString(runtime).utf8(runtime);
-    auto value = props.getProperty(runtime, name.c_str());
-    props_.emplace(name, cloneValue(runtime, value));
+void ReactDOMComponent::rebuildPropsMap() const {
+  propsMap_.clear();
+  isPropsMapStale_ = false;
+  if (runtime_ == nullptr) {
+    return;
+  }
+  propsMap_.reserve(props_.size());
+  for (const PropSnapshot::Entry& entry : props_.entries()) {
+    propsMap_.emplace(propNameString(entry.id), entry.value.toJsi(*runtime_));
   }
 }
 
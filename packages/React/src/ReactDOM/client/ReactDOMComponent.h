@@ -1,6 +1,8 @@
 #pragma once
 
+#include "ReactDOM/client/ReactDOMChildList.h"
 #include "ReactDOM/client/ReactDOMInstance.h"
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
 
 #include "jsi/jsi.h"
 
@@ -11,34 +13,51 @@
 
 namespace react {
 
+/**
+ * Host component backed by a prop snapshot
+ *
+ * Only makeReactDOMRef can construct one, so every component is owned by its
+ * handles and a shared_ptr view can never outlive or double-free it.
+ */
 class ReactDOMComponent final : public ReactDOMInstance {
 public:
-  ReactDOMComponent(
-      std::string type,
-      facebook::jsi::Runtime& runtime,
-      const facebook::jsi::Object& props,
-      bool isTextInstance = false,
-      std::string textContent = {}
-  );
-
   [[nodiscard]] bool isTextInstance() const override;
   [[nodiscard]] const std::string& getType() const noexcept;
-  [[nodiscard]] const std::unordered_map<std::string, facebook::jsi::Value>& getProps() const noexcept;
+  // JS view of the props, rebuilt from the snapshot after it changes
+  [[nodiscard]] const std::unordered_map<std::string, facebook::jsi::Value>& getProps() const;
+  [[nodiscard]] const PropSnapshot& getPropSnapshot() const noexcept;
   [[nodiscard]] const std::string& getTextContent() const noexcept;
 
   void setProps(facebook::jsi::Runtime& runtime, const facebook::jsi::Object& props);
+  // Applies a diff without touching the JS runtime
+  void applyPropUpdate(const PropUpdatePayload& payload);
+  void replacePropSnapshot(PropSnapshot props);
   void setTextContent(std::string text);
 
   [[nodiscard]] std::string debugDescription() const override;
 
-  std::vector<std::shared_ptr<ReactDOMInstance>> children;
+  ReactDOMChildList children;
 
 private:
-  void rebuildPropsMap(facebook::jsi::Runtime& runtime, const facebook::jsi::Object& props);
+  template <typename T, typename... Args>
+  friend ReactDOMRef<T> makeReactDOMRef(Args&&... args);
+
+  ReactDOMComponent(
+      std::string type,
+      facebook::jsi::Runtime& runtime,
+      const facebook::jsi::Object& props,
+      bool isTextInstance = false,
+      std::string textContent = {}
+  );
+
+  void rebuildPropsMap() const;
 
   std::string type_;
   bool isTextInstance_{false};
-  std::unordered_map<std::string, facebook::jsi::Value> props_;
+  facebook::jsi::Runtime* runtime_{nullptr};
+  PropSnapshot props_{};
+  mutable std::unordered_map<std::string, facebook::jsi::Value> propsMap_{};
+  mutable bool isPropsMapStale_{true};
   std::string textContent_{};
 };
 
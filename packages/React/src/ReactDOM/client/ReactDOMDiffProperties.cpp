@@ -1,58 +1,29 @@
 #include "ReactDOM/client/ReactDOMDiffProperties.h"
 
-namespace react {
-
-namespace {
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
 
-facebook::jsi::Value cloneValue(
-    facebook::jsi::Runtime& runtime,
-    const facebook::jsi::Value& value) {
-  return facebook::jsi::Value(runtime, value);
-}
-
-} // namespace
+namespace react {
 
 facebook::jsi::Object diffHostProperties(
     facebook::jsi::Runtime& runtime,
     const facebook::jsi::Object& prevProps,
     const facebook::jsi::Object& nextProps) {
+  PropUpdatePayload diff;
+  diffPropSnapshots(
+      runtime, PropSnapshot::fromObject(runtime, prevProps), PropSnapshot::fromObject(runtime, nextProps), diff);
+
   facebook::jsi::Object payload(runtime);
   facebook::jsi::Object attributes(runtime);
   bool hasChanges = false;
 
-  auto valuesEqual = [&runtime](const facebook::jsi::Value& a, const facebook::jsi::Value& b) {
-    if (a.isUndefined() && b.isUndefined()) {
-      return true;
-    }
-    if (a.isNull() && b.isNull()) {
-      return true;
-    }
-    if (a.isBool() && b.isBool()) {
-      return a.getBool() == b.getBool();
-    }
-    if (a.isNumber() && b.isNumber()) {
-      return a.getNumber() == b.getNumber();
-    }
-    if (a.isString() && b.isString()) {
-      return a.getString(runtime).utf8(runtime) == b.getString(runtime).utf8(runtime);
-    }
-    return false;
-  };
-
-  auto nextNames = nextProps.getPropertyNames(runtime);
-  const size_t nextLength = nextNames.size(runtime);
-  for (size_t index = 0; index < nextLength; ++index) {
-    auto nameValue = nextNames.getValueAtIndex(runtime, index);
-    if (!nameValue.isString()) {
+  PropUpdatePayload::Operation operation;
+  for (std::size_t offset = 0; offset < diff.bytes().size();) {
+    offset = diff.decode(offset, operation);
+    if (operation.op != PropUpdatePayload::Op::Set) {
       continue;
     }
-    const auto name = nameValue.getString(runtime).utf8(runtime);
-    auto nextValue = nextProps.getProperty(runtime, name.c_str());
-    auto prevValue = prevProps.getProperty(runtime, name.c_str());
-    if (!valuesEqual(prevValue, nextValue)) {
-      attributes.setProperty(runtime, name.c_str(), cloneValue(runtime, nextValue));
-      hasChanges = true;
-    }
+    attributes.setProperty(runtime, propNameString(operation.id).c_str(), operation.value.toJsi(runtime));
+    hasChanges = true;
   }
 
   if (hasChanges) {
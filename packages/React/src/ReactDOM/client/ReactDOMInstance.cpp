@@ -1,5 +1,7 @@
 #include "ReactDOM/client/ReactDOMInstance.h"
 
+#include "ReactDOM/client/ReactDOMChildList.h"
+
 namespace react {
 
 void ReactDOMInstance::setKey(std::string key) {
@@ -10,16 +12,38 @@ const std::string& ReactDOMInstance::getKey() const noexcept {
   return key_;
 }
 
+ReactDOMInstance* ReactDOMInstance::parent() const noexcept {
+  return childList_ != nullptr ? childList_->owner_ : nullptr;
+}
+
 std::shared_ptr<ReactDOMInstance> ReactDOMInstance::getParent() const {
-  return parent_.lock();
+  return ReactDOMInstanceRef(parent()).share();
 }
 
 void ReactDOMInstance::setParent(const std::shared_ptr<ReactDOMInstance>& parent) {
-  parent_ = parent;
+  ReactDOMChildList* children = parent ? parent->ownChildren_ : nullptr;
+  if (children == nullptr) {
+    clearParent();
+    return;
+  }
+  if (childList_ != children) {
+    children->push_back(ReactDOMInstanceRef(this));
+  }
 }
 
 void ReactDOMInstance::clearParent() {
-  parent_.reset();
+  ReactDOMChildList::detach(*this);
+}
+
+void ReactDOMInstance::setChildList(ReactDOMChildList* children) noexcept {
+  ownChildren_ = children;
+  if (children != nullptr) {
+    children->owner_ = this;
+  }
+}
+
+ReactDOMInstance* ReactDOMInstance::firstChild() const noexcept {
+  return ownChildren_ != nullptr ? ownChildren_->front().get() : nullptr;
 }
 
 } // namespace react
@@ -1,30 +1,70 @@
 #pragma once
 
+#include "ReactDOM/client/ReactDOMInstanceRef.h"
+
+#include <cstdint>
 #include <memory>
 #include <string>
 
 namespace react {
 
-class ReactDOMInstance : public std::enable_shared_from_this<ReactDOMInstance> {
+class HostMutationBuffer;
+class ReactDOMChildList;
+
+class ReactDOMInstance : public ReactDOMRefCounted {
 public:
-  virtual ~ReactDOMInstance() = default;
+  ~ReactDOMInstance() override = default;
 
   void setKey(std::string key);
   [[nodiscard]] const std::string& getKey() const noexcept;
 
+  // The component whose children hold this instance. Follows the tree, so
+  // it is never stale and costs no reference.
+  [[nodiscard]] ReactDOMInstance* parent() const noexcept;
+
+  // shared_ptr adapters over the tree links: setParent appends this instance
+  // to `parent`'s children unless it is already one of them, clearParent
+  // takes it out
   [[nodiscard]] std::shared_ptr<ReactDOMInstance> getParent() const;
   void setParent(const std::shared_ptr<ReactDOMInstance>& parent);
   void clearParent();
 
+  // Host tree links for cursors such as hydration; null at the ends and for
+  // instances that cannot have children
+  [[nodiscard]] ReactDOMInstance* nextSibling() const noexcept {
+    return nextSibling_.get();
+  }
+  [[nodiscard]] ReactDOMInstance* previousSibling() const noexcept {
+    return previousSibling_;
+  }
+  [[nodiscard]] ReactDOMInstance* firstChild() const noexcept;
+
   [[nodiscard]] virtual bool isTextInstance() const = 0;
   [[nodiscard]] virtual std::string debugDescription() const = 0;
 
 protected:
   ReactDOMInstance() = default;
 
+  // Derived classes that hold children register their list here
+  void setChildList(ReactDOMChildList* children) noexcept;
+
 private:
-  std::weak_ptr<ReactDOMInstance> parent_;
+  friend class HostMutationBuffer;
+  friend class ReactDOMChildList;
+
+  // Id in the mutation buffer whose epoch matches, so recording needs no
+  // lookup table. Kept next to the vtable pointer, on the line recording
+  // touches anyway.
+  std::uint64_t mutationBufferEpoch_{0};
+  std::uint32_t mutationBufferId_{0};
+  // Sibling links, owned by the ReactDOMChildList holding this instance
+  ReactDOMRef<ReactDOMInstance> nextSibling_{};
+  ReactDOMInstance* previousSibling_{nullptr};
+  ReactDOMChildList* childList_{nullptr};
+  ReactDOMChildList* ownChildren_{nullptr};
   std::string key_{};
 };
 
+using ReactDOMInstanceRef = ReactDOMRef<ReactDOMInstance>;
+
 } // namespace react
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace react {
+
+template <typename T>
+class ReactDOMRef;
+
+/**
+ * Intrusive reference count for host instances
+ *
+ * Host instances belong to the thread that runs the renderer, so the count is
+ * a plain integer rather than an atomic. Only instances handed to
+ * ReactDOMRef::adopt (or made with makeReactDOMRef) are freed when their last
+ * handle goes away; instances constructed any other way, e.g. on the stack,
+ * are counted but never deleted by a handle.
+ */
+class ReactDOMRefCounted {
+public:
+  ReactDOMRefCounted(const ReactDOMRefCounted&) = delete;
+  ReactDOMRefCounted& operator=(const ReactDOMRefCounted&) = delete;
+
+  [[nodiscard]] std::uint32_t refCount() const noexcept {
+    return refCount_;
+  }
+
+protected:
+  ReactDOMRefCounted() = default;
+  virtual ~ReactDOMRefCounted() = default;
+
+private:
+  template <typename>
+  friend class ReactDOMRef;
+
+  void retainRef() const noexcept {
+    ++refCount_;
+  }
+
+  void releaseRef() const noexcept {
+    if (--refCount_ == 0 && ownedByRefs_) {
+      delete this;
+    }
+  }
+
+  mutable std::uint32_t refCount_{0};
+  bool ownedByRefs_{false};
+};
+
+/**
+ * Handle to a host instance: a pointer plus a non-atomic intrusive count
+ *
+ * Copying one costs an increment, with no control block and no atomic
+ * traffic. It converts to and from `std::shared_ptr` so callers of the
+ * shared_ptr API keep working: the shared_ptr view holds one reference for as
+ * long as any of its copies live. Making a view allocates a control block, so
+ * hot paths should pass handles by reference instead.
+ */
+template <typename T>
+class ReactDOMRef {
+public:
+  using element_type = T;
+
+  ReactDOMRef() noexcept = default;
+
+  ReactDOMRef(std::nullptr_t) noexcept {}
+
+  explicit ReactDOMRef(T* instance) noexcept
+    : instance_(instance) {
+    retain(instance_);
+  }
+
+  ReactDOMRef(const ReactDOMRef& other) noexcept
+    : ReactDOMRef(other.instance_) {}
+
+  ReactDOMRef(ReactDOMRef&& other) noexcept
+    : instance_(std::exchange(other.instance_, nullptr)) {}
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  ReactDOMRef(const ReactDOMRef<U>& other) noexcept
+    : ReactDOMRef(static_cast<T*>(other.get())) {}
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  ReactDOMRef(ReactDOMRef<U>&& other) noexcept
+    : instance_(other.detach()) {}
+
+  // Adapter for the shared_ptr API. The instance must be owned by handles,
+  // i.e. made with makeReactDOMRef and viewed through share(); a shared_ptr
+  // that owns the instance itself would free it under the handle. Host
+  // components can only be made through makeReactDOMRef.
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  ReactDOMRef(const std::shared_ptr<U>& shared) noexcept
+    : ReactDOMRef(static_cast<T*>(shared.get())) {}
+
+  ~ReactDOMRef() {
+    release(instance_);
+  }
+
+  ReactDOMRef& operator=(const ReactDOMRef& other) noexcept {
+    ReactDOMRef(other).swap(*this);
+    return *this;
+  }
+
+  ReactDOMRef& operator=(ReactDOMRef&& other) noexcept {
+    ReactDOMRef(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  // Takes ownership of a freshly allocated instance: it is deleted when the
+  // last handle, or shared_ptr view, lets go of it
+  static ReactDOMRef adopt(T* instance) noexcept {
+    if (instance != nullptr) {
+      static_cast<ReactDOMRefCounted*>(instance)->ownedByRefs_ = true;
+    }
+    return ReactDOMRef(instance);
+  }
+
+  [[nodiscard]] T* get() const noexcept {
+    return instance_;
+  }
+
+  T& operator*() const noexcept {
+    return *instance_;
+  }
+
+  T* operator->() const noexcept {
+    return instance_;
+  }
+
+  explicit operator bool() const noexcept {
+    return instance_ != nullptr;
+  }
+
+  void reset() noexcept {
+    release(std::exchange(instance_, nullptr));
+  }
+
+  void swap(ReactDOMRef& other) noexcept {
+    std::swap(instance_, other.instance_);
+  }
+
+  // A shared_ptr view of the same instance, for code written against the
+  // shared_ptr API
+  [[nodiscard]] std::shared_ptr<T> share() const {
+    if (instance_ == nullptr) {
+      return nullptr;
+    }
+    retain(instance_);
+    return std::shared_ptr<T>(instance_, [](T* instance) {
+      release(instance);
+    });
+  }
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<T*, U*>>>
+  operator std::shared_ptr<U>() const {
+    return share();
+  }
+
+private:
+  template <typename>
+  friend class ReactDOMRef;
+
+  static void retain(const T* instance) noexcept {
+    if (instance != nullptr) {
+      static_cast<const ReactDOMRefCounted*>(instance)->retainRef();
+    }
+  }
+
+  static void release(const T* instance) noexcept {
+    if (instance != nullptr) {
+      static_cast<const ReactDOMRefCounted*>(instance)->releaseRef();
+    }
+  }
+
+  // Hands the reference over to the caller
+  T* detach() noexcept {
+    return std::exchange(instance_, nullptr);
+  }
+
+  T* instance_{nullptr};
+};
+
+template <typename T, typename... Args>
+ReactDOMRef<T> makeReactDOMRef(Args&&... args) {
+  return ReactDOMRef<T>::adopt(new T(std::forward<Args>(args)...));
+}
+
+template <typename T, typename U>
+ReactDOMRef<T> staticRefCast(const ReactDOMRef<U>& ref) noexcept {
+  return ReactDOMRef<T>(static_cast<T*>(ref.get()));
+}
+
+template <typename T, typename U>
+ReactDOMRef<T> dynamicRefCast(const ReactDOMRef<U>& ref) noexcept {
+  return ReactDOMRef<T>(dynamic_cast<T*>(ref.get()));
+}
+
+template <typename T, typename U>
+bool operator==(const ReactDOMRef<T>& left, const ReactDOMRef<U>& right) noexcept {
+  return left.get() == right.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const ReactDOMRef<T>& left, const ReactDOMRef<U>& right) noexcept {
+  return left.get() != right.get();
+}
+
+template <typename T>
+bool operator==(const ReactDOMRef<T>& ref, std::nullptr_t) noexcept {
+  return ref.get() == nullptr;
+}
+
+template <typename T>
+bool operator!=(const ReactDOMRef<T>& ref, std::nullptr_t) noexcept {
+  return ref.get() != nullptr;
+}
+
+template <typename T, typename U>
+bool operator==(const ReactDOMRef<T>& ref, const std::shared_ptr<U>& shared) noexcept {
+  return ref.get() == shared.get();
+}
+
+template <typename T, typename U>
+bool operator==(const std::shared_ptr<U>& shared, const ReactDOMRef<T>& ref) noexcept {
+  return ref.get() == shared.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const ReactDOMRef<T>& ref, const std::shared_ptr<U>& shared) noexcept {
+  return ref.get() != shared.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const std::shared_ptr<U>& shared, const ReactDOMRef<T>& ref) noexcept {
+  return ref.get() != shared.get();
+}
+
+} // namespace react
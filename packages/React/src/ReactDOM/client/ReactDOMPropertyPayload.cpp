@@ -0,0 +1,380 @@
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace react {
+
+namespace {
+
+using facebook::jsi::Array;
+using facebook::jsi::Object;
+using facebook::jsi::Runtime;
+using facebook::jsi::String;
+using facebook::jsi::Value;
+
+struct PropNameTable {
+  std::shared_mutex mutex;
+  // Deque elements never move, so the views in `ids` stay valid
+  std::deque<std::string> strings;
+  std::unordered_map<std::string_view, PropId> ids;
+};
+
+PropNameTable& propNameTable() {
+  static PropNameTable table;
+  return table;
+}
+
+bool sameNumber(double a, double b) {
+  // NaN props are unchanged when they stay NaN
+  return a == b || (a != a && b != b);
+}
+
+template <typename T>
+void writeRaw(std::vector<std::uint8_t>& bytes, T value) {
+  const std::size_t offset = bytes.size();
+  bytes.resize(offset + sizeof(T));
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T readRaw(const std::vector<std::uint8_t>& bytes, std::size_t& offset) {
+  T value;
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+
+// Fills `out` from a primitive; false for objects, symbols and bigints
+bool readPrimitive(Runtime& runtime, const Value& value, PropValue& out) {
+  if (value.isUndefined()) {
+    out.kind = PropValue::Kind::Undefined;
+  } else if (value.isNull()) {
+    out.kind = PropValue::Kind::Null;
+  } else if (value.isBool()) {
+    out.kind = PropValue::Kind::Bool;
+    out.boolean = value.getBool();
+  } else if (value.isNumber()) {
+    out.kind = PropValue::Kind::Number;
+    out.number = value.getNumber();
+  } else if (value.isString()) {
+    out.kind = PropValue::Kind::String;
+    out.string = value.getString(runtime).utf8(runtime);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool lessById(const PropSnapshot::Entry& entry, PropId id) {
+  return entry.id < id;
+}
+
+} // namespace
+
+PropId internPropName(std::string_view name) {
+  PropNameTable& table = propNameTable();
+  {
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    auto iter = table.ids.find(name);
+    if (iter != table.ids.end()) {
+      return iter->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(table.mutex);
+  auto iter = table.ids.find(name);
+  if (iter != table.ids.end()) {
+    return iter->second;
+  }
+  if (table.strings.size() >= std::numeric_limits<PropId>::max()) {
+    throw std::length_error("Prop name table is full");
+  }
+  const auto id = static_cast<PropId>(table.strings.size());
+  const std::string& stored = table.strings.emplace_back(name);
+  table.ids.emplace(std::string_view(stored), id);
+  return id;
+}
+
+const std::string& propNameString(PropId id) {
+  PropNameTable& table = propNameTable();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+  if (id >= table.strings.size()) {
+    throw std::out_of_range("Unknown prop name id");
+  }
+  return table.strings[id];
+}
+
+std::size_t internedPropNameCount() {
+  PropNameTable& table = propNameTable();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+  return table.strings.size();
+}
+
+PropValue PropValue::fromJsi(Runtime& runtime, const Value& value) {
+  PropValue result;
+  if (!readPrimitive(runtime, value, result)) {
+    result.kind = Kind::Object;
+    result.object = std::make_shared<const Value>(runtime, value);
+  }
+  return result;
+}
+
+PropValue PropValue::fromJsi(Runtime& runtime, Value&& value) {
+  PropValue result;
+  if (!readPrimitive(runtime, value, result)) {
+    result.kind = Kind::Object;
+    result.object = std::make_shared<const Value>(std::move(value));
+  }
+  return result;
+}
+
+Value PropValue::toJsi(Runtime& runtime) const {
+  switch (kind) {
+    case Kind::Undefined:
+      return Value::undefined();
+    case Kind::Null:
+      return Value::null();
+    case Kind::Bool:
+      return Value(boolean);
+    case Kind::Number:
+      return Value(number);
+    case Kind::String:
+      return Value(runtime, String::createFromUtf8(runtime, string));
+    case Kind::Object:
+      return object ? Value(runtime, *object) : Value::undefined();
+  }
+  return Value::undefined();
+}
+
+bool PropValue::sameValue(Runtime& runtime, const PropValue& other) const {
+  if (kind != other.kind) {
+    return false;
+  }
+  switch (kind) {
+    case Kind::Undefined:
+    case Kind::Null:
+      return true;
+    case Kind::Bool:
+      return boolean == other.boolean;
+    case Kind::Number:
+      return sameNumber(number, other.number);
+    case Kind::String:
+      return string == other.string;
+    case Kind::Object:
+      if (object == other.object) {
+        return true;
+      }
+      if (!object || !other.object) {
+        return false;
+      }
+      return Value::strictEquals(runtime, *object, *other.object);
+  }
+  return false;
+}
+
+PropSnapshot PropSnapshot::fromObject(Runtime& runtime, const Object& props) {
+  PropSnapshot snapshot;
+  Array names = props.getPropertyNames(runtime);
+  const std::size_t length = names.size(runtime);
+  snapshot.entries_.reserve(length);
+  for (std::size_t index = 0; index < length; ++index) {
+    Value nameValue = names.getValueAtIndex(runtime, index);
+    if (!nameValue.isString()) {
+      continue;
+    }
+    String name = nameValue.getString(runtime);
+    Entry& entry = snapshot.entries_.emplace_back();
+    entry.id = internPropName(name.utf8(runtime));
+    entry.value = PropValue::fromJsi(runtime, props.getProperty(runtime, name));
+  }
+  // Engines usually enumerate in insertion order, which for props built by
+  // the same component is the same every render; sort by id only when needed
+  auto byId = [](const Entry& a, const Entry& b) { return a.id < b.id; };
+  if (!std::is_sorted(snapshot.entries_.begin(), snapshot.entries_.end(), byId)) {
+    std::sort(snapshot.entries_.begin(), snapshot.entries_.end(), byId);
+  }
+  return snapshot;
+}
+
+const PropValue* PropSnapshot::find(PropId id) const {
+  auto iter = std::lower_bound(entries_.begin(), entries_.end(), id, lessById);
+  return iter != entries_.end() && iter->id == id ? &iter->value : nullptr;
+}
+
+const PropValue* PropSnapshot::find(std::string_view name) const {
+  return find(internPropName(name));
+}
+
+void PropSnapshot::set(PropId id, PropValue value) {
+  auto iter = std::lower_bound(entries_.begin(), entries_.end(), id, lessById);
+  if (iter != entries_.end() && iter->id == id) {
+    iter->value = std::move(value);
+    return;
+  }
+  entries_.insert(iter, Entry{id, std::move(value)});
+}
+
+void PropSnapshot::erase(PropId id) {
+  auto iter = std::lower_bound(entries_.begin(), entries_.end(), id, lessById);
+  if (iter != entries_.end() && iter->id == id) {
+    entries_.erase(iter);
+  }
+}
+
+Object PropSnapshot::toObject(Runtime& runtime) const {
+  Object object(runtime);
+  for (const Entry& entry : entries_) {
+    object.setProperty(runtime, propNameString(entry.id).c_str(), entry.value.toJsi(runtime));
+  }
+  return object;
+}
+
+void PropUpdatePayload::appendSet(PropId id, const PropValue& value) {
+  bytes_.push_back(static_cast<std::uint8_t>(Op::Set));
+  bytes_.push_back(static_cast<std::uint8_t>(value.kind));
+  writeRaw(bytes_, id);
+  switch (value.kind) {
+    case PropValue::Kind::Undefined:
+    case PropValue::Kind::Null:
+      break;
+    case PropValue::Kind::Bool:
+      bytes_.push_back(value.boolean ? 1 : 0);
+      break;
+    case PropValue::Kind::Number:
+      writeRaw(bytes_, value.number);
+      break;
+    case PropValue::Kind::String: {
+      writeRaw(bytes_, static_cast<std::uint32_t>(value.string.size()));
+      bytes_.insert(bytes_.end(), value.string.begin(), value.string.end());
+      break;
+    }
+    case PropValue::Kind::Object:
+      writeRaw(bytes_, static_cast<std::uint32_t>(objects_.size()));
+      objects_.push_back(value.object);
+      break;
+  }
+  ++operationCount_;
+}
+
+void PropUpdatePayload::appendRemove(PropId id) {
+  bytes_.push_back(static_cast<std::uint8_t>(Op::Remove));
+  bytes_.push_back(static_cast<std::uint8_t>(PropValue::Kind::Undefined));
+  writeRaw(bytes_, id);
+  ++operationCount_;
+}
+
+std::size_t PropUpdatePayload::decode(std::size_t offset, Operation& out) const {
+  out.op = static_cast<Op>(bytes_[offset++]);
+  const auto kind = static_cast<PropValue::Kind>(bytes_[offset++]);
+  out.id = readRaw<PropId>(bytes_, offset);
+  out.value = PropValue{};
+  out.value.kind = kind;
+  if (out.op == Op::Remove) {
+    return offset;
+  }
+  switch (kind) {
+    case PropValue::Kind::Undefined:
+    case PropValue::Kind::Null:
+      break;
+    case PropValue::Kind::Bool:
+      out.value.boolean = bytes_[offset++] != 0;
+      break;
+    case PropValue::Kind::Number:
+      out.value.number = readRaw<double>(bytes_, offset);
+      break;
+    case PropValue::Kind::String: {
+      const auto length = readRaw<std::uint32_t>(bytes_, offset);
+      out.value.string.assign(reinterpret_cast<const char*>(bytes_.data() + offset), length);
+      offset += length;
+      break;
+    }
+    case PropValue::Kind::Object:
+      out.value.object = objects_[readRaw<std::uint32_t>(bytes_, offset)];
+      break;
+  }
+  return offset;
+}
+
+void PropUpdatePayload::clear() {
+  bytes_.clear();
+  objects_.clear();
+  operationCount_ = 0;
+}
+
+bool diffPropSnapshots(Runtime& runtime, const PropSnapshot& prev, const PropSnapshot& next, PropUpdatePayload& out) {
+  const std::size_t before = out.operationCount();
+  auto prevIter = prev.entries().begin();
+  auto nextIter = next.entries().begin();
+  const auto prevEnd = prev.entries().end();
+  const auto nextEnd = next.entries().end();
+  while (prevIter != prevEnd || nextIter != nextEnd) {
+    if (nextIter == nextEnd || (prevIter != prevEnd && prevIter->id < nextIter->id)) {
+      out.appendRemove(prevIter->id);
+      ++prevIter;
+    } else if (prevIter == prevEnd || nextIter->id < prevIter->id) {
+      out.appendSet(nextIter->id, nextIter->value);
+      ++nextIter;
+    } else {
+      if (!prevIter->value.sameValue(runtime, nextIter->value)) {
+        out.appendSet(nextIter->id, nextIter->value);
+      }
+      ++prevIter;
+      ++nextIter;
+    }
+  }
+  return out.operationCount() != before;
+}
+
+void applyPropUpdatePayload(const PropUpdatePayload& payload, PropSnapshot& props) {
+  PropUpdatePayload::Operation operation;
+  const std::size_t end = payload.bytes().size();
+  for (std::size_t offset = 0; offset < end;) {
+    offset = payload.decode(offset, operation);
+    if (operation.op == PropUpdatePayload::Op::Remove) {
+      props.erase(operation.id);
+    } else {
+      props.set(operation.id, std::move(operation.value));
+    }
+  }
+}
+
+Object propUpdatePayloadToObject(Runtime& runtime, const PropUpdatePayload& payload) {
+  Object result(runtime);
+  Object attributes(runtime);
+  std::vector<PropId> removed;
+  bool hasAttributes = false;
+
+  PropUpdatePayload::Operation operation;
+  const std::size_t end = payload.bytes().size();
+  for (std::size_t offset = 0; offset < end;) {
+    offset = payload.decode(offset, operation);
+    if (operation.op == PropUpdatePayload::Op::Remove) {
+      removed.push_back(operation.id);
+      continue;
+    }
+    attributes.setProperty(runtime, propNameString(operation.id).c_str(), operation.value.toJsi(runtime));
+    hasAttributes = true;
+  }
+
+  if (hasAttributes) {
+    result.setProperty(runtime, "attributes", attributes);
+  }
+  if (!removed.empty()) {
+    Array removedArray(runtime, removed.size());
+    for (std::size_t index = 0; index < removed.size(); ++index) {
+      removedArray.setValueAtIndex(runtime, index, String::createFromUtf8(runtime, propNameString(removed[index])));
+    }
+    result.setProperty(runtime, "removedAttributes", removedArray);
+  }
+  return result;
+}
+
+} // namespace react
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "jsi/jsi.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace react {
+
+/**
+ * Process-wide intern table for host prop names
+ *
+ * Works like the React key table: each distinct name gets a stable 32-bit
+ * id the first time it is seen, so snapshots and payloads refer to props by
+ * id and never hash a name again. Ids are never reused.
+ */
+using PropId = std::uint32_t;
+
+PropId internPropName(std::string_view name);
+
+const std::string& propNameString(PropId id);
+
+std::size_t internedPropNameCount();
+
+/**
+ * A prop value held natively
+ *
+ * Primitives are copied out of the JS runtime, strings as UTF-8, so they
+ * compare without JSI. Objects, functions and anything else stay JS values
+ * and compare by identity, like Object.is.
+ */
+struct PropValue {
+  enum class Kind : std::uint8_t { Undefined, Null, Bool, Number, String, Object };
+
+  Kind kind{Kind::Undefined};
+  bool boolean{false};
+  double number{0.0};
+  std::string string{};
+  std::shared_ptr<const facebook::jsi::Value> object{};
+
+  static PropValue fromJsi(facebook::jsi::Runtime& runtime, const facebook::jsi::Value& value);
+  static PropValue fromJsi(facebook::jsi::Runtime& runtime, facebook::jsi::Value&& value);
+  facebook::jsi::Value toJsi(facebook::jsi::Runtime& runtime) const;
+
+  bool sameValue(facebook::jsi::Runtime& runtime, const PropValue& other) const;
+};
+
+/**
+ * Flat copy of a props object, ordered by prop id
+ *
+ * Reading a props object through JSI costs a property-name array, a UTF-8
+ * conversion per name and a lookup per value. A snapshot pays that once;
+ * diffs against it are a merge of two sorted vectors.
+ */
+class PropSnapshot {
+public:
+  struct Entry {
+    PropId id{0};
+    PropValue value{};
+  };
+
+  static PropSnapshot fromObject(facebook::jsi::Runtime& runtime, const facebook::jsi::Object& props);
+
+  const PropValue* find(PropId id) const;
+  const PropValue* find(std::string_view name) const;
+
+  void set(PropId id, PropValue value);
+  void erase(PropId id);
+
+  const std::vector<Entry>& entries() const {
+    return entries_;
+  }
+
+  std::size_t size() const {
+    return entries_.size();
+  }
+
+  bool empty() const {
+    return entries_.empty();
+  }
+
+  facebook::jsi::Object toObject(facebook::jsi::Runtime& runtime) const;
+
+private:
+  std::vector<Entry> entries_{};
+};
+
+/**
+ * Binary list of prop changes for one host instance
+ *
+ * Each operation is a one-byte opcode, a one-byte value kind and a 32-bit
+ * prop id, followed for sets by the value: a byte for booleans, eight for
+ * numbers, a 32-bit length and the bytes for strings, and a 32-bit index
+ * into the payload's object table for JS values. Removals carry no value.
+ * Applying a payload needs no JS runtime.
+ */
+class PropUpdatePayload {
+public:
+  enum class Op : std::uint8_t { Set, Remove };
+
+  struct Operation {
+    Op op{Op::Set};
+    PropId id{0};
+    PropValue value{};
+  };
+
+  void appendSet(PropId id, const PropValue& value);
+  void appendRemove(PropId id);
+
+  // Decodes the operation at `offset` into `out` and returns the offset of
+  // the next one; iteration ends at bytes().size()
+  std::size_t decode(std::size_t offset, Operation& out) const;
+
+  void clear();
+
+  bool empty() const {
+    return operationCount_ == 0;
+  }
+
+  std::size_t operationCount() const {
+    return operationCount_;
+  }
+
+  const std::vector<std::uint8_t>& bytes() const {
+    return bytes_;
+  }
+
+private:
+  std::vector<std::uint8_t> bytes_{};
+  std::vector<std::shared_ptr<const facebook::jsi::Value>> objects_{};
+  std::size_t operationCount_{0};
+};
+
+// Appends to `out` the operations that turn `prev` into `next`. Returns true
+// when there was at least one.
+bool diffPropSnapshots(
+    facebook::jsi::Runtime& runtime,
+    const PropSnapshot& prev,
+    const PropSnapshot& next,
+    PropUpdatePayload& out);
+
+void applyPropUpdatePayload(const PropUpdatePayload& payload, PropSnapshot& props);
+
+// The `{attributes, removedAttributes}` object earlier payloads used
+facebook::jsi::Object propUpdatePayloadToObject(facebook::jsi::Runtime& runtime, const PropUpdatePayload& payload);
+
+} // namespace react
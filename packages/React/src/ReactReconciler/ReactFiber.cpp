@@ -1,5 +1,6 @@
 #include "ReactReconciler/ReactFiber.h"
 
+#include "ReactReconciler/ReactFiberArena.h"
 #include "ReactReconciler/ReactFiberFlags.h"
 #include "ReactReconciler/ReactFiberLane.h"
 #include "ReactReconciler/ReactRootTags.h"
@@ -14,20 +15,17 @@ namespace {
 
 constexpr bool kIsDevToolsPresent = false;
 
+// Fresh timings are the ColdData defaults, so only existing cold storage
+// needs resetting
 void initializeProfilerDurations(FiberNode& fiber) {
-  if (enableProfilerTimer) {
-    fiber.actualDuration = -0.0;
-    fiber.actualStartTime = -1.0;
-    fiber.selfBaseDuration = -0.0;
-    fiber.treeBaseDuration = -0.0;
-  } else {
-    fiber.actualDuration = 0.0;
-    fiber.actualStartTime = 0.0;
-    fiber.selfBaseDuration = 0.0;
-    fiber.treeBaseDuration = 0.0;
+  if (fiber.cold) {
+    fiber.cold->timings = FiberNode::ProfilerTimings{};
   }
 }
 
+const std::vector<FiberNode*> kNoDeletions{};
+const FiberNode::ProfilerTimings kDefaultTimings{};
+
 std::unique_ptr<FiberNode::Dependencies> cloneDependencies(
     const FiberNode::Dependencies* source) {
   if (source == nullptr) {
@@ -47,14 +45,64 @@ FiberNode::Dependencies::~Dependencies() {
   firstContext = nullptr;
 }
 
+const std::vector<FiberNode*>& FiberNode::getDeletions() const {
+  return cold ? cold->deletions : kNoDeletions;
+}
+
+void FiberNode::addDeletion(FiberNode* fiber) {
+  ensureCold().deletions.push_back(fiber);
+}
+
+void FiberNode::setUpdatePayload(std::unique_ptr<PropUpdatePayload> payload) {
+  if (payload || cold) {
+    ensureCold().updatePayload = std::move(payload);
+  }
+}
+
+const std::shared_ptr<const PropSnapshot>& FiberNode::getPropSnapshot() const {
+  static const std::shared_ptr<const PropSnapshot> none;
+  return cold ? cold->propSnapshot : none;
+}
+
+void FiberNode::setPropSnapshot(std::shared_ptr<const PropSnapshot> snapshot) {
+  if (snapshot || cold) {
+    ensureCold().propSnapshot = std::move(snapshot);
+  }
+}
+
+void FiberNode::setDependencies(std::unique_ptr<Dependencies> dependencies) {
+  if (dependencies || cold) {
+    ensureCold().dependencies = std::move(dependencies);
+  }
+}
+
+FiberNode::Dependencies& FiberNode::ensureDependencies() {
+  ColdData& data = ensureCold();
+  if (!data.dependencies) {
+    data.dependencies = std::make_unique<Dependencies>();
+  }
+  return *data.dependencies;
+}
+
+void FiberNode::setRefCleanup(void* refCleanup) {
+  if (refCleanup != nullptr || cold) {
+    ensureCold().refCleanup = refCleanup;
+  }
+}
+
+const FiberNode::ProfilerTimings& FiberNode::getProfilerTimings() const {
+  return cold ? cold->timings : kDefaultTimings;
+}
+
 FiberNode* createFiber(
     WorkTag tag,
     void* pendingProps,
-    std::string key,
+    ReactKeyId key,
     TypeOfMode mode) {
-  auto* fiber = new FiberNode();
+  FiberArena* arena = currentFiberArena();
+  FiberNode* fiber = arena != nullptr ? arena->allocate() : new FiberNode();
   fiber->tag = tag;
-  fiber->key = std::move(key);
+  fiber->key = ReactKey(key);
   fiber->elementType = nullptr;
   fiber->type = nullptr;
   fiber->stateNode = nullptr;
@@ -65,32 +113,37 @@ FiberNode* createFiber(
   fiber->index = 0;
 
   fiber->ref = nullptr;
-  fiber->refCleanup = nullptr;
+  fiber->setRefCleanup(nullptr);
 
   fiber->pendingProps = pendingProps;
   fiber->memoizedProps = nullptr;
   fiber->updateQueue = nullptr;
   fiber->memoizedState = nullptr;
-  fiber->dependencies.reset();
+  fiber->setDependencies(nullptr);
 
   fiber->mode = mode;
 
   fiber->flags = NoFlags;
   fiber->subtreeFlags = NoFlags;
-  fiber->deletions.clear();
+  fiber->clearDeletions();
 
   fiber->lanes = NoLanes;
   fiber->childLanes = NoLanes;
 
   fiber->alternate = nullptr;
 
-  fiber->updatePayload.reset();
+  fiber->clearUpdatePayload();
+  fiber->setPropSnapshot(nullptr);
 
   initializeProfilerDurations(*fiber);
 
   return fiber;
 }
 
+FiberNode* createFiber(WorkTag tag, void* pendingProps, std::string_view key, TypeOfMode mode) {
+  return createFiber(tag, pendingProps, internReactKey(key).id(), mode);
+}
+
 FiberNode* createWorkInProgress(FiberNode* current, void* pendingProps) {
   if (current == nullptr) {
     return nullptr;
@@ -111,11 +164,11 @@ FiberNode* createWorkInProgress(FiberNode* current, void* pendingProps) {
 
     workInProgress->flags = NoFlags;
     workInProgress->subtreeFlags = NoFlags;
-    workInProgress->deletions.clear();
+    workInProgress->clearDeletions();
 
-    if (enableProfilerTimer) {
-      workInProgress->actualDuration = -0.0;
-      workInProgress->actualStartTime = -1.0;
+    if (enableProfilerTimer && workInProgress->cold) {
+      workInProgress->cold->timings.actualDuration = -0.0;
+      workInProgress->cold->timings.actualStartTime = -1.0;
     }
   }
 
@@ -125,20 +178,22 @@ FiberNode* createWorkInProgress(FiberNode* current, void* pendingProps) {
 
   workInProgress->child = current->child;
   workInProgress->memoizedProps = current->memoizedProps;
+  workInProgress->setPropSnapshot(current->getPropSnapshot());
   workInProgress->memoizedState = current->memoizedState;
   workInProgress->updateQueue = current->updateQueue;
-  workInProgress->dependencies = cloneDependencies(current->dependencies.get());
+  workInProgress->setDependencies(cloneDependencies(current->getDependencies()));
 
   workInProgress->sibling = current->sibling;
   workInProgress->index = current->index;
   workInProgress->ref = current->ref;
-  workInProgress->refCleanup = current->refCleanup;
+  workInProgress->setRefCleanup(current->getRefCleanup());
 
-    workInProgress->updatePayload.reset();
+  workInProgress->clearUpdatePayload();
 
-  if (enableProfilerTimer) {
-    workInProgress->selfBaseDuration = current->selfBaseDuration;
-    workInProgress->treeBaseDuration = current->treeBaseDuration;
+  if (enableProfilerTimer && (current->cold || workInProgress->cold)) {
+    const FiberNode::ProfilerTimings& timings = current->getProfilerTimings();
+    workInProgress->mutableProfilerTimings().selfBaseDuration = timings.selfBaseDuration;
+    workInProgress->mutableProfilerTimings().treeBaseDuration = timings.treeBaseDuration;
   }
 
   return workInProgress;
@@ -158,17 +213,18 @@ FiberNode* resetWorkInProgress(FiberNode* workInProgress, Lanes renderLanes) {
 
     workInProgress->child = nullptr;
     workInProgress->subtreeFlags = NoFlags;
-    workInProgress->deletions.clear();
+    workInProgress->clearDeletions();
     workInProgress->memoizedProps = nullptr;
+    workInProgress->setPropSnapshot(nullptr);
     workInProgress->memoizedState = nullptr;
     workInProgress->updateQueue = nullptr;
-    workInProgress->dependencies.reset();
+    workInProgress->setDependencies(nullptr);
     workInProgress->stateNode = nullptr;
-    workInProgress->updatePayload.reset();
+    workInProgress->clearUpdatePayload();
 
-    if (enableProfilerTimer) {
-      workInProgress->selfBaseDuration = 0.0;
-      workInProgress->treeBaseDuration = 0.0;
+    if (enableProfilerTimer && workInProgress->cold) {
+      workInProgress->cold->timings.selfBaseDuration = 0.0;
+      workInProgress->cold->timings.treeBaseDuration = 0.0;
     }
   } else {
     workInProgress->childLanes = current->childLanes;
@@ -176,17 +232,19 @@ FiberNode* resetWorkInProgress(FiberNode* workInProgress, Lanes renderLanes) {
 
     workInProgress->child = current->child;
     workInProgress->subtreeFlags = NoFlags;
-    workInProgress->deletions.clear();
+    workInProgress->clearDeletions();
     workInProgress->memoizedProps = current->memoizedProps;
+    workInProgress->setPropSnapshot(current->getPropSnapshot());
     workInProgress->memoizedState = current->memoizedState;
     workInProgress->updateQueue = current->updateQueue;
     workInProgress->type = current->type;
-    workInProgress->dependencies = cloneDependencies(current->dependencies.get());
-    workInProgress->updatePayload.reset();
+    workInProgress->setDependencies(cloneDependencies(current->getDependencies()));
+    workInProgress->clearUpdatePayload();
 
-    if (enableProfilerTimer) {
-      workInProgress->selfBaseDuration = current->selfBaseDuration;
-      workInProgress->treeBaseDuration = current->treeBaseDuration;
+    if (enableProfilerTimer && (current->cold || workInProgress->cold)) {
+      const FiberNode::ProfilerTimings& timings = current->getProfilerTimings();
+      workInProgress->mutableProfilerTimings().selfBaseDuration = timings.selfBaseDuration;
+      workInProgress->mutableProfilerTimings().treeBaseDuration = timings.treeBaseDuration;
     }
   }
 
@@ -3,20 +3,38 @@
 // Auto-generated by scripts/translate-react.js
 // Source: reactjs/packages/react-reconciler/src/ReactFiber.js
 
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
 #include "ReactReconciler/ReactFiberFlags.h"
 #include "ReactReconciler/ReactFiberLane.h"
 #include "ReactReconciler/ReactTypeOfMode.h"
 #include "ReactReconciler/ReactWorkTags.h"
 #include "ReactReconciler/ReactRootTags.h"
+#include "shared/ReactFeatureFlags.h"
+#include "shared/ReactKeyTable.h"
 #include "jsi/jsi.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace react {
 
+/**
+ * Fiber layout, split by how often the work loop touches each field
+ *
+ * - Hot (first 64 bytes): tag, mode, flags, lanes, index, the interned key
+ *   id and the tree links. This is all a traversal or keyed child match
+ *   reads for fibers it skips over.
+ * - Warm: type, props, state and instance pointers, read when the fiber itself
+ *   is worked on.
+ * - Cold: deletions, update payload, host prop snapshot, context
+ *   dependencies, ref cleanup and profiler timings, kept in a ColdData record that is only allocated on
+ *   the first write of a non-default value. Readers get the defaults when it
+ *   is absent.
+ */
 struct FiberNode {
   struct Dependencies {
     Lanes lanes{NoLanes};
@@ -25,51 +43,116 @@ struct FiberNode {
     ~Dependencies();
   };
 
+  struct ProfilerTimings {
+    double actualDuration{0.0};
+    double actualStartTime{enableProfilerTimer ? -1.0 : 0.0};
+    double selfBaseDuration{0.0};
+    double treeBaseDuration{0.0};
+  };
+
+  struct ColdData {
+    std::vector<FiberNode*> deletions{};
+    std::unique_ptr<PropUpdatePayload> updatePayload{};
+    // Snapshot of a host fiber's memoizedProps, shared with its alternate so
+    // the next update diffs against it instead of re-reading the JS object
+    std::shared_ptr<const PropSnapshot> propSnapshot{};
+    std::unique_ptr<Dependencies> dependencies{};
+    void* refCleanup{nullptr};
+    ProfilerTimings timings{};
+  };
+
+  // Hot
   WorkTag tag{WorkTag::IndeterminateComponent};
-  std::string key{};
-  const void* elementType{nullptr};
-  const void* type{nullptr};
-  void* stateNode{nullptr};
+  TypeOfMode mode{NoMode};
+  FiberFlags flags{NoFlags};
+  FiberFlags subtreeFlags{NoFlags};
+  Lanes lanes{NoLanes};
+  Lanes childLanes{NoLanes};
+  std::uint32_t index{0};
+  ReactKey key{};
 
   FiberNode* returnFiber{nullptr};
   FiberNode* child{nullptr};
   FiberNode* sibling{nullptr};
-  std::uint32_t index{0};
+  FiberNode* alternate{nullptr};
 
+  // Warm
+  const void* elementType{nullptr};
+  const void* type{nullptr};
+  void* stateNode{nullptr};
   void* ref{nullptr};
-  void* refCleanup{nullptr};
 
   void* pendingProps{nullptr};
   void* memoizedProps{nullptr};
   void* updateQueue{nullptr};
   void* memoizedState{nullptr};
-  std::unique_ptr<Dependencies> dependencies{};
-
-  TypeOfMode mode{NoMode};
 
-  FiberFlags flags{NoFlags};
-  FiberFlags subtreeFlags{NoFlags};
-  std::vector<FiberNode*> deletions{};
-
-  Lanes lanes{NoLanes};
-  Lanes childLanes{NoLanes};
-
-  FiberNode* alternate{nullptr};
-
-  std::unique_ptr<facebook::jsi::Value> updatePayload{};
-
-  double actualDuration{0.0};
-  double actualStartTime{0.0};
-  double selfBaseDuration{0.0};
-  double treeBaseDuration{0.0};
+  // Cold
+  std::unique_ptr<ColdData> cold{};
+
+  ColdData& ensureCold() {
+    if (!cold) {
+      cold = std::make_unique<ColdData>();
+    }
+    return *cold;
+  }
+
+  const std::string& getKey() const {
+    return reactKeyString(key);
+  }
+  void setKey(std::string_view value) {
+    key = internReactKey(value);
+  }
+
+  const std::vector<FiberNode*>& getDeletions() const;
+  void addDeletion(FiberNode* fiber);
+  void clearDeletions() {
+    if (cold) {
+      cold->deletions.clear();
+    }
+  }
+
+  const PropUpdatePayload* getUpdatePayload() const {
+    return cold ? cold->updatePayload.get() : nullptr;
+  }
+  void setUpdatePayload(std::unique_ptr<PropUpdatePayload> payload);
+  void clearUpdatePayload() {
+    if (cold) {
+      cold->updatePayload.reset();
+    }
+  }
+
+  const std::shared_ptr<const PropSnapshot>& getPropSnapshot() const;
+  void setPropSnapshot(std::shared_ptr<const PropSnapshot> snapshot);
+
+  Dependencies* getDependencies() const {
+    return cold ? cold->dependencies.get() : nullptr;
+  }
+  void setDependencies(std::unique_ptr<Dependencies> dependencies);
+  Dependencies& ensureDependencies();
+
+  void* getRefCleanup() const {
+    return cold ? cold->refCleanup : nullptr;
+  }
+  void setRefCleanup(void* refCleanup);
+
+  const ProfilerTimings& getProfilerTimings() const;
+  ProfilerTimings& mutableProfilerTimings() {
+    return ensureCold().timings;
+  }
 };
 
+static_assert(offsetof(FiberNode, elementType) <= 64, "FiberNode hot fields must fit in one cache line");
+
 FiberNode* createFiber(
     WorkTag tag,
     void* pendingProps = nullptr,
-    std::string key = std::string{},
+    ReactKeyId key = NoReactKey,
     TypeOfMode mode = NoMode);
 
+// Interns `key` and forwards to the id overload
+FiberNode* createFiber(WorkTag tag, void* pendingProps, std::string_view key, TypeOfMode mode = NoMode);
+
 FiberNode* createWorkInProgress(FiberNode* current, void* pendingProps);
 FiberNode* resetWorkInProgress(FiberNode* workInProgress, Lanes renderLanes);
 FiberNode* createHostRootFiber(RootTag tag, bool isStrictMode);
@@ -0,0 +1,227 @@
+#include "ReactReconciler/ReactFiberArena.h"
+
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberLane.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <new>
+
+namespace react {
+
+namespace {
+
+thread_local FiberArena* currentArena = nullptr;
+
+inline size_t lowestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<size_t>(__builtin_ctzll(value));
+#else
+  size_t bit = 0;
+  while ((value & 1u) == 0) {
+    value >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+struct FreeSlot {
+  FreeSlot* next;
+};
+
+static_assert(sizeof(FiberNode) >= sizeof(FreeSlot), "FiberNode slots must fit a free-list link");
+
+} // namespace
+
+struct FiberArena::Slab {
+  static constexpr size_t kWords = kFibersPerSlab / 64;
+
+  alignas(FiberNode) unsigned char storage[sizeof(FiberNode) * kFibersPerSlab];
+  // One bit per slot holding a constructed fiber, for bulk destruction
+  uint64_t liveBits[kWords]{};
+
+  FiberNode* slot(size_t index) {
+    return reinterpret_cast<FiberNode*>(storage + index * sizeof(FiberNode));
+  }
+
+  size_t indexOf(const FiberNode* fiber) const {
+    return static_cast<size_t>(reinterpret_cast<const unsigned char*>(fiber) - storage) / sizeof(FiberNode);
+  }
+
+  bool isLive(size_t index) const {
+    return (liveBits[index / 64] >> (index % 64)) & 1u;
+  }
+
+  void setLive(size_t index, bool live) {
+    const uint64_t mask = uint64_t{1} << (index % 64);
+    if (live) {
+      liveBits[index / 64] |= mask;
+    } else {
+      liveBits[index / 64] &= ~mask;
+    }
+  }
+};
+
+static_assert(FiberArena::kFibersPerSlab % 64 == 0, "Slab size must be a multiple of 64");
+
+FiberArena::FiberArena() = default;
+
+FiberArena::~FiberArena() {
+  releaseAll();
+}
+
+void FiberArena::addSlab() {
+  auto slab = std::make_unique<Slab>();
+  bumpSlab_ = slab.get();
+  bumpIndex_ = 0;
+  const auto position = std::upper_bound(
+      slabs_.begin(), slabs_.end(), bumpSlab_, [](const Slab* value, const std::unique_ptr<Slab>& entry) {
+        return std::less<const Slab*>()(value, entry.get());
+      });
+  slabs_.insert(position, std::move(slab));
+  stats_.slabCount = slabs_.size();
+  stats_.capacity = slabs_.size() * kFibersPerSlab;
+}
+
+FiberNode* FiberArena::allocate() {
+  void* memory = nullptr;
+  Slab* slab = nullptr;
+  if (freeList_ != nullptr) {
+    auto* slot = static_cast<FreeSlot*>(freeList_);
+    freeList_ = slot->next;
+    memory = slot;
+    slab = findSlab(static_cast<FiberNode*>(memory));
+    ++stats_.reuses;
+  } else {
+    if (bumpIndex_ == kFibersPerSlab) {
+      if (nextRetainedSlab_ < slabs_.size()) {
+        bumpSlab_ = slabs_[nextRetainedSlab_++].get();
+        bumpIndex_ = 0;
+      } else {
+        addSlab();
+        nextRetainedSlab_ = slabs_.size();
+      }
+    }
+    slab = bumpSlab_;
+    memory = slab->slot(bumpIndex_++);
+  }
+
+  FiberNode* fiber = new (memory) FiberNode();
+  slab->setLive(slab->indexOf(fiber), true);
+
+  ++stats_.allocations;
+  ++stats_.liveFibers;
+  stats_.peakLiveFibers = std::max(stats_.peakLiveFibers, stats_.liveFibers);
+  return fiber;
+}
+
+bool FiberArena::release(FiberNode* fiber) {
+  Slab* slab = findSlab(fiber);
+  if (slab == nullptr) {
+    return false;
+  }
+  const size_t index = slab->indexOf(fiber);
+  if (!slab->isLive(index)) {
+    return false;
+  }
+
+  fiber->~FiberNode();
+  slab->setLive(index, false);
+  auto* slot = reinterpret_cast<FreeSlot*>(fiber);
+  slot->next = static_cast<FreeSlot*>(freeList_);
+  freeList_ = slot;
+  --stats_.liveFibers;
+  return true;
+}
+
+void FiberArena::destroyLiveFibers() {
+  for (const auto& slab : slabs_) {
+    for (size_t word = 0; word < Slab::kWords; ++word) {
+      uint64_t bits = slab->liveBits[word];
+      while (bits != 0) {
+        const size_t bit = lowestBit(bits);
+        slab->slot(word * 64 + bit)->~FiberNode();
+        bits &= bits - 1;
+      }
+      slab->liveBits[word] = 0;
+    }
+  }
+  bumpSlab_ = nullptr;
+  bumpIndex_ = kFibersPerSlab;
+  nextRetainedSlab_ = 0;
+  freeList_ = nullptr;
+  stats_.liveFibers = 0;
+  ++generation_;
+}
+
+void FiberArena::releaseAll() {
+  destroyLiveFibers();
+  slabs_.clear();
+  stats_.slabCount = 0;
+  stats_.capacity = 0;
+}
+
+void FiberArena::reset() {
+  destroyLiveFibers();
+}
+
+bool FiberArena::owns(const FiberNode* fiber) const {
+  const Slab* slab = findSlab(fiber);
+  return slab != nullptr && slab->isLive(slab->indexOf(fiber));
+}
+
+FiberArena::Slab* FiberArena::findSlab(const FiberNode* fiber) const {
+  if (fiber == nullptr || slabs_.empty()) {
+    return nullptr;
+  }
+
+  // Last slab starting at or before the fiber
+  const auto* address = reinterpret_cast<const unsigned char*>(fiber);
+  const auto position = std::upper_bound(
+      slabs_.begin(), slabs_.end(), address, [](const unsigned char* value, const std::unique_ptr<Slab>& entry) {
+        return std::less<const unsigned char*>()(value, entry->storage);
+      });
+  if (position == slabs_.begin()) {
+    return nullptr;
+  }
+
+  Slab* slab = std::prev(position)->get();
+  const unsigned char* end = slab->storage + sizeof(slab->storage);
+  if (!std::less<const unsigned char*>()(address, end)) {
+    return nullptr;
+  }
+  if (static_cast<size_t>(address - slab->storage) % sizeof(FiberNode) != 0) {
+    return nullptr;
+  }
+  return slab;
+}
+
+FiberArenaScope::FiberArenaScope(FiberArena* arena) : previous_(currentArena) {
+  currentArena = arena;
+}
+
+FiberArenaScope::~FiberArenaScope() {
+  currentArena = previous_;
+}
+
+FiberArena* currentFiberArena() {
+  return currentArena;
+}
+
+FiberArena& ensureRootFiberArena(FiberRoot& root) {
+  if (!root.fiberArena) {
+    root.fiberArena = std::make_shared<FiberArena>();
+  }
+  return *root.fiberArena;
+}
+
+void releaseRootFibers(FiberRoot& root) {
+  root.current = nullptr;
+  if (root.fiberArena) {
+    root.fiberArena->releaseAll();
+  }
+}
+
+} // namespace react
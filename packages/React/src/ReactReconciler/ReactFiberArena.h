@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace react {
+
+struct FiberNode;
+struct FiberRoot;
+
+/**
+ * Slab allocator for the fibers of one FiberRoot
+ *
+ * Fibers are carved out of fixed-size slabs, so a freshly mounted tree sits
+ * in a handful of contiguous blocks instead of one heap allocation per fiber,
+ * and beginWork/completeWork walk mostly adjacent memory. Released fibers
+ * (discarded alternates, deleted subtrees) go onto a LIFO free list and are
+ * reused by the next allocation while still warm. releaseAll() destroys
+ * every live fiber at once when the root unmounts.
+ *
+ * Not thread-safe; a root is only ever rendered from one thread.
+ */
+class FiberArena {
+public:
+  static constexpr size_t kFibersPerSlab = 256;
+
+  struct Stats {
+    size_t liveFibers{0};
+    size_t peakLiveFibers{0};
+    size_t capacity{0};
+    size_t slabCount{0};
+    uint64_t allocations{0};
+    // Allocations served from the free list
+    uint64_t reuses{0};
+  };
+
+  FiberArena();
+  ~FiberArena();
+
+  FiberArena(const FiberArena&) = delete;
+  FiberArena& operator=(const FiberArena&) = delete;
+
+  // Returns a value-initialized fiber
+  FiberNode* allocate();
+
+  // Destroys the fiber and recycles its slot. Returns false (and does
+  // nothing) if the fiber was not allocated from this arena.
+  bool release(FiberNode* fiber);
+
+  // Destroys every live fiber and frees all slabs
+  void releaseAll();
+
+  // Destroys every live fiber but keeps the slabs, which later allocations
+  // refill from the start. Used when a pooled root is recycled.
+  void reset();
+
+  bool owns(const FiberNode* fiber) const;
+
+  // Bumped whenever releaseAll() or reset() destroys the live fibers, so
+  // holders of fiber pointers can tell theirs are gone
+  uint64_t generation() const {
+    return generation_;
+  }
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  struct Slab;
+
+  Slab* findSlab(const FiberNode* fiber) const;
+  void addSlab();
+  void destroyLiveFibers();
+
+  // Sorted by address so ownership checks can binary search
+  std::vector<std::unique_ptr<Slab>> slabs_;
+  Slab* bumpSlab_{nullptr};
+  size_t bumpIndex_{kFibersPerSlab};
+  // Slabs kept by reset() that allocation has not moved on to yet
+  size_t nextRetainedSlab_{0};
+  void* freeList_{nullptr};
+  uint64_t generation_{0};
+  Stats stats_{};
+};
+
+/**
+ * Routes createFiber to an arena for the current scope
+ *
+ * The work loop opens one for the root being rendered. Scopes nest, and a
+ * null arena falls back to plain heap allocation.
+ */
+class FiberArenaScope {
+public:
+  explicit FiberArenaScope(FiberArena* arena);
+  ~FiberArenaScope();
+
+  FiberArenaScope(const FiberArenaScope&) = delete;
+  FiberArenaScope& operator=(const FiberArenaScope&) = delete;
+
+private:
+  FiberArena* previous_;
+};
+
+FiberArena* currentFiberArena();
+
+// Creates the root's arena on first use
+FiberArena& ensureRootFiberArena(FiberRoot& root);
+
+// Bulk-frees every fiber of an unmounted root and clears root.current.
+// Must not be called while the root is rendering or committing. The root
+// pool calls it for roots it discards; ReactRuntime::unmountFiberRoot
+// reaches it through the pool.
+void releaseRootFibers(FiberRoot& root);
+
+} // namespace react
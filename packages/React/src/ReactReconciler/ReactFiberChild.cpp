@@ -3,9 +3,11 @@
 #include "ReactReconciler/ReactFiber.h"
 #include "ReactReconciler/ReactFiberFlags.h"
 #include "ReactReconciler/ReactFiberHydrationContext.h"
+#include "ReactReconciler/ReactFiberKeyMap.h"
 #include "ReactReconciler/ReactFiberNewContext.h"
 #include "ReactReconciler/ReactFiberThenable.h"
 #include "ReactReconciler/ReactFiberTreeContext.h"
+#include "ReactReconciler/ReactFiberTypeDescriptor.h"
 #include "ReactReconciler/ReactTypeOfMode.h"
 #include "ReactReconciler/ReactWorkTags.h"
 #include "shared/ReactSymbols.h"
@@ -14,7 +16,6 @@
 #include <memory>
 #include <sstream>
 #include <stdexcept>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -127,17 +128,6 @@ bool isTextLike(const Value& value) {
   return value.isString() || value.isNumber();
 }
 
-std::string valueToKey(Runtime& runtime, const Value& value) {
-  if (value.isString()) {
-    return value.getString(runtime).utf8(runtime);
-  }
-  if (value.isNumber()) {
-    std::ostringstream out;
-    out << value.getNumber();
-    return out.str();
-  }
-  return std::string{};
-}
 
 std::string valueToText(Runtime& runtime, const Value& value) {
   if (value.isString()) {
@@ -181,36 +171,7 @@ bool toBoolean(Runtime& runtime, const Value& value) {
 }
 
 WorkTag resolveTagForElement(Runtime& runtime, const Value& typeValue) {
-  if (typeValue.isString()) {
-    return WorkTag::HostComponent;
-  }
-
-  if (isSymbol(runtime, typeValue, REACT_FRAGMENT_TYPE)) {
-    return WorkTag::Fragment;
-  }
-  if (isSymbol(runtime, typeValue, REACT_PROFILER_TYPE)) {
-    return WorkTag::Profiler;
-  }
-  if (isSymbol(runtime, typeValue, REACT_STRICT_MODE_TYPE)) {
-    return WorkTag::Mode;
-  }
-  if (isSymbol(runtime, typeValue, REACT_SUSPENSE_TYPE)) {
-    return WorkTag::SuspenseComponent;
-  }
-  if (isSymbol(runtime, typeValue, REACT_SUSPENSE_LIST_TYPE)) {
-    return WorkTag::SuspenseListComponent;
-  }
-  if (isSymbol(runtime, typeValue, REACT_LAZY_TYPE)) {
-    return WorkTag::LazyComponent;
-  }
-  if (isSymbol(runtime, typeValue, REACT_MEMO_TYPE)) {
-    return WorkTag::MemoComponent;
-  }
-  if (isSymbol(runtime, typeValue, REACT_FORWARD_REF_TYPE)) {
-    return WorkTag::ForwardRef;
-  }
-
-  return WorkTag::FunctionComponent;
+  return describeElementType(runtime, typeValue)->tag;
 }
 
 FiberNode* createFiberFromReactElement(
@@ -221,15 +182,10 @@ FiberNode* createFiberFromReactElement(
   const Value& typeValue = element.type;
   WorkTag tag = resolveTagForElement(runtime, typeValue);
 
-  std::string key;
-  if (element.key.has_value()) {
-    key = valueToKey(runtime, element.key.value());
-  }
-
   const Value propsValue(runtime, element.props);
   Value* propsStorage = storeValue(runtime, propsValue);
 
-  FiberNode* fiber = createFiber(tag, propsStorage, key, returnFiber.mode);
+  FiberNode* fiber = createFiber(tag, propsStorage, element.keyId, returnFiber.mode);
   fiber->lanes = lanes;
 
   Value* typeStorage = storeValue(runtime, typeValue);
@@ -304,12 +260,9 @@ PortalState* createPortalState(Runtime& runtime, const Object& portalObject) {
   return state;
 }
 
-std::string portalKeyFromObject(Runtime& runtime, const Object& portalObject) {
+ReactKey portalKeyFromObject(Runtime& runtime, const Object& portalObject) {
   Value keyValue = portalObject.getProperty(runtime, kKeyProp);
-  if (keyValue.isUndefined() || keyValue.isNull()) {
-    return std::string{};
-  }
-  return valueToKey(runtime, keyValue);
+  return internReactKey(runtime, keyValue);
 }
 
 bool isReactPortalObject(Runtime& runtime, const Object& objectValue) {
@@ -356,9 +309,9 @@ FiberNode* createPortalFiber(
     FiberNode& returnFiber,
     Value* pendingProps,
     const Object& portalObject,
-    std::string key,
+    ReactKeyId key,
     Lanes lanes) {
-  FiberNode* fiber = createFiber(WorkTag::HostPortal, pendingProps, std::move(key), returnFiber.mode);
+  FiberNode* fiber = createFiber(WorkTag::HostPortal, pendingProps, key, returnFiber.mode);
   fiber->lanes = lanes;
   fiber->stateNode = createPortalState(runtime, portalObject);
   return fiber;
@@ -368,8 +321,8 @@ FiberNode* createFragmentFiber(
     FiberNode& returnFiber,
     Value* children,
     Lanes lanes,
-    std::string key = std::string{}) {
-  FiberNode* fiber = createFiber(WorkTag::Fragment, children, std::move(key), returnFiber.mode);
+    ReactKeyId key = NoReactKey) {
+  FiberNode* fiber = createFiber(WorkTag::Fragment, children, key, returnFiber.mode);
   fiber->lanes = lanes;
   return fiber;
 }
@@ -438,7 +391,7 @@ void deleteChild(FiberNode& returnFiber, FiberNode* childToDelete, bool shouldTr
   if (!shouldTrackSideEffects || childToDelete == nullptr) {
     return;
   }
-  returnFiber.deletions.push_back(childToDelete);
+  returnFiber.addDeletion(childToDelete);
   returnFiber.flags = static_cast<FiberFlags>(returnFiber.flags | ChildDeletion);
 }
 
@@ -465,39 +418,61 @@ FiberNode* placeSingleChild(FiberNode& returnFiber, FiberNode* child, bool shoul
   return child;
 }
 
-std::string makeIndexKey(std::size_t index) {
-  return "#" + std::to_string(index);
-}
-
-std::string fiberMapKey(const FiberNode& fiber) {
-  if (!fiber.key.empty()) {
-    return fiber.key;
+FiberKeyMap::SlotKey fiberMapKey(const FiberNode& fiber) {
+  if (fiber.key != NoReactKey) {
+    return FiberKeyMap::keyedSlot(fiber.key);
   }
-  return makeIndexKey(fiber.index);
+  return FiberKeyMap::indexSlot(fiber.index);
 }
 
-std::string childMapKey(Runtime& runtime, const Value& childValue, std::size_t index) {
-  if (jsx::isReactElementValue(runtime, childValue)) {
-    auto element = jsx::getReactElementFromValue(runtime, childValue);
-    if (element->key.has_value()) {
-      std::string key = valueToKey(runtime, element->key.value());
-      if (!key.empty()) {
-        return key;
-      }
+FiberKeyMap::SlotKey childMapKey(Runtime& runtime, const Value& childValue, std::size_t index) {
+  if (auto element = jsx::getReactElementFromValue(runtime, childValue)) {
+    if (element->keyId != NoReactKey) {
+      return FiberKeyMap::keyedSlot(element->keyId);
     }
-  }
- 
-  if (isReactPortalValue(runtime, childValue)) {
+  } else if (isReactPortalValue(runtime, childValue)) {
     Object portalObject = childValue.getObject(runtime);
-    std::string key = portalKeyFromObject(runtime, portalObject);
-    if (!key.empty()) {
-      return key;
+    const ReactKey key = portalKeyFromObject(runtime, portalObject);
+    if (key != NoReactKey) {
+      return FiberKeyMap::keyedSlot(key);
     }
   }
- 
-  return makeIndexKey(index);
+
+  return FiberKeyMap::indexSlot(index);
 }
 
+// reconcileChildrenArray borrows a map per nesting level so the slot
+// storage survives across calls on this thread
+class ScopedFiberKeyMap {
+public:
+  ScopedFiberKeyMap() {
+    if (depth_ == pool_.size()) {
+      pool_.push_back(std::make_unique<FiberKeyMap>());
+    }
+    map_ = pool_[depth_++].get();
+  }
+
+  ~ScopedFiberKeyMap() {
+    --depth_;
+  }
+
+  ScopedFiberKeyMap(const ScopedFiberKeyMap&) = delete;
+  ScopedFiberKeyMap& operator=(const ScopedFiberKeyMap&) = delete;
+
+  FiberKeyMap& operator*() const {
+    return *map_;
+  }
+
+private:
+  static thread_local std::vector<std::unique_ptr<FiberKeyMap>> pool_;
+  static thread_local std::size_t depth_;
+
+  FiberKeyMap* map_;
+};
+
+thread_local std::vector<std::unique_ptr<FiberKeyMap>> ScopedFiberKeyMap::pool_;
+thread_local std::size_t ScopedFiberKeyMap::depth_ = 0;
+
 int placeChildWithTracking(
     FiberNode& returnFiber,
     FiberNode* child,
@@ -608,8 +583,8 @@ FiberNode* createFiberForPortalValue(
     return clone;
   }
 
-  std::string key = portalKeyFromObject(runtime, portalObject);
-  return createPortalFiber(runtime, returnFiber, childrenStorage, portalObject, std::move(key), renderLanes);
+  const ReactKey key = portalKeyFromObject(runtime, portalObject);
+  return createPortalFiber(runtime, returnFiber, childrenStorage, portalObject, key, renderLanes);
 }
 
 FiberNode* reconcileSingleElement(
@@ -619,13 +594,8 @@ FiberNode* reconcileSingleElement(
     const jsx::ReactElement& element,
     Lanes renderLanes,
     bool shouldTrackSideEffects) {
-  std::string key;
-  if (element.key.has_value()) {
-    key = valueToKey(runtime, element.key.value());
-  }
-
   if (currentFirstChild != nullptr) {
-    const bool keysMatch = currentFirstChild->key == key;
+    const bool keysMatch = currentFirstChild->key == element.keyId;
     const WorkTag expectedTag = resolveTagForElement(runtime, element.type);
     if (keysMatch && fiberTypeMatchesElement(runtime, *currentFirstChild, element, expectedTag)) {
       if (shouldTrackSideEffects) {
@@ -657,7 +627,7 @@ FiberNode* reconcileSinglePortal(
     const Object& portalObject,
     Lanes renderLanes,
     bool shouldTrackSideEffects) {
-  std::string key = portalKeyFromObject(runtime, portalObject);
+  const ReactKey key = portalKeyFromObject(runtime, portalObject);
 
   FiberNode* child = currentFirstChild;
   while (child != nullptr) {
@@ -791,6 +761,9 @@ FiberNode* createFiberForChildValue(
   return nullptr;
 }
 
+// Mirrors ReactChildFiber's reconcileChildrenArray: a linear pass while the
+// old and new children line up, then a map over whatever is left. Unchanged
+// lists, appends and removals from the end never build the map.
 FiberNode* reconcileChildrenArray(
     Runtime& runtime,
     FiberNode* currentFirstChild,
@@ -798,61 +771,84 @@ FiberNode* reconcileChildrenArray(
     const Array& nextChildren,
     Lanes renderLanes,
     bool shouldTrackSideEffects) {
-  std::unordered_map<std::string, FiberNode*> existingChildren;
-  for (FiberNode* child = currentFirstChild; child != nullptr; child = child->sibling) {
-    existingChildren.emplace(fiberMapKey(*child), child);
-  }
+  const std::size_t length = nextChildren.size(runtime);
 
   FiberNode* firstNewChild = nullptr;
   FiberNode* previousNewChild = nullptr;
   int lastPlacedIndex = 0;
 
-  const std::size_t length = nextChildren.size(runtime);
-  for (std::size_t index = 0; index < length; ++index) {
-    Value nextChild = nextChildren.getValueAtIndex(runtime, index);
-    std::string lookupKey = childMapKey(runtime, nextChild, index);
-
-    FiberNode* matchedExisting = nullptr;
-    auto iter = existingChildren.find(lookupKey);
-    if (iter != existingChildren.end()) {
-      matchedExisting = iter->second;
+  auto placeNewChild = [&](FiberNode* newFiber, std::size_t index) {
+    if (newFiber == nullptr) {
+      return;
     }
+    lastPlacedIndex = placeChildWithTracking(workInProgress, newFiber, lastPlacedIndex, index, shouldTrackSideEffects);
+    if (firstNewChild == nullptr) {
+      firstNewChild = newFiber;
+    } else {
+      previousNewChild->sibling = newFiber;
+    }
+    previousNewChild = newFiber;
+  };
 
+  auto updateMatched = [&](FiberNode* matchedExisting, const Value& nextChild, std::size_t index) {
     bool didReuseExisting = false;
     FiberNode* newFiber = createFiberForChildValue(
         runtime, workInProgress, matchedExisting, nextChild, renderLanes, didReuseExisting);
-
-    if (matchedExisting != nullptr) {
-      existingChildren.erase(lookupKey);
-      if (!didReuseExisting && shouldTrackSideEffects) {
-        deleteChild(workInProgress, matchedExisting, shouldTrackSideEffects);
-      }
+    if (matchedExisting != nullptr && !didReuseExisting && shouldTrackSideEffects) {
+      deleteChild(workInProgress, matchedExisting, shouldTrackSideEffects);
+    }
+    placeNewChild(newFiber, index);
+  };
+
+  // Pass 1: walk both lists in lockstep while each old child has the same
+  // key (or index, when unkeyed) as the new child in its position
+  FiberNode* oldFiber = currentFirstChild;
+  std::size_t index = 0;
+  for (; oldFiber != nullptr && index < length; ++index) {
+    Value nextChild = nextChildren.getValueAtIndex(runtime, index);
+    if (childMapKey(runtime, nextChild, index) != fiberMapKey(*oldFiber)) {
+      break;
     }
+    FiberNode* nextOldFiber = oldFiber->sibling;
+    updateMatched(oldFiber, nextChild, index);
+    oldFiber = nextOldFiber;
+  }
 
-    if (newFiber == nullptr) {
-      continue;
+  if (index == length) {
+    // Removed from the end, or unchanged
+    if (shouldTrackSideEffects) {
+      deleteRemainingChildren(workInProgress, oldFiber, shouldTrackSideEffects);
+    }
+  } else if (oldFiber == nullptr) {
+    // Appended, or mounting
+    for (; index < length; ++index) {
+      Value nextChild = nextChildren.getValueAtIndex(runtime, index);
+      updateMatched(nullptr, nextChild, index);
+    }
+  } else {
+    // Pass 2: match the remaining tail by key
+    ScopedFiberKeyMap scopedMap;
+    FiberKeyMap& existingChildren = *scopedMap;
+    existingChildren.reset(length - index);
+    for (; oldFiber != nullptr; oldFiber = oldFiber->sibling) {
+      existingChildren.insert(fiberMapKey(*oldFiber), oldFiber);
     }
 
-    lastPlacedIndex = placeChildWithTracking(workInProgress, newFiber, lastPlacedIndex, index, shouldTrackSideEffects);
+    for (; index < length; ++index) {
+      Value nextChild = nextChildren.getValueAtIndex(runtime, index);
+      FiberNode* matchedExisting = existingChildren.take(childMapKey(runtime, nextChild, index));
+      updateMatched(matchedExisting, nextChild, index);
+    }
 
-    if (firstNewChild == nullptr) {
-      firstNewChild = newFiber;
-    } else {
-      previousNewChild->sibling = newFiber;
+    if (shouldTrackSideEffects) {
+      existingChildren.forEach([&](FiberNode* child) { deleteChild(workInProgress, child, shouldTrackSideEffects); });
     }
-    previousNewChild = newFiber;
   }
 
   if (previousNewChild != nullptr) {
     previousNewChild->sibling = nullptr;
   }
 
-  if (shouldTrackSideEffects) {
-    for (const auto& entry : existingChildren) {
-      deleteChild(workInProgress, entry.second, shouldTrackSideEffects);
-    }
-  }
-
   recordChildForkIfHydrating(workInProgress, length);
   workInProgress.child = firstNewChild;
   return firstNewChild;
@@ -1,48 +1,43 @@
 #include "ReactReconciler/ReactFiberHiddenContext.h"
 
 #include "ReactReconciler/ReactFiberWorkLoop.h"
+#include "ReactReconciler/ReactFiberWorkLoopState.h"
 #include "ReactRuntime/ReactRuntime.h"
 
 namespace react {
-namespace {
 
-StackCursor<HiddenContextOptional> gCurrentTreeHiddenStackCursor =
-    createCursor<HiddenContextOptional>(std::nullopt);
-StackCursor<Lanes> gPrevEntangledRenderLanesCursor =
-    createCursor<Lanes>(NoLanes);
-
-} // namespace
-
-StackCursor<HiddenContextOptional>& currentTreeHiddenStackCursor() {
-  return gCurrentTreeHiddenStackCursor;
+StackCursor<HiddenContextOptional>& currentTreeHiddenStackCursor(ReactRuntime& runtime) {
+  return runtime.workLoopState().currentTreeHiddenStackCursor;
 }
 
-StackCursor<Lanes>& prevEntangledRenderLanesCursor() {
-  return gPrevEntangledRenderLanesCursor;
+StackCursor<Lanes>& prevEntangledRenderLanesCursor(ReactRuntime& runtime) {
+  return runtime.workLoopState().prevEntangledRenderLanesCursor;
 }
 
 void pushHiddenContext(ReactRuntime& runtime, FiberNode& fiber, const HiddenContext& context) {
   const auto prevEntangledRenderLanes = getEntangledRenderLanes(runtime);
-  push(gPrevEntangledRenderLanesCursor, prevEntangledRenderLanes, &fiber);
-  push(gCurrentTreeHiddenStackCursor, HiddenContextOptional{context}, &fiber);
+  push(prevEntangledRenderLanesCursor(runtime), prevEntangledRenderLanes, &fiber);
+  push(currentTreeHiddenStackCursor(runtime), HiddenContextOptional{context}, &fiber);
 
   setEntangledRenderLanes(runtime, mergeLanes(prevEntangledRenderLanes, context.baseLanes));
 }
 
 void reuseHiddenContextOnStack(ReactRuntime& runtime, FiberNode& fiber) {
   const auto prevEntangledRenderLanes = getEntangledRenderLanes(runtime);
-  push(gPrevEntangledRenderLanesCursor, prevEntangledRenderLanes, &fiber);
-  push(gCurrentTreeHiddenStackCursor, gCurrentTreeHiddenStackCursor.current, &fiber);
+  push(prevEntangledRenderLanesCursor(runtime), prevEntangledRenderLanes, &fiber);
+  auto& hiddenCursor = currentTreeHiddenStackCursor(runtime);
+  push(hiddenCursor, hiddenCursor.current, &fiber);
 }
 
 void popHiddenContext(ReactRuntime& runtime, FiberNode& fiber) {
-  setEntangledRenderLanes(runtime, gPrevEntangledRenderLanesCursor.current);
-  pop(gCurrentTreeHiddenStackCursor, &fiber);
-  pop(gPrevEntangledRenderLanesCursor, &fiber);
+  auto& prevLanesCursor = prevEntangledRenderLanesCursor(runtime);
+  setEntangledRenderLanes(runtime, prevLanesCursor.current);
+  pop(currentTreeHiddenStackCursor(runtime), &fiber);
+  pop(prevLanesCursor, &fiber);
 }
 
-bool isCurrentTreeHidden() {
-  return gCurrentTreeHiddenStackCursor.current.has_value();
+bool isCurrentTreeHidden(ReactRuntime& runtime) {
+  return currentTreeHiddenStackCursor(runtime).current.has_value();
 }
 
 } // namespace react
@@ -16,13 +16,13 @@ struct HiddenContext {
 
 using HiddenContextOptional = std::optional<HiddenContext>;
 
-StackCursor<HiddenContextOptional>& currentTreeHiddenStackCursor();
-StackCursor<Lanes>& prevEntangledRenderLanesCursor();
+StackCursor<HiddenContextOptional>& currentTreeHiddenStackCursor(ReactRuntime& runtime);
+StackCursor<Lanes>& prevEntangledRenderLanesCursor(ReactRuntime& runtime);
 
 void pushHiddenContext(ReactRuntime& runtime, FiberNode& fiber, const HiddenContext& context);
 void reuseHiddenContextOnStack(ReactRuntime& runtime, FiberNode& fiber);
 void popHiddenContext(ReactRuntime& runtime, FiberNode& fiber);
 
-bool isCurrentTreeHidden();
+bool isCurrentTreeHidden(ReactRuntime& runtime);
 
 } // namespace react
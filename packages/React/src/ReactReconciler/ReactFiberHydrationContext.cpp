@@ -29,8 +29,8 @@ std::string getHostSingletonType(FiberNode& fiber) {
   if (!instance) {
     return std::string{};
   }
-  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(instance);
-  if (!component) {
+  const auto* component = dynamic_cast<const ReactDOMComponent*>(instance.get());
+  if (component == nullptr) {
     return std::string{};
   }
   return component->getType();
@@ -27,8 +27,7 @@ ReactDOMInstance* tryToClaimNextHydratableInstance(ReactRuntime& runtime, FiberN
   if (component && component->getType() == type) {
     state.hydrationParentFiber = &fiber;
     state.rootOrSingletonHydrationContext = false;
-    auto sharedInstance = instance->shared_from_this();
-    state.nextHydratableInstance = hostconfig::getFirstHydratableChild(runtime, sharedInstance);
+    state.nextHydratableInstance = hostconfig::getFirstHydratableChild(runtime, hostconfig::HostInstance(instance));
     return instance;
   }
   // If not matched, report error and skip.
@@ -69,11 +68,10 @@ ReactDOMInstance* claimHydratableSingleton(ReactRuntime& runtime, FiberNode& fib
     if (component && component->getType() == type) {
       state.hydrationParentFiber = &fiber;
       state.rootOrSingletonHydrationContext = true;
-      auto sharedInstance = instance->shared_from_this();
       state.nextHydratableInstance = hostconfig::getFirstHydratableChildWithinSingleton(
           runtime,
           type,
-          sharedInstance,
+          hostconfig::HostInstance(instance),
           state.nextHydratableInstance);
       return instance;
     }
@@ -99,7 +97,7 @@ void queueHydrationError(ReactRuntime& runtime, FiberNode& fiber, const char* me
   auto& state = getState(runtime);
   state.hydrationErrors.push_back({&fiber, std::string(message)});
   // Still mirror to stderr for debugging; host interfaces receive queued errors via ReactRuntime::drainHydrationErrors.
-  std::cerr << "[HydrationError] Fiber key: " << fiber.key << " - " << message << std::endl;
+  std::cerr << "[HydrationError] Fiber key: " << fiber.getKey() << " - " << message << std::endl;
 }
 
 } // namespace react
@@ -0,0 +1,95 @@
+#include "ReactReconciler/ReactFiberKeyMap.h"
+
+#include <utility>
+
+namespace react {
+
+namespace {
+
+constexpr std::size_t kMinCapacity = 8;
+
+// Load factor stays at or below 1/2
+std::size_t capacityFor(std::size_t entries) {
+  std::size_t capacity = kMinCapacity;
+  while (capacity < entries * 2) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+} // namespace
+
+void FiberKeyMap::reset(std::size_t expected) {
+  // assign() keeps the existing buffer when it is large enough
+  slots_.assign(capacityFor(expected), Slot{});
+  mask_ = slots_.size() - 1;
+  size_ = 0;
+}
+
+std::size_t FiberKeyMap::home(SlotKey key) const {
+  // Fibonacci hashing; the high bits of the product are the best mixed
+  return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask_;
+}
+
+void FiberKeyMap::grow() {
+  std::vector<Slot> previous = std::move(slots_);
+  slots_.assign(previous.size() * 2, Slot{});
+  mask_ = slots_.size() - 1;
+  size_ = 0;
+  for (const Slot& slot : previous) {
+    if (slot.key != kEmpty) {
+      insert(slot.key, slot.fiber);
+    }
+  }
+}
+
+void FiberKeyMap::insert(SlotKey key, FiberNode* fiber) {
+  if (slots_.empty()) {
+    reset(0);
+  } else if ((size_ + 1) * 2 > slots_.size()) {
+    grow();
+  }
+
+  std::size_t position = home(key);
+  while (slots_[position].key != kEmpty) {
+    if (slots_[position].key == key) {
+      return;
+    }
+    position = (position + 1) & mask_;
+  }
+  slots_[position] = Slot{key, fiber};
+  ++size_;
+}
+
+FiberNode* FiberKeyMap::take(SlotKey key) {
+  if (size_ == 0) {
+    return nullptr;
+  }
+
+  std::size_t position = home(key);
+  while (slots_[position].key != key) {
+    if (slots_[position].key == kEmpty) {
+      return nullptr;
+    }
+    position = (position + 1) & mask_;
+  }
+  FiberNode* fiber = slots_[position].fiber;
+
+  // Backward-shift the rest of the probe run into the hole
+  std::size_t hole = position;
+  std::size_t next = (hole + 1) & mask_;
+  while (slots_[next].key != kEmpty) {
+    const std::size_t desired = home(slots_[next].key);
+    // Move the entry unless its home lies cyclically in (hole, next]
+    if (((next - desired) & mask_) >= ((next - hole) & mask_)) {
+      slots_[hole] = slots_[next];
+      hole = next;
+    }
+    next = (next + 1) & mask_;
+  }
+  slots_[hole] = Slot{};
+  --size_;
+  return fiber;
+}
+
+} // namespace react
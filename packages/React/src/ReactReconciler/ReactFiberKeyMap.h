@@ -0,0 +1,74 @@
+#pragma once
+
+#include "shared/ReactKeyTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace react {
+
+struct FiberNode;
+
+/**
+ * Open-addressing map from a child's identity to its current fiber
+ *
+ * Used by reconcileChildrenArray to match new children against the old
+ * ones. A child is identified by its interned key id, or by its index when
+ * it has no key; both are packed into one nonzero 64-bit slot key, so
+ * lookups never touch key strings. Linear probing with backward-shift
+ * erase keeps the table free of tombstones, and reset() reuses the slot
+ * storage across calls instead of reallocating.
+ */
+class FiberKeyMap {
+public:
+  using SlotKey = std::uint64_t;
+
+  static SlotKey keyedSlot(ReactKeyId key) {
+    return key;
+  }
+
+  static SlotKey indexSlot(std::size_t index) {
+    return kIndexTag | static_cast<std::uint32_t>(index);
+  }
+
+  // Empties the map and sizes it for about `expected` entries
+  void reset(std::size_t expected);
+
+  // Keeps the existing entry when the slot key is already present
+  void insert(SlotKey key, FiberNode* fiber);
+
+  // Removes and returns the entry for `key`, or nullptr
+  FiberNode* take(SlotKey key);
+
+  std::size_t size() const {
+    return size_;
+  }
+
+  template<typename Fn>
+  void forEach(Fn&& fn) const {
+    for (const Slot& slot : slots_) {
+      if (slot.key != kEmpty) {
+        fn(slot.fiber);
+      }
+    }
+  }
+
+private:
+  static constexpr SlotKey kEmpty = 0;
+  static constexpr SlotKey kIndexTag = SlotKey{1} << 32;
+
+  struct Slot {
+    SlotKey key{kEmpty};
+    FiberNode* fiber{nullptr};
+  };
+
+  std::size_t home(SlotKey key) const;
+  void grow();
+
+  std::vector<Slot> slots_;
+  std::size_t mask_{0};
+  std::size_t size_{0};
+};
+
+} // namespace react
@@ -4,6 +4,7 @@
 // Source: reactjs/packages/react-reconciler/src/ReactFiberLane.js
 
 #include "shared/ReactFeatureFlags.h"
+#include "ReactReconciler/ReactFiberLaneStorage.h"
 #include "ReactReconciler/ReactRootTags.h"
 #include "scheduler/Scheduler.h"
 #include "scheduler/Scheduler.h"
@@ -12,6 +13,7 @@
 #include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <unordered_map>
@@ -25,6 +27,8 @@ using Lanes = std::uint32_t;
 
 class FiberNode;
 struct FiberRoot;
+class FiberArena;
+class RootScheduleIndex;
 class Wakeable;
 struct Transition {};
 
@@ -541,7 +545,9 @@ enum class LanePriority : std::uint8_t {
 
 struct FiberRoot {
 	FiberNode* current{nullptr};
-	FiberRoot* next{nullptr};
+	// Set while the root scheduler tracks this root; see ReactFiberRootScheduleIndex.h
+	RootScheduleIndex* scheduleIndex{nullptr};
+	std::uint32_t scheduleSlot{0};
 	TaskHandle callbackNode{};
 	Lane callbackPriority{NoLane};
 	TimeoutHandle timeoutHandle{noTimeout};
@@ -558,15 +564,12 @@ struct FiberRoot {
 	Lanes indicatorLanes{NoLanes};
 	LaneMap<int> expirationTimes{createLaneMap<int>(NoTimestamp)};
 	int shellSuspendCounter{0};
-	LaneMap<std::optional<std::vector<ConcurrentUpdate*>>> hiddenUpdates{
-		createLaneMap<std::optional<std::vector<ConcurrentUpdate*>>>(std::nullopt)};
-	LaneMap<std::unordered_set<const FiberNode*>> pendingUpdatersLaneMap{
-		createLaneMap<std::unordered_set<const FiberNode*>>(
-			std::unordered_set<const FiberNode*>{})};
+	// Per-lane storage is sparse: only lanes with entries cost anything
+	SparseLaneMap<std::vector<ConcurrentUpdate*>> hiddenUpdates{};
+	SparseLaneMap<SmallSet<const FiberNode*, 2>> pendingUpdatersLaneMap{};
 	std::unordered_set<const FiberNode*> memoizedUpdaters{};
-	LaneMap<std::optional<std::unordered_set<const Transition*>>> transitionLanes{
-		createLaneMap<std::optional<std::unordered_set<const Transition*>>>(std::nullopt)};
-	std::unordered_map<const Wakeable*, std::unordered_set<Lanes>> pingCache{};
+	SparseLaneMap<SmallSet<const Transition*, 2>> transitionLanes{};
+	std::unordered_map<const Wakeable*, SmallSet<Lanes, 2>> pingCache{};
 	std::function<std::function<void()>()> onDefaultTransitionIndicator{};
 	std::function<void()> pendingIndicator{};
 	void* pooledCache{nullptr};
@@ -577,8 +580,22 @@ struct FiberRoot {
 	struct HostRootState {
 		bool isDehydrated{false};
 	} hostRootState{};
+	// Backing storage for this root's fibers; see ReactFiberArena.h. Set on
+	// roots made by ReactRuntime::createFiberRoot. Without one, fibers are
+	// heap-allocated and deleted one by one.
+	std::shared_ptr<FiberArena> fiberArena{};
 };
 
+void updateRootScheduleIndex(FiberRoot& root);
+void setRootNextExpirationTime(FiberRoot& root, int expirationTime);
+
+// Called after every change to root.pendingLanes
+inline void notifyPendingLanesChanged(FiberRoot& root) {
+	if (root.scheduleIndex != nullptr) {
+		updateRootScheduleIndex(root);
+	}
+}
+
 [[nodiscard]] inline int computeExpirationTime(Lane lane, int currentTime) {
 	switch (lane) {
 		case SyncHydrationLane:
@@ -623,6 +640,7 @@ struct FiberRoot {
 
 inline void markRootUpdated(FiberRoot& root, Lane updateLane) {
 	root.pendingLanes |= updateLane;
+	notifyPendingLanesChanged(root);
 	if (enableDefaultTransitionIndicator) {
 		root.indicatorLanes |= updateLane & TransitionLanes;
 	}
@@ -635,6 +653,7 @@ inline void markRootUpdated(FiberRoot& root, Lane updateLane) {
 
 inline void markSpawnedDeferredLane(FiberRoot& root, Lane spawnedLane, Lanes entangledLanes) {
 	root.pendingLanes |= spawnedLane;
+	notifyPendingLanesChanged(root);
 	root.suspendedLanes &= ~spawnedLane;
 
 	const auto spawnedLaneIndex = laneToIndex(spawnedLane);
@@ -771,6 +790,7 @@ inline void markRootFinished(
 	const Lanes noLongerPendingLanes = previouslyPendingLanes & ~remainingLanes;
 
 	root.pendingLanes = remainingLanes;
+	notifyPendingLanesChanged(root);
 	root.suspendedLanes = NoLanes;
 	root.pingedLanes = NoLanes;
 	root.warmLanes = NoLanes;
@@ -796,14 +816,13 @@ inline void markRootFinished(
 		entanglements[index] = NoLanes;
 		expirationTimes[index] = NoTimestamp;
 
-		auto& hiddenSlot = hiddenUpdates[index];
-		if (hiddenSlot.has_value()) {
+		if (auto* hiddenSlot = hiddenUpdates.find(index)) {
 			for (auto* update : *hiddenSlot) {
 				if (update != nullptr) {
 					update->lane &= ~OffscreenLane;
 				}
 			}
-			hiddenSlot.reset();
+			hiddenUpdates.erase(index);
 		}
 
 		lanes &= ~lane;
@@ -823,21 +842,31 @@ inline void markRootFinished(
 
 inline void markStarvedLanesAsExpired(FiberRoot& root, int currentTime) {
 	Lanes lanes = enableRetryLaneExpiration ? root.pendingLanes : removeLanes(root.pendingLanes, RetryLanes);
+	// The root scheduler revisits the root when the next of these comes due
+	int nextExpirationTime = NoTimestamp;
 	while (lanes != NoLanes) {
 		const auto index = pickArbitraryLaneIndex(lanes);
 		const auto lane = static_cast<Lane>(1u << index);
-		const int expirationTime = root.expirationTimes[index];
+		int expirationTime = root.expirationTimes[index];
 		if (expirationTime == NoTimestamp) {
 			const bool laneSuspended = (lane & root.suspendedLanes) != NoLanes;
 			const bool lanePinged = (lane & root.pingedLanes) != NoLanes;
 			if (!laneSuspended || lanePinged) {
-				root.expirationTimes[index] = computeExpirationTime(lane, currentTime);
+				expirationTime = computeExpirationTime(lane, currentTime);
+				root.expirationTimes[index] = expirationTime;
 			}
 		} else if (expirationTime <= currentTime) {
 			root.expiredLanes |= lane;
 		}
+		if (expirationTime != NoTimestamp && (root.expiredLanes & lane) == NoLanes &&
+			(nextExpirationTime == NoTimestamp || expirationTime < nextExpirationTime)) {
+			nextExpirationTime = expirationTime;
+		}
 		lanes &= ~lane;
 	}
+	if (root.scheduleIndex != nullptr) {
+		setRootNextExpirationTime(root, nextExpirationTime);
+	}
 }
 
 [[nodiscard]] inline Lanes getEntangledLanes(const FiberRoot& root, Lanes renderLanes) {
@@ -902,6 +931,7 @@ inline void markRootEntangled(FiberRoot& root, Lanes entangledLanes) {
 
 inline void upgradePendingLanesToSync(FiberRoot& root, Lanes lanesToUpgrade) {
 	root.pendingLanes |= SyncLane;
+	notifyPendingLanesChanged(root);
 	root.entangledLanes |= SyncLane;
 	Lanes lanes = lanesToUpgrade;
 	while (lanes != NoLanes) {
@@ -917,11 +947,7 @@ inline void markHiddenUpdate(FiberRoot& root, ConcurrentUpdate* update, Lane lan
 		return;
 	}
 	const auto index = laneToIndex(lane);
-	auto& hiddenSlot = root.hiddenUpdates[index];
-	if (!hiddenSlot.has_value()) {
-		hiddenSlot.emplace();
-	}
-	hiddenSlot->push_back(update);
+	root.hiddenUpdates.emplace(index).push_back(update);
 	update->lane = lane | OffscreenLane;
 }
 
@@ -1005,7 +1031,7 @@ inline void addFiberToLanesMap(FiberRoot& root, const FiberNode* fiber, Lanes la
 	while (remaining != NoLanes) {
 		const auto index = pickArbitraryLaneIndex(remaining);
 		const auto lane = static_cast<Lane>(1u << index);
-		root.pendingUpdatersLaneMap[index].insert(fiber);
+		root.pendingUpdatersLaneMap.emplace(index).insert(fiber);
 		remaining &= ~lane;
 	}
 }
@@ -1015,11 +1041,7 @@ inline void addTransitionToLanesMap(FiberRoot& root, const Transition* transitio
 		return;
 	}
 	const auto index = laneToIndex(lane);
-	auto& slot = root.transitionLanes[index];
-	if (!slot.has_value()) {
-		slot.emplace();
-	}
-	slot->insert(transition);
+	root.transitionLanes.emplace(index).insert(transition);
 }
 
 [[nodiscard]] inline std::vector<const Transition*> getTransitionsForLanes(const FiberRoot& root, Lanes lanes) {
@@ -1032,8 +1054,7 @@ inline void addTransitionToLanesMap(FiberRoot& root, const Transition* transitio
 	while (remaining != NoLanes) {
 		const auto index = pickArbitraryLaneIndex(remaining);
 		const auto lane = static_cast<Lane>(1u << index);
-		const auto& slot = root.transitionLanes[index];
-		if (slot.has_value()) {
+		if (const auto* slot = root.transitionLanes.find(index)) {
 			for (const auto* entry : *slot) {
 				if (entry != nullptr && seen.insert(entry).second) {
 					transitions.push_back(entry);
@@ -1053,7 +1074,7 @@ inline void clearTransitionsForLanes(FiberRoot& root, Lanes lanes) {
 	while (remaining != NoLanes) {
 		const auto index = pickArbitraryLaneIndex(remaining);
 		const auto lane = static_cast<Lane>(1u << index);
-		root.transitionLanes[index].reset();
+		root.transitionLanes.erase(index);
 		remaining &= ~lane;
 	}
 }
@@ -1066,11 +1087,67 @@ inline void movePendingFibersToMemoized(FiberRoot& root, Lanes lanes) {
 	while (remaining != NoLanes) {
 		const auto index = pickArbitraryLaneIndex(remaining);
 		const auto lane = static_cast<Lane>(1u << index);
-		auto& updaters = root.pendingUpdatersLaneMap[index];
-		root.memoizedUpdaters.insert(updaters.begin(), updaters.end());
-		updaters.clear();
+		if (const auto* updaters = root.pendingUpdatersLaneMap.find(index)) {
+			root.memoizedUpdaters.insert(updaters->begin(), updaters->end());
+			root.pendingUpdatersLaneMap.erase(index);
+		}
 		remaining &= ~lane;
 	}
 }
 
+// Approximate bytes held by a root's lane bookkeeping. Hash containers are
+// estimated as one bucket pointer per bucket plus one node per entry.
+struct FiberRootMemoryUsage {
+	std::size_t inlineBytes{0};
+	std::size_t hiddenUpdateBytes{0};
+	std::size_t updaterBytes{0};
+	std::size_t transitionBytes{0};
+	std::size_t pingCacheBytes{0};
+
+	[[nodiscard]] std::size_t totalBytes() const {
+		return inlineBytes + hiddenUpdateBytes + updaterBytes + transitionBytes + pingCacheBytes;
+	}
+};
+
+namespace detail {
+
+template <typename Container>
+[[nodiscard]] std::size_t estimateHashContainerBytes(const Container& container) {
+	if (container.empty()) {
+		// Standard libraries keep an empty table's single bucket inline
+		return 0;
+	}
+	return container.bucket_count() * sizeof(void*) +
+		container.size() * (sizeof(typename Container::value_type) + 2 * sizeof(void*));
+}
+
+} // namespace detail
+
+[[nodiscard]] inline FiberRootMemoryUsage getFiberRootMemoryUsage(const FiberRoot& root) {
+	FiberRootMemoryUsage usage;
+	usage.inlineBytes = sizeof(FiberRoot);
+
+	usage.hiddenUpdateBytes = root.hiddenUpdates.heapBytes();
+	root.hiddenUpdates.forEach([&](std::size_t, const std::vector<ConcurrentUpdate*>& updates) {
+		usage.hiddenUpdateBytes += updates.capacity() * sizeof(ConcurrentUpdate*);
+	});
+
+	usage.updaterBytes = root.pendingUpdatersLaneMap.heapBytes() +
+		detail::estimateHashContainerBytes(root.memoizedUpdaters);
+	root.pendingUpdatersLaneMap.forEach([&](std::size_t, const auto& updaters) {
+		usage.updaterBytes += updaters.heapBytes();
+	});
+
+	usage.transitionBytes = root.transitionLanes.heapBytes();
+	root.transitionLanes.forEach([&](std::size_t, const auto& transitions) {
+		usage.transitionBytes += transitions.heapBytes();
+	});
+
+	usage.pingCacheBytes = detail::estimateHashContainerBytes(root.pingCache);
+	for (const auto& entry : root.pingCache) {
+		usage.pingCacheBytes += entry.second.heapBytes();
+	}
+	return usage;
+}
+
 } // namespace react
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace react {
+
+/**
+ * Set of trivially copyable values with inline storage for the first few
+ *
+ * Per-lane updater and transition sets almost always hold one or two
+ * entries, so they live inline in the owner and only spill to a heap
+ * vector past InlineCapacity. Lookups are a linear scan, which beats
+ * hashing at these sizes. Iteration order is insertion order until an
+ * erase, which moves the last entry into the hole.
+ */
+template <typename T, std::size_t InlineCapacity>
+class SmallSet {
+  static_assert(std::is_trivially_copyable_v<T>, "SmallSet stores values by copy");
+  static_assert(InlineCapacity > 0 && InlineCapacity <= 255, "InlineCapacity must fit the inline count");
+
+public:
+  using value_type = T;
+  using const_iterator = const T*;
+
+  bool insert(T value) {
+    if (contains(value)) {
+      return false;
+    }
+    if (heap_.empty()) {
+      if (inlineSize_ < InlineCapacity) {
+        inline_[inlineSize_++] = value;
+        return true;
+      }
+      heap_.reserve(InlineCapacity * 2);
+      heap_.assign(inline_.begin(), inline_.end());
+      inlineSize_ = 0;
+    }
+    heap_.push_back(value);
+    return true;
+  }
+
+  bool erase(T value) {
+    T* first = data();
+    T* last = first + size();
+    T* found = std::find(first, last, value);
+    if (found == last) {
+      return false;
+    }
+    *found = *(last - 1);
+    if (heap_.empty()) {
+      --inlineSize_;
+    } else {
+      heap_.pop_back();
+    }
+    return true;
+  }
+
+  bool contains(T value) const {
+    return std::find(begin(), end(), value) != end();
+  }
+
+  void clear() {
+    inlineSize_ = 0;
+    heap_.clear();
+  }
+
+  std::size_t size() const {
+    return heap_.empty() ? inlineSize_ : heap_.size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  const_iterator begin() const {
+    return data();
+  }
+
+  const_iterator end() const {
+    return data() + size();
+  }
+
+  // Bytes owned outside the object itself
+  std::size_t heapBytes() const {
+    return heap_.capacity() * sizeof(T);
+  }
+
+private:
+  T* data() {
+    return heap_.empty() ? inline_.data() : heap_.data();
+  }
+
+  const T* data() const {
+    return heap_.empty() ? inline_.data() : heap_.data();
+  }
+
+  // While heap_ is non-empty it holds every entry and inline_ is unused
+  std::array<T, InlineCapacity> inline_{};
+  std::uint8_t inlineSize_{0};
+  std::vector<T> heap_{};
+};
+
+/**
+ * Lane-indexed map that only stores entries for lanes in use
+ *
+ * A dense LaneMap of containers costs 31 constructed entries per root even
+ * though a root rarely has more than a couple of lanes with hidden updates
+ * or transitions at once. This keeps a bitmask of occupied lanes and a
+ * vector of values ordered by lane index; a lane's slot is the number of
+ * occupied lanes below it. An empty map owns no heap storage.
+ */
+template <typename T>
+class SparseLaneMap {
+public:
+  bool contains(std::size_t index) const {
+    return (occupied_ & bit(index)) != 0;
+  }
+
+  T* find(std::size_t index) {
+    return contains(index) ? &values_[slot(index)] : nullptr;
+  }
+
+  const T* find(std::size_t index) const {
+    return contains(index) ? &values_[slot(index)] : nullptr;
+  }
+
+  // Returns the entry for `index`, default-constructing it if absent
+  T& emplace(std::size_t index) {
+    const std::size_t position = slot(index);
+    if (!contains(index)) {
+      values_.emplace(values_.begin() + static_cast<std::ptrdiff_t>(position));
+      occupied_ |= bit(index);
+    }
+    return values_[position];
+  }
+
+  void erase(std::size_t index) {
+    if (!contains(index)) {
+      return;
+    }
+    values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(slot(index)));
+    occupied_ &= ~bit(index);
+    if (values_.empty()) {
+      // Roots go idle between renders; give the storage back
+      std::vector<T>().swap(values_);
+    }
+  }
+
+  void clear() {
+    occupied_ = 0;
+    std::vector<T>().swap(values_);
+  }
+
+  // Bitmask of lanes that have an entry
+  std::uint32_t lanes() const {
+    return occupied_;
+  }
+
+  std::size_t size() const {
+    return values_.size();
+  }
+
+  bool empty() const {
+    return occupied_ == 0;
+  }
+
+  // Visits (index, value) in ascending lane order
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    std::uint32_t remaining = occupied_;
+    for (const T& value : values_) {
+      fn(static_cast<std::size_t>(__builtin_ctz(remaining)), value);
+      remaining &= remaining - 1;
+    }
+  }
+
+  // Bytes owned by the value vector, not counting what the values own
+  std::size_t heapBytes() const {
+    return values_.capacity() * sizeof(T);
+  }
+
+private:
+  static std::uint32_t bit(std::size_t index) {
+    return std::uint32_t{1} << index;
+  }
+
+  std::size_t slot(std::size_t index) const {
+    return static_cast<std::size_t>(__builtin_popcount(occupied_ & (bit(index) - 1)));
+  }
+
+  std::uint32_t occupied_{0};
+  std::vector<T> values_{};
+};
+
+} // namespace react
@@ -64,10 +64,11 @@ const char* currentValuePropertyName() {
 }
 
 ContextDependencyList* getContextDependencyList(const FiberNode& fiber) {
-  if (!fiber.dependencies) {
+  const FiberNode::Dependencies* deps = fiber.getDependencies();
+  if (deps == nullptr) {
     return nullptr;
   }
-  return static_cast<ContextDependencyList*>(fiber.dependencies->firstContext);
+  return static_cast<ContextDependencyList*>(deps->firstContext);
 }
 
 ContextHandle makeContextHandle(Runtime& runtime, const Value& contextValue) {
@@ -162,11 +163,7 @@ Value getObjectProperty(Runtime& runtime, const Value& objectValue, const char*
 }
 
 ContextDependencyList* ensureContextList(FiberNode& fiber) {
-  if (!fiber.dependencies) {
-    fiber.dependencies = std::make_unique<FiberNode::Dependencies>();
-  }
-
-  FiberNode::Dependencies* deps = fiber.dependencies.get();
+  FiberNode::Dependencies* deps = &fiber.ensureDependencies();
   if (deps->firstContext == nullptr) {
     deps->firstContext = new ContextDependencyList();
     deps->lanes = NoLanes;
@@ -315,10 +312,10 @@ void prepareToReadContext(FiberNode& workInProgress, Lanes /*renderLanes*/) {
   gCurrentlyRenderingFiber = &workInProgress;
   gLastContextDependency = nullptr;
 
-  if (workInProgress.dependencies) {
-    deleteContextDependencies(workInProgress.dependencies->firstContext);
-    workInProgress.dependencies->firstContext = nullptr;
-    workInProgress.dependencies->lanes = NoLanes;
+  if (FiberNode::Dependencies* deps = workInProgress.getDependencies()) {
+    deleteContextDependencies(deps->firstContext);
+    deps->firstContext = nullptr;
+    deps->lanes = NoLanes;
   }
 }
 
@@ -0,0 +1,345 @@
+#include "ReactReconciler/ReactFiberReclaim.h"
+
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberArena.h"
+#include "ReactReconciler/ReactFiberConcurrentUpdates.h"
+#include "ReactReconciler/ReactFiberFlags.h"
+#include "ReactReconciler/ReactFiberHookTypes.h"
+#include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberOffscreenComponent.h"
+#include "ReactReconciler/ReactFiberWorkLoopState.h"
+#include "ReactReconciler/ReactHostConfig.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "shared/ReactKeyTable.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace react {
+
+namespace {
+
+using facebook::jsi::Value;
+
+// Tags whose memoizedState is a Hook chain and updateQueue an effect ring
+bool usesHooks(WorkTag tag) {
+  return tag == WorkTag::FunctionComponent || tag == WorkTag::SimpleMemoComponent;
+}
+
+bool holdsHostInstance(WorkTag tag) {
+  return tag == WorkTag::HostComponent || tag == WorkTag::HostText || tag == WorkTag::HostHoistable ||
+      tag == WorkTag::HostSingleton;
+}
+
+// Offscreen props are OffscreenProps records, and legacy hidden fibers read
+// theirs as one too; everything else below the root holds a cloned value
+bool holdsValueProps(WorkTag tag) {
+  return tag != WorkTag::HostRoot && tag != WorkTag::OffscreenComponent && tag != WorkTag::LegacyHiddenComponent;
+}
+
+template <typename T>
+void sortUnique(std::vector<T*>& pointers) {
+  std::sort(pointers.begin(), pointers.end(), std::less<T*>());
+  pointers.erase(std::unique(pointers.begin(), pointers.end()), pointers.end());
+}
+
+template <typename T>
+void addIfSet(std::vector<T*>& pointers, const void* pointer) {
+  if (pointer != nullptr) {
+    pointers.push_back(static_cast<T*>(const_cast<void*>(pointer)));
+  }
+}
+
+// Everything one batch frees, each pointer listed once after dedupe()
+struct ReclaimBatch {
+  std::vector<FiberNode*> fibers;
+  std::vector<Value*> values;
+  std::vector<OffscreenProps*> offscreenProps;
+  std::vector<hostconfig::HostInstance*> hostInstances;
+  std::vector<Hook*> hooks;
+  std::vector<FunctionComponentUpdateQueue*> updateQueues;
+
+  void collectPayloads(const FiberNode& fiber) {
+    if (holdsValueProps(fiber.tag)) {
+      addIfSet(values, fiber.pendingProps);
+      addIfSet(values, fiber.memoizedProps);
+    } else if (fiber.tag == WorkTag::OffscreenComponent) {
+      addIfSet(offscreenProps, fiber.pendingProps);
+      addIfSet(offscreenProps, fiber.memoizedProps);
+    }
+
+    addIfSet(values, fiber.type);
+    addIfSet(values, fiber.elementType);
+    // An Activity's Offscreen child borrows its parent's ref
+    if (fiber.tag != WorkTag::OffscreenComponent) {
+      addIfSet(values, fiber.ref);
+    }
+
+    if (fiber.tag == WorkTag::ClassComponent) {
+      addIfSet(values, fiber.stateNode);
+    } else if (holdsHostInstance(fiber.tag)) {
+      addIfSet(hostInstances, fiber.stateNode);
+    }
+
+    if (usesHooks(fiber.tag)) {
+      for (auto* hook = static_cast<Hook*>(fiber.memoizedState); hook != nullptr; hook = hook->next) {
+        hooks.push_back(hook);
+      }
+      addIfSet(updateQueues, fiber.updateQueue);
+    }
+  }
+
+  void dedupe() {
+    sortUnique(fibers);
+    sortUnique(values);
+    sortUnique(offscreenProps);
+    sortUnique(hostInstances);
+    sortUnique(hooks);
+    sortUnique(updateQueues);
+  }
+};
+
+void releaseHookQueue(HookQueue& queue) {
+  // Dispatches through the component's setters become no-ops
+  queue.fiber = nullptr;
+
+  auto* last = static_cast<HookUpdate*>(queue.pending);
+  queue.pending = nullptr;
+  if (last == nullptr) {
+    return;
+  }
+  auto* update = static_cast<HookUpdate*>(last->next);
+  while (true) {
+    auto* next = static_cast<HookUpdate*>(update->next);
+    const bool wasLast = update == last;
+    delete update;
+    if (wasLast) {
+      break;
+    }
+    update = next;
+  }
+}
+
+std::uint64_t releaseEffectRing(FunctionComponentUpdateQueue& queue) {
+  Effect* last = queue.lastEffect;
+  queue.lastEffect = nullptr;
+  if (last == nullptr) {
+    return 0;
+  }
+  std::uint64_t count = 0;
+  Effect* effect = last->next;
+  while (true) {
+    Effect* next = effect->next;
+    const bool wasLast = effect == last;
+    delete effect;
+    ++count;
+    if (wasLast) {
+      break;
+    }
+    effect = next;
+  }
+  return count;
+}
+
+void detachFromParent(FiberNode& fiber) {
+  fiber.returnFiber = nullptr;
+  fiber.sibling = nullptr;
+  if (fiber.alternate != nullptr) {
+    fiber.alternate->returnFiber = nullptr;
+    fiber.alternate->sibling = nullptr;
+  }
+}
+
+} // namespace
+
+void FiberReclaimQueue::enqueue(FiberNode& subtree, std::shared_ptr<FiberArena> arena) {
+  const std::uint64_t generation = arena ? arena->generation() : 0;
+  pending_.push_back(Entry{&subtree, std::move(arena), generation});
+  ++stats_.queuedSubtrees;
+}
+
+std::size_t FiberReclaimQueue::detachDeletions(FiberNode& finishedWork, const std::shared_ptr<FiberArena>& arena) {
+  std::size_t queued = 0;
+  walkStack_.clear();
+  walkStack_.push_back(&finishedWork);
+  while (!walkStack_.empty()) {
+    FiberNode* fiber = walkStack_.back();
+    walkStack_.pop_back();
+
+    if (!fiber->getDeletions().empty()) {
+      for (FiberNode* deleted : fiber->getDeletions()) {
+        detachFromParent(*deleted);
+        enqueue(*deleted, arena);
+        ++queued;
+      }
+      fiber->clearDeletions();
+    }
+
+    if ((fiber->subtreeFlags & ChildDeletion) == NoFlags) {
+      continue;
+    }
+    for (FiberNode* child = fiber->child; child != nullptr; child = child->sibling) {
+      walkStack_.push_back(child);
+    }
+  }
+  return queued;
+}
+
+std::size_t FiberReclaimQueue::detachAbandonedWork(
+    FiberNode& current,
+    FiberNode& workInProgress,
+    const std::shared_ptr<FiberArena>& arena) {
+  std::size_t queued = 0;
+  walkStack_.clear();
+  walkStack_.push_back(&workInProgress);
+  while (!walkStack_.empty()) {
+    FiberNode* fiber = walkStack_.back();
+    walkStack_.pop_back();
+
+    // A list shared with the current tree was not reconciled by this render
+    FiberNode* currentFiber = fiber == &workInProgress ? &current : fiber->alternate;
+    if (currentFiber == nullptr || fiber->child == currentFiber->child) {
+      continue;
+    }
+
+    FiberNode* child = fiber->child;
+    while (child != nullptr) {
+      FiberNode* sibling = child->sibling;
+      if (child->alternate == nullptr) {
+        // Mounted by this render, so everything below it was too
+        child->returnFiber = nullptr;
+        child->sibling = nullptr;
+        enqueue(*child, arena);
+        ++queued;
+      } else {
+        walkStack_.push_back(child);
+      }
+      child = sibling;
+    }
+    // The next render rebuilds this list from the current tree
+    fiber->child = currentFiber->child;
+  }
+  return queued;
+}
+
+void FiberReclaimQueue::reclaimAll() {
+  if (pending_.empty()) {
+    return;
+  }
+
+  std::vector<Entry> entries;
+  entries.swap(pending_);
+
+  ReclaimBatch batch;
+  std::vector<FiberNode*> stack;
+  std::vector<std::shared_ptr<FiberArena>> arenas;
+  for (Entry& entry : entries) {
+    if (entry.arena && entry.arena->generation() != entry.arenaGeneration) {
+      ++stats_.staleSubtrees;
+      continue;
+    }
+    if (entry.arena && std::find(arenas.begin(), arenas.end(), entry.arena) == arenas.end()) {
+      arenas.push_back(entry.arena);
+    }
+
+    stack.push_back(entry.fiber);
+    while (!stack.empty()) {
+      FiberNode* fiber = stack.back();
+      stack.pop_back();
+      batch.fibers.push_back(fiber);
+      batch.collectPayloads(*fiber);
+      if (fiber->alternate != nullptr) {
+        batch.fibers.push_back(fiber->alternate);
+        batch.collectPayloads(*fiber->alternate);
+      }
+      for (FiberNode* child = fiber->child; child != nullptr; child = child->sibling) {
+        stack.push_back(child);
+      }
+    }
+  }
+  batch.dedupe();
+
+  for (Hook* hook : batch.hooks) {
+    if (hook->queue) {
+      releaseHookQueue(*hook->queue);
+    }
+  }
+  for (FunctionComponentUpdateQueue* queue : batch.updateQueues) {
+    stats_.reclaimedEffects += releaseEffectRing(*queue);
+    delete queue;
+  }
+  for (Hook* hook : batch.hooks) {
+    delete hook;
+  }
+  for (OffscreenProps* props : batch.offscreenProps) {
+    delete props->children;
+    delete props;
+  }
+  for (hostconfig::HostInstance* instance : batch.hostInstances) {
+    delete instance;
+  }
+  for (Value* value : batch.values) {
+    delete value;
+  }
+
+  for (FiberNode* fiber : batch.fibers) {
+    bool released = false;
+    for (const auto& arena : arenas) {
+      if (arena->release(fiber)) {
+        released = true;
+        break;
+      }
+    }
+    if (!released) {
+      delete fiber;
+    }
+  }
+
+  ++stats_.batches;
+  stats_.reclaimedFibers += batch.fibers.size();
+  stats_.reclaimedValues += batch.values.size();
+  stats_.reclaimedHooks += batch.hooks.size();
+}
+
+void detachDeletedFibers(ReactRuntime& runtime, FiberRoot& root, FiberNode& finishedWork) {
+  runtime.workLoopState().fiberReclaimQueue.detachDeletions(finishedWork, root.fiberArena);
+  // Even without new deletions: a task that backed off relies on the next
+  // commit to retry it
+  scheduleFiberReclamation(runtime);
+}
+
+void detachAbandonedWork(ReactRuntime& runtime, FiberRoot& root) {
+  FiberNode* current = root.current;
+  FiberNode* workInProgress = current != nullptr ? current->alternate : nullptr;
+  if (workInProgress == nullptr) {
+    return;
+  }
+  FiberReclaimQueue& queue = runtime.workLoopState().fiberReclaimQueue;
+  if (queue.detachAbandonedWork(*current, *workInProgress, root.fiberArena) != 0) {
+    scheduleFiberReclamation(runtime);
+  }
+}
+
+void scheduleFiberReclamation(ReactRuntime& runtime) {
+  FiberReclaimQueue& queue = runtime.workLoopState().fiberReclaimQueue;
+  if (queue.empty() || queue.isTaskScheduled()) {
+    return;
+  }
+  queue.setTaskScheduled(true);
+  ReactRuntime* runtimePtr = &runtime;
+  runtime.scheduleTask(SchedulerPriority::IdlePriority, [runtimePtr]() { runFiberReclamationTask(*runtimePtr); });
+}
+
+void runFiberReclamationTask(ReactRuntime& runtime) {
+  FiberReclaimQueue& queue = runtime.workLoopState().fiberReclaimQueue;
+  queue.setTaskScheduled(false);
+  if (getConcurrentlyUpdatedLanes() != NoLanes) {
+    return;
+  }
+  queue.reclaimAll();
+  // The reclaimed fibers dropped their keys; free the ones nothing else holds
+  sweepReactKeys();
+}
+
+} // namespace react
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace react {
+
+class FiberArena;
+class ReactRuntime;
+struct FiberNode;
+struct FiberRoot;
+
+/**
+ * Fibers that have left the tree, waiting to be freed
+ *
+ * Commit unlinks every deleted subtree and queues it here, and
+ * prepareFreshStack queues the fibers an interrupted render had mounted.
+ * An idle-priority task then frees each subtree with what its fibers own:
+ * cloned props, type and ref values, hook chains with their queues and
+ * pending updates, effect rings, class instances and host instance slots.
+ * Portal, Suspense and Offscreen state stays with its owners.
+ *
+ * A fiber and its alternate share most of those pointers, so a batch
+ * collects every distinct one before freeing anything. Only the queued
+ * fiber's own tree is walked; alternates are freed but their child lists,
+ * which may still name fibers freed by an earlier batch, are not followed.
+ * Fibers go back to the arena that allocated them. An entry whose arena was
+ * bulk-freed after it was queued is dropped, since its fibers are gone.
+ */
+class FiberReclaimQueue {
+public:
+  struct Stats {
+    std::uint64_t queuedSubtrees{0};
+    std::uint64_t batches{0};
+    std::uint64_t reclaimedFibers{0};
+    // Cloned jsi values: props, types, refs and class instances
+    std::uint64_t reclaimedValues{0};
+    std::uint64_t reclaimedHooks{0};
+    std::uint64_t reclaimedEffects{0};
+    // Entries dropped because their arena was reset first
+    std::uint64_t staleSubtrees{0};
+  };
+
+  void enqueue(FiberNode& subtree, std::shared_ptr<FiberArena> arena);
+
+  // Unlinks and queues every deletion recorded in a committed tree, pruned
+  // by ChildDeletion in subtreeFlags. Returns how many subtrees it queued.
+  std::size_t detachDeletions(FiberNode& finishedWork, const std::shared_ptr<FiberArena>& arena);
+
+  // Queues the fibers an interrupted render mounted under `workInProgress`,
+  // the alternate of `current`. A child list the render did not reconcile
+  // is still the current tree's, so only reconciled lists are searched.
+  std::size_t detachAbandonedWork(FiberNode& current, FiberNode& workInProgress, const std::shared_ptr<FiberArena>& arena);
+
+  // Frees every queued subtree now
+  void reclaimAll();
+
+  std::size_t pendingSubtrees() const {
+    return pending_.size();
+  }
+
+  bool empty() const {
+    return pending_.empty();
+  }
+
+  bool isTaskScheduled() const {
+    return isTaskScheduled_;
+  }
+
+  void setTaskScheduled(bool scheduled) {
+    isTaskScheduled_ = scheduled;
+  }
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  struct Entry {
+    FiberNode* fiber{nullptr};
+    std::shared_ptr<FiberArena> arena{};
+    std::uint64_t arenaGeneration{0};
+  };
+
+  std::vector<Entry> pending_{};
+  // Reused by the detach walks
+  std::vector<FiberNode*> walkStack_{};
+  bool isTaskScheduled_{false};
+  Stats stats_{};
+};
+
+// Unlinks the deletions recorded in a just-committed tree and queues them.
+// Runs on every commit and schedules the reclaim task whenever anything is
+// queued, including subtrees an earlier task left behind.
+void detachDeletedFibers(ReactRuntime& runtime, FiberRoot& root, FiberNode& finishedWork);
+
+// Queues the fibers the interrupted render of `root` mounted. Runs after
+// the render's stack was reset and before the root's next createWorkInProgress.
+void detachAbandonedWork(ReactRuntime& runtime, FiberRoot& root);
+
+// Schedules the idle-priority reclaim task unless one is already pending
+void scheduleFiberReclamation(ReactRuntime& runtime);
+
+// Body of the reclaim task. Backs off while updates are still being queued,
+// since the concurrent update queue may point at queued fibers; the next
+// commit schedules another task, whether or not it deletes anything.
+void runFiberReclamationTask(ReactRuntime& runtime);
+
+} // namespace react
@@ -0,0 +1,89 @@
+#include "ReactReconciler/ReactFiberRootPool.h"
+
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberArena.h"
+#include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberRootScheduleIndex.h"
+
+#include <utility>
+
+namespace react {
+
+namespace {
+
+// Returns the root to its default state, keeping its arena slabs and the
+// buckets of its hash tables
+void resetForReuse(FiberRoot& root) {
+  if (root.scheduleIndex != nullptr) {
+    root.scheduleIndex->remove(root);
+  }
+
+  std::shared_ptr<FiberArena> arena = std::move(root.fiberArena);
+  if (arena) {
+    arena->reset();
+  }
+  auto memoizedUpdaters = std::move(root.memoizedUpdaters);
+  auto pingCache = std::move(root.pingCache);
+  memoizedUpdaters.clear();
+  pingCache.clear();
+
+  root = FiberRoot{};
+  root.fiberArena = std::move(arena);
+  root.memoizedUpdaters = std::move(memoizedUpdaters);
+  root.pingCache = std::move(pingCache);
+}
+
+} // namespace
+
+FiberRootPool::FiberRootPool(std::size_t capacity) : capacity_(capacity) {}
+
+FiberRootPool::~FiberRootPool() = default;
+
+std::unique_ptr<FiberRoot> FiberRootPool::acquire(RootTag tag, bool isStrictMode, void* containerInfo) {
+  std::unique_ptr<FiberRoot> root;
+  if (!pooled_.empty()) {
+    root = std::move(pooled_.back());
+    pooled_.pop_back();
+    ++stats_.hits;
+  } else {
+    root = std::make_unique<FiberRoot>();
+    ++stats_.misses;
+  }
+
+  root->tag = tag;
+  root->containerInfo = containerInfo;
+  FiberArenaScope scope(&ensureRootFiberArena(*root));
+  root->current = createHostRootFiber(tag, isStrictMode);
+  root->current->stateNode = root.get();
+  return root;
+}
+
+void FiberRootPool::release(std::unique_ptr<FiberRoot> root) {
+  if (!root) {
+    return;
+  }
+  ++stats_.releases;
+  if (pooled_.size() >= capacity_) {
+    if (root->scheduleIndex != nullptr) {
+      root->scheduleIndex->remove(*root);
+    }
+    releaseRootFibers(*root);
+    ++stats_.discards;
+    return;
+  }
+  resetForReuse(*root);
+  pooled_.push_back(std::move(root));
+}
+
+void FiberRootPool::setCapacity(std::size_t capacity) {
+  capacity_ = capacity;
+  if (pooled_.size() > capacity_) {
+    pooled_.resize(capacity_);
+  }
+}
+
+void FiberRootPool::clear() {
+  pooled_.clear();
+}
+
+} // namespace react
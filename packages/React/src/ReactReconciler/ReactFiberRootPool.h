@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ReactReconciler/ReactRootTags.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace react {
+
+struct FiberRoot;
+
+/**
+ * Recycles FiberRoots for hosts that create and drop roots per request
+ *
+ * A released root is reset to a fresh state but keeps what it allocated:
+ * its fiber arena keeps its slabs, and the updater and ping-cache tables
+ * keep their buckets. acquire() hands such a root back out with a new
+ * HostRoot fiber, carved from the warm arena, as its current tree, so a
+ * request-scoped render does not pay for building a root.
+ *
+ * Roots beyond the pool's capacity are destroyed on release. Not
+ * thread-safe; like the roots themselves, a pool belongs to one runtime.
+ */
+class FiberRootPool {
+public:
+  static constexpr std::size_t kDefaultCapacity = 32;
+
+  struct Stats {
+    // acquire() calls served from the pool
+    std::uint64_t hits{0};
+    // acquire() calls that had to build a new root
+    std::uint64_t misses{0};
+    std::uint64_t releases{0};
+    // Released roots destroyed because the pool was full
+    std::uint64_t discards{0};
+  };
+
+  explicit FiberRootPool(std::size_t capacity = kDefaultCapacity);
+  ~FiberRootPool();
+
+  FiberRootPool(const FiberRootPool&) = delete;
+  FiberRootPool& operator=(const FiberRootPool&) = delete;
+
+  // Returns a root whose current tree is a lone HostRoot fiber
+  std::unique_ptr<FiberRoot> acquire(RootTag tag, bool isStrictMode, void* containerInfo);
+
+  // Takes back a root that is no longer rendering or committing. Its
+  // fibers are destroyed and it is dropped from the root scheduler.
+  void release(std::unique_ptr<FiberRoot> root);
+
+  // Shrinking destroys pooled roots beyond the new capacity
+  void setCapacity(std::size_t capacity);
+
+  std::size_t capacity() const {
+    return capacity_;
+  }
+
+  std::size_t pooledRoots() const {
+    return pooled_.size();
+  }
+
+  // Destroys every pooled root; statistics are kept
+  void clear();
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  std::vector<std::unique_ptr<FiberRoot>> pooled_;
+  std::size_t capacity_;
+  Stats stats_{};
+};
+
+} // namespace react
@@ -0,0 +1,201 @@
+#include "ReactReconciler/ReactFiberRootScheduleIndex.h"
+
+namespace react {
+
+namespace {
+
+constexpr Lanes kIdleLaneClass = SelectiveHydrationLane | IdleHydrationLane | IdleLane | OffscreenLane | DeferredLane;
+
+constexpr std::array<Lanes, 7> kLaneClasses{
+    SyncHydrationLane | SyncLane,
+    InputContinuousHydrationLane | InputContinuousLane,
+    DefaultHydrationLane | DefaultLane,
+    GestureLane,
+    TransitionHydrationLane | TransitionLanes,
+    RetryLanes,
+    kIdleLaneClass,
+};
+
+constexpr Lanes allClassLanes() {
+  Lanes lanes = NoLanes;
+  for (Lanes laneClass : kLaneClasses) {
+    lanes |= laneClass;
+  }
+  return lanes;
+}
+
+static_assert(allClassLanes() == (1u << TotalLanes) - 1, "Every lane must belong to a lane class");
+
+constexpr std::size_t kBitsPerWord = 64;
+
+} // namespace
+
+void RootScheduleIndex::setBit(Bits& bits, std::uint32_t slot) {
+  bits[slot / kBitsPerWord] |= std::uint64_t{1} << (slot % kBitsPerWord);
+}
+
+void RootScheduleIndex::clearBit(Bits& bits, std::uint32_t slot) {
+  bits[slot / kBitsPerWord] &= ~(std::uint64_t{1} << (slot % kBitsPerWord));
+}
+
+// A root can still point here after the index was reset, so the slot has to
+// be confirmed rather than trusted
+bool RootScheduleIndex::owns(const FiberRoot& root) const {
+  return root.scheduleIndex == this && root.scheduleSlot < roots_.size() && roots_[root.scheduleSlot] == &root;
+}
+
+bool RootScheduleIndex::contains(const FiberRoot& root) const {
+  return owns(root);
+}
+
+void RootScheduleIndex::add(FiberRoot& root) {
+  if (!owns(root)) {
+    std::uint32_t slot;
+    if (!freeSlots_.empty()) {
+      slot = freeSlots_.back();
+      freeSlots_.pop_back();
+    } else {
+      slot = static_cast<std::uint32_t>(roots_.size());
+      roots_.push_back(nullptr);
+      expirationTimes_.push_back(NoTimestamp);
+      if (slot % kBitsPerWord == 0) {
+        occupied_.push_back(0);
+        dirty_.push_back(0);
+        for (Bits& bits : pendingByClass_) {
+          bits.push_back(0);
+        }
+      }
+    }
+    roots_[slot] = &root;
+    root.scheduleIndex = this;
+    root.scheduleSlot = slot;
+    setBit(occupied_, slot);
+    ++size_;
+  }
+  update(root);
+}
+
+void RootScheduleIndex::remove(FiberRoot& root) {
+  if (!owns(root)) {
+    return;
+  }
+  const std::uint32_t slot = root.scheduleSlot;
+  clearBit(occupied_, slot);
+  clearBit(dirty_, slot);
+  for (Bits& bits : pendingByClass_) {
+    clearBit(bits, slot);
+  }
+  roots_[slot] = nullptr;
+  expirationTimes_[slot] = NoTimestamp;
+  freeSlots_.push_back(slot);
+  root.scheduleIndex = nullptr;
+  root.scheduleSlot = 0;
+  --size_;
+}
+
+void RootScheduleIndex::update(FiberRoot& root) {
+  if (!owns(root)) {
+    return;
+  }
+  const std::uint32_t slot = root.scheduleSlot;
+  for (std::size_t laneClass = 0; laneClass < kLaneClassCount; ++laneClass) {
+    if ((root.pendingLanes & kLaneClasses[laneClass]) != NoLanes) {
+      setBit(pendingByClass_[laneClass], slot);
+    } else {
+      clearBit(pendingByClass_[laneClass], slot);
+    }
+  }
+  setBit(dirty_, slot);
+}
+
+void RootScheduleIndex::collectWord(std::size_t word, std::uint64_t bits, std::vector<FiberRoot*>& roots) const {
+  while (bits != 0) {
+    const auto bit = static_cast<std::size_t>(__builtin_ctzll(bits));
+    roots.push_back(roots_[word * kBitsPerWord + bit]);
+    bits &= bits - 1;
+  }
+}
+
+void RootScheduleIndex::collectRootsWithPendingLanes(Lanes lanes, std::vector<FiberRoot*>& roots) const {
+  std::array<const Bits*, kLaneClassCount> classes{};
+  std::size_t classCount = 0;
+  for (std::size_t laneClass = 0; laneClass < kLaneClassCount; ++laneClass) {
+    if ((lanes & kLaneClasses[laneClass]) != NoLanes) {
+      classes[classCount++] = &pendingByClass_[laneClass];
+    }
+  }
+  for (std::size_t word = 0; word < occupied_.size(); ++word) {
+    std::uint64_t bits = 0;
+    for (std::size_t index = 0; index < classCount; ++index) {
+      bits |= (*classes[index])[word];
+    }
+    collectWord(word, bits, roots);
+  }
+}
+
+bool RootScheduleIndex::hasRootsWithPendingLanes(Lanes lanes) const {
+  for (std::size_t laneClass = 0; laneClass < kLaneClassCount; ++laneClass) {
+    if ((lanes & kLaneClasses[laneClass]) == NoLanes) {
+      continue;
+    }
+    for (std::uint64_t word : pendingByClass_[laneClass]) {
+      if (word != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void RootScheduleIndex::collectRoots(std::vector<FiberRoot*>& roots) const {
+  for (std::size_t word = 0; word < occupied_.size(); ++word) {
+    collectWord(word, occupied_[word], roots);
+  }
+}
+
+void RootScheduleIndex::takeDirtyRoots(std::vector<FiberRoot*>& roots) {
+  for (std::size_t word = 0; word < dirty_.size(); ++word) {
+    collectWord(word, dirty_[word], roots);
+    dirty_[word] = 0;
+  }
+}
+
+void RootScheduleIndex::setNextExpirationTime(FiberRoot& root, int expirationTime) {
+  if (!owns(root)) {
+    return;
+  }
+  expirationTimes_[root.scheduleSlot] = expirationTime;
+  if (expirationTime != NoTimestamp &&
+      (nextExpirationTime_ == NoTimestamp || expirationTime < nextExpirationTime_)) {
+    nextExpirationTime_ = expirationTime;
+  }
+}
+
+void RootScheduleIndex::markExpiringRoots(int currentTime) {
+  if (nextExpirationTime_ == NoTimestamp || nextExpirationTime_ > currentTime) {
+    return;
+  }
+  nextExpirationTime_ = NoTimestamp;
+  for (std::size_t slot = 0; slot < expirationTimes_.size(); ++slot) {
+    int& expirationTime = expirationTimes_[slot];
+    if (expirationTime == NoTimestamp) {
+      continue;
+    }
+    if (expirationTime <= currentTime) {
+      setBit(dirty_, static_cast<std::uint32_t>(slot));
+      expirationTime = NoTimestamp;
+    } else if (nextExpirationTime_ == NoTimestamp || expirationTime < nextExpirationTime_) {
+      nextExpirationTime_ = expirationTime;
+    }
+  }
+}
+
+void updateRootScheduleIndex(FiberRoot& root) {
+  root.scheduleIndex->update(root);
+}
+
+void setRootNextExpirationTime(FiberRoot& root, int expirationTime) {
+  root.scheduleIndex->setNextExpirationTime(root, expirationTime);
+}
+
+} // namespace react
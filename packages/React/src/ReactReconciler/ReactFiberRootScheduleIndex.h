@@ -0,0 +1,92 @@
+#pragma once
+
+#include "ReactReconciler/ReactFiberLane.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace react {
+
+/**
+ * The root scheduler's set of scheduled roots, indexed by pending lanes
+ *
+ * Each registered root gets a slot. For every lane class (sync, continuous,
+ * default, gesture, transition, retry, idle) the index keeps a bitset of the
+ * slots whose pendingLanes touch that class, so finding the roots with, say,
+ * sync work costs one bit per root and no FiberRoot reads. A second bitset
+ * marks roots that were scheduled or had their pending lanes change since the
+ * last schedule pass, which is all that pass needs to revisit.
+ *
+ * Registered roots point back at the index, and the lane helpers in
+ * ReactFiberLane.h call update() whenever they change pendingLanes. Queries
+ * return candidates in slot order; callers still check each root's lanes.
+ *
+ * A root can also need a pass without any change to its lanes: once one of
+ * its pending lanes reaches its expiration time, it has to be marked expired.
+ * markStarvedLanesAsExpired reports each root's earliest such time, and
+ * markExpiringRoots() marks the roots whose time has come.
+ */
+class RootScheduleIndex {
+public:
+  bool contains(const FiberRoot& root) const;
+
+  // Registers the root if needed and marks it for the next schedule pass
+  void add(FiberRoot& root);
+
+  void remove(FiberRoot& root);
+
+  // Re-reads root.pendingLanes and marks the root for the next schedule pass
+  void update(FiberRoot& root);
+
+  // Roots whose pending lanes share a lane class with `lanes`
+  void collectRootsWithPendingLanes(Lanes lanes, std::vector<FiberRoot*>& roots) const;
+  bool hasRootsWithPendingLanes(Lanes lanes) const;
+
+  // Every registered root
+  void collectRoots(std::vector<FiberRoot*>& roots) const;
+
+  // Roots marked since the last call, which clears the marks
+  void takeDirtyRoots(std::vector<FiberRoot*>& roots);
+
+  // Records when the root's earliest pending, not yet expired lane expires;
+  // NoTimestamp if none will
+  void setNextExpirationTime(FiberRoot& root, int expirationTime);
+
+  // Marks the roots whose recorded expiration time is at or before
+  // currentTime for the next schedule pass, and forgets those times
+  void markExpiringRoots(int currentTime);
+
+  std::size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+private:
+  using Bits = std::vector<std::uint64_t>;
+
+  static constexpr std::size_t kLaneClassCount = 7;
+
+  static void setBit(Bits& bits, std::uint32_t slot);
+  static void clearBit(Bits& bits, std::uint32_t slot);
+
+  bool owns(const FiberRoot& root) const;
+  void collectWord(std::size_t word, std::uint64_t bits, std::vector<FiberRoot*>& roots) const;
+
+  std::vector<FiberRoot*> roots_{};
+  std::vector<std::uint32_t> freeSlots_{};
+  Bits occupied_{};
+  Bits dirty_{};
+  std::array<Bits, kLaneClassCount> pendingByClass_{};
+  // Per slot, as reported by setNextExpirationTime
+  std::vector<int> expirationTimes_{};
+  // No later than the earliest entry of expirationTimes_
+  int nextExpirationTime_{NoTimestamp};
+  std::size_t size_{0};
+};
+
+} // namespace react
@@ -7,6 +7,7 @@
 #include "ReactReconciler/ReactFiberFlags.h"
 #include "ReactReconciler/ReactEventPriorities.h"
 #include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberReclaim.h"
 #include "ReactReconciler/ReactProfilerTimer.h"
 #include "ReactReconciler/ReactFiberWorkLoop.h"
 #include "ReactRuntime/ReactRuntime.h"
@@ -14,6 +15,7 @@
 #include "shared/ReactGlobalError.h"
 #include "shared/ReactSharedInternals.h"
 #include "jsi/jsi.h"
+#include <algorithm>
 #include <exception>
 #include <functional>
 #include <iostream>
@@ -425,8 +427,9 @@ void startDefaultTransitionIndicatorIfNeeded(ReactRuntime& runtime, facebook::js
 
   startIsomorphicDefaultIndicatorIfNeeded(runtime);
 
-  RootSchedulerState& state = getState(runtime);
-  for (FiberRoot* root = state.firstScheduledRoot; root != nullptr; root = root->next) {
+  std::vector<FiberRoot*> roots;
+  getState(runtime).scheduledRoots.collectRoots(roots);
+  for (FiberRoot* root : roots) {
     if (root->indicatorLanes == NoLanes || root->pendingIndicator) {
       continue;
     }
@@ -485,41 +488,18 @@ void cleanupDefaultTransitionIndicatorIfNeeded(ReactRuntime& runtime, facebook::
   }
 }
 
+// Also marks an already scheduled root for the next schedule pass
 void addRootToSchedule(ReactRuntime& runtime, FiberRoot& root) {
-  RootSchedulerState& state = getState(runtime);
-  if (&root == state.lastScheduledRoot || root.next != nullptr || state.firstScheduledRoot == &root) {
-    return;
-  }
-
-  root.next = nullptr;
-  if (state.lastScheduledRoot == nullptr) {
-    state.firstScheduledRoot = state.lastScheduledRoot = &root;
-  } else {
-    state.lastScheduledRoot->next = &root;
-    state.lastScheduledRoot = &root;
-  }
+  getState(runtime).scheduledRoots.add(root);
 }
 
 void removeRootFromSchedule(ReactRuntime& runtime, FiberRoot& root) {
-  RootSchedulerState& state = getState(runtime);
-  FiberRoot* previous = nullptr;
-  FiberRoot* current = state.firstScheduledRoot;
-  while (current != nullptr) {
-    if (current == &root) {
-      if (previous == nullptr) {
-        state.firstScheduledRoot = current->next;
-      } else {
-        previous->next = current->next;
-      }
-      if (state.lastScheduledRoot == &root) {
-        state.lastScheduledRoot = previous;
-      }
-      root.next = nullptr;
-      break;
-    }
-    previous = current;
-    current = current->next;
-  }
+  getState(runtime).scheduledRoots.remove(root);
+}
+
+// Lanes that can make a root's next lanes count as sync work
+Lanes syncWorkLanes() {
+  return enableGestureTransition ? (SyncLane | SyncHydrationLane | GestureLane) : (SyncLane | SyncHydrationLane);
 }
 
 SchedulerPriority toSchedulerPriority(Lane lane) {
@@ -561,6 +541,10 @@ void commitRoot(
     throw std::logic_error("commitRoot should not run during render or commit context");
   }
 
+  // Background work from the render phase must land before the host tree is
+  // mutated
+  runtime.joinOffloadedWork();
+
   FiberNode* const previousCurrent = root.current;
   if (previousCurrent == &finishedWork) {
     throw std::logic_error("Cannot commit the same tree twice");
@@ -591,6 +575,8 @@ void commitRoot(
     previousCurrent->alternate = &finishedWork;
   }
 
+  detachDeletedFibers(runtime, root, finishedWork);
+
   setPendingFinishedWork(runtime, &finishedWork);
   setPendingEffectsRoot(runtime, &root);
   setPendingEffectsLanes(runtime, lanes);
@@ -780,37 +766,35 @@ void processRootSchedule(ReactRuntime& runtime, facebook::jsi::Runtime& jsRuntim
       }
     }
 
+    // Only roots that were scheduled, had their lanes change or have a lane
+    // coming due since the last pass can need a different task; the rest
+    // keep the one they have
     const int currentTime = static_cast<int>(runtime.now());
-    FiberRoot* prev = nullptr;
-    FiberRoot* root = state.firstScheduledRoot;
+    std::vector<FiberRoot*>& roots = state.rootsToProcess;
+    roots.clear();
+    state.scheduledRoots.markExpiringRoots(currentTime);
+    state.scheduledRoots.takeDirtyRoots(roots);
 
-    while (root != nullptr) {
-      FiberRoot* const next = root->next;
+    for (FiberRoot* root : roots) {
+      if (!state.scheduledRoots.contains(*root)) {
+        continue;
+      }
       const Lanes scheduledLanes = scheduleTaskForRootDuringMicrotask(runtime, jsRuntime, *root, currentTime);
 
       if (scheduledLanes == NoLanes) {
-        root->next = nullptr;
-        if (prev == nullptr) {
-          state.firstScheduledRoot = next;
-        } else {
-          prev->next = next;
-        }
-        if (next == nullptr) {
-          state.lastScheduledRoot = prev;
-        }
-      } else {
-        prev = root;
-
-        if ((includesSyncLane(scheduledLanes) || (enableGestureTransition && isGestureRender(scheduledLanes))) &&
-            !checkIfRootIsPrerendering(*root, scheduledLanes)) {
-          state.mightHavePendingSyncWork = true;
-        }
+        removeRootFromSchedule(runtime, *root);
+      } else if (
+          (includesSyncLane(scheduledLanes) || (enableGestureTransition && isGestureRender(scheduledLanes))) &&
+          !checkIfRootIsPrerendering(*root, scheduledLanes)) {
+        state.mightHavePendingSyncWork = true;
       }
-
-      root = next;
     }
+    roots.clear();
 
-    state.lastScheduledRoot = prev;
+    // A root skipped above may still hold sync work a previous flush left
+    if (state.scheduledRoots.hasRootsWithPendingLanes(syncWorkLanes())) {
+      state.mightHavePendingSyncWork = true;
+    }
 
     if (!hasPendingCommitEffects(runtime)) {
       flushSyncWorkAcrossRoots(runtime, jsRuntime, syncTransitionLanes, false);
@@ -870,14 +854,31 @@ void flushSyncWorkAcrossRoots(
     shouldProcessSchedule = true;
   }
 
+  // getNextLanesToFlushSync only returns lanes of at least the priority it
+  // is asked for, and getNextLanes only returns pending lanes, so roots with
+  // no pending lanes in that range can be skipped without reading them
+  const Lanes candidateLanes = syncTransitionLanes != NoLanes
+      ? getLanesOfEqualOrHigherPriority(SyncUpdateLanes | syncTransitionLanes)
+      : syncWorkLanes();
+  std::vector<FiberRoot*>& roots = state.rootsToFlush;
+
   do {
     didPerformSomeWork = false;
-    FiberRoot* root = state.firstScheduledRoot;
-    while (root != nullptr) {
-      FiberRoot* const next = root->next;
+    roots.clear();
+    state.scheduledRoots.collectRootsWithPendingLanes(candidateLanes, roots);
+    // The work-in-progress root may resume its render lanes instead
+    FiberRoot* const renderingRoot = getWorkInProgressRoot(runtime);
+    if (syncTransitionLanes == NoLanes && renderingRoot != nullptr && state.scheduledRoots.contains(*renderingRoot) &&
+        std::find(roots.begin(), roots.end(), renderingRoot) == roots.end()) {
+      roots.push_back(renderingRoot);
+    }
+
+    for (FiberRoot* root : roots) {
+      if (!state.scheduledRoots.contains(*root)) {
+        continue;
+      }
 
       if (onlyLegacy && (disableLegacyMode || root->tag != RootTag::LegacyRoot)) {
-        root = next;
         continue;
       }
 
@@ -907,10 +908,9 @@ void flushSyncWorkAcrossRoots(
           }
         }
       }
-
-      root = next;
     }
   } while (didPerformSomeWork);
+  roots.clear();
 
   state.isFlushingWork = false;
   state.mightHavePendingSyncWork = false;
@@ -1259,4 +1259,12 @@ void registerRootDefaultIndicator(
   }
 }
 
+Lanes scheduleTaskForRootDuringMicrotaskForTesting(
+  ReactRuntime& runtime,
+  facebook::jsi::Runtime& jsRuntime,
+  FiberRoot& root,
+  int currentTime) {
+  return scheduleTaskForRootDuringMicrotask(runtime, jsRuntime, root, currentTime);
+}
+
 } // namespace react
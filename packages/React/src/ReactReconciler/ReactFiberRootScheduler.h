@@ -31,4 +31,10 @@ void registerRootDefaultIndicator(
 // Entry points for different scheduling contexts
 bool performSyncWorkOnRoot(ReactRuntime& runtime, facebook::jsi::Runtime& jsRuntime, FiberRoot& root, Lanes lanes);
 
+Lanes scheduleTaskForRootDuringMicrotaskForTesting(
+	ReactRuntime& runtime,
+	facebook::jsi::Runtime& jsRuntime,
+	FiberRoot& root,
+	int currentTime);
+
 } // namespace react
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberRootScheduleIndex.h"
 
 #include "jsi/jsi.h"
 
@@ -8,14 +9,17 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace react {
 
 struct FiberRoot;
 
 struct RootSchedulerState {
-  FiberRoot* firstScheduledRoot{nullptr};
-  FiberRoot* lastScheduledRoot{nullptr};
+  RootScheduleIndex scheduledRoots{};
+  // Reused snapshots of the roots a schedule pass or sync flush visits
+  std::vector<FiberRoot*> rootsToProcess{};
+  std::vector<FiberRoot*> rootsToFlush{};
   bool didScheduleRootProcessing{false};
   bool isProcessingRootSchedule{false};
   bool mightHavePendingSyncWork{false};
@@ -1,22 +1,37 @@
 #pragma once
 
-#include <any>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
+#ifndef NDEBUG
+#include <iostream>
+#endif
+
 namespace react {
 
 class FiberNode;
 
-namespace detail {
-std::vector<std::any>& valueStack();
-std::vector<const FiberNode*>& fiberStack();
-int& stackIndex();
-} // namespace detail
-
+/**
+ * A value saved and restored as the work loop enters and leaves fibers
+ *
+ * Each cursor keeps its own typed stack of previous values rather than
+ * boxing them into one shared std::any stack. Slots are reused once a
+ * render has reached a given depth, so push and pop are a move and a store
+ * with no allocation. Cursors live in per-runtime state (WorkLoopState),
+ * never in globals. Debug builds also record which fiber pushed each entry
+ * and report a pop from a different fiber, like React's
+ * "Unexpected Fiber popped" warning.
+ */
 template <typename T>
 struct StackCursor {
   T current;
+
+  std::vector<T> previousValues{};
+#ifndef NDEBUG
+  std::vector<const FiberNode*> fibers{};
+#endif
+  std::size_t depth{0};
 };
 
 template <typename T>
@@ -26,47 +41,45 @@ inline StackCursor<T> createCursor(T defaultValue) {
 
 template <typename T>
 inline void push(StackCursor<T>& cursor, T value, FiberNode* fiber) {
-  auto& index = detail::stackIndex();
-  auto& valueStack = detail::valueStack();
-  auto& fiberStack = detail::fiberStack();
-
-  ++index;
-  if (index >= static_cast<int>(valueStack.size())) {
-    valueStack.emplace_back();
-    fiberStack.emplace_back(nullptr);
+  if (cursor.depth == cursor.previousValues.size()) {
+    cursor.previousValues.push_back(std::move(cursor.current));
+#ifndef NDEBUG
+    cursor.fibers.push_back(fiber);
+#endif
+  } else {
+    cursor.previousValues[cursor.depth] = std::move(cursor.current);
+#ifndef NDEBUG
+    cursor.fibers[cursor.depth] = fiber;
+#endif
   }
+  (void)fiber;
 
-  valueStack[index] = cursor.current;
-  fiberStack[index] = fiber;
+  ++cursor.depth;
   cursor.current = std::move(value);
 }
 
 template <typename T>
 inline void pop(StackCursor<T>& cursor, FiberNode* fiber) {
-  auto& index = detail::stackIndex();
-  auto& valueStack = detail::valueStack();
-  auto& fiberStack = detail::fiberStack();
-
-  if (index < 0) {
+  if (cursor.depth == 0) {
     return;
   }
+  --cursor.depth;
 
 #ifndef NDEBUG
-  if (fiberStack[index] != nullptr && fiberStack[index] != fiber) {
-    // Unexpected fiber popped; this mirrors the development warning in React.
-    // We intentionally ignore the mismatch in release builds.
+  if (cursor.fibers[cursor.depth] != nullptr && cursor.fibers[cursor.depth] != fiber) {
+    std::cerr << "Unexpected Fiber popped." << std::endl;
   }
 #endif
+  (void)fiber;
 
-  if (auto* stored = std::any_cast<T>(&valueStack[index])) {
-    cursor.current = std::move(*stored);
-  } else {
-    cursor.current = T{};
-  }
+  cursor.current = std::move(cursor.previousValues[cursor.depth]);
+}
 
-  valueStack[index].reset();
-  fiberStack[index] = nullptr;
-  --index;
+// Drops every saved value, as popping all the way out of the tree would
+template <typename T>
+inline void resetCursor(StackCursor<T>& cursor, T value) {
+  cursor.depth = 0;
+  cursor.current = std::move(value);
 }
 
 } // namespace react
@@ -4,36 +4,38 @@
 #include "ReactReconciler/ReactFiberHiddenContext.h"
 #include "ReactReconciler/ReactFiberStack.h"
 #include "ReactReconciler/ReactFiberSuspenseComponent.h"
+#include "ReactReconciler/ReactFiberWorkLoopState.h"
 #include "ReactReconciler/ReactWorkTags.h"
+#include "ReactRuntime/ReactRuntime.h"
 #include "shared/ReactFeatureFlags.h"
 
 namespace react {
 namespace {
 
-StackCursor<FiberNode*> gSuspenseHandlerStackCursor = createCursor<FiberNode*>(nullptr);
-StackCursor<SuspenseContext> gSuspenseStackCursor = createCursor<SuspenseContext>(DefaultSuspenseContext);
-FiberNode* gShellBoundary = nullptr;
+inline WorkLoopState& getState(ReactRuntime& runtime) {
+  return runtime.workLoopState();
+}
 
 } // namespace
 
-FiberNode* getShellBoundary() {
-  return gShellBoundary;
+FiberNode* getShellBoundary(ReactRuntime& runtime) {
+  return getState(runtime).shellBoundary;
 }
 
-FiberNode* getSuspenseHandler() {
-  return gSuspenseHandlerStackCursor.current;
+FiberNode* getSuspenseHandler(ReactRuntime& runtime) {
+  return getState(runtime).suspenseHandlerStackCursor.current;
 }
 
-SuspenseContext getCurrentSuspenseContext() {
-  return gSuspenseStackCursor.current;
+SuspenseContext getCurrentSuspenseContext(ReactRuntime& runtime) {
+  return getState(runtime).suspenseStackCursor.current;
 }
 
-void pushSuspenseListContext(FiberNode& fiber, SuspenseContext newContext) {
-  push(gSuspenseStackCursor, newContext, &fiber);
+void pushSuspenseListContext(ReactRuntime& runtime, FiberNode& fiber, SuspenseContext newContext) {
+  push(getState(runtime).suspenseStackCursor, newContext, &fiber);
 }
 
-void popSuspenseListContext(FiberNode& fiber) {
-  pop(gSuspenseStackCursor, &fiber);
+void popSuspenseListContext(ReactRuntime& runtime, FiberNode& fiber) {
+  pop(getState(runtime).suspenseStackCursor, &fiber);
 }
 
 bool hasSuspenseListContext(SuspenseContext parentContext, SuspenseContext flag) {
@@ -50,75 +52,80 @@ SuspenseContext setShallowSuspenseListContext(
   return (parentContext & SubtreeSuspenseContextMask) | shallowContext;
 }
 
-void pushPrimaryTreeSuspenseHandler(FiberNode& handler) {
+void pushPrimaryTreeSuspenseHandler(ReactRuntime& runtime, FiberNode& handler) {
+  auto& state = getState(runtime);
   FiberNode* const current = handler.alternate;
-  pushSuspenseListContext(handler, setDefaultShallowSuspenseListContext(gSuspenseStackCursor.current));
+  pushSuspenseListContext(runtime, handler, setDefaultShallowSuspenseListContext(state.suspenseStackCursor.current));
 
   if constexpr (enableSuspenseAvoidThisFallback) {
     const bool avoidFallback = false;
-    const bool isHidden = current == nullptr || isCurrentTreeHidden();
+    const bool isHidden = current == nullptr || isCurrentTreeHidden(runtime);
     if (avoidFallback && isHidden) {
-      if (gShellBoundary == nullptr) {
-        push(gSuspenseHandlerStackCursor, &handler, &handler);
+      if (state.shellBoundary == nullptr) {
+        push(state.suspenseHandlerStackCursor, &handler, &handler);
         return;
       }
-      FiberNode* const handlerOnStack = gSuspenseHandlerStackCursor.current;
-      push(gSuspenseHandlerStackCursor, handlerOnStack, &handler);
+      FiberNode* const handlerOnStack = state.suspenseHandlerStackCursor.current;
+      push(state.suspenseHandlerStackCursor, handlerOnStack, &handler);
       return;
     }
   }
 
-  push(gSuspenseHandlerStackCursor, &handler, &handler);
-  if (gShellBoundary == nullptr) {
-    if (current == nullptr || isCurrentTreeHidden()) {
-      gShellBoundary = &handler;
+  push(state.suspenseHandlerStackCursor, &handler, &handler);
+  if (state.shellBoundary == nullptr) {
+    if (current == nullptr || isCurrentTreeHidden(runtime)) {
+      state.shellBoundary = &handler;
     } else {
       const auto* const prevState = current != nullptr
           ? static_cast<SuspenseState*>(current->memoizedState)
           : nullptr;
       if (prevState != nullptr) {
-        gShellBoundary = &handler;
+        state.shellBoundary = &handler;
       }
     }
   }
 }
 
-void pushFallbackTreeSuspenseHandler(FiberNode& fiber) {
-  reuseSuspenseHandlerOnStack(fiber);
+void pushFallbackTreeSuspenseHandler(ReactRuntime& runtime, FiberNode& fiber) {
+  reuseSuspenseHandlerOnStack(runtime, fiber);
 }
 
-void pushDehydratedActivitySuspenseHandler(FiberNode& fiber) {
-  pushSuspenseListContext(fiber, gSuspenseStackCursor.current);
-  push(gSuspenseHandlerStackCursor, &fiber, &fiber);
-  if (gShellBoundary == nullptr) {
-    gShellBoundary = &fiber;
+void pushDehydratedActivitySuspenseHandler(ReactRuntime& runtime, FiberNode& fiber) {
+  auto& state = getState(runtime);
+  pushSuspenseListContext(runtime, fiber, state.suspenseStackCursor.current);
+  push(state.suspenseHandlerStackCursor, &fiber, &fiber);
+  if (state.shellBoundary == nullptr) {
+    state.shellBoundary = &fiber;
   }
 }
 
-void pushOffscreenSuspenseHandler(FiberNode& fiber) {
+void pushOffscreenSuspenseHandler(ReactRuntime& runtime, FiberNode& fiber) {
   if (fiber.tag == WorkTag::OffscreenComponent) {
-    pushSuspenseListContext(fiber, gSuspenseStackCursor.current);
-    push(gSuspenseHandlerStackCursor, &fiber, &fiber);
-    if (gShellBoundary == nullptr) {
-      gShellBoundary = &fiber;
+    auto& state = getState(runtime);
+    pushSuspenseListContext(runtime, fiber, state.suspenseStackCursor.current);
+    push(state.suspenseHandlerStackCursor, &fiber, &fiber);
+    if (state.shellBoundary == nullptr) {
+      state.shellBoundary = &fiber;
     }
   } else {
-    reuseSuspenseHandlerOnStack(fiber);
+    reuseSuspenseHandlerOnStack(runtime, fiber);
   }
 }
 
-void reuseSuspenseHandlerOnStack(FiberNode& fiber) {
-  pushSuspenseListContext(fiber, gSuspenseStackCursor.current);
-  FiberNode* const handlerOnStack = gSuspenseHandlerStackCursor.current;
-  push(gSuspenseHandlerStackCursor, handlerOnStack, &fiber);
+void reuseSuspenseHandlerOnStack(ReactRuntime& runtime, FiberNode& fiber) {
+  auto& state = getState(runtime);
+  pushSuspenseListContext(runtime, fiber, state.suspenseStackCursor.current);
+  FiberNode* const handlerOnStack = state.suspenseHandlerStackCursor.current;
+  push(state.suspenseHandlerStackCursor, handlerOnStack, &fiber);
 }
 
-void popSuspenseHandler(FiberNode& fiber) {
-  pop(gSuspenseHandlerStackCursor, &fiber);
-  if (gShellBoundary == &fiber) {
-    gShellBoundary = nullptr;
+void popSuspenseHandler(ReactRuntime& runtime, FiberNode& fiber) {
+  auto& state = getState(runtime);
+  pop(state.suspenseHandlerStackCursor, &fiber);
+  if (state.shellBoundary == &fiber) {
+    state.shellBoundary = nullptr;
   }
-  popSuspenseListContext(fiber);
+  popSuspenseListContext(runtime, fiber);
 }
 
 } // namespace react
@@ -7,6 +7,7 @@
 namespace react {
 
 class FiberNode;
+class ReactRuntime;
 
 using SuspenseContext = std::uint8_t;
 using SubtreeSuspenseContext = std::uint8_t;
@@ -16,24 +17,24 @@ inline constexpr SuspenseContext DefaultSuspenseContext = 0b00;
 inline constexpr SuspenseContext SubtreeSuspenseContextMask = 0b01;
 inline constexpr ShallowSuspenseContext ForceSuspenseFallback = 0b10;
 
-FiberNode* getShellBoundary();
-FiberNode* getSuspenseHandler();
+FiberNode* getShellBoundary(ReactRuntime& runtime);
+FiberNode* getSuspenseHandler(ReactRuntime& runtime);
 
-void pushPrimaryTreeSuspenseHandler(FiberNode& handler);
-void pushFallbackTreeSuspenseHandler(FiberNode& fiber);
-void pushDehydratedActivitySuspenseHandler(FiberNode& fiber);
-void pushOffscreenSuspenseHandler(FiberNode& fiber);
-void reuseSuspenseHandlerOnStack(FiberNode& fiber);
-void popSuspenseHandler(FiberNode& fiber);
+void pushPrimaryTreeSuspenseHandler(ReactRuntime& runtime, FiberNode& handler);
+void pushFallbackTreeSuspenseHandler(ReactRuntime& runtime, FiberNode& fiber);
+void pushDehydratedActivitySuspenseHandler(ReactRuntime& runtime, FiberNode& fiber);
+void pushOffscreenSuspenseHandler(ReactRuntime& runtime, FiberNode& fiber);
+void reuseSuspenseHandlerOnStack(ReactRuntime& runtime, FiberNode& fiber);
+void popSuspenseHandler(ReactRuntime& runtime, FiberNode& fiber);
 
 bool hasSuspenseListContext(SuspenseContext parentContext, SuspenseContext flag);
 SuspenseContext setDefaultShallowSuspenseListContext(SuspenseContext parentContext);
 SuspenseContext setShallowSuspenseListContext(
     SuspenseContext parentContext,
     ShallowSuspenseContext shallowContext);
-void pushSuspenseListContext(FiberNode& fiber, SuspenseContext newContext);
-void popSuspenseListContext(FiberNode& fiber);
+void pushSuspenseListContext(ReactRuntime& runtime, FiberNode& fiber, SuspenseContext newContext);
+void popSuspenseListContext(ReactRuntime& runtime, FiberNode& fiber);
 
-SuspenseContext getCurrentSuspenseContext();
+SuspenseContext getCurrentSuspenseContext(ReactRuntime& runtime);
 
 } // namespace react
@@ -121,21 +121,21 @@ bool throwException(
   FiberNode& unitOfWork,
   void* thrownValue,
   Lanes renderLanes) {
+  // The work loop cleared the suspended reason before unwinding; setting it
+  // again here would make it throw on whatever fiber the unwind lands on
   unitOfWork.flags = static_cast<FiberFlags>(unitOfWork.flags | Incomplete);
-  setWorkInProgressThrownValue(runtime, thrownValue);
 
   if (isWakeableValue(thrownValue)) {
     auto* const wakeable = tryGetWakeable(thrownValue);
     const bool isSuspenseyResource = isNoopSuspenseyCommitThenable(wakeable);
     resetSuspendedComponent(unitOfWork, renderLanes);
 
-    if (FiberNode* const boundary = getSuspenseHandler()) {
-      setWorkInProgressSuspendedReason(runtime, SuspendedReason::SuspendedOnData);
+    if (FiberNode* const boundary = getSuspenseHandler(runtime)) {
       switch (boundary->tag) {
         case WorkTag::SuspenseComponent:
         case WorkTag::ActivityComponent: {
           if (disableLegacyMode || (unitOfWork.mode & ConcurrentMode) != NoMode) {
-            if (getShellBoundary() == nullptr) {
+            if (getShellBoundary(runtime) == nullptr) {
               renderDidSuspendDelayIfPossible(runtime);
             } else if (boundary->alternate == nullptr) {
               renderDidSuspend(runtime);
@@ -182,7 +182,6 @@ bool throwException(
     }
 
     if (disableLegacyMode || root.tag == RootTag::ConcurrentRoot) {
-      setWorkInProgressSuspendedReason(runtime, SuspendedReason::SuspendedOnData);
       if (!isSuspenseyResource) {
   attachPingListener(runtime, jsRuntime, root, *wakeable, renderLanes);
       }
@@ -193,10 +192,8 @@ bool throwException(
     static constexpr const char* kUncaughtSuspenseError =
         "A component suspended while responding to synchronous input. This will cause the UI to be replaced with a loading indicator. Wrap updates that suspend with startTransition.";
     thrownValue = const_cast<char*>(kUncaughtSuspenseError);
-    setWorkInProgressThrownValue(runtime, thrownValue);
   }
 
-  setWorkInProgressSuspendedReason(runtime, SuspendedReason::SuspendedOnError);
   renderDidError(runtime);
 
   CapturedValue errorInfo = createCapturedValueAtFiber(thrownValue, &unitOfWork);
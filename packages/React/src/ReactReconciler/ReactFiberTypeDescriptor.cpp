@@ -0,0 +1,170 @@
+#include "ReactReconciler/ReactFiberTypeDescriptor.h"
+
+#include "shared/ReactSymbols.h"
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace react {
+
+namespace {
+
+using facebook::jsi::JSIException;
+using facebook::jsi::NativeState;
+using facebook::jsi::Object;
+using facebook::jsi::Runtime;
+using facebook::jsi::Symbol;
+using facebook::jsi::UUID;
+using facebook::jsi::Value;
+
+struct TypeDescriptorState : NativeState {
+  FiberTypeDescriptor descriptor;
+};
+
+thread_local std::unordered_map<std::string, FiberTypeDescriptorPtr> hostTypeDescriptors;
+
+// The React symbols that are element types, and the fiber each one makes
+constexpr std::pair<const ReactSymbolDescriptor*, WorkTag> kTypeSymbols[] = {
+    {&REACT_FRAGMENT_TYPE, WorkTag::Fragment},
+    {&REACT_PROFILER_TYPE, WorkTag::Profiler},
+    {&REACT_STRICT_MODE_TYPE, WorkTag::Mode},
+    {&REACT_SUSPENSE_TYPE, WorkTag::SuspenseComponent},
+    {&REACT_SUSPENSE_LIST_TYPE, WorkTag::SuspenseListComponent},
+    {&REACT_LAZY_TYPE, WorkTag::LazyComponent},
+    {&REACT_MEMO_TYPE, WorkTag::MemoComponent},
+    {&REACT_FORWARD_REF_TYPE, WorkTag::ForwardRef},
+};
+constexpr std::size_t kTypeSymbolCount = std::size(kTypeSymbols);
+
+// Runtime data key for ReactTypeSymbols
+constexpr UUID kTypeSymbolsKey{0x2b8f6c1e, 0x5d3a, 0x4e7b, 0x9c20, 0x7f1e4a6d8b35};
+
+// One runtime's resolved kTypeSymbols, in the same order
+struct ReactTypeSymbols {
+  std::vector<Symbol> symbols;
+};
+
+std::shared_ptr<ReactTypeSymbols> typeSymbols(Runtime& runtime) {
+  auto cached = std::static_pointer_cast<ReactTypeSymbols>(runtime.getRuntimeData(kTypeSymbolsKey));
+  if (cached) {
+    return cached;
+  }
+  auto resolved = std::make_shared<ReactTypeSymbols>();
+  resolved->symbols.reserve(kTypeSymbolCount);
+  for (const auto& entry : kTypeSymbols) {
+    resolved->symbols.push_back(resolveSymbol(runtime, *entry.first));
+  }
+  runtime.setRuntimeData(kTypeSymbolsKey, resolved);
+  return resolved;
+}
+
+// Descriptors do not depend on the runtime, so every runtime shares one per
+// React symbol; the last one describes symbols React does not know
+const FiberTypeDescriptorPtr& symbolTypeDescriptor(std::size_t index) {
+  static const std::vector<FiberTypeDescriptorPtr> descriptors = []() {
+    std::vector<FiberTypeDescriptorPtr> result;
+    for (const auto& entry : kTypeSymbols) {
+      FiberTypeDescriptor descriptor;
+      descriptor.tag = entry.second;
+      result.push_back(std::make_shared<const FiberTypeDescriptor>(std::move(descriptor)));
+    }
+    result.push_back(std::make_shared<const FiberTypeDescriptor>());
+    return result;
+  }();
+  return descriptors[index];
+}
+
+FiberTypeDescriptorPtr describeSymbolType(Runtime& runtime, const Symbol& symbol) {
+  const auto resolved = typeSymbols(runtime);
+  std::size_t index = 0;
+  while (index < kTypeSymbolCount && !Symbol::strictEquals(runtime, resolved->symbols[index], symbol)) {
+    ++index;
+  }
+  return symbolTypeDescriptor(index);
+}
+
+std::string stringProperty(Runtime& runtime, const Object& object, const char* name) {
+  Value value = object.getProperty(runtime, name);
+  return value.isString() ? value.getString(runtime).utf8(runtime) : std::string{};
+}
+
+bool isTruthyProperty(Runtime& runtime, const Object& object, const char* name) {
+  Value value = object.getProperty(runtime, name);
+  if (value.isBool()) {
+    return value.getBool();
+  }
+  return !value.isUndefined() && !value.isNull();
+}
+
+FiberTypeDescriptor describeComponentType(Runtime& runtime, const Object& type) {
+  FiberTypeDescriptor descriptor;
+  descriptor.isFunction = type.isFunction(runtime);
+  if (descriptor.isFunction) {
+    Value prototype = type.getProperty(runtime, "prototype");
+    descriptor.isClassComponent =
+        prototype.isObject() && isTruthyProperty(runtime, prototype.getObject(runtime), "isReactComponent");
+  }
+  descriptor.tag = descriptor.isClassComponent ? WorkTag::ClassComponent : WorkTag::FunctionComponent;
+  descriptor.displayName = stringProperty(runtime, type, "displayName");
+  if (descriptor.displayName.empty() && descriptor.isFunction) {
+    descriptor.displayName = stringProperty(runtime, type, "name");
+  }
+  return descriptor;
+}
+
+FiberTypeDescriptorPtr describeObjectType(Runtime& runtime, const Object& type) {
+  if (type.hasNativeState(runtime)) {
+    auto state = std::dynamic_pointer_cast<TypeDescriptorState>(type.getNativeState(runtime));
+    if (state) {
+      return FiberTypeDescriptorPtr(state, &state->descriptor);
+    }
+    // Someone else's native state; do not replace it
+    return std::make_shared<const FiberTypeDescriptor>(describeComponentType(runtime, type));
+  }
+
+  auto state = std::make_shared<TypeDescriptorState>();
+  state->descriptor = describeComponentType(runtime, type);
+  try {
+    type.setNativeState(runtime, state);
+  } catch (const JSIException&) {
+    // Proxies and host objects; nothing to attach the descriptor to
+  }
+  // Shares ownership with the object, if it took the state
+  return FiberTypeDescriptorPtr(state, &state->descriptor);
+}
+
+} // namespace
+
+FiberTypeDescriptorPtr describeElementType(Runtime& runtime, const Value& type) {
+  if (type.isString()) {
+    std::string hostType = type.getString(runtime).utf8(runtime);
+    auto iter = hostTypeDescriptors.find(hostType);
+    if (iter == hostTypeDescriptors.end()) {
+      FiberTypeDescriptor descriptor;
+      descriptor.tag = WorkTag::HostComponent;
+      descriptor.isHostComponent = true;
+      descriptor.hostType = hostType;
+      iter = hostTypeDescriptors
+                 .emplace(std::move(hostType), std::make_shared<const FiberTypeDescriptor>(std::move(descriptor)))
+                 .first;
+    }
+    return iter->second;
+  }
+
+  if (type.isSymbol()) {
+    return describeSymbolType(runtime, type.getSymbol(runtime));
+  }
+
+  if (type.isObject()) {
+    return describeObjectType(runtime, type.getObject(runtime));
+  }
+
+  // Shared with unknown symbols: nothing to describe
+  return symbolTypeDescriptor(kTypeSymbolCount);
+}
+
+} // namespace react
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ReactReconciler/ReactWorkTags.h"
+#include "jsi/jsi.h"
+
+#include <memory>
+#include <string>
+
+namespace react {
+
+/**
+ * What reconciliation needs to know about an element type
+ *
+ * Resolving a type's fiber shape means checking it against each React
+ * symbol and reading its prototype, which costs several JSI calls. The
+ * descriptor records the result once per type:
+ * - Component types (functions, classes) carry their descriptor as JSI
+ *   native state, so it is keyed by object identity and lives exactly as
+ *   long as the type in its runtime.
+ * - Host type strings are cached by content on the calling thread, since
+ *   "div" describes the same thing in every runtime.
+ * - React symbols are matched by identity against the runtime's own
+ *   Symbol.for results, resolved once per runtime and kept as runtime data.
+ *
+ * A descriptor never changes once built, and the returned pointer keeps it
+ * alive. Proxies and host objects cannot carry native state, so they are
+ * described again on every call.
+ */
+struct FiberTypeDescriptor {
+  WorkTag tag{WorkTag::FunctionComponent};
+  bool isHostComponent{false};
+  bool isFunction{false};
+  // Functions whose prototype has isReactComponent, as in shouldConstruct
+  bool isClassComponent{false};
+  // Host components only
+  std::string hostType{};
+  // displayName, else the function name; empty for host and symbol types
+  std::string displayName{};
+};
+
+using FiberTypeDescriptorPtr = std::shared_ptr<const FiberTypeDescriptor>;
+
+FiberTypeDescriptorPtr describeElementType(facebook::jsi::Runtime& runtime, const facebook::jsi::Value& type);
+
+} // namespace react
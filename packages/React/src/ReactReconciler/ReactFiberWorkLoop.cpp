@@ -1,6 +1,7 @@
 #include "ReactReconciler/ReactFiberWorkLoop.h"
 
 #include "ReactReconciler/ReactCapturedValue.h"
+#include "ReactReconciler/ReactFiberArena.h"
 #include "ReactReconciler/ReactFiberChild.h"
 #include "ReactReconciler/ReactFiberCommitEffects.h"
 #include "ReactReconciler/ReactFiberConcurrentUpdates.h"
@@ -10,6 +11,7 @@
 #include "ReactReconciler/ReactFiberHydrationContext.h"
 #include "ReactReconciler/ReactFiberHydrationContext_ext.h"
 #include "ReactReconciler/ReactFiberNewContext.h"
+#include "ReactReconciler/ReactFiberReclaim.h"
 #include "ReactReconciler/ReactFiberTreeContext.h"
 #include "ReactDOM/client/ReactDOMComponent.h"
 #include "ReactDOM/client/ReactDOMInstance.h"
@@ -99,6 +101,9 @@ struct SuspenseInfo {
 
 using PendingBoundaries = std::unordered_map<OffscreenInstance*, SuspenseInfo>;
 
+} // namespace
+
+// Outside the anonymous namespace so WorkLoopState can hold the marker stack
 struct TracingMarkerInstance {
   TracingMarkerTag tag{TracingMarkerTag::TransitionTracingMarker};
   std::unordered_set<const Transition*> transitions{};
@@ -107,12 +112,7 @@ struct TracingMarkerInstance {
   std::optional<std::string> name{};
 };
 
-StackCursor<std::optional<std::vector<TracingMarkerInstance*>>> markerInstanceStack =
-    createCursor<std::optional<std::vector<TracingMarkerInstance*>>>(std::nullopt);
-
-StackCursor<void*> resumedCacheCursor = createCursor<void*>(nullptr);
-StackCursor<std::optional<std::vector<const Transition*>>> transitionStackCursor =
-  createCursor<std::optional<std::vector<const Transition*>>>(std::nullopt);
+namespace {
 
 Value* cloneForFiber(Runtime& jsRuntime, const Value& source) {
   return new Value(jsRuntime, source);
@@ -226,7 +226,7 @@ OffscreenState* updateSuspenseOffscreenState(const OffscreenState* prevState, La
 }
 
 void markChildForDeletion(FiberNode& workInProgress, FiberNode& childToDelete) {
-  workInProgress.deletions.push_back(&childToDelete);
+  workInProgress.addDeletion(&childToDelete);
   workInProgress.flags = static_cast<FiberFlags>(workInProgress.flags | ChildDeletion);
 }
 
@@ -307,9 +307,9 @@ bool tryHandleSuspenseHydrationOnMount(
   }
 
   if (showFallback) {
-    pushPrimaryTreeSuspenseHandler(workInProgress);
+    pushPrimaryTreeSuspenseHandler(runtime, workInProgress);
   } else {
-    pushFallbackTreeSuspenseHandler(workInProgress);
+    pushFallbackTreeSuspenseHandler(runtime, workInProgress);
   }
 
   void* dehydrated = tryToClaimNextHydratableSuspenseInstance(runtime, workInProgress);
@@ -322,7 +322,7 @@ bool tryHandleSuspenseHydrationOnMount(
 
   auto* suspenseState = new SuspenseState();
   suspenseState->dehydrated = dehydrated;
-  suspenseState->treeContext = getSuspenseHandler();
+  suspenseState->treeContext = getSuspenseHandler(runtime);
   suspenseState->retryLane = NoLane;
   workInProgress.memoizedState = suspenseState;
   workInProgress.child = nullptr;
@@ -437,7 +437,7 @@ FiberNode* updateSuspenseFallbackChildren(
   return fallbackChildFragment;
 }
 
-bool shouldRemainOnFallback(FiberNode* current) {
+bool shouldRemainOnFallback(ReactRuntime& runtime, FiberNode* current) {
   if (current != nullptr) {
     const auto* suspenseState = static_cast<const SuspenseState*>(current->memoizedState);
     if (suspenseState == nullptr) {
@@ -445,7 +445,7 @@ bool shouldRemainOnFallback(FiberNode* current) {
     }
   }
 
-  const SuspenseContext suspenseContext = getCurrentSuspenseContext();
+  const SuspenseContext suspenseContext = getCurrentSuspenseContext(runtime);
   return hasSuspenseListContext(suspenseContext, ForceSuspenseFallback);
 }
 
@@ -497,18 +497,6 @@ Object ensureObject(Runtime& jsRuntime, const Value& value) {
   return Object(jsRuntime);
 }
 
-Value propsMapToValue(
-    Runtime& jsRuntime,
-    const std::unordered_map<std::string, Value>& propsMap) {
-  Object object(jsRuntime);
-  for (const auto& entry : propsMap) {
-    const auto& name = entry.first;
-    const auto& storedValue = entry.second;
-    object.setProperty(jsRuntime, name.c_str(), Value(jsRuntime, storedValue));
-  }
-  return Value(jsRuntime, object);
-}
-
 std::string getFiberType(Runtime& jsRuntime, const FiberNode& fiber) {
   Value typeValue = cloneJsiValue(jsRuntime, fiber.type);
   if (!typeValue.isString()) {
@@ -559,10 +547,9 @@ void pushTransition(
     FiberNode& fiber,
     const CachePoolPtr& cachePool,
     const std::vector<const Transition*>* transitions) {
-  (void)runtime;
-
-  void* const nextCache = cachePool != nullptr ? cachePool->pool : resumedCacheCursor.current;
-  push(resumedCacheCursor, nextCache, &fiber);
+  auto& state = getState(runtime);
+  void* const nextCache = cachePool != nullptr ? cachePool->pool : state.resumedCacheCursor.current;
+  push(state.resumedCacheCursor, nextCache, &fiber);
 
   if (!enableTransitionTracing) {
     return;
@@ -570,6 +557,7 @@ void pushTransition(
 
   std::optional<std::vector<const Transition*>> nextTransitions = std::nullopt;
 
+  auto& transitionStackCursor = state.transitionStackCursor;
   if (!transitionStackCursor.current.has_value()) {
     if (transitions != nullptr) {
       nextTransitions = *transitions;
@@ -585,16 +573,17 @@ void pushTransition(
   push(transitionStackCursor, std::move(nextTransitions), &fiber);
 }
 
-void popTransition(FiberNode& workInProgress, FiberNode* current) {
+void popTransition(ReactRuntime& runtime, FiberNode& workInProgress, FiberNode* current) {
   if (current == nullptr) {
     return;
   }
 
+  auto& state = getState(runtime);
   if (enableTransitionTracing) {
-    pop(transitionStackCursor, &workInProgress);
+    pop(state.transitionStackCursor, &workInProgress);
   }
 
-  pop(resumedCacheCursor, &workInProgress);
+  pop(state.resumedCacheCursor, &workInProgress);
 }
 
 bool isHiddenMode(OffscreenMode mode) {
@@ -701,16 +690,44 @@ void appendAllChildren(
   }
 }
 
-void storeHostUpdatePayload(Runtime& jsRuntime, FiberNode& fiber, const Value& payload) {
-  if (payload.isUndefined()) {
-    fiber.updatePayload.reset();
-    return;
+// Snapshots the props a host fiber is about to commit with and caches the
+// snapshot on it, so its next update only has to read the new props
+std::shared_ptr<const PropSnapshot> cacheHostPropSnapshot(Runtime& jsRuntime, FiberNode& fiber, const Object& props) {
+  auto snapshot = std::make_shared<const PropSnapshot>(PropSnapshot::fromObject(jsRuntime, props));
+  fiber.setPropSnapshot(snapshot);
+  return snapshot;
+}
+
+// The props `current` committed with: its cached snapshot, or one read from
+// memoizedProps for fibers that mounted without one
+std::shared_ptr<const PropSnapshot> committedHostPropSnapshot(Runtime& jsRuntime, const FiberNode& current) {
+  if (const auto& cached = current.getPropSnapshot()) {
+    return cached;
   }
-  fiber.updatePayload = std::make_unique<Value>(jsRuntime, payload);
+  Value prevPropsValue = cloneJsiValue(jsRuntime, current.memoizedProps);
+  return std::make_shared<const PropSnapshot>(
+      PropSnapshot::fromObject(jsRuntime, ensureObject(jsRuntime, prevPropsValue)));
+}
+
+// Diffs two snapshots into the fiber's binary update payload, which stays
+// native until commit. Returns whether anything changed.
+bool prepareHostUpdate(
+    ReactRuntime& runtime,
+    Runtime& jsRuntime,
+    FiberNode& fiber,
+    const PropSnapshot& prevProps,
+    const PropSnapshot& nextProps) {
+  PropUpdatePayload payload;
+  if (!hostconfig::prepareUpdate(runtime, jsRuntime, prevProps, nextProps, payload)) {
+    fiber.clearUpdatePayload();
+    return false;
+  }
+  fiber.setUpdatePayload(std::make_unique<PropUpdatePayload>(std::move(payload)));
+  return true;
 }
 
 void clearHostUpdatePayload(FiberNode& fiber) {
-  fiber.updatePayload.reset();
+  fiber.clearUpdatePayload();
 }
 
 void markRef(FiberNode* current, FiberNode& workInProgress) {
@@ -733,8 +750,8 @@ std::unordered_set<void*>& legacyErrorBoundariesThatAlreadyFailed() {
 }
 
 std::unique_ptr<FiberNode::Dependencies> cloneDependencies(
-    const std::unique_ptr<FiberNode::Dependencies>& source) {
-  if (!source) {
+    const FiberNode::Dependencies* source) {
+  if (source == nullptr) {
     return nullptr;
   }
 
@@ -749,19 +766,21 @@ void pushTreeContext(FiberNode& workInProgress) {
   // TODO: wire tree context stack once translated.
 }
 
-void pushRootMarkerInstance(FiberNode& workInProgress) {
+void pushRootMarkerInstance(ReactRuntime& runtime, FiberNode& workInProgress) {
   if (!enableTransitionTracing) {
     return;
   }
 
+  auto& markerInstanceStack = getState(runtime).markerInstanceStack;
   push(markerInstanceStack, markerInstanceStack.current, &workInProgress);
 }
 
-void pushMarkerInstance(FiberNode& workInProgress, TracingMarkerInstance& markerInstance) {
+void pushMarkerInstance(ReactRuntime& runtime, FiberNode& workInProgress, TracingMarkerInstance& markerInstance) {
   if (!enableTransitionTracing) {
     return;
   }
 
+  auto& markerInstanceStack = getState(runtime).markerInstanceStack;
   std::optional<std::vector<TracingMarkerInstance*>> nextStack;
   if (markerInstanceStack.current.has_value()) {
     nextStack = markerInstanceStack.current;
@@ -792,7 +811,7 @@ void pushRootTransition(
     nextTransitions = std::nullopt;
   }
 
-  push(transitionStackCursor, std::move(nextTransitions), &workInProgress);
+  push(getState(runtime).transitionStackCursor, std::move(nextTransitions), &workInProgress);
 }
 
 void pushHostContainer(ReactRuntime& runtime, FiberNode& workInProgress, void* container) {
@@ -869,20 +888,20 @@ void pushHostRootContext(ReactRuntime& runtime, FiberNode& workInProgress) {
   pushHostContainer(runtime, workInProgress, fiberRoot->containerInfo);
 }
 
-void popRootMarkerInstance(FiberNode& workInProgress) {
+void popRootMarkerInstance(ReactRuntime& runtime, FiberNode& workInProgress) {
   if (!enableTransitionTracing) {
     return;
   }
 
-  pop(markerInstanceStack, &workInProgress);
+  pop(getState(runtime).markerInstanceStack, &workInProgress);
 }
 
-void popMarkerInstance(FiberNode& workInProgress) {
+void popMarkerInstance(ReactRuntime& runtime, FiberNode& workInProgress) {
   if (!enableTransitionTracing) {
     return;
   }
 
-  pop(markerInstanceStack, &workInProgress);
+  pop(getState(runtime).markerInstanceStack, &workInProgress);
 }
 
 bool hasLegacyContextChanged(ReactRuntime& runtime) {
@@ -894,7 +913,7 @@ bool checkScheduledUpdateOrContext(FiberNode& current, Lanes renderLanes) {
     return true;
   }
 
-  const auto* dependencies = current.dependencies.get();
+  const auto* dependencies = current.getDependencies();
   if (dependencies != nullptr) {
     if (includesSomeLane(dependencies->lanes, renderLanes)) {
       return true;
@@ -910,7 +929,7 @@ FiberNode* attemptEarlyBailoutIfNoScheduledUpdate(
     FiberNode& workInProgress,
     Lanes renderLanes) {
   if (current != nullptr) {
-    workInProgress.dependencies = cloneDependencies(current->dependencies);
+    workInProgress.setDependencies(cloneDependencies(current->getDependencies()));
   }
 
   markSkippedUpdateLanes(runtime, workInProgress.lanes);
@@ -958,17 +977,15 @@ FiberNode* updateHostComponent(
   if (current == nullptr && !type.empty() && getIsHydrating(runtime)) {
     auto* hydratableInstance = tryToClaimNextHydratableInstance(runtime, workInProgress, type);
     if (hydratableInstance != nullptr) {
-      auto sharedInstance = hydratableInstance->shared_from_this();
-      setHostInstance(workInProgress, sharedInstance);
+      hostconfig::HostInstance claimedInstance(hydratableInstance);
+      setHostInstance(workInProgress, claimedInstance);
       clearHostUpdatePayload(workInProgress);
 
-      auto componentInstance = std::dynamic_pointer_cast<ReactDOMComponent>(sharedInstance);
+      auto* componentInstance = dynamic_cast<ReactDOMComponent*>(claimedInstance.get());
       if (componentInstance) {
-        Value prevPropsValue = propsMapToValue(jsRuntime, componentInstance->getProps());
-        Value payload = hostconfig::prepareUpdate(runtime, jsRuntime, prevPropsValue, nextPropsValue, false);
-        if (!payload.isUndefined()) {
+        auto nextSnapshot = cacheHostPropSnapshot(jsRuntime, workInProgress, nextPropsObject);
+        if (prepareHostUpdate(runtime, jsRuntime, workInProgress, componentInstance->getPropSnapshot(), *nextSnapshot)) {
           queueHydrationError(runtime, workInProgress, "Hydration: host component prop mismatch");
-          storeHostUpdatePayload(jsRuntime, workInProgress, payload);
           markUpdate(workInProgress);
         }
 
@@ -982,7 +999,7 @@ FiberNode* updateHostComponent(
           }
         }
 
-        componentInstance->setProps(jsRuntime, nextPropsObject);
+        componentInstance->replacePropSnapshot(*nextSnapshot);
       }
     } else {
       workInProgress.flags = static_cast<FiberFlags>(workInProgress.flags | ForceClientRender);
@@ -1043,19 +1060,16 @@ FiberNode* updateHostHoistable(
       if (!type.empty()) {
         auto* hydratableInstance = tryToClaimNextHydratableInstance(runtime, workInProgress, type);
         if (hydratableInstance != nullptr) {
-          auto sharedInstance = hydratableInstance->shared_from_this();
-          setHostInstance(workInProgress, sharedInstance);
-          auto componentInstance = std::dynamic_pointer_cast<ReactDOMComponent>(sharedInstance);
+          hostconfig::HostInstance claimedInstance(hydratableInstance);
+          setHostInstance(workInProgress, claimedInstance);
+          auto* componentInstance = dynamic_cast<ReactDOMComponent*>(claimedInstance.get());
           if (componentInstance) {
-            clearHostUpdatePayload(workInProgress);
-            Value prevPropsValue = propsMapToValue(jsRuntime, componentInstance->getProps());
-            Value payload = hostconfig::prepareUpdate(runtime, jsRuntime, prevPropsValue, nextPropsValue, false);
-            if (!payload.isUndefined()) {
+            auto nextSnapshot = cacheHostPropSnapshot(jsRuntime, workInProgress, nextPropsObject);
+            if (prepareHostUpdate(runtime, jsRuntime, workInProgress, componentInstance->getPropSnapshot(), *nextSnapshot)) {
               queueHydrationError(runtime, workInProgress, "Hydration: hoistable prop mismatch");
-              storeHostUpdatePayload(jsRuntime, workInProgress, payload);
               markUpdate(workInProgress);
             }
-            componentInstance->setProps(jsRuntime, nextPropsObject);
+            componentInstance->replacePropSnapshot(*nextSnapshot);
           } else {
             clearHostUpdatePayload(workInProgress);
           }
@@ -1075,14 +1089,10 @@ FiberNode* updateHostHoistable(
   }
 
   if (!getIsHydrating(runtime)) {
-    Value prevPropsValue = cloneJsiValue(jsRuntime, current->memoizedProps);
-    Value payload = hostconfig::prepareUpdate(runtime, jsRuntime, prevPropsValue, nextPropsValue, false);
-
-    if (!payload.isUndefined()) {
-      storeHostUpdatePayload(jsRuntime, workInProgress, payload);
+    const auto prevSnapshot = committedHostPropSnapshot(jsRuntime, *current);
+    const auto nextSnapshot = cacheHostPropSnapshot(jsRuntime, workInProgress, nextPropsObject);
+    if (prepareHostUpdate(runtime, jsRuntime, workInProgress, *prevSnapshot, *nextSnapshot)) {
       markUpdate(workInProgress);
-    } else {
-      clearHostUpdatePayload(workInProgress);
     }
 
     if (workInProgress.stateNode == nullptr) {
@@ -1091,6 +1101,8 @@ FiberNode* updateHostHoistable(
         setHostInstance(workInProgress, instance);
       }
     }
+  } else {
+    workInProgress.setPropSnapshot(nullptr);
   }
 
   return nullptr;
@@ -1120,8 +1132,8 @@ FiberNode* updateHostSingleton(
     if (!type.empty() && getIsHydrating(runtime)) {
       auto* hydratableSingleton = claimHydratableSingleton(runtime, workInProgress, type);
       if (hydratableSingleton != nullptr) {
-        auto sharedInstance = hydratableSingleton->shared_from_this();
-        setHostInstance(workInProgress, sharedInstance);
+        hostconfig::HostInstance claimedInstance(hydratableSingleton);
+        setHostInstance(workInProgress, claimedInstance);
       } else {
         workInProgress.flags = static_cast<FiberFlags>(workInProgress.flags | ForceClientRender);
         resetHydrationState(runtime);
@@ -1149,9 +1161,9 @@ FiberNode* updateHostText(
     if (isHydrating) {
       auto* hydratableText = tryToClaimNextHydratableTextInstance(runtime, workInProgress);
       if (hydratableText != nullptr) {
-        auto sharedInstance = hydratableText->shared_from_this();
-        setHostInstance(workInProgress, sharedInstance);
-        const bool needsUpdate = hostconfig::prepareToHydrateHostTextInstance(runtime, sharedInstance, nextText);
+        hostconfig::HostInstance claimedInstance(hydratableText);
+        setHostInstance(workInProgress, claimedInstance);
+        const bool needsUpdate = hostconfig::prepareToHydrateHostTextInstance(runtime, claimedInstance, nextText);
         if (needsUpdate) {
           queueHydrationError(runtime, workInProgress, "Hydration: text content mismatch");
           markUpdate(workInProgress);
@@ -1202,7 +1214,7 @@ FiberNode* updateSuspenseComponent(
   const bool isHydrating = getIsHydrating(runtime);
 
   const bool didSuspend = (workInProgress.flags & DidCapture) != 0;
-  bool showFallback = didSuspend || shouldRemainOnFallback(current);
+  bool showFallback = didSuspend || shouldRemainOnFallback(runtime, current);
 
   if (showFallback) {
     workInProgress.flags = static_cast<FiberFlags>(workInProgress.flags & ~DidCapture);
@@ -1233,7 +1245,7 @@ FiberNode* updateSuspenseComponent(
     }
 
     if (showFallback) {
-      pushFallbackTreeSuspenseHandler(workInProgress);
+      pushFallbackTreeSuspenseHandler(runtime, workInProgress);
       workInProgress.memoizedState = const_cast<SuspenseState*>(&kSuspendedMarker);
       mountSuspenseFallbackChildren(
           runtime, jsRuntime, workInProgress, nextPrimaryChildren, nextFallbackChildren, renderLanes);
@@ -1249,7 +1261,7 @@ FiberNode* updateSuspenseComponent(
       Value expectedLoadTimeValue = nextPropsObject.getProperty(jsRuntime, "unstable_expectedLoadTime");
       if (expectedLoadTimeValue.isNumber()) {
         // CPU-bound树：跳过主内容，挂起 primary，立刻调度重试
-        pushFallbackTreeSuspenseHandler(workInProgress);
+        pushFallbackTreeSuspenseHandler(runtime, workInProgress);
         mountSuspenseFallbackChildren(
             runtime, jsRuntime, workInProgress, nextPrimaryChildren, nextFallbackChildren, renderLanes);
         FiberNode* primaryChildFragment = workInProgress.child;
@@ -1263,12 +1275,12 @@ FiberNode* updateSuspenseComponent(
           nextChild = nullptr;
         }
       } else {
-        pushPrimaryTreeSuspenseHandler(workInProgress);
+        pushPrimaryTreeSuspenseHandler(runtime, workInProgress);
         workInProgress.memoizedState = nullptr;
         nextChild = mountSuspensePrimaryChildren(runtime, jsRuntime, workInProgress, nextPrimaryChildren, renderLanes);
       }
     } else {
-      pushPrimaryTreeSuspenseHandler(workInProgress);
+      pushPrimaryTreeSuspenseHandler(runtime, workInProgress);
       workInProgress.memoizedState = nullptr;
       nextChild = mountSuspensePrimaryChildren(runtime, jsRuntime, workInProgress, nextPrimaryChildren, renderLanes);
     }
@@ -1284,7 +1296,7 @@ FiberNode* updateSuspenseComponent(
     }
 
     if (showFallback) {
-      pushFallbackTreeSuspenseHandler(workInProgress);
+      pushFallbackTreeSuspenseHandler(runtime, workInProgress);
       workInProgress.memoizedState = const_cast<SuspenseState*>(&kSuspendedMarker);
       updateSuspenseFallbackChildren(
           runtime, jsRuntime, *current, workInProgress, nextPrimaryChildren, nextFallbackChildren, renderLanes);
@@ -1300,7 +1312,7 @@ FiberNode* updateSuspenseComponent(
         nextChild = nullptr;
       }
     } else {
-      pushPrimaryTreeSuspenseHandler(workInProgress);
+      pushPrimaryTreeSuspenseHandler(runtime, workInProgress);
       workInProgress.memoizedState = nullptr;
       nextChild = updateSuspensePrimaryChildren(
           runtime, jsRuntime, *current, workInProgress, nextPrimaryChildren, renderLanes);
@@ -1715,7 +1727,7 @@ FiberNode* updateSuspenseListComponent(
     nextChildren = nextPropsObject.getProperty(jsRuntime, kChildrenPropName);
   }
 
-  SuspenseContext parentContext = getCurrentSuspenseContext();
+  SuspenseContext parentContext = getCurrentSuspenseContext(runtime);
   const bool shouldForceFallback = hasSuspenseListContext(parentContext, ForceSuspenseFallback);
   const SuspenseContext nextContext = shouldForceFallback
       ? setShallowSuspenseListContext(parentContext, ForceSuspenseFallback)
@@ -1725,7 +1737,7 @@ FiberNode* updateSuspenseListComponent(
     workInProgress.flags = static_cast<FiberFlags>(workInProgress.flags | DidCapture);
   }
 
-  pushSuspenseListContext(workInProgress, nextContext);
+  pushSuspenseListContext(runtime, workInProgress, nextContext);
 
   FiberNode* firstChild = nullptr;
   if (current == nullptr) {
@@ -1816,7 +1828,7 @@ FiberNode* deferHiddenOffscreenComponent(
   }
 
   reuseHiddenContextOnStack(runtime, workInProgress);
-  pushOffscreenSuspenseHandler(workInProgress);
+  pushOffscreenSuspenseHandler(runtime, workInProgress);
 
   if (current != nullptr) {
     (void)renderLanes;
@@ -1875,7 +1887,7 @@ FiberNode* updateOffscreenComponent(
       }
 
       reuseHiddenContextOnStack(runtime, workInProgress);
-      pushOffscreenSuspenseHandler(workInProgress);
+      pushOffscreenSuspenseHandler(runtime, workInProgress);
     } else if (!includesSomeLane(renderLanes, OffscreenLane)) {
       const Lanes offscreenLanes = laneToLanes(OffscreenLane);
       workInProgress.lanes = offscreenLanes;
@@ -1898,7 +1910,7 @@ FiberNode* updateOffscreenComponent(
       } else {
         reuseHiddenContextOnStack(runtime, workInProgress);
       }
-      pushOffscreenSuspenseHandler(workInProgress);
+      pushOffscreenSuspenseHandler(runtime, workInProgress);
     }
   } else {
     if (prevState != nullptr) {
@@ -1913,7 +1925,7 @@ FiberNode* updateOffscreenComponent(
       pushTransition(runtime, workInProgress, cachePool, transitions);
 
       pushHiddenContext(runtime, workInProgress, makeHiddenContextFromState(*prevState));
-      reuseSuspenseHandlerOnStack(workInProgress);
+      reuseSuspenseHandlerOnStack(runtime, workInProgress);
 
       workInProgress.memoizedState = nullptr;
     } else {
@@ -1922,7 +1934,7 @@ FiberNode* updateOffscreenComponent(
       }
 
       reuseHiddenContextOnStack(runtime, workInProgress);
-      reuseSuspenseHandlerOnStack(workInProgress);
+      reuseSuspenseHandlerOnStack(runtime, workInProgress);
     }
   }
 
@@ -2031,7 +2043,7 @@ FiberNode* updateTracingMarkerComponent(
   FiberNode* resultingChild = nullptr;
 
   if (markerInstance != nullptr) {
-    pushMarkerInstance(workInProgress, *markerInstance);
+    pushMarkerInstance(runtime, workInProgress, *markerInstance);
   }
 
   if (current == nullptr) {
@@ -2045,7 +2057,7 @@ FiberNode* updateTracingMarkerComponent(
   }
 
   if (markerInstance != nullptr) {
-    popMarkerInstance(workInProgress);
+    popMarkerInstance(runtime, workInProgress);
   }
 
   return resultingChild;
@@ -2129,7 +2141,7 @@ FiberNode* updateHostRoot(
   pushHostRootContext(runtime, workInProgress);
   pushRootTransition(runtime, workInProgress, *fiberRoot, renderLanes);
   if (enableTransitionTracing) {
-    pushRootMarkerInstance(workInProgress);
+    pushRootMarkerInstance(runtime, workInProgress);
   }
 
   auto* prevState = current != nullptr ? static_cast<HostRootMemoizedState*>(current->memoizedState) : nullptr;
@@ -2177,7 +2189,7 @@ void popRootTransition(
     return;
   }
 
-  pop(transitionStackCursor, &workInProgress);
+  pop(getState(runtime).transitionStackCursor, &workInProgress);
 }
 
 void popHostContainer(ReactRuntime& runtime, FiberNode& workInProgress) {
@@ -2199,7 +2211,7 @@ void emitPendingHydrationWarningsInternal(ReactRuntime& runtime) {
   }
 
   auto logError = [](const HydrationErrorInfo& info) {
-    const std::string key = info.fiber != nullptr ? info.fiber->key : std::string{};
+    const std::string key = info.fiber != nullptr ? info.fiber->getKey() : std::string{};
     std::cerr << "[HydrationWarning] Fiber key: " << key << " - " << info.message << std::endl;
   };
 
@@ -2358,7 +2370,7 @@ FiberNode* completeWork(
         if (!getWorkInProgressTransitions(runtime).empty()) {
           workInProgress->flags = static_cast<FiberFlags>(workInProgress->flags | Passive);
         }
-        popRootMarkerInstance(*workInProgress);
+        popRootMarkerInstance(runtime, *workInProgress);
       }
 
       popCacheProvider(*workInProgress, nullptr);
@@ -2415,13 +2427,10 @@ FiberNode* completeWork(
       Object nextPropsObject = ensureObject(jsRuntime, nextPropsValue);
 
       if (current != nullptr && current->stateNode != nullptr) {
-        Value prevPropsValue = cloneJsiValue(jsRuntime, current->memoizedProps);
-        Value payload = hostconfig::prepareUpdate(runtime, jsRuntime, prevPropsValue, nextPropsValue, false);
-        if (!payload.isUndefined()) {
-          storeHostUpdatePayload(jsRuntime, *workInProgress, payload);
+        const auto prevSnapshot = committedHostPropSnapshot(jsRuntime, *current);
+        const auto nextSnapshot = cacheHostPropSnapshot(jsRuntime, *workInProgress, nextPropsObject);
+        if (prepareHostUpdate(runtime, jsRuntime, *workInProgress, *prevSnapshot, *nextSnapshot)) {
           markUpdate(*workInProgress);
-        } else {
-          clearHostUpdatePayload(*workInProgress);
         }
 
         // Reuse existing host instance pointer from current fiber.
@@ -2436,6 +2445,9 @@ FiberNode* completeWork(
         break;
       }
 
+      // A snapshot carried over from the alternate no longer matches these props
+      workInProgress->setPropSnapshot(nullptr);
+
       if (type.empty()) {
         bubbleProperties(*workInProgress);
         break;
@@ -2493,9 +2505,9 @@ FiberNode* completeWork(
       break;
     case WorkTag::OffscreenComponent:
     case WorkTag::LegacyHiddenComponent: {
-      popSuspenseHandler(*workInProgress);
+      popSuspenseHandler(runtime, *workInProgress);
       popHiddenContext(runtime, *workInProgress);
-      popTransition(*workInProgress, current);
+      popTransition(runtime, *workInProgress, current);
       bubbleProperties(*workInProgress);
       break;
     }
@@ -2531,12 +2543,28 @@ FiberNode* unwindWork(FiberNode* current, FiberNode* workInProgress, Lanes entan
 
   resetSuspendedWorkLoopOnUnwind(workInProgress);
 
-  workInProgress->flags = static_cast<FiberFlags>(workInProgress->flags | Incomplete);
-  workInProgress->subtreeFlags = NoFlags;
-  workInProgress->childLanes = NoLanes;
-  workInProgress->deletions.clear();
-
-  return workInProgress->returnFiber;
+  // Only a boundary that captured the throw resumes rendering; everything
+  // else hands the unwind back to unwindUnitOfWork to keep climbing
+  const FiberFlags flags = workInProgress->flags;
+  switch (workInProgress->tag) {
+    case WorkTag::ClassComponent:
+    case WorkTag::SuspenseComponent:
+    case WorkTag::ActivityComponent:
+    case WorkTag::OffscreenComponent:
+      if ((flags & ShouldCapture) != NoFlags) {
+        workInProgress->flags = static_cast<FiberFlags>((flags & ~ShouldCapture) | DidCapture);
+        return workInProgress;
+      }
+      return nullptr;
+    case WorkTag::HostRoot:
+      if ((flags & ShouldCapture) != NoFlags && (flags & DidCapture) == NoFlags) {
+        workInProgress->flags = static_cast<FiberFlags>((flags & ~ShouldCapture) | DidCapture);
+        return workInProgress;
+      }
+      return nullptr;
+    default:
+      return nullptr;
+  }
 }
 
 void startProfilerTimer(FiberNode&) {
@@ -2559,14 +2587,14 @@ FiberNode* beginWork(
 
   workInProgress->flags &= StaticMask;
   workInProgress->subtreeFlags = NoFlags;
-  workInProgress->deletions.clear();
+  workInProgress->clearDeletions();
 
   bool didReceiveUpdate = false;
 
   if (current != nullptr) {
     workInProgress->childLanes = current->childLanes;
-    if (current->dependencies != nullptr) {
-      workInProgress->dependencies = cloneDependencies(current->dependencies);
+    if (current->getDependencies() != nullptr) {
+      workInProgress->setDependencies(cloneDependencies(current->getDependencies()));
     }
 
     void* const oldProps = current->memoizedProps;
@@ -2827,7 +2855,7 @@ void attachPingListener(
     Lanes lanes) {
   (void)jsRuntime;
   auto& threadIds = root.pingCache[&wakeable];
-  if (!threadIds.insert(lanes).second) {
+  if (!threadIds.insert(lanes)) {
     return;
   }
 
@@ -3327,6 +3355,7 @@ RootExitStatus renderRootSync(
   FiberRoot& root,
   Lanes lanes,
   bool shouldYieldForPrerendering) {
+  FiberArenaScope arenaScope(root.fiberArena.get());
   (void)shouldYieldForPrerendering;
 
   pushExecutionContext(runtime, RenderContext);
@@ -3366,6 +3395,7 @@ RootExitStatus renderRootConcurrent(
   Runtime& jsRuntime,
   FiberRoot& root,
   Lanes lanes) {
+  FiberArenaScope arenaScope(root.fiberArena.get());
   pushExecutionContext(runtime, RenderContext);
 
   if (getWorkInProgressRoot(runtime) != &root ||
@@ -3495,7 +3525,7 @@ void throwAndUnwindWorkLoop(
           reason == SuspendedReason::SuspendedOnAction ||
           reason == SuspendedReason::SuspendedOnImmediate ||
           reason == SuspendedReason::SuspendedOnDeprecatedThrowPromise) {
-        if (FiberNode* const boundary = getSuspenseHandler()) {
+        if (FiberNode* const boundary = getSuspenseHandler(runtime)) {
           if (boundary->tag == WorkTag::SuspenseComponent) {
             boundary->flags = static_cast<FiberFlags>(boundary->flags | ScheduleRetry);
 
@@ -3580,18 +3610,18 @@ void unwindUnitOfWork(ReactRuntime& runtime, FiberNode& unitOfWork, bool skipSib
 
     if (enableProfilerTimer && (incompleteWork->mode & ProfileMode) != NoMode) {
       stopProfilerTimerIfRunningAndRecordIncompleteDuration(*incompleteWork);
-      double actualDuration = incompleteWork->actualDuration;
+      double actualDuration = incompleteWork->getProfilerTimings().actualDuration;
       for (FiberNode* child = incompleteWork->child; child != nullptr; child = child->sibling) {
-        actualDuration += child->actualDuration;
+        actualDuration += child->getProfilerTimings().actualDuration;
       }
-      incompleteWork->actualDuration = actualDuration;
+      incompleteWork->mutableProfilerTimings().actualDuration = actualDuration;
     }
 
     FiberNode* returnFiber = incompleteWork->returnFiber;
     if (returnFiber != nullptr) {
       returnFiber->flags |= Incomplete;
       returnFiber->subtreeFlags = NoFlags;
-      returnFiber->deletions.clear();
+      returnFiber->clearDeletions();
     }
 
     if (!skipSiblings) {
@@ -3622,7 +3652,12 @@ FiberNode* prepareFreshStack(ReactRuntime& runtime, FiberRoot& root, Lanes lanes
     cancel();
   }
 
+  FiberRoot* const interruptedRoot =
+      getWorkInProgressFiber(runtime) != nullptr ? getWorkInProgressRoot(runtime) : nullptr;
   resetWorkInProgressStack(runtime);
+  if (interruptedRoot != nullptr) {
+    detachAbandonedWork(runtime, *interruptedRoot);
+  }
 
   setWorkInProgressRoot(runtime, &root);
   FiberNode* rootWorkInProgress = createWorkInProgress(root.current, nullptr);
@@ -3678,6 +3713,23 @@ void resetWorkInProgressStack(ReactRuntime& runtime) {
     interruptedWork = interruptedWork->returnFiber;
   }
 
+  // unwindInterruptedWork does not pop contexts yet. Drop the fiber pointers
+  // the interrupted render left on the stacks, since the fibers it mounted
+  // are about to be queued for reclamation.
+  WorkLoopState& state = getState(runtime);
+  resetCursor(state.hostContextCursor, static_cast<void*>(nullptr));
+  resetCursor(state.hostContextFiberCursor, static_cast<FiberNode*>(nullptr));
+  resetCursor(state.suspenseHandlerStackCursor, static_cast<FiberNode*>(nullptr));
+  state.shellBoundary = nullptr;
+  state.hydrationParentFiber = nullptr;
+  state.treeForkProvider = nullptr;
+  state.treeForkCount = 0;
+  state.treeForkStack.clear();
+  state.treeContextProvider = nullptr;
+  state.treeContextId = 1u;
+  state.treeContextOverflow.clear();
+  state.treeIdStack.clear();
+
   setWorkInProgressFiber(runtime, nullptr);
 }
 
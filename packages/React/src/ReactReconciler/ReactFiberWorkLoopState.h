@@ -1,10 +1,14 @@
 #pragma once
 
+#include "ReactReconciler/ReactFiberHiddenContext.h"
 #include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberReclaim.h"
 #include "ReactReconciler/ReactFiberStack.h"
+#include "ReactReconciler/ReactFiberSuspenseContext.h"
 
 #include <cstdint>
 #include <limits>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -13,6 +17,7 @@ namespace react {
 class FiberNode;
 struct FiberRoot;
 struct Transition;
+struct TracingMarkerInstance;
 
 struct PendingRenderPhaseUpdateNode {
   FiberNode* fiber{nullptr};
@@ -144,6 +149,7 @@ struct WorkLoopState {
   bool isRunningInsertionEffect{false};
   PendingRenderPhaseUpdateNode* pendingRenderPhaseUpdates{nullptr};
   std::vector<FiberNode*> pendingPassiveEffects{};
+  FiberReclaimQueue fiberReclaimQueue{};
   bool isHydrating{false};
   FiberNode* hydrationParentFiber{nullptr};
   void* nextHydratableInstance{nullptr};
@@ -160,6 +166,16 @@ struct WorkLoopState {
   StackCursor<void*> hostContextCursor{createCursor<void*>(nullptr)};
   StackCursor<FiberNode*> hostContextFiberCursor{createCursor<FiberNode*>(nullptr)};
   StackCursor<LegacyContextEntry> legacyContextCursor{createCursor(LegacyContextEntry{})};
+  StackCursor<HiddenContextOptional> currentTreeHiddenStackCursor{createCursor<HiddenContextOptional>(std::nullopt)};
+  StackCursor<Lanes> prevEntangledRenderLanesCursor{createCursor<Lanes>(NoLanes)};
+  StackCursor<FiberNode*> suspenseHandlerStackCursor{createCursor<FiberNode*>(nullptr)};
+  StackCursor<SuspenseContext> suspenseStackCursor{createCursor<SuspenseContext>(DefaultSuspenseContext)};
+  FiberNode* shellBoundary{nullptr};
+  StackCursor<void*> resumedCacheCursor{createCursor<void*>(nullptr)};
+  StackCursor<std::optional<std::vector<const Transition*>>> transitionStackCursor{
+      createCursor<std::optional<std::vector<const Transition*>>>(std::nullopt)};
+  StackCursor<std::optional<std::vector<TracingMarkerInstance*>>> markerInstanceStack{
+      createCursor<std::optional<std::vector<TracingMarkerInstance*>>>(std::nullopt)};
 };
 
 } // namespace react
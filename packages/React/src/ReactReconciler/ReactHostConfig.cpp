@@ -1,11 +1,9 @@
 #include "ReactReconciler/ReactHostConfig.h"
 
 #include "ReactDOM/client/ReactDOMComponent.h"
-#include "ReactDOM/client/ReactDOMDiffProperties.h"
 
 #include <cmath>
 #include <sstream>
-#include <vector>
 
 namespace react::hostconfig {
 
@@ -16,8 +14,8 @@ using facebook::jsi::Runtime;
 using facebook::jsi::String;
 using facebook::jsi::Value;
 
-std::shared_ptr<ReactDOMComponent> asComponent(const HostInstance& instance) {
-  return std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+ReactDOMComponent* asComponent(const HostInstance& instance) {
+  return dynamic_cast<ReactDOMComponent*>(instance.get());
 }
 
 std::string numberToString(double value) {
@@ -60,7 +58,7 @@ HostInstance createInstance(
     Runtime& jsRuntime,
     const std::string& type,
     const Object& props) {
-  return runtime.createInstance(jsRuntime, type, props);
+  return runtime.createInstanceRef(jsRuntime, type, props);
 }
 
 HostInstance createHoistableInstance(
@@ -76,7 +74,7 @@ HostTextInstance createTextInstance(
     ReactRuntime& runtime,
     Runtime& jsRuntime,
     const std::string& text) {
-  return runtime.createTextInstance(jsRuntime, text);
+  return runtime.createTextInstanceRef(jsRuntime, text);
 }
 
 void appendInitialChild(
@@ -208,39 +206,26 @@ UpdatePayload prepareUpdate(
   Object prevObj = ensureObject(jsRuntime, prevProps);
   Object nextObj = ensureObject(jsRuntime, nextProps);
 
-  Object payload = diffHostProperties(jsRuntime, prevObj, nextObj);
-  bool hasChanges = payload.hasProperty(jsRuntime, "attributes");
-
-  auto prevNames = prevObj.getPropertyNames(jsRuntime);
-  const size_t prevLength = prevNames.size(jsRuntime);
-  std::vector<std::string> removed;
-  removed.reserve(prevLength);
-
-  for (size_t index = 0; index < prevLength; ++index) {
-    auto nameValue = prevNames.getValueAtIndex(jsRuntime, index);
-    if (!nameValue.isString()) {
-      continue;
-    }
-    const auto name = nameValue.getString(jsRuntime).utf8(jsRuntime);
-    if (!nextObj.hasProperty(jsRuntime, name.c_str())) {
-      removed.push_back(name);
-    }
-  }
-
-  if (!removed.empty()) {
-    facebook::jsi::Array removedArray(jsRuntime, removed.size());
-    for (size_t i = 0; i < removed.size(); ++i) {
-      removedArray.setValueAtIndex(jsRuntime, i, String::createFromUtf8(jsRuntime, removed[i]));
-    }
-    payload.setProperty(jsRuntime, "removedAttributes", removedArray);
-    hasChanges = true;
-  }
-
-  if (!hasChanges) {
+  PropUpdatePayload payload;
+  if (!prepareUpdate(
+          runtime,
+          jsRuntime,
+          PropSnapshot::fromObject(jsRuntime, prevObj),
+          PropSnapshot::fromObject(jsRuntime, nextObj),
+          payload)) {
     return Value::undefined();
   }
 
-  return Value(jsRuntime, payload);
+  return Value(jsRuntime, propUpdatePayloadToObject(jsRuntime, payload));
+}
+
+bool prepareUpdate(
+    ReactRuntime& /*runtime*/,
+    Runtime& jsRuntime,
+    const PropSnapshot& prevProps,
+    const PropSnapshot& nextProps,
+    PropUpdatePayload& payload) {
+  return diffPropSnapshots(jsRuntime, prevProps, nextProps, payload);
 }
 
 void commitUpdate(
@@ -260,6 +245,16 @@ void commitUpdate(
   runtime.commitUpdate(jsRuntime, instance, prev, next, payloadObject);
 }
 
+void commitUpdate(
+    ReactRuntime& runtime,
+    const HostInstance& instance,
+    const PropUpdatePayload& payload) {
+  if (!instance || payload.empty()) {
+    return;
+  }
+  runtime.commitPropUpdate(instance, payload);
+}
+
 void commitTextUpdate(
     ReactRuntime& runtime,
     const HostTextInstance& textInstance,
@@ -292,13 +287,6 @@ bool supportsHydration(ReactRuntime& /*runtime*/) {
 
 namespace {
 
-ReactDOMComponent* asComponent(void* pointer) {
-  if (pointer == nullptr) {
-    return nullptr;
-  }
-  return dynamic_cast<ReactDOMComponent*>(static_cast<ReactDOMInstance*>(pointer));
-}
-
 ReactDOMInstance* asInstance(void* pointer) {
   if (pointer == nullptr) {
     return nullptr;
@@ -315,75 +303,25 @@ ReactDOMInstance* previousHydratableOnEnteringSingleton = nullptr;
 } // namespace
 
 void* getFirstHydratableChildWithinContainer(ReactRuntime& /*runtime*/, void* container) {
-  ReactDOMComponent* component = asComponent(container);
-  if (component == nullptr) {
-    return nullptr;
-  }
-
-  for (const auto& child : component->children) {
-    if (child) {
-      return child.get();
-    }
-  }
-
-  return nullptr;
+  ReactDOMInstance* instance = asInstance(container);
+  return instance != nullptr ? instance->firstChild() : nullptr;
 }
 
 void* getFirstHydratableChild(ReactRuntime& /*runtime*/, const HostInstance& parent) {
-  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(parent);
-  if (!component) {
-    return nullptr;
-  }
-
-  for (const auto& child : component->children) {
-    if (child) {
-      return child.get();
-    }
-  }
-
-  return nullptr;
+  return parent ? parent->firstChild() : nullptr;
 }
 
 void* getNextHydratableSibling(ReactRuntime& /*runtime*/, void* instance) {
   ReactDOMInstance* current = asInstance(instance);
-  if (current == nullptr) {
-    return nullptr;
-  }
-
-  auto parent = current->getParent();
-  if (!parent) {
-    return nullptr;
-  }
-
-  auto parentComponent = std::dynamic_pointer_cast<ReactDOMComponent>(parent);
-  if (!parentComponent) {
-    return nullptr;
-  }
-
-  bool foundCurrent = false;
-  for (const auto& sibling : parentComponent->children) {
-    if (!sibling) {
-      continue;
-    }
-
-    if (foundCurrent) {
-      return sibling.get();
-    }
-
-    if (sibling.get() == current) {
-      foundCurrent = true;
-    }
-  }
-
-  return nullptr;
+  return current != nullptr ? current->nextSibling() : nullptr;
 }
 
 bool prepareToHydrateHostTextInstance(
     ReactRuntime& /*runtime*/,
     const HostTextInstance& textInstance,
     const std::string& textContent) {
-  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(textInstance);
-  if (!component) {
+  const auto* component = dynamic_cast<const ReactDOMComponent*>(textInstance.get());
+  if (component == nullptr) {
     return true;
   }
 
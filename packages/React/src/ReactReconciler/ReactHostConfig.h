@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReactDOM/client/ReactDOMInstance.h"
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
 #include "ReactRuntime/ReactRuntime.h"
 
 #include "jsi/jsi.h"
@@ -10,9 +11,9 @@
 
 namespace react::hostconfig {
 
-using HostInstance = std::shared_ptr<ReactDOMInstance>;
-using HostTextInstance = std::shared_ptr<ReactDOMInstance>;
-using HostContainer = std::shared_ptr<ReactDOMInstance>;
+using HostInstance = ReactDOMInstanceRef;
+using HostTextInstance = ReactDOMInstanceRef;
+using HostContainer = ReactDOMInstanceRef;
 using UpdatePayload = facebook::jsi::Value;
 
 HostInstance createInstance(
@@ -88,6 +89,15 @@ UpdatePayload prepareUpdate(
   const facebook::jsi::Value& nextProps,
   bool isTextNode);
 
+// Native form: appends the changes between two snapshots to `payload`
+// and returns whether there were any
+bool prepareUpdate(
+  ReactRuntime& runtime,
+  facebook::jsi::Runtime& jsRuntime,
+  const PropSnapshot& prevProps,
+  const PropSnapshot& nextProps,
+  PropUpdatePayload& payload);
+
 void commitUpdate(
   ReactRuntime& runtime,
   facebook::jsi::Runtime& jsRuntime,
@@ -96,6 +106,11 @@ void commitUpdate(
   const facebook::jsi::Value& nextProps,
   const UpdatePayload& payload);
 
+void commitUpdate(
+  ReactRuntime& runtime,
+  const HostInstance& instance,
+  const PropUpdatePayload& payload);
+
 void commitTextUpdate(
   ReactRuntime& runtime,
   const HostTextInstance& textInstance,
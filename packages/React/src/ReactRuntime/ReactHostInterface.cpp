@@ -1,7 +1,7 @@
 #include "ReactRuntime/ReactHostInterface.h"
 
-#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "ReactReconciler/ReactFiber.h"
 
@@ -9,170 +9,174 @@ namespace react {
 
 namespace {
 
-facebook::jsi::Value cloneValue(
-    facebook::jsi::Runtime& runtime,
-    const facebook::jsi::Value& value) {
-  return facebook::jsi::Value(runtime, value);
+ReactDOMComponent* asComponent(const ReactDOMInstanceRef& instance) {
+  return dynamic_cast<ReactDOMComponent*>(instance.get());
 }
 
-facebook::jsi::Object cloneObject(
+} // namespace
+
+ReactDOMInstanceRef HostInterface::createHostInstanceRef(
     facebook::jsi::Runtime& runtime,
-    const facebook::jsi::Object& object) {
-  facebook::jsi::Object clone(runtime);
-  auto names = object.getPropertyNames(runtime);
-  const size_t length = names.size(runtime);
-  for (size_t index = 0; index < length; ++index) {
-    auto nameValue = names.getValueAtIndex(runtime, index);
-    if (!nameValue.isString()) {
-      continue;
-    }
-    const auto name = nameValue.getString(runtime).utf8(runtime);
-    clone.setProperty(runtime, name.c_str(), cloneValue(runtime, object.getProperty(runtime, name.c_str())));
-  }
-  return clone;
+    const std::string& type,
+    const facebook::jsi::Object& props) {
+  return makeReactDOMRef<ReactDOMComponent>(type, runtime, props);
 }
 
-std::shared_ptr<ReactDOMComponent> asComponent(const std::shared_ptr<ReactDOMInstance>& instance) {
-  return std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+ReactDOMInstanceRef HostInterface::createHostTextInstanceRef(
+    facebook::jsi::Runtime& runtime,
+    const std::string& text) {
+  facebook::jsi::Object emptyProps(runtime);
+  auto component = makeReactDOMRef<ReactDOMComponent>("#text", runtime, emptyProps, true, text);
+  component->setTextContent(text);
+  return component;
 }
 
-} // namespace
-
 std::shared_ptr<ReactDOMInstance> HostInterface::createHostInstance(
     facebook::jsi::Runtime& runtime,
     const std::string& type,
     const facebook::jsi::Object& props) {
-  auto component = std::make_shared<ReactDOMComponent>(type, runtime, cloneObject(runtime, props));
-  return component;
+  return createHostInstanceRef(runtime, type, props).share();
 }
 
 std::shared_ptr<ReactDOMInstance> HostInterface::createHostTextInstance(
     facebook::jsi::Runtime& runtime,
     const std::string& text) {
-  facebook::jsi::Object emptyProps(runtime);
-  auto component = std::make_shared<ReactDOMComponent>("#text", runtime, emptyProps, true, text);
-  component->setTextContent(text);
-  return component;
+  return createHostTextInstanceRef(runtime, text).share();
 }
 
-void HostInterface::detachFromParent(const std::shared_ptr<ReactDOMInstance>& child) {
-  if (!child) {
-    return;
-  }
-  auto currentParent = child->getParent();
-  if (!currentParent) {
-    return;
-  }
-  auto parentComponent = asComponent(currentParent);
-  if (!parentComponent) {
-    return;
-  }
-  auto& siblings = parentComponent->children;
-  siblings.erase(
-      std::remove_if(
-          siblings.begin(),
-          siblings.end(),
-          [&](const std::shared_ptr<ReactDOMInstance>& candidate) {
-            return candidate.get() == child.get();
-          }),
-      siblings.end());
-  child->clearParent();
+void HostInterface::eraseChild(ReactDOMComponent& parent, ReactDOMInstance& child) {
+  parent.children.erase(child);
+}
+
+void HostInterface::insertChild(
+    ReactDOMComponent& parent,
+    const ReactDOMInstanceRef& child,
+    const ReactDOMInstance* beforeChild) {
+  // The list takes the child out of its old parent first
+  parent.children.insert(beforeChild, child);
 }
 
 void HostInterface::appendHostChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child) {
-  auto parentComponent = asComponent(parent);
-  auto childComponent = asComponent(child);
-  if (!parentComponent || parentComponent->isTextInstance() || !childComponent) {
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child) {
+  ReactDOMComponent* parentComponent = asComponent(parent);
+  if (parentComponent == nullptr || parentComponent->isTextInstance() || asComponent(child) == nullptr) {
     return;
   }
-
-  detachFromParent(child);
-  parentComponent->children.push_back(child);
-  child->setParent(parent);
+  insertChild(*parentComponent, child, nullptr);
 }
 
 void HostInterface::insertHostChildBefore(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child,
-    std::shared_ptr<ReactDOMInstance> beforeChild) {
-  auto parentComponent = asComponent(parent);
-  auto childComponent = asComponent(child);
-  if (!parentComponent || parentComponent->isTextInstance() || !childComponent) {
-    return;
-  }
-
-  detachFromParent(child);
-
-  if (!beforeChild) {
-    parentComponent->children.push_back(child);
-    child->setParent(parent);
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child,
+    const ReactDOMInstanceRef& beforeChild) {
+  ReactDOMComponent* parentComponent = asComponent(parent);
+  if (parentComponent == nullptr || parentComponent->isTextInstance() || asComponent(child) == nullptr) {
     return;
   }
-
-  auto& siblings = parentComponent->children;
-  auto it = std::find_if(
-      siblings.begin(),
-      siblings.end(),
-      [&](const std::shared_ptr<ReactDOMInstance>& candidate) {
-        return candidate.get() == beforeChild.get();
-      });
-
-  if (it == siblings.end()) {
-    siblings.push_back(child);
-  } else {
-    siblings.insert(it, child);
-  }
-  child->setParent(parent);
+  insertChild(*parentComponent, child, beforeChild.get());
 }
 
 void HostInterface::removeHostChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child) {
-  auto parentComponent = asComponent(parent);
-  auto childComponent = asComponent(child);
-  if (!parentComponent || !childComponent) {
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child) {
+  ReactDOMComponent* parentComponent = asComponent(parent);
+  if (parentComponent == nullptr || asComponent(child) == nullptr) {
     return;
   }
-  auto& siblings = parentComponent->children;
-  siblings.erase(
-      std::remove_if(
-          siblings.begin(),
-          siblings.end(),
-          [&](const std::shared_ptr<ReactDOMInstance>& candidate) {
-            return candidate.get() == child.get();
-          }),
-      siblings.end());
-  child->clearParent();
+  eraseChild(*parentComponent, *child);
 }
 
 void HostInterface::commitHostUpdate(
     facebook::jsi::Runtime& runtime,
-    std::shared_ptr<ReactDOMInstance> instance,
+    const ReactDOMInstanceRef& instance,
     const facebook::jsi::Object& /*oldProps*/,
     const facebook::jsi::Object& newProps,
     const facebook::jsi::Object& /*payload*/) {
-  auto component = asComponent(instance);
-  if (!component || component->isTextInstance()) {
+  ReactDOMComponent* component = asComponent(instance);
+  if (component == nullptr || component->isTextInstance()) {
     return;
   }
-  component->setProps(runtime, cloneObject(runtime, newProps));
+  component->setProps(runtime, newProps);
+}
+
+void HostInterface::commitHostPropUpdate(
+    const ReactDOMInstanceRef& instance,
+    const PropUpdatePayload& payload) {
+  ReactDOMComponent* component = asComponent(instance);
+  if (component == nullptr || component->isTextInstance()) {
+    return;
+  }
+  component->applyPropUpdate(payload);
 }
 
 void HostInterface::commitHostTextUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
+    const ReactDOMInstanceRef& instance,
     const std::string& /*oldText*/,
     const std::string& newText) {
-  auto component = asComponent(instance);
-  if (!component) {
+  ReactDOMComponent* component = asComponent(instance);
+  if (component == nullptr) {
     return;
   }
   component->setTextContent(newText);
 }
 
+void HostInterface::applyMutations(const HostMutationBuffer& buffer) {
+  // Each instance is resolved once; the commands then run straight off the
+  // buffer without a dispatch or handle copy per mutation
+  std::vector<ReactDOMComponent*> components(buffer.instanceCount() + 1, nullptr);
+  for (HostInstanceId id = 1; id < components.size(); ++id) {
+    components[id] = dynamic_cast<ReactDOMComponent*>(buffer.instance(id).get());
+  }
+
+  HostMutationBuffer::Command command;
+  const std::size_t end = buffer.bytes().size();
+  for (std::size_t offset = 0; offset < end;) {
+    offset = buffer.decode(offset, command);
+    ReactDOMComponent* target = components[command.target];
+    if (target == nullptr) {
+      continue;
+    }
+    switch (command.op) {
+      case HostMutationBuffer::Op::Create:
+      case HostMutationBuffer::Op::CreateText:
+        // Created when recorded; nothing left to do in this process
+        break;
+      case HostMutationBuffer::Op::Append:
+      case HostMutationBuffer::Op::Insert:
+        if (!target->isTextInstance() && components[command.child] != nullptr) {
+          insertChild(
+              *target,
+              buffer.instance(command.child),
+              command.before != 0 ? components[command.before] : nullptr);
+        }
+        break;
+      case HostMutationBuffer::Op::Remove:
+        if (components[command.child] != nullptr) {
+          eraseChild(*target, *components[command.child]);
+        }
+        break;
+      case HostMutationBuffer::Op::SetProps:
+        if (!target->isTextInstance()) {
+          target->applyPropUpdate(buffer.payload(command.payload));
+        }
+        break;
+      case HostMutationBuffer::Op::ReplaceProps:
+        if (!target->isTextInstance()) {
+          PropSnapshot props;
+          applyPropUpdatePayload(buffer.payload(command.payload), props);
+          target->replacePropSnapshot(std::move(props));
+        }
+        break;
+      case HostMutationBuffer::Op::SetText:
+        target->setTextContent(std::string(command.text));
+        break;
+    }
+  }
+}
+
 void HostInterface::handleHydrationError(const HydrationErrorInfo& info) {
-  const std::string key = info.fiber != nullptr ? info.fiber->key : std::string{};
+  const std::string key = info.fiber != nullptr ? info.fiber->getKey() : std::string{};
   std::cerr << "[HydrationWarning] Fiber key: " << key << " - " << info.message << std::endl;
 }
 
@@ -2,6 +2,7 @@
 
 #include "ReactDOM/client/ReactDOMComponent.h"
 #include "ReactReconciler/ReactFiberWorkLoopState.h"
+#include "ReactRuntime/ReactHostMutationBuffer.h"
 
 #include "jsi/jsi.h"
 
@@ -15,6 +16,17 @@ public:
     HostInterface() = default;
     virtual ~HostInterface() = default;
 
+  // Handle-returning factories; the shared_ptr overloads below are views
+  // over the same refcounted instances
+  ReactDOMInstanceRef createHostInstanceRef(
+      facebook::jsi::Runtime& runtime,
+      const std::string& type,
+      const facebook::jsi::Object& props);
+
+  ReactDOMInstanceRef createHostTextInstanceRef(
+      facebook::jsi::Runtime& runtime,
+      const std::string& text);
+
   std::shared_ptr<ReactDOMInstance> createHostInstance(
       facebook::jsi::Runtime& runtime,
       const std::string& type,
@@ -24,35 +36,49 @@ public:
       facebook::jsi::Runtime& runtime,
       const std::string& text);
 
+  // shared_ptr arguments convert to a handle without allocating
   void appendHostChild(
-      std::shared_ptr<ReactDOMInstance> parent,
-      std::shared_ptr<ReactDOMInstance> child);
+      const ReactDOMInstanceRef& parent,
+      const ReactDOMInstanceRef& child);
 
   void insertHostChildBefore(
-      std::shared_ptr<ReactDOMInstance> parent,
-      std::shared_ptr<ReactDOMInstance> child,
-      std::shared_ptr<ReactDOMInstance> beforeChild);
+      const ReactDOMInstanceRef& parent,
+      const ReactDOMInstanceRef& child,
+      const ReactDOMInstanceRef& beforeChild);
 
   void removeHostChild(
-      std::shared_ptr<ReactDOMInstance> parent,
-      std::shared_ptr<ReactDOMInstance> child);
+      const ReactDOMInstanceRef& parent,
+      const ReactDOMInstanceRef& child);
 
   void commitHostUpdate(
       facebook::jsi::Runtime& runtime,
-      std::shared_ptr<ReactDOMInstance> instance,
+      const ReactDOMInstanceRef& instance,
       const facebook::jsi::Object& oldProps,
       const facebook::jsi::Object& newProps,
       const facebook::jsi::Object& payload);
 
+  void commitHostPropUpdate(
+      const ReactDOMInstanceRef& instance,
+      const PropUpdatePayload& payload);
+
   void commitHostTextUpdate(
-      std::shared_ptr<ReactDOMInstance> instance,
+      const ReactDOMInstanceRef& instance,
       const std::string& oldText,
       const std::string& newText);
 
+  // Replays a recorded commit in order, in one pass
+  void applyMutations(const HostMutationBuffer& buffer);
+
         virtual void handleHydrationError(const HydrationErrorInfo& info);
 
 private:
-  void detachFromParent(const std::shared_ptr<ReactDOMInstance>& child);
+  void eraseChild(ReactDOMComponent& parent, ReactDOMInstance& child);
+  // Moves `child` in front of `beforeChild`, or to the end when it is null or
+  // not a child of `parent`
+  void insertChild(
+      ReactDOMComponent& parent,
+      const ReactDOMInstanceRef& child,
+      const ReactDOMInstance* beforeChild);
 };
 
 } // namespace react
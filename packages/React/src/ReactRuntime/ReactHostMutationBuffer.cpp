@@ -0,0 +1,270 @@
+#include "ReactRuntime/ReactHostMutationBuffer.h"
+
+#include "ReactDOM/client/ReactDOMComponent.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace react {
+
+namespace {
+
+std::uint64_t nextEpoch() {
+  static std::atomic<std::uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+template <typename T>
+void writeRaw(std::vector<std::uint8_t>& bytes, T value) {
+  const std::size_t offset = bytes.size();
+  bytes.resize(offset + sizeof(T));
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T readRaw(const std::vector<std::uint8_t>& bytes, std::size_t& offset) {
+  T value;
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+
+void writeString(std::vector<std::uint8_t>& bytes, std::string_view text) {
+  writeRaw(bytes, static_cast<std::uint32_t>(text.size()));
+  bytes.insert(bytes.end(), text.begin(), text.end());
+}
+
+void writePropOperation(
+    std::vector<std::uint8_t>& bytes,
+    PropUpdatePayload::Op op,
+    PropId id,
+    const PropValue& value) {
+  bytes.push_back(static_cast<std::uint8_t>(op));
+  bytes.push_back(static_cast<std::uint8_t>(op == PropUpdatePayload::Op::Remove ? PropValue::Kind::Undefined : value.kind));
+  writeString(bytes, propNameString(id));
+  if (op == PropUpdatePayload::Op::Remove) {
+    return;
+  }
+  switch (value.kind) {
+    case PropValue::Kind::Undefined:
+    case PropValue::Kind::Null:
+    case PropValue::Kind::Object:
+      break;
+    case PropValue::Kind::Bool:
+      bytes.push_back(value.boolean ? 1 : 0);
+      break;
+    case PropValue::Kind::Number:
+      writeRaw(bytes, value.number);
+      break;
+    case PropValue::Kind::String:
+      writeString(bytes, value.string);
+      break;
+  }
+}
+
+void writeSnapshot(std::vector<std::uint8_t>& bytes, const PropSnapshot& props) {
+  writeRaw(bytes, static_cast<std::uint32_t>(props.size()));
+  for (const PropSnapshot::Entry& entry : props.entries()) {
+    writePropOperation(bytes, PropUpdatePayload::Op::Set, entry.id, entry.value);
+  }
+}
+
+void writePayload(std::vector<std::uint8_t>& bytes, const PropUpdatePayload& payload) {
+  writeRaw(bytes, static_cast<std::uint32_t>(payload.operationCount()));
+  PropUpdatePayload::Operation operation;
+  const std::size_t end = payload.bytes().size();
+  for (std::size_t offset = 0; offset < end;) {
+    offset = payload.decode(offset, operation);
+    writePropOperation(bytes, operation.op, operation.id, operation.value);
+  }
+}
+
+} // namespace
+
+HostMutationBuffer::HostMutationBuffer()
+  : epoch_(nextEpoch()) {}
+
+HostInstanceId HostMutationBuffer::idFor(const ReactDOMInstanceRef& instance) {
+  if (!instance) {
+    return 0;
+  }
+  if (instance->mutationBufferEpoch_ != epoch_) {
+    instances_.push_back(instance);
+    instance->mutationBufferEpoch_ = epoch_;
+    instance->mutationBufferId_ = static_cast<HostInstanceId>(instances_.size());
+  }
+  return instance->mutationBufferId_;
+}
+
+void HostMutationBuffer::writeOp(Op op) {
+  bytes_.push_back(static_cast<std::uint8_t>(op));
+  ++commandCount_;
+}
+
+void HostMutationBuffer::writeId(HostInstanceId id) {
+  writeRaw(bytes_, id);
+}
+
+void HostMutationBuffer::writeText(const std::string& text) {
+  writeString(bytes_, text);
+}
+
+void HostMutationBuffer::recordCreate(const ReactDOMInstanceRef& instance, const std::string& type) {
+  const HostInstanceId id = idFor(instance);
+  writeOp(Op::Create);
+  writeId(id);
+  writeText(type);
+  // Copied now: the instance belongs to the renderer's thread, and
+  // serialize() may run on another one
+  writeRaw(bytes_, static_cast<std::uint32_t>(createProps_.size()));
+  const auto* component = dynamic_cast<const ReactDOMComponent*>(instance.get());
+  createProps_.push_back(component ? component->getPropSnapshot() : PropSnapshot());
+}
+
+void HostMutationBuffer::recordCreateText(const ReactDOMInstanceRef& instance, const std::string& text) {
+  const HostInstanceId id = idFor(instance);
+  writeOp(Op::CreateText);
+  writeId(id);
+  writeText(text);
+}
+
+void HostMutationBuffer::recordAppend(
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child) {
+  const HostInstanceId parentId = idFor(parent);
+  const HostInstanceId childId = idFor(child);
+  writeOp(Op::Append);
+  writeId(parentId);
+  writeId(childId);
+}
+
+void HostMutationBuffer::recordInsert(
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child,
+    const ReactDOMInstanceRef& before) {
+  const HostInstanceId parentId = idFor(parent);
+  const HostInstanceId childId = idFor(child);
+  const HostInstanceId beforeId = idFor(before);
+  writeOp(Op::Insert);
+  writeId(parentId);
+  writeId(childId);
+  writeId(beforeId);
+}
+
+void HostMutationBuffer::recordRemove(
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child) {
+  const HostInstanceId parentId = idFor(parent);
+  const HostInstanceId childId = idFor(child);
+  writeOp(Op::Remove);
+  writeId(parentId);
+  writeId(childId);
+}
+
+void HostMutationBuffer::recordSetProps(const ReactDOMInstanceRef& instance, PropUpdatePayload payload) {
+  const HostInstanceId id = idFor(instance);
+  writeOp(Op::SetProps);
+  writeId(id);
+  writeRaw(bytes_, static_cast<std::uint32_t>(payloads_.size()));
+  payloads_.push_back(std::move(payload));
+}
+
+void HostMutationBuffer::recordReplaceProps(
+    const ReactDOMInstanceRef& instance,
+    PropUpdatePayload payload) {
+  const HostInstanceId id = idFor(instance);
+  writeOp(Op::ReplaceProps);
+  writeId(id);
+  writeRaw(bytes_, static_cast<std::uint32_t>(payloads_.size()));
+  payloads_.push_back(std::move(payload));
+}
+
+void HostMutationBuffer::recordSetText(const ReactDOMInstanceRef& instance, const std::string& text) {
+  const HostInstanceId id = idFor(instance);
+  writeOp(Op::SetText);
+  writeId(id);
+  writeText(text);
+}
+
+std::size_t HostMutationBuffer::decode(std::size_t offset, Command& out) const {
+  out = Command{};
+  out.op = static_cast<Op>(bytes_[offset++]);
+  out.target = readRaw<HostInstanceId>(bytes_, offset);
+  switch (out.op) {
+    case Op::Create:
+    case Op::CreateText:
+    case Op::SetText: {
+      const auto length = readRaw<std::uint32_t>(bytes_, offset);
+      out.text = std::string_view(reinterpret_cast<const char*>(bytes_.data() + offset), length);
+      offset += length;
+      if (out.op == Op::Create) {
+        out.props = readRaw<std::uint32_t>(bytes_, offset);
+      }
+      break;
+    }
+    case Op::Insert:
+      out.child = readRaw<HostInstanceId>(bytes_, offset);
+      out.before = readRaw<HostInstanceId>(bytes_, offset);
+      break;
+    case Op::Append:
+    case Op::Remove:
+      out.child = readRaw<HostInstanceId>(bytes_, offset);
+      break;
+    case Op::SetProps:
+    case Op::ReplaceProps:
+      out.payload = readRaw<std::uint32_t>(bytes_, offset);
+      break;
+  }
+  return offset;
+}
+
+std::vector<std::uint8_t> HostMutationBuffer::serialize() const {
+  // Layout: u32 command count, then per command the opcode and ids as in
+  // bytes(), strings as u32 length + UTF-8, and props as a u32 count of
+  // (op u8, kind u8, name, value) records
+  std::vector<std::uint8_t> out;
+  out.reserve(bytes_.size() + sizeof(std::uint32_t));
+  writeRaw(out, static_cast<std::uint32_t>(commandCount_));
+
+  Command command;
+  for (std::size_t offset = 0; offset < bytes_.size();) {
+    offset = decode(offset, command);
+    out.push_back(static_cast<std::uint8_t>(command.op));
+    writeRaw(out, command.target);
+    switch (command.op) {
+      case Op::Create: {
+        writeString(out, command.text);
+        writeSnapshot(out, createProps_[command.props]);
+        break;
+      }
+      case Op::CreateText:
+      case Op::SetText:
+        writeString(out, command.text);
+        break;
+      case Op::Insert:
+        writeRaw(out, command.child);
+        writeRaw(out, command.before);
+        break;
+      case Op::Append:
+      case Op::Remove:
+        writeRaw(out, command.child);
+        break;
+      case Op::SetProps:
+      case Op::ReplaceProps:
+        writePayload(out, payloads_[command.payload]);
+        break;
+    }
+  }
+  return out;
+}
+
+void HostMutationBuffer::clear() {
+  bytes_.clear();
+  instances_.clear();
+  epoch_ = nextEpoch();
+  payloads_.clear();
+  createProps_.clear();
+  commandCount_ = 0;
+}
+
+} // namespace react
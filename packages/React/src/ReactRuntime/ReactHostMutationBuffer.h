@@ -0,0 +1,129 @@
+#pragma once
+
+#include "ReactDOM/client/ReactDOMInstance.h"
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace react {
+
+// Index of an instance within one HostMutationBuffer; 0 means none
+using HostInstanceId = std::uint32_t;
+
+/**
+ * Host mutations recorded during a commit, for the host to apply in one pass
+ *
+ * Commands are packed back to back: a one-byte opcode, then 32-bit instance
+ * ids, then for creates and text updates a 32-bit length and the UTF-8
+ * bytes, and for prop updates a 32-bit index into the buffer's payload
+ * table. Creates also carry a 32-bit index into the table of the props the
+ * instance was created with, copied when the command is recorded. Instances get an id the first time a command names them, stored
+ * on the instance under the buffer's epoch, and the buffer keeps them alive
+ * until it is cleared. Those handles are not thread-safe, so the buffer is
+ * cleared and destroyed on the renderer's thread; serialize() is what
+ * crosses to another one.
+ *
+ * Instances are still created when the reconciler asks for them, since it
+ * needs the handle; the Create commands tell a renderer on the other side
+ * of serialize() to build its own copy.
+ */
+class HostMutationBuffer {
+public:
+  enum class Op : std::uint8_t {
+    Create,       // target, type, props
+    CreateText,   // target, text
+    Append,       // target = parent, child
+    Insert,       // target = parent, child, before
+    Remove,       // target = parent, child
+    SetProps,     // target, payload applied as a diff
+    ReplaceProps, // target, payload holding every prop
+    SetText,      // target, text
+  };
+
+  struct Command {
+    Op op{Op::Create};
+    HostInstanceId target{0};
+    HostInstanceId child{0};
+    HostInstanceId before{0};
+    // Points into the buffer; valid until it is next modified
+    std::string_view text{};
+    std::uint32_t payload{0};
+    std::uint32_t props{0};
+  };
+
+  HostMutationBuffer();
+
+  void recordCreate(const ReactDOMInstanceRef& instance, const std::string& type);
+  void recordCreateText(const ReactDOMInstanceRef& instance, const std::string& text);
+  void recordAppend(const ReactDOMInstanceRef& parent, const ReactDOMInstanceRef& child);
+  void recordInsert(
+      const ReactDOMInstanceRef& parent,
+      const ReactDOMInstanceRef& child,
+      const ReactDOMInstanceRef& before);
+  void recordRemove(const ReactDOMInstanceRef& parent, const ReactDOMInstanceRef& child);
+  void recordSetProps(const ReactDOMInstanceRef& instance, PropUpdatePayload payload);
+  void recordReplaceProps(const ReactDOMInstanceRef& instance, PropUpdatePayload payload);
+  void recordSetText(const ReactDOMInstanceRef& instance, const std::string& text);
+
+  // Decodes the command at `offset` into `out` and returns the offset of the
+  // next one; iteration ends at bytes().size()
+  std::size_t decode(std::size_t offset, Command& out) const;
+
+  const ReactDOMInstanceRef& instance(HostInstanceId id) const {
+    return instances_[id - 1];
+  }
+
+  const PropUpdatePayload& payload(std::uint32_t index) const {
+    return payloads_[index];
+  }
+
+  // Props a Create command's instance was created with
+  const PropSnapshot& createProps(std::uint32_t index) const {
+    return createProps_[index];
+  }
+
+  // Self-contained copy for a renderer on another thread or in another
+  // process. Prop ids become names and JS object values are sent as their
+  // kind only. Reads nothing but the buffer, so it may run while the
+  // recorded instances change on their own thread.
+  std::vector<std::uint8_t> serialize() const;
+
+  void clear();
+
+  bool empty() const {
+    return commandCount_ == 0;
+  }
+
+  std::size_t commandCount() const {
+    return commandCount_;
+  }
+
+  std::size_t instanceCount() const {
+    return instances_.size();
+  }
+
+  const std::vector<std::uint8_t>& bytes() const {
+    return bytes_;
+  }
+
+private:
+  HostInstanceId idFor(const ReactDOMInstanceRef& instance);
+  void writeOp(Op op);
+  void writeId(HostInstanceId id);
+  void writeText(const std::string& text);
+
+  std::vector<std::uint8_t> bytes_{};
+  std::vector<ReactDOMInstanceRef> instances_{};
+  // Unique per buffer and per clear(), so ids left on instances by other
+  // buffers are never mistaken for ours
+  std::uint64_t epoch_{0};
+  std::vector<PropUpdatePayload> payloads_{};
+  std::vector<PropSnapshot> createProps_{};
+  std::size_t commandCount_{0};
+};
+
+} // namespace react
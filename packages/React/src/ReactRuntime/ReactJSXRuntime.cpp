@@ -155,6 +155,9 @@ ReactElementPtr createElement(
   element->type = cloneValue(runtime, type);
   element->props = jsi::Value(runtime, props);
   element->key = std::move(key);
+  if (element->key) {
+    element->keyId = internReactKey(runtime, *element->key);
+  }
   element->ref = std::move(ref);
   element->source = std::move(source);
   element->hasStaticChildren = hasStaticChildren;
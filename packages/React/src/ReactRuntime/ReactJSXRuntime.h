@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReactRuntime/ReactWasmLayout.h"
+#include "shared/ReactKeyTable.h"
 #include "jsi/jsi.h"
 
 #include <memory>
@@ -30,6 +31,8 @@ struct ReactElement {
   jsi::Value type;
   jsi::Value props;
   std::optional<jsi::Value> key;
+  // `key` interned at creation, so reconciliation never reads key strings
+  ReactKey keyId{};
   std::optional<jsi::Value> ref;
   std::optional<SourceLocation> source;
   bool hasStaticChildren{false};
@@ -1,18 +1,24 @@
 #include "jsi/jsi.h"
 #include "ReactRuntime.h"
 #include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
+#include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberWorkLoop.h"
 #include "ReactReconciler/ReactHostConfig.h"
 #include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactHostMutationBuffer.h"
 #include "ReactRuntime/ReactWasmBridge.h"
 #include "ReactRuntime/ReactWasmLayout.h"
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerWorkerPool.h"
 
 #include <algorithm>
-#include <chrono>
 #include <cmath>
+#include <exception>
 #include <iterator>
-#include <limits>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -23,25 +29,6 @@ using facebook::jsi::Object;
 using facebook::jsi::Runtime;
 using facebook::jsi::Value;
 
-int priorityOrder(react::SchedulerPriority priority) {
-  using react::SchedulerPriority;
-  switch (priority) {
-    case SchedulerPriority::ImmediatePriority:
-      return 0;
-    case SchedulerPriority::UserBlockingPriority:
-      return 1;
-    case SchedulerPriority::NormalPriority:
-      return 2;
-    case SchedulerPriority::LowPriority:
-      return 3;
-    case SchedulerPriority::IdlePriority:
-      return 4;
-    case SchedulerPriority::NoPriority:
-    default:
-      return 5;
-  }
-}
-
 std::string numberToString(double value) {
   if (std::isnan(value) || !std::isfinite(value)) {
     return std::string{};
@@ -129,12 +116,12 @@ struct ElementExtraction {
   std::string type;
   std::string key;
   Object propsObject;
-  std::unordered_map<std::string, Value> propsMap;
+  react::PropSnapshot props;
   Value children;
 };
 
 ElementExtraction extractElement(Runtime& rt, const Object& element) {
-  ElementExtraction extraction{std::string{}, std::string{}, Object(rt), std::unordered_map<std::string, Value>{}, Value::undefined()};
+  ElementExtraction extraction{std::string{}, std::string{}, Object(rt), react::PropSnapshot{}, Value::undefined()};
 
   Value typeValue = element.getProperty(rt, "type");
   if (!typeValue.isString()) {
@@ -166,104 +153,33 @@ ElementExtraction extractElement(Runtime& rt, const Object& element) {
       }
 
       extraction.propsObject.setProperty(rt, propName.c_str(), propEntry);
-      extraction.propsMap.emplace(propName, Value(rt, propEntry));
+      extraction.props.set(react::internPropName(propName), react::PropValue::fromJsi(rt, propEntry));
     }
   }
 
   return extraction;
 }
 
-Object createPropsObject(Runtime& rt, const std::unordered_map<std::string, Value>& propsMap) {
-  Object props(rt);
-  for (const auto& entry : propsMap) {
-    props.setProperty(rt, entry.first.c_str(), Value(rt, entry.second));
-  }
-  return props;
-}
-
-bool valuesEqual(Runtime& rt, const Value& a, const Value& b) {
-  if (a.isUndefined() && b.isUndefined()) {
-    return true;
-  }
-  if (a.isNull() && b.isNull()) {
-    return true;
-  }
-  if (a.isBool() && b.isBool()) {
-    return a.getBool() == b.getBool();
-  }
-  if (a.isNumber() && b.isNumber()) {
-    return a.getNumber() == b.getNumber();
-  }
-  if (a.isString() && b.isString()) {
-    return a.getString(rt).utf8(rt) == b.getString(rt).utf8(rt);
-  }
-  return false;
-}
-
-bool computeUpdatePayload(
-    Runtime& rt,
-    const std::unordered_map<std::string, Value>& prevProps,
-    const std::unordered_map<std::string, Value>& nextProps,
-    Object& payload) {
-  bool hasChanges = false;
-
-  Object attributes(rt);
-  bool hasAttributeChanges = false;
-
-  for (const auto& [key, nextValue] : nextProps) {
-    auto it = prevProps.find(key);
-    if (it == prevProps.end() || !valuesEqual(rt, it->second, nextValue)) {
-      attributes.setProperty(rt, key.c_str(), Value(rt, nextValue));
-      hasAttributeChanges = true;
-      hasChanges = true;
-    }
-  }
-
-  if (hasAttributeChanges) {
-    payload.setProperty(rt, "attributes", attributes);
-  }
-
-  std::vector<std::string> removedKeys;
-  removedKeys.reserve(prevProps.size());
-  for (const auto& [key, prevValue] : prevProps) {
-    (void)prevValue;
-    if (nextProps.find(key) == nextProps.end()) {
-      removedKeys.push_back(key);
-    }
-  }
-
-  if (!removedKeys.empty()) {
-    Array removedArray(rt, removedKeys.size());
-    for (size_t i = 0; i < removedKeys.size(); ++i) {
-      removedArray.setValueAtIndex(rt, i, facebook::jsi::String::createFromUtf8(rt, removedKeys[i]));
-    }
-    payload.setProperty(rt, "removedAttributes", removedArray);
-    hasChanges = true;
-  }
-
-  return hasChanges;
-}
-
 void reconcileChildren(
     react::ReactRuntime& runtime,
     Runtime& rt,
-    const std::shared_ptr<react::ReactDOMInstance>& parent,
+    const react::ReactDOMInstanceRef& parent,
     const Value& childrenValue);
 
-std::shared_ptr<react::ReactDOMInstance> mountElement(
+react::ReactDOMInstanceRef mountElement(
     react::ReactRuntime& runtime,
     Runtime& rt,
     const ElementExtraction& extraction,
-    const std::shared_ptr<react::ReactDOMInstance>& existing) {
+    const react::ReactDOMInstanceRef& existing) {
   if (extraction.type.empty()) {
     return nullptr;
   }
 
-  std::shared_ptr<react::ReactDOMInstance> instance = existing;
-  auto existingComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(existing);
+  react::ReactDOMInstanceRef instance = existing;
+  auto existingComponent = react::dynamicRefCast<react::ReactDOMComponent>(existing);
 
   if (!instance || !existingComponent || existingComponent->getType() != extraction.type) {
-    instance = runtime.createInstance(rt, extraction.type, extraction.propsObject);
+    instance = runtime.createInstanceRef(rt, extraction.type, extraction.propsObject);
     instance->setKey(extraction.key);
     reconcileChildren(runtime, rt, instance, extraction.children);
     return instance;
@@ -271,11 +187,9 @@ std::shared_ptr<react::ReactDOMInstance> mountElement(
 
   instance->setKey(extraction.key);
 
-  const auto& previousProps = existingComponent->getProps();
-  Object payload(rt);
-  if (computeUpdatePayload(rt, previousProps, extraction.propsMap, payload)) {
-  Object oldProps = createPropsObject(rt, previousProps);
-  runtime.commitUpdate(rt, instance, oldProps, extraction.propsObject, payload);
+  react::PropUpdatePayload payload;
+  if (react::diffPropSnapshots(rt, existingComponent->getPropSnapshot(), extraction.props, payload)) {
+    runtime.commitPropUpdate(instance, payload);
   }
 
   reconcileChildren(runtime, rt, instance, extraction.children);
@@ -284,17 +198,18 @@ std::shared_ptr<react::ReactDOMInstance> mountElement(
 
 void removeAllChildren(
     react::ReactRuntime& runtime,
-    const std::shared_ptr<react::ReactDOMInstance>& parent) {
+    const react::ReactDOMInstanceRef& parent) {
   if (!parent) {
     return;
   }
 
-  auto component = std::dynamic_pointer_cast<react::ReactDOMComponent>(parent);
+  auto component = react::dynamicRefCast<react::ReactDOMComponent>(parent);
   if (!component) {
     return;
   }
 
-  auto existingChildren = component->children;
+  const std::vector<react::ReactDOMInstanceRef> existingChildren(
+      component->children.begin(), component->children.end());
   for (const auto& child : existingChildren) {
     runtime.removeChild(parent, child);
   }
@@ -303,9 +218,9 @@ void removeAllChildren(
 void reconcileChildren(
     react::ReactRuntime& runtime,
     Runtime& rt,
-    const std::shared_ptr<react::ReactDOMInstance>& parent,
+    const react::ReactDOMInstanceRef& parent,
     const Value& childrenValue) {
-  auto parentComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(parent);
+  auto parentComponent = react::dynamicRefCast<react::ReactDOMComponent>(parent);
   if (!parentComponent || parentComponent->isTextInstance()) {
     return;
   }
@@ -313,12 +228,12 @@ void reconcileChildren(
   std::vector<Value> desiredValues;
   collectChildValues(rt, childrenValue, desiredValues);
 
-  std::unordered_map<std::string, std::shared_ptr<react::ReactDOMInstance>> keyedExisting;
-  std::vector<std::shared_ptr<react::ReactDOMInstance>> unkeyedElements;
-  std::vector<std::shared_ptr<react::ReactDOMInstance>> unkeyedText;
+  std::unordered_map<std::string, react::ReactDOMInstanceRef> keyedExisting;
+  std::vector<react::ReactDOMInstanceRef> unkeyedElements;
+  std::vector<react::ReactDOMInstanceRef> unkeyedText;
 
   for (const auto& child : parentComponent->children) {
-    auto component = std::dynamic_pointer_cast<react::ReactDOMComponent>(child);
+    auto component = react::dynamicRefCast<react::ReactDOMComponent>(child);
     if (!component) {
       continue;
     }
@@ -337,7 +252,7 @@ void reconcileChildren(
   }
 
   struct DesiredChild {
-    std::shared_ptr<react::ReactDOMInstance> instance;
+    react::ReactDOMInstanceRef instance;
   };
 
   std::vector<DesiredChild> desiredChildren;
@@ -346,20 +261,20 @@ void reconcileChildren(
   for (const auto& childValue : desiredValues) {
     if (childValue.isString() || childValue.isNumber()) {
       const std::string text = valueToString(rt, childValue);
-      std::shared_ptr<react::ReactDOMInstance> existingText;
+      react::ReactDOMInstanceRef existingText;
       if (!unkeyedText.empty()) {
         existingText = unkeyedText.front();
         unkeyedText.erase(unkeyedText.begin());
       }
 
       if (existingText) {
-        auto textComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(existingText);
+        auto textComponent = react::dynamicRefCast<react::ReactDOMComponent>(existingText);
         if (textComponent && textComponent->getTextContent() != text) {
           runtime.commitTextUpdate(existingText, textComponent->getTextContent(), text);
         }
         desiredChildren.push_back({existingText});
       } else {
-        auto textInstance = runtime.createTextInstance(rt, text);
+        auto textInstance = runtime.createTextInstanceRef(rt, text);
         desiredChildren.push_back({textInstance});
       }
       continue;
@@ -375,7 +290,7 @@ void reconcileChildren(
     }
 
     ElementExtraction extraction = extractElement(rt, childObject);
-    std::shared_ptr<react::ReactDOMInstance> existingMatch;
+    react::ReactDOMInstanceRef existingMatch;
 
     if (!extraction.key.empty()) {
       auto keyedIt = keyedExisting.find(extraction.key);
@@ -389,8 +304,8 @@ void reconcileChildren(
       auto matchIt = std::find_if(
           unkeyedElements.begin(),
           unkeyedElements.end(),
-          [&](const std::shared_ptr<react::ReactDOMInstance>& candidate) {
-            auto candidateComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(candidate);
+          [&](const react::ReactDOMInstanceRef& candidate) {
+            auto candidateComponent = react::dynamicRefCast<react::ReactDOMComponent>(candidate);
             return candidateComponent && !candidateComponent->isTextInstance() && candidateComponent->getType() == extraction.type;
           });
       if (matchIt != unkeyedElements.end()) {
@@ -406,14 +321,29 @@ void reconcileChildren(
   }
 
   // Remove any remaining children that were not reused.
-  for (auto& [_, child] : keyedExisting) {
+  std::unordered_set<const react::ReactDOMInstance*> removed;
+  auto removeLeftover = [&](const react::ReactDOMInstanceRef& child) {
+    removed.insert(child.get());
     runtime.removeChild(parent, child);
+  };
+  for (auto& [_, child] : keyedExisting) {
+    removeLeftover(child);
   }
   for (auto& child : unkeyedElements) {
-    runtime.removeChild(parent, child);
+    removeLeftover(child);
   }
   for (auto& child : unkeyedText) {
-    runtime.removeChild(parent, child);
+    removeLeftover(child);
+  }
+
+  // Track the parent's children locally rather than reading them back after
+  // each move, so this also works when the host applies mutations later
+  std::vector<react::ReactDOMInstanceRef> currentChildren;
+  currentChildren.reserve(parentComponent->children.size() + desiredChildren.size());
+  for (const auto& child : parentComponent->children) {
+    if (removed.count(child.get()) == 0) {
+      currentChildren.push_back(child);
+    }
   }
 
   for (size_t index = 0; index < desiredChildren.size(); ++index) {
@@ -423,30 +353,35 @@ void reconcileChildren(
       continue;
     }
 
-    auto currentChildren = parentComponent->children;
-    std::shared_ptr<react::ReactDOMInstance> beforeChild;
+    react::ReactDOMInstanceRef beforeChild;
     if (index < currentChildren.size()) {
       beforeChild = currentChildren[index];
     }
 
-    auto attachedParent = child->getParent();
-    const bool isAttachedToParent = attachedParent && attachedParent.get() == parent.get();
+    const bool isAttachedToParent = child->parent() == parent.get();
 
     if (!isAttachedToParent) {
       if (beforeChild) {
         runtime.insertBefore(parent, child, beforeChild);
+        currentChildren.insert(currentChildren.begin() + static_cast<std::ptrdiff_t>(index), child);
       } else {
         runtime.appendChild(parent, child);
+        currentChildren.push_back(child);
       }
       continue;
     }
 
-    currentChildren = parentComponent->children;
-    if (index < currentChildren.size() && currentChildren[index].get() == child.get()) {
+    if (beforeChild.get() == child.get()) {
       continue;
     }
 
     runtime.insertBefore(parent, child, beforeChild);
+    auto previous = std::find(
+        currentChildren.begin() + static_cast<std::ptrdiff_t>(index), currentChildren.end(), child);
+    if (previous != currentChildren.end()) {
+      currentChildren.erase(previous);
+    }
+    currentChildren.insert(currentChildren.begin() + static_cast<std::ptrdiff_t>(index), child);
   }
 }
 
@@ -454,7 +389,8 @@ void reconcileChildren(
 
 namespace react {
 
-ReactRuntime::ReactRuntime() = default;
+ReactRuntime::ReactRuntime()
+  : scheduler_(std::make_shared<ReactScheduler>()) {}
 
 WorkLoopState& ReactRuntime::workLoopState() {
   return workLoopState_;
@@ -545,10 +481,15 @@ void ReactRuntime::renderRootSync(
     return;
   }
 
+  // Off-thread serialization reads instance props; let it finish before the
+  // host tree changes
+  joinOffloadedWork();
+
   bindHostInterface(runtime);
   registerRootContainer(rootContainer);
+  const ReactDOMInstanceRef root(rootContainer);
   if (rootElementOffset == 0 || __wasm_memory_buffer == nullptr) {
-    removeAllChildren(*this, rootContainer);
+    removeAllChildren(*this, root);
     return;
   }
 
@@ -557,7 +498,7 @@ void ReactRuntime::renderRootSync(
   rootValue.data.ptrValue = rootElementOffset;
 
   Value rootElement = convertWasmLayoutToJsi(runtime, 0, rootValue);
-  reconcileChildren(*this, runtime, rootContainer, rootElement);
+  reconcileChildren(*this, runtime, root, rootElement);
 }
 
 void ReactRuntime::hydrateRoot(
@@ -567,65 +508,54 @@ void ReactRuntime::hydrateRoot(
   renderRootSync(runtime, rootElementOffset, std::move(rootContainer));
 }
 
+void ReactRuntime::setScheduler(std::shared_ptr<Scheduler> scheduler) {
+  scheduler_ = scheduler ? std::move(scheduler) : std::make_shared<ReactScheduler>();
+}
+
+Scheduler& ReactRuntime::scheduler() {
+  return *scheduler_;
+}
+
+const Scheduler& ReactRuntime::scheduler() const {
+  return *scheduler_;
+}
+
+std::shared_ptr<Scheduler> ReactRuntime::sharedScheduler() const {
+  return scheduler_;
+}
+
 TaskHandle ReactRuntime::scheduleTask(
   SchedulerPriority priority,
   Task task,
   const TaskOptions& options) {
-  SchedulerPriority effectivePriority = priority == SchedulerPriority::NoPriority ? SchedulerPriority::NormalPriority : priority;
-  TaskHandle handle{nextTaskId_++};
-  const double currentTime = now();
-  const double readyTime = currentTime + std::max(0.0, options.delayMs);
-  double timeoutTime = std::numeric_limits<double>::infinity();
-  if (options.timeoutMs > 0.0 && std::isfinite(options.timeoutMs)) {
-    timeoutTime = readyTime + options.timeoutMs;
-  }
-
-  ScheduledTask scheduled{
-      handle,
-      effectivePriority,
-      std::move(task),
-      readyTime,
-      timeoutTime,
-      false};
-
-  taskQueue_.push_back(std::move(scheduled));
-
-  return handle;
+  const SchedulerPriority effectivePriority =
+      priority == SchedulerPriority::NoPriority ? SchedulerPriority::NormalPriority : priority;
+  return scheduler_->scheduleTask(effectivePriority, std::move(task), options);
 }
 
 void ReactRuntime::cancelTask(TaskHandle handle) {
-  for (auto& entry : taskQueue_) {
-    if (entry.handle == handle) {
-      entry.cancelled = true;
-      entry.task = nullptr;
-      break;
-    }
-  }
+  scheduler_->cancelTask(handle);
 }
 
 SchedulerPriority ReactRuntime::getCurrentPriorityLevel() const {
-  return currentPriority_;
+  return scheduler_->getCurrentPriorityLevel();
 }
 
 SchedulerPriority ReactRuntime::runWithPriority(
   SchedulerPriority priority,
   const std::function<void()>& fn) {
-  const auto previous = currentPriority_;
-  currentPriority_ = priority;
-  if (fn) {
-    fn();
+  if (!fn) {
+    return scheduler_->getCurrentPriorityLevel();
   }
-  currentPriority_ = previous;
-  return previous;
+  return scheduler_->runWithPriority(priority, fn);
 }
 
 bool ReactRuntime::shouldYield() const {
-  return false;
+  return scheduler_->shouldYield();
 }
 
 double ReactRuntime::now() const {
-  const auto steadyNow = std::chrono::steady_clock::now().time_since_epoch();
-  return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(steadyNow).count();
+  return scheduler_->now();
 }
 
 std::shared_ptr<HostInterface> ReactRuntime::ensureHostInterface() {
@@ -635,100 +565,243 @@ std::shared_ptr<HostInterface> ReactRuntime::ensureHostInterface() {
   return hostInterface_;
 }
 
+ReactDOMInstanceRef ReactRuntime::createInstanceRef(
+    facebook::jsi::Runtime& runtime,
+    const std::string& type,
+    const facebook::jsi::Object& props) {
+  auto instance = ensureHostInterface()->createHostInstanceRef(runtime, type, props);
+  if (recordedMutations_) {
+    recordedMutations_->recordCreate(instance, type);
+  }
+  return instance;
+}
+
+ReactDOMInstanceRef ReactRuntime::createTextInstanceRef(
+    facebook::jsi::Runtime& runtime,
+    const std::string& text) {
+  auto instance = ensureHostInterface()->createHostTextInstanceRef(runtime, text);
+  if (recordedMutations_) {
+    recordedMutations_->recordCreateText(instance, text);
+  }
+  return instance;
+}
+
 std::shared_ptr<ReactDOMInstance> ReactRuntime::createInstance(
     facebook::jsi::Runtime& runtime,
     const std::string& type,
     const facebook::jsi::Object& props) {
-  return ensureHostInterface()->createHostInstance(runtime, type, props);
+  return createInstanceRef(runtime, type, props).share();
 }
 
 std::shared_ptr<ReactDOMInstance> ReactRuntime::createTextInstance(
     facebook::jsi::Runtime& runtime,
     const std::string& text) {
-  return ensureHostInterface()->createHostTextInstance(runtime, text);
+  return createTextInstanceRef(runtime, text).share();
 }
 
 void ReactRuntime::appendChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child) {
-  ensureHostInterface()->appendHostChild(std::move(parent), std::move(child));
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child) {
+  if (recordedMutations_) {
+    recordedMutations_->recordAppend(parent, child);
+    return;
+  }
+  ensureHostInterface()->appendHostChild(parent, child);
 }
 
 void ReactRuntime::removeChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child) {
-  ensureHostInterface()->removeHostChild(std::move(parent), std::move(child));
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child) {
+  if (recordedMutations_) {
+    recordedMutations_->recordRemove(parent, child);
+    return;
+  }
+  ensureHostInterface()->removeHostChild(parent, child);
 }
 
 void ReactRuntime::insertBefore(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child,
-    std::shared_ptr<ReactDOMInstance> beforeChild) {
-  ensureHostInterface()->insertHostChildBefore(std::move(parent), std::move(child), std::move(beforeChild));
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child,
+    const ReactDOMInstanceRef& beforeChild) {
+  if (recordedMutations_) {
+    recordedMutations_->recordInsert(parent, child, beforeChild);
+    return;
+  }
+  ensureHostInterface()->insertHostChildBefore(parent, child, beforeChild);
 }
 
 void ReactRuntime::commitUpdate(
     facebook::jsi::Runtime& runtime,
-    std::shared_ptr<ReactDOMInstance> instance,
+    const ReactDOMInstanceRef& instance,
     const facebook::jsi::Object& oldProps,
     const facebook::jsi::Object& newProps,
     const facebook::jsi::Object& payload) {
-  ensureHostInterface()->commitHostUpdate(runtime, std::move(instance), oldProps, newProps, payload);
+  if (recordedMutations_) {
+    // The host replaces the props wholesale, so record all of them rather
+    // than a diff against a snapshot that earlier commands may still change
+    const PropSnapshot nextProps = PropSnapshot::fromObject(runtime, newProps);
+    PropUpdatePayload allProps;
+    for (const PropSnapshot::Entry& entry : nextProps.entries()) {
+      allProps.appendSet(entry.id, entry.value);
+    }
+    recordedMutations_->recordReplaceProps(instance, std::move(allProps));
+    return;
+  }
+  ensureHostInterface()->commitHostUpdate(runtime, instance, oldProps, newProps, payload);
+}
+
+void ReactRuntime::commitPropUpdate(
+    const ReactDOMInstanceRef& instance,
+    const PropUpdatePayload& payload) {
+  if (recordedMutations_) {
+    recordedMutations_->recordSetProps(instance, payload);
+    return;
+  }
+  ensureHostInterface()->commitHostPropUpdate(instance, payload);
 }
 
 void ReactRuntime::commitTextUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
+    const ReactDOMInstanceRef& instance,
     const std::string& oldText,
     const std::string& newText) {
-  ensureHostInterface()->commitHostTextUpdate(std::move(instance), oldText, newText);
+  if (recordedMutations_) {
+    recordedMutations_->recordSetText(instance, newText);
+    return;
+  }
+  ensureHostInterface()->commitHostTextUpdate(instance, oldText, newText);
 }
 
-void ReactRuntime::flushAllTasksForTest() {
-  double currentTime = now();
+void ReactRuntime::beginRecordingMutations() {
+  if (!recordedMutations_) {
+    recordedMutations_ = std::make_shared<HostMutationBuffer>();
+  }
+}
 
-  while (true) {
-    auto bestIt = taskQueue_.end();
-    for (auto it = taskQueue_.begin(); it != taskQueue_.end(); ++it) {
-      if (it->cancelled || !it->task) {
-        continue;
-      }
+bool ReactRuntime::isRecordingMutations() const {
+  return recordedMutations_ != nullptr;
+}
 
-      if (bestIt == taskQueue_.end() ||
-          it->readyTime < bestIt->readyTime ||
-          (it->readyTime == bestIt->readyTime && priorityOrder(it->priority) < priorityOrder(bestIt->priority)) ||
-          (it->readyTime == bestIt->readyTime &&
-           priorityOrder(it->priority) == priorityOrder(bestIt->priority) &&
-           it->handle.id < bestIt->handle.id)) {
-        bestIt = it;
-      }
-    }
+void ReactRuntime::flushRecordedMutations() {
+  auto buffer = takeRecordedMutations();
+  if (buffer && !buffer->empty()) {
+    ensureHostInterface()->applyMutations(*buffer);
+  }
+}
 
-    if (bestIt == taskQueue_.end()) {
-      taskQueue_.erase(
-          std::remove_if(
-              taskQueue_.begin(),
-              taskQueue_.end(),
-              [](const ScheduledTask& entry) {
-                return entry.cancelled || !entry.task;
-              }),
-          taskQueue_.end());
-      break;
-    }
+std::shared_ptr<HostMutationBuffer> ReactRuntime::takeRecordedMutations() {
+  return std::exchange(recordedMutations_, nullptr);
+}
 
-    ScheduledTask task = std::move(*bestIt);
-    taskQueue_.erase(bestIt);
+std::future<std::vector<std::uint8_t>> ReactRuntime::serializeRecordedMutations() {
+  auto buffer = takeRecordedMutations();
+  if (!buffer) {
+    buffer = std::make_shared<HostMutationBuffer>();
+  }
+  serializingMutations_.push_back(buffer);
 
-    if (task.readyTime > currentTime) {
-      currentTime = task.readyTime;
+  auto bytes = std::make_shared<std::promise<std::vector<std::uint8_t>>>();
+  std::future<std::vector<std::uint8_t>> result = bytes->get_future();
+  const HostMutationBuffer* source = buffer.get();
+  offload(SchedulerPriority::NormalPriority, [source, bytes]() {
+    try {
+      bytes->set_value(source->serialize());
+    } catch (...) {
+      bytes->set_exception(std::current_exception());
     }
+  });
+  return result;
+}
 
-    const auto previousPriority = currentPriority_;
-    currentPriority_ = task.priority;
-    if (task.task) {
-      task.task();
-    }
-    currentPriority_ = previousPriority;
+bool ReactRuntime::performWorkUntilDeadline() {
+  return scheduler_->performWorkUntilDeadline();
+}
+
+bool ReactRuntime::snapshotSchedulerMetrics(SchedulerMetricsSnapshot& out) const {
+  return scheduler_->snapshotMetrics(out);
+}
+
+void ReactRuntime::setWorkerPool(std::shared_ptr<SchedulerWorkerPool> pool) {
+  if (pool == workerPool_) {
+    return;
+  }
+  if (offloadGroup_) {
+    offloadGroup_->wait();
+    offloadGroup_.reset();
+  }
+  serializingMutations_.clear();
+  workerPool_ = std::move(pool);
+}
+
+SchedulerWorkerPool& ReactRuntime::workerPool() {
+  if (!workerPool_) {
+    workerPool_ = std::make_shared<SchedulerWorkerPool>();
+  }
+  return *workerPool_;
+}
+
+FiberRootPool& ReactRuntime::rootPool() {
+  return rootPool_;
+}
+
+const FiberRootPool& ReactRuntime::rootPool() const {
+  return rootPool_;
+}
+
+std::unique_ptr<FiberRoot> ReactRuntime::createFiberRoot(RootTag tag, bool isStrictMode, void* containerInfo) {
+  return rootPool_.acquire(tag, isStrictMode, containerInfo);
+}
+
+void ReactRuntime::unmountFiberRoot(std::unique_ptr<FiberRoot> root) {
+  if (!root) {
+    return;
+  }
+  if (root->callbackNode) {
+    cancelTask(root->callbackNode);
+    root->callbackNode = {};
+  }
+  if (root->cancelPendingCommit) {
+    auto cancel = std::move(root->cancelPendingCommit);
+    root->cancelPendingCommit = nullptr;
+    cancel();
   }
+
+  auto& state = workLoopState_;
+  if (state.workInProgressRoot == root.get()) {
+    resetWorkInProgressStack(*this);
+    state.workInProgressRoot = nullptr;
+  }
+  if (state.rootWithNestedUpdates == root.get()) {
+    state.rootWithNestedUpdates = nullptr;
+  }
+  if (state.rootWithPassiveNestedUpdates == root.get()) {
+    state.rootWithPassiveNestedUpdates = nullptr;
+  }
+
+  rootPool_.release(std::move(root));
+}
+
+void ReactRuntime::offload(SchedulerPriority priority, std::function<void()> fn) {
+  if (!offloadGroup_) {
+    offloadGroup_ = std::make_shared<SchedulerWorkGroup>(workerPool());
+  }
+  offloadGroup_->run(priority, std::move(fn));
+}
+
+void ReactRuntime::joinOffloadedWork() {
+  if (!offloadGroup_) {
+    return;
+  }
+  try {
+    offloadGroup_->wait();
+  } catch (...) {
+    serializingMutations_.clear();
+    throw;
+  }
+  serializingMutations_.clear();
+}
+
+void ReactRuntime::flushAllTasksForTest() {
+  scheduler_->flushAllTasks();
 }
 
 std::vector<HydrationErrorInfo> ReactRuntime::drainHydrationErrors() {
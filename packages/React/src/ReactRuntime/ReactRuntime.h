@@ -1,12 +1,15 @@
 #pragma once
 
+#include "ReactDOM/client/ReactDOMInstance.h"
 #include "ReactReconciler/ReactFiberAsyncAction.h"
+#include "ReactReconciler/ReactFiberRootPool.h"
 #include "ReactReconciler/ReactFiberRootSchedulerState.h"
 #include "ReactReconciler/ReactFiberWorkLoopState.h"
 #include "scheduler/Scheduler.h"
 
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <typeinfo>
 #include <unordered_map>
@@ -23,7 +26,10 @@ class Value;
 namespace react {
 
 class HostInterface;
-class ReactDOMInstance;
+class HostMutationBuffer;
+class PropUpdatePayload;
+class SchedulerWorkGroup;
+class SchedulerWorkerPool;
 struct FiberRoot;
 struct FiberNode;
 struct Hook;
@@ -96,6 +102,14 @@ public:
 
   [[nodiscard]] std::size_t getRegisteredRootCount() const;
 
+  // Task scheduling is delegated to a pluggable Scheduler backend. Passing
+  // nullptr restores the default ReactScheduler.
+  void setScheduler(std::shared_ptr<Scheduler> scheduler);
+  Scheduler& scheduler();
+  const Scheduler& scheduler() const;
+  // For event loops that drive the backend and must outlive a setScheduler
+  [[nodiscard]] std::shared_ptr<Scheduler> sharedScheduler() const;
+
   TaskHandle scheduleTask(
     SchedulerPriority priority,
     Task task,
@@ -113,6 +127,17 @@ public:
 
   [[nodiscard]] double now() const;
 
+  // Handle-returning factories; the shared_ptr overloads below are views
+  // over the same refcounted instances
+  ReactDOMInstanceRef createInstanceRef(
+    facebook::jsi::Runtime& runtime,
+    const std::string& type,
+    const facebook::jsi::Object& props);
+
+  ReactDOMInstanceRef createTextInstanceRef(
+    facebook::jsi::Runtime& runtime,
+    const std::string& text);
+
   std::shared_ptr<ReactDOMInstance> createInstance(
     facebook::jsi::Runtime& runtime,
     const std::string& type,
@@ -123,30 +148,82 @@ public:
     const std::string& text);
 
   void appendChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child);
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child);
 
   void removeChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child);
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child);
 
   void insertBefore(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child,
-    std::shared_ptr<ReactDOMInstance> beforeChild);
+    const ReactDOMInstanceRef& parent,
+    const ReactDOMInstanceRef& child,
+    const ReactDOMInstanceRef& beforeChild);
 
   void commitUpdate(
     facebook::jsi::Runtime& runtime,
-    std::shared_ptr<ReactDOMInstance> instance,
+    const ReactDOMInstanceRef& instance,
     const facebook::jsi::Object& oldProps,
     const facebook::jsi::Object& newProps,
     const facebook::jsi::Object& payload);
 
+  void commitPropUpdate(
+    const ReactDOMInstanceRef& instance,
+    const PropUpdatePayload& payload);
+
   void commitTextUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
+    const ReactDOMInstanceRef& instance,
     const std::string& oldText,
     const std::string& newText);
 
+  // Batched commit mode. While recording, the mutation and update calls above
+  // are written to a command buffer instead of reaching the host; instances
+  // are still created on demand and their creation is recorded too.
+  void beginRecordingMutations();
+  [[nodiscard]] bool isRecordingMutations() const;
+  // Stops recording and applies everything recorded to the host in one pass
+  void flushRecordedMutations();
+  // Stops recording and hands over the commands, e.g. to serialize them for a
+  // renderer on another thread
+  std::shared_ptr<HostMutationBuffer> takeRecordedMutations();
+  // Stops recording and serializes the commands on the worker pool. The
+  // buffer stays with the runtime until the next join, because its instance
+  // handles may only be released on this thread. The worker reads only the
+  // buffer, which copied each created instance's props when recording, so
+  // the instances may be updated while it runs.
+  std::future<std::vector<std::uint8_t>> serializeRecordedMutations();
+
+  // Runs scheduled work for one time slice. Hosts call this while it returns
+  // true, e.g. from their event loop.
+  bool performWorkUntilDeadline();
+
+  // Copies the scheduler backend's per-priority latency metrics. Returns false
+  // when the backend does not record them.
+  bool snapshotSchedulerMetrics(SchedulerMetricsSnapshot& out) const;
+
+  // Background pool for work that does not touch the JS runtime. Created on
+  // first use; several runtimes can share one pool via setWorkerPool.
+  // Passing nullptr drops the current pool after joining its offloaded work.
+  void setWorkerPool(std::shared_ptr<SchedulerWorkerPool> pool);
+  SchedulerWorkerPool& workerPool();
+
+  // Recycled FiberRoots for hosts that create a root per request
+  FiberRootPool& rootPool();
+  const FiberRootPool& rootPool() const;
+
+  // Creates a root whose fibers live in its own arena, drawing on the pool.
+  // Hand it back to unmountFiberRoot, which frees its fibers in bulk.
+  std::unique_ptr<FiberRoot> createFiberRoot(RootTag tag, bool isStrictMode, void* containerInfo);
+  // Cancels the root's scheduled work, abandons an in-progress render of it
+  // and returns it to the pool. The root must not be mid-commit.
+  void unmountFiberRoot(std::unique_ptr<FiberRoot> root);
+
+  // Runs fn on the worker pool. Everything offloaded is joined before the
+  // next commit (or explicitly with joinOffloadedWork), which also rethrows
+  // the first exception a job threw.
+  void offload(SchedulerPriority priority, std::function<void()> fn);
+  void joinOffloadedWork();
+
   void flushAllTasksForTest();
 
   std::vector<HydrationErrorInfo> drainHydrationErrors();
@@ -156,26 +233,23 @@ private:
   void dispatchHydrationError(const HydrationErrorInfo& info);
   void registerRootContainer(const std::shared_ptr<ReactDOMInstance>& rootContainer);
 
-  struct ScheduledTask {
-    TaskHandle handle;
-    SchedulerPriority priority;
-    Task task;
-    double readyTime{0.0};
-    double timeoutTime{0.0};
-    bool cancelled{false};
-  };
-
   std::shared_ptr<HostInterface> hostInterface_{};
+  // Set while recording mutations
+  std::shared_ptr<HostMutationBuffer> recordedMutations_{};
   std::function<void(const HydrationErrorInfo&)> hydrationErrorCallback_{};
   WorkLoopState workLoopState_{};
   RootSchedulerState rootSchedulerState_{};
   AsyncActionState asyncActionState_{};
   HookRuntimeState hookState_{};
-  SchedulerPriority currentPriority_{SchedulerPriority::NormalPriority};
-  std::uint64_t nextTaskId_{1};
+  std::shared_ptr<Scheduler> scheduler_{};
+  // Buffers being serialized off-thread; outlives offloadGroup_'s join
+  std::vector<std::shared_ptr<HostMutationBuffer>> serializingMutations_{};
+  std::shared_ptr<SchedulerWorkerPool> workerPool_{};
+  // Declared after the pool so it is joined before the pool goes away
+  std::shared_ptr<SchedulerWorkGroup> offloadGroup_{};
+  FiberRootPool rootPool_{};
   std::function<bool()> shouldAttemptEagerTransitionCallback_{};
   std::unordered_map<const ReactDOMInstance*, std::weak_ptr<ReactDOMInstance>> registeredRoots_{};
-  std::vector<ScheduledTask> taskQueue_{};
 };
 
 namespace ReactRuntimeTestHelper {
@@ -4,8 +4,12 @@
 
 namespace react {
 
-ReactScheduler::ReactScheduler() 
+ReactScheduler::ReactScheduler(SchedulerTimerQueue timerQueue)
   : baseTime_(std::chrono::steady_clock::now()) {
+  slice_.configure(SchedulerSliceConfig{}, frameInterval_);
+  if (timerQueue == SchedulerTimerQueue::TimerWheel) {
+    timerWheel_ = std::make_unique<SchedulerTimerWheel>(1.0, now());
+  }
 }
 
 TaskHandle ReactScheduler::scheduleTask(
@@ -29,23 +33,16 @@ TaskHandle ReactScheduler::scheduleTask(
   
   const double expirationTime = startTime + timeout;
   
-  // Wrap the task to match expected callback signature
-  auto wrappedCallback = [task = std::move(task)](bool didTimeout) -> std::function<void(bool)> {
-    (void)didTimeout; // didTimeout is handled by scheduler logic
-    task();
-    return nullptr; // No continuation by default
-  };
-  
-  SchedulerTask* newTask = createTask(priority, std::move(wrappedCallback), startTime, expirationTime);
+  SchedulerTask* newTask = createTask(priority, std::move(task), startTime, expirationTime);
   
   if (startTime > currentTime) {
     // This is a delayed task - add to timer queue
+    const double previousFirstTimer = nextTimerTime();
     newTask->sortIndex = startTime;
-    newTask->HeapNode::sortIndex = startTime;
-    timerQueue_.push(newTask);
+    pushTimer(newTask);
     
     // If this is the earliest timer and no callback is scheduled, set up timeout
-    if (taskQueue_.empty() && newTask == timerQueue_.peek()) {
+    if (taskQueue_.empty() && (previousFirstTimer < 0.0 || startTime < previousFirstTimer)) {
       if (isHostTimeoutScheduled_) {
         cancelHostTimeout();
       }
@@ -54,9 +51,7 @@ TaskHandle ReactScheduler::scheduleTask(
   } else {
     // Immediate task - add to task queue
     newTask->sortIndex = expirationTime;
-    newTask->HeapNode::sortIndex = expirationTime;
-    taskQueue_.push(newTask);
-    newTask->isQueued = true;
+    enqueueTask(newTask);
     
     // Schedule host callback if needed
     if (!isHostCallbackScheduled_ && !isPerformingWork_) {
@@ -64,7 +59,7 @@ TaskHandle ReactScheduler::scheduleTask(
     }
   }
   
-  return TaskHandle{newTask->id};
+  return newTask->handle;
 }
 
 void ReactScheduler::cancelTask(TaskHandle handle) {
@@ -72,14 +67,26 @@ void ReactScheduler::cancelTask(TaskHandle handle) {
     return;
   }
   
-  // Find and null out the callback to mark as cancelled
-  // We can't remove from heap efficiently, so we just mark as cancelled
-  for (auto& taskPtr : taskStorage_) {
-    if (taskPtr && taskPtr->id == handle.id) {
-      taskPtr->callback = nullptr;
-      taskPtr->isQueued = false;
-      break;
-    }
+  // Stale handles (finished or already cancelled tasks) resolve to nullptr
+  SchedulerTask* task = taskPool_.get(handle);
+  if (task == nullptr) {
+    return;
+  }
+  
+  // Remove the task from whichever queue holds it using its tracked heap index
+  task->callback = nullptr;
+  if (metrics_) {
+    metrics_->recordCancel(task->priorityLevel);
+  }
+  if (task->isQueued) {
+    dequeueTask(task);
+  } else {
+    removeTimer(task);
+  }
+  
+  // The running task is reclaimed by workLoop once its callback returns
+  if (task != currentTask_) {
+    taskPool_.release(task);
   }
 }
 
@@ -112,6 +119,7 @@ SchedulerPriority ReactScheduler::runWithPriority(
 
 bool ReactScheduler::shouldYield() const {
   if (needsPaint_) {
+    slice_.noteYield(SchedulerYieldReason::Paint, 0.0);
     return true;
   }
   
@@ -119,8 +127,28 @@ bool ReactScheduler::shouldYield() const {
     return false;
   }
   
-  const double timeElapsed = now() - startTime_;
-  return timeElapsed >= frameInterval_;
+  slice_.recordUnit();
+  if (!yieldSampler_.shouldSample()) {
+    return false;
+  }
+  
+  const double timeElapsed = yieldClock_.nowMs() - sliceClockStart_;
+  const double budget = slice_.budget();
+  yieldSampler_.onSample(sliceClockStart_ + timeElapsed, budget - timeElapsed);
+  if (timeElapsed >= budget) {
+    slice_.noteYield(SchedulerYieldReason::Budget, timeElapsed - budget);
+    return true;
+  }
+  
+  // Adaptive slices give way early to input work queued behind a lower
+  // priority render, once the minimum slice has run
+  const SchedulerSliceConfig& config = slice_.config();
+  if (config.adaptive && timeElapsed >= config.minSliceMs &&
+      isLowerPriority(currentPriorityLevel_, SchedulerPriority::UserBlockingPriority) && hasInputPending()) {
+    slice_.noteYield(SchedulerYieldReason::Input, 0.0);
+    return true;
+  }
+  return false;
 }
 
 double ReactScheduler::now() const {
@@ -139,12 +167,74 @@ void ReactScheduler::forceFrameRate(double fps) {
   } else {
     frameInterval_ = 5.0; // Reset to default 5ms
   }
+  slice_.configure(slice_.config(), frameInterval_);
 }
 
 void ReactScheduler::requestPaint() {
   needsPaint_ = true;
 }
 
+void ReactScheduler::setSliceConfig(const SchedulerSliceConfig& config) {
+  slice_.configure(config, frameInterval_);
+}
+
+const SchedulerSliceConfig& ReactScheduler::sliceConfig() const {
+  return slice_.config();
+}
+
+const SchedulerSliceStats& ReactScheduler::sliceStats() const {
+  return slice_.stats();
+}
+
+void ReactScheduler::resetSliceStats() {
+  slice_.resetStats();
+  yieldSampler_.resetStats();
+}
+
+void ReactScheduler::setYieldCheckConfig(const SchedulerYieldCheckConfig& config) {
+  yieldCheckConfig_ = config;
+  yieldClock_ = SchedulerClock(config.clock);
+  yieldSampler_.configure(config);
+}
+
+const SchedulerYieldCheckConfig& ReactScheduler::yieldCheckConfig() const {
+  return yieldCheckConfig_;
+}
+
+const SchedulerYieldSampler::Stats& ReactScheduler::yieldCheckStats() const {
+  return yieldSampler_.stats();
+}
+
+SchedulerClockSource ReactScheduler::yieldClockSource() const {
+  return yieldClock_.source();
+}
+
+void ReactScheduler::setMetricsEnabled(bool enabled) {
+  if (!enabled) {
+    metrics_.reset();
+  } else if (!metrics_) {
+    metrics_ = std::make_unique<SchedulerMetrics>();
+  }
+}
+
+bool ReactScheduler::metricsEnabled() const {
+  return metrics_ != nullptr;
+}
+
+void ReactScheduler::resetMetrics() {
+  if (metrics_) {
+    metrics_->reset();
+  }
+}
+
+bool ReactScheduler::snapshotMetrics(SchedulerMetricsSnapshot& out) const {
+  if (!metrics_) {
+    return false;
+  }
+  out = metrics_->data();
+  return true;
+}
+
 bool ReactScheduler::flushWork(double initialTime) {
   // Reset host callback state
   isHostCallbackScheduled_ = false;
@@ -176,23 +266,25 @@ bool ReactScheduler::flushWork(double initialTime) {
 }
 
 void ReactScheduler::advanceTimers(double currentTime) {
-  // Move expired timers to task queue
-  SchedulerTask* timer = timerQueue_.peek();
-  while (timer != nullptr) {
-    if (timer->callback == nullptr) {
-      // Timer was cancelled
-      timerQueue_.pop();
-    } else if (timer->startTime <= currentTime) {
-      // Timer fired - move to task queue
-      timerQueue_.pop();
-      timer->sortIndex = timer->expirationTime;
-      timer->HeapNode::sortIndex = timer->expirationTime;
-      taskQueue_.push(timer);
-      timer->isQueued = true;
-    } else {
-      // Remaining timers are not ready
-      break;
+  // Move expired timers to task queue. Cancelled timers were already removed.
+  if (timerWheel_) {
+    // The wheel hands back every due timer at once; queue them in one batch
+    expiredTimers_.clear();
+    timerWheel_->advance(currentTime, expiredTimers_);
+    for (SchedulerTask* expired : expiredTimers_) {
+      expired->sortIndex = expired->expirationTime;
+      expired->isQueued = true;
+      ++queuedByPriority_[static_cast<size_t>(expired->priorityLevel)];
     }
+    taskQueue_.pushAll(expiredTimers_.begin(), expiredTimers_.end());
+    return;
+  }
+  
+  SchedulerTask* timer = timerQueue_.peek();
+  while (timer != nullptr && timer->startTime <= currentTime) {
+    timerQueue_.pop();
+    timer->sortIndex = timer->expirationTime;
+    enqueueTask(timer);
     timer = timerQueue_.peek();
   }
 }
@@ -208,38 +300,28 @@ bool ReactScheduler::workLoop(double initialTime) {
       break;
     }
     
-    if (currentTask_->callback) {
-      // Execute the task
-      currentTask_->callback = nullptr; // Clear callback before execution
-      currentPriorityLevel_ = currentTask_->priorityLevel;
-      
-      const bool didUserCallbackTimeout = currentTask_->expirationTime <= currentTime;
-      
-      // Execute callback and check for continuation
-      auto continuationCallback = currentTask_->callback 
-        ? currentTask_->callback(didUserCallbackTimeout) 
-        : nullptr;
-        
+    SchedulerTask* task = currentTask_;
+    // Clear callback before execution so re-entrant flushes skip this task
+    Task callback = std::move(task->callback);
+    task->callback = nullptr;
+    
+    if (callback) {
+      // Execute the task. Continuations are driven by the caller (see the root
+      // scheduler), so a task always completes here.
+      currentPriorityLevel_ = task->priorityLevel;
+      const double runStart = currentTime;
+      callback();
       currentTime = now();
-      
-      if (continuationCallback) {
-        // Task yielded with continuation
-        currentTask_->callback = [continuationCallback](bool timeout) -> std::function<void(bool)> {
-          continuationCallback(timeout);
-          return nullptr;
-        };
-        advanceTimers(currentTime);
-        return true; // Has more work
-      } else {
-        // Task completed
-        if (currentTask_ == taskQueue_.peek()) {
-          taskQueue_.pop();
-        }
-        advanceTimers(currentTime);
+      if (metrics_) {
+        metrics_->recordRun(task->priorityLevel, task->startTime, task->expirationTime, runStart, currentTime);
       }
+      
+      // Task completed (or cancelled itself while running)
+      finishTask(task);
+      advanceTimers(currentTime);
     } else {
-      // Task was cancelled
-      taskQueue_.pop();
+      // Task has no callback left (e.g. a previous run threw)
+      finishTask(task);
     }
     
     currentTask_ = taskQueue_.peek();
@@ -250,9 +332,9 @@ bool ReactScheduler::workLoop(double initialTime) {
     return true;
   } else {
     // Schedule timeout for next timer if needed
-    SchedulerTask* firstTimer = timerQueue_.peek();
-    if (firstTimer != nullptr) {
-      scheduleHostTimeout(firstTimer->startTime - currentTime);
+    const double firstTimer = nextTimerTime();
+    if (firstTimer >= 0.0) {
+      scheduleHostTimeout(firstTimer - currentTime);
     }
     return false;
   }
@@ -260,26 +342,19 @@ bool ReactScheduler::workLoop(double initialTime) {
 
 SchedulerTask* ReactScheduler::createTask(
     SchedulerPriority priority,
-    Task task,
+    Task callback,
     double startTime,
     double expirationTime) {
   
-  const uint64_t taskId = nextTaskId_++;
+  SchedulerTask* task = taskPool_.acquire();
+  task->id = nextTaskId_++;
+  task->callback = std::move(callback);
+  task->priorityLevel = isValidPriority(priority) ? priority : SchedulerPriority::NormalPriority;
+  task->startTime = startTime;
+  task->expirationTime = expirationTime;
+  task->sortIndex = expirationTime; // Default to expiration time for immediate tasks
   
-  // Convert Task to SchedulerTask::Callback
-  auto callback = [task = std::move(task)](bool didTimeout) -> std::function<void(bool)> {
-    (void)didTimeout;
-    task();
-    return nullptr; // No continuation
-  };
-  
-  auto taskPtr = std::make_unique<SchedulerTask>(
-    taskId, std::move(callback), priority, startTime, expirationTime);
-  
-  SchedulerTask* rawPtr = taskPtr.get();
-  taskStorage_.push_back(std::move(taskPtr));
-  
-  return rawPtr;
+  return task;
 }
 
 double ReactScheduler::priorityTimeout(SchedulerPriority priority) const {
@@ -288,8 +363,12 @@ double ReactScheduler::priorityTimeout(SchedulerPriority priority) const {
 
 void ReactScheduler::scheduleHostCallback() {
   isHostCallbackScheduled_ = true;
-  // In a real implementation, this would integrate with the event loop
-  // For now, we'll mark that a callback is needed
+  // The host drives the loop by calling performWorkUntilDeadline while it
+  // returns true
+  isMessageLoopRunning_ = true;
+  if (host_ != nullptr) {
+    host_->requestHostCallback();
+  }
 }
 
 void ReactScheduler::cancelHostCallback() {
@@ -298,13 +377,35 @@ void ReactScheduler::cancelHostCallback() {
 
 void ReactScheduler::scheduleHostTimeout(double delay) {
   isHostTimeoutScheduled_ = true;
-  // In a real implementation, this would set up a timer
-  // For now, we'll just mark that a timeout is scheduled
-  (void)delay;
+  if (host_ != nullptr) {
+    host_->requestHostTimeout(std::max(delay, 0.0));
+  }
 }
 
 void ReactScheduler::cancelHostTimeout() {
   isHostTimeoutScheduled_ = false;
+  if (host_ != nullptr) {
+    host_->cancelHostTimeout();
+  }
+}
+
+void ReactScheduler::setHost(SchedulerHost* host) {
+  host_ = host;
+  if (host_ == nullptr) {
+    return;
+  }
+  // Hand over work that was queued before the host attached
+  if (isMessageLoopRunning_) {
+    host_->requestHostCallback();
+  }
+  const double firstTimer = nextTimerTime();
+  if (firstTimer >= 0.0) {
+    scheduleHostTimeout(firstTimer - now());
+  }
+}
+
+SchedulerHost* ReactScheduler::host() const {
+  return host_;
 }
 
 void ReactScheduler::handleTimeout(double currentTime) {
@@ -315,9 +416,9 @@ void ReactScheduler::handleTimeout(double currentTime) {
     if (taskQueue_.peek() != nullptr) {
       scheduleHostCallback();
     } else {
-      SchedulerTask* firstTimer = timerQueue_.peek();
-      if (firstTimer != nullptr) {
-        scheduleHostTimeout(firstTimer->startTime - currentTime);
+      const double firstTimer = nextTimerTime();
+      if (firstTimer >= 0.0) {
+        scheduleHostTimeout(firstTimer - currentTime);
       }
     }
   }
@@ -332,21 +433,40 @@ void ReactScheduler::stopMessageLoop() {
 }
 
 bool ReactScheduler::performWorkUntilDeadline() {
+  const double currentTime = now();
+  
+  // Delayed tasks that came due since the last slice restart the loop
+  if (isHostTimeoutScheduled_ && !isHostCallbackScheduled_) {
+    const double firstTimer = nextTimerTime();
+    if (firstTimer >= 0.0 && firstTimer <= currentTime) {
+      handleTimeout(currentTime);
+    } else if (firstTimer >= 0.0 && !isMessageLoopRunning_) {
+      // Woken before the timer is due (the timer wheel reports slot
+      // boundaries); ask the host to wait again
+      scheduleHostTimeout(firstTimer - currentTime);
+    }
+  }
+  
   if (!isMessageLoopRunning_) {
     return false;
   }
   
+  slice_.beginSlice(hasInputPending(), needsPaint_);
   needsPaint_ = false;
-  const double currentTime = now();
   startTime_ = currentTime;
+  sliceClockStart_ = yieldClock_.nowMs();
+  yieldSampler_.beginSlice(sliceClockStart_);
   
-  bool hasMoreWork = false;
+  // If a task throws, the error propagates to the host while the loop stays
+  // running so remaining work is picked up by the next call
+  bool hasMoreWork = true;
   try {
     hasMoreWork = flushWork(currentTime);
   } catch (...) {
-    // If work throws, we still have more work to do
-    hasMoreWork = true;
+    slice_.endSlice(now() - currentTime, true);
+    throw;
   }
+  slice_.endSlice(now() - currentTime, hasMoreWork);
   
   if (hasMoreWork) {
     // Schedule next work iteration
@@ -357,12 +477,111 @@ bool ReactScheduler::performWorkUntilDeadline() {
   }
 }
 
-void ReactScheduler::removeTaskFromStorage(uint64_t taskId) {
-  auto it = std::remove_if(taskStorage_.begin(), taskStorage_.end(),
-    [taskId](const std::unique_ptr<SchedulerTask>& task) {
-      return task && task->id == taskId;
-    });
-  taskStorage_.erase(it, taskStorage_.end());
+size_t ReactScheduler::pendingTaskCount() const {
+  return taskQueue_.size();
+}
+
+size_t ReactScheduler::pendingTaskCount(SchedulerPriority priority) const {
+  return isValidPriority(priority) ? queuedByPriority_[static_cast<size_t>(priority)] : 0;
+}
+
+size_t ReactScheduler::pendingTimerCount() const {
+  return timerWheel_ ? timerWheel_->size() : timerQueue_.size();
+}
+
+SchedulerTimerQueue ReactScheduler::timerQueueKind() const {
+  return timerWheel_ ? SchedulerTimerQueue::TimerWheel : SchedulerTimerQueue::MinHeap;
+}
+
+void ReactScheduler::pushTimer(SchedulerTask* task) {
+  if (timerWheel_) {
+    timerWheel_->insert(task);
+  } else {
+    timerQueue_.push(task);
+  }
+}
+
+void ReactScheduler::removeTimer(SchedulerTask* task) {
+  if (timerWheel_) {
+    timerWheel_->remove(task);
+  } else {
+    timerQueue_.remove(task);
+  }
+}
+
+double ReactScheduler::nextTimerTime() const {
+  // The wheel may report a slot boundary earlier than the real start time;
+  // callers only use this to decide when to look again
+  if (timerWheel_) {
+    return timerWheel_->nextExpiryTime();
+  }
+  SchedulerTask* firstTimer = timerQueue_.peek();
+  return firstTimer != nullptr ? firstTimer->startTime : -1.0;
+}
+
+void ReactScheduler::enqueueTask(SchedulerTask* task) {
+  taskQueue_.push(task);
+  task->isQueued = true;
+  ++queuedByPriority_[static_cast<size_t>(task->priorityLevel)];
+}
+
+void ReactScheduler::dequeueTask(SchedulerTask* task) {
+  if (taskQueue_.remove(task)) {
+    --queuedByPriority_[static_cast<size_t>(task->priorityLevel)];
+  }
+  task->isQueued = false;
+}
+
+bool ReactScheduler::hasInputPending() const {
+  return queuedByPriority_[static_cast<size_t>(SchedulerPriority::ImmediatePriority)] != 0 ||
+      queuedByPriority_[static_cast<size_t>(SchedulerPriority::UserBlockingPriority)] != 0;
+}
+
+void ReactScheduler::finishTask(SchedulerTask* task) {
+  dequeueTask(task);
+  if (task == currentTask_) {
+    currentTask_ = nullptr;
+  }
+  taskPool_.release(task);
+}
+
+const SchedulerTaskPool::Stats& ReactScheduler::taskPoolStats() const {
+  return taskPool_.stats();
+}
+
+void ReactScheduler::flushAllTasks() {
+  if (isPerformingWork_) {
+    return;
+  }
+  
+  // Run without time slicing; restore the host's slice state afterwards
+  const double previousStartTime = startTime_;
+  startTime_ = -1.0;
+  
+  try {
+    while (true) {
+      needsPaint_ = false;
+      double currentTime = now();
+      if (taskQueue_.empty()) {
+        const double firstTimer = nextTimerTime();
+        if (firstTimer < 0.0) {
+          break;
+        }
+        // Treat the earliest delay as elapsed
+        currentTime = std::max(currentTime, firstTimer);
+        advanceTimers(currentTime);
+      }
+      flushWork(currentTime);
+    }
+  } catch (...) {
+    startTime_ = previousStartTime;
+    throw;
+  }
+  
+  startTime_ = previousStartTime;
+  isHostCallbackScheduled_ = false;
+  cancelHostTimeout();
+  isMessageLoopRunning_ = false;
 }
 
 } // namespace react
\ No newline at end of file
@@ -2,52 +2,50 @@
 
 #include "ReactScheduler/Scheduler.h"
 #include "ReactScheduler/SchedulerPriorities.h"
-#include "ReactScheduler/SchedulerMinHeap.h"
+#include "ReactScheduler/SchedulerIndexedMinHeap.h"
+#include "ReactScheduler/SchedulerMetrics.h"
+#include "ReactScheduler/SchedulerTaskPool.h"
+#include "ReactScheduler/SchedulerTimeSlice.h"
+#include "ReactScheduler/SchedulerTimerWheel.h"
+#include <array>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <vector>
-#include <functional>
 
 namespace react {
 
 /**
- * Internal task representation for the scheduler
- * Implements HeapNode interface for use with SchedulerMinHeap
+ * Backing structure for delayed tasks
+ * MinHeap keeps exact startTime order with O(log n) insert/cancel;
+ * TimerWheel trades that for O(1) insert/cancel and batched expiry, which
+ * pays off with large numbers of pending timers
  */
-struct SchedulerTask : public HeapNode {
-  using Callback = std::function<std::function<void(bool)>()>;
-  
-  uint64_t id;
-  Callback callback;
-  SchedulerPriority priorityLevel;
-  double startTime;
-  double expirationTime;
-  double sortIndex; // Inherited from HeapNode but explicitly typed
-  bool isQueued{false};
-  
-  SchedulerTask(uint64_t taskId, Callback cb, SchedulerPriority priority, double start, double expiration)
-    : id(taskId), callback(std::move(cb)), priorityLevel(priority), startTime(start), expirationTime(expiration) {
-    this->HeapNode::id = taskId;
-    sortIndex = expiration; // Default to expiration time for immediate tasks
-    this->HeapNode::sortIndex = sortIndex;
-  }
+enum class SchedulerTimerQueue : uint8_t {
+  MinHeap,
+  TimerWheel,
 };
 
 /**
  * Default React Scheduler Implementation
  * 
  * This implementation closely follows the JavaScript Scheduler behavior:
- * - Min-heap based task queue with priority sorting
- * - Separate timer queue for delayed tasks
- * - Time-slicing with configurable frame intervals
+ * - Indexed 4-ary min-heap task queue with priority sorting
+ * - Separate timer queue for delayed tasks (min-heap or hierarchical wheel)
+ * - O(log n) cancellation that removes tasks instead of leaving tombstones
+ * - Slab-pooled task storage with generation-checked handles
+ * - Time-slicing with a fixed frame interval or an adaptive slice budget
  * - Priority-based timeout calculation
  * - Message loop integration for yielding
+ * - Per-priority queue wait / run time histograms and starvation counters
  */
 class ReactScheduler : public Scheduler {
 private:
   // Task queues
-  SchedulerMinHeap<SchedulerTask> taskQueue_;
-  SchedulerMinHeap<SchedulerTask> timerQueue_;
+  SchedulerIndexedMinHeap<SchedulerTask> taskQueue_;
+  SchedulerIndexedMinHeap<SchedulerTask> timerQueue_;
+  std::unique_ptr<SchedulerTimerWheel> timerWheel_;
+  std::vector<SchedulerTask*> expiredTimers_;
   
   // Current state
   uint64_t nextTaskId_{1};
@@ -61,16 +59,35 @@ private:
   bool isMessageLoopRunning_{false};
   bool needsPaint_{false};
   
+  // Per-priority latency metrics; null while disabled
+  std::unique_ptr<SchedulerMetrics> metrics_;
+  
+  // Event loop driving this scheduler, if any
+  SchedulerHost* host_{nullptr};
+  
+  SchedulerYieldCheckConfig yieldCheckConfig_{};
+  
   // Time management
   double frameInterval_{5.0}; // 5ms default frame interval (200 FPS)
   double startTime_{-1.0};
+  
+  // Slice budget policy; shouldYield records units and yield reasons
+  mutable SchedulerSliceController slice_;
+  
+  // Clock used for yield checks, and how often shouldYield reads it
+  SchedulerClock yieldClock_;
+  double sliceClockStart_{0.0};
+  mutable SchedulerYieldSampler yieldSampler_;
+  
+  // Ready tasks per SchedulerPriority, used as input-pressure signal
+  std::array<size_t, 6> queuedByPriority_{};
   std::chrono::steady_clock::time_point baseTime_;
   
-  // Task storage - we need to keep tasks alive
-  std::vector<std::unique_ptr<SchedulerTask>> taskStorage_;
+  // Task storage - slots stay alive until the task finishes or is cancelled
+  SchedulerTaskPool taskPool_;
   
 public:
-  ReactScheduler();
+  explicit ReactScheduler(SchedulerTimerQueue timerQueue = SchedulerTimerQueue::MinHeap);
   ~ReactScheduler() override = default;
 
   // Scheduler interface implementation
@@ -91,22 +108,48 @@ public:
   
   double now() const override;
 
+  bool performWorkUntilDeadline() override;
+  void flushAllTasks() override;
+  void setHost(SchedulerHost* host) override;
+  SchedulerHost* host() const override;
+  bool snapshotMetrics(SchedulerMetricsSnapshot& out) const override;
+
   // Additional Scheduler functionality
   void forceFrameRate(double fps);
   void requestPaint();
+  void setSliceConfig(const SchedulerSliceConfig& config);
+  const SchedulerSliceConfig& sliceConfig() const;
+  const SchedulerSliceStats& sliceStats() const;
+  void resetSliceStats();
+  void setYieldCheckConfig(const SchedulerYieldCheckConfig& config);
+  const SchedulerYieldCheckConfig& yieldCheckConfig() const;
+  const SchedulerYieldSampler::Stats& yieldCheckStats() const;
+  SchedulerClockSource yieldClockSource() const;
+  
+  // Metrics are off by default (the histograms take ~48 KB per scheduler);
+  // disabling drops the collected data
+  void setMetricsEnabled(bool enabled);
+  bool metricsEnabled() const;
+  void resetMetrics();
   bool flushWork(double initialTime);
   void advanceTimers(double currentTime);
   
   // Message loop integration
   void startMessageLoop();
   void stopMessageLoop();
-  bool performWorkUntilDeadline();
+
+  // Introspection
+  size_t pendingTaskCount() const;
+  size_t pendingTaskCount(SchedulerPriority priority) const;
+  size_t pendingTimerCount() const;
+  SchedulerTimerQueue timerQueueKind() const;
+  const SchedulerTaskPool::Stats& taskPoolStats() const;
   
 private:
   // Internal helpers
   SchedulerTask* createTask(
     SchedulerPriority priority,
-    Task task,
+    Task callback,
     double startTime,
     double expirationTime);
     
@@ -117,7 +160,17 @@ private:
   void handleTimeout(double currentTime);
   bool workLoop(double initialTime);
   double priorityTimeout(SchedulerPriority priority) const;
-  void removeTaskFromStorage(uint64_t taskId);
+  void finishTask(SchedulerTask* task);
+
+  // Ready queue bookkeeping
+  void enqueueTask(SchedulerTask* task);
+  void dequeueTask(SchedulerTask* task);
+  bool hasInputPending() const;
+  
+  // Timer queue dispatch (heap or wheel)
+  void pushTimer(SchedulerTask* task);
+  void removeTimer(SchedulerTask* task);
+  double nextTimerTime() const;
 };
 
 } // namespace react
\ No newline at end of file
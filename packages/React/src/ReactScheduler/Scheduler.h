@@ -7,6 +7,8 @@ namespace react {
 
 using Task = std::function<void()>;
 
+struct SchedulerMetricsSnapshot;
+
 enum class SchedulerPriority : uint8_t {
   NoPriority = 0,
   ImmediatePriority = 1,
@@ -37,6 +39,23 @@ struct TaskHandle {
   }
 };
 
+// Host integration points a Scheduler calls when it needs to be driven.
+// Implemented by event loops (see SchedulerEpollLoop); all calls happen on the
+// thread that runs the scheduler.
+class SchedulerHost {
+public:
+  virtual ~SchedulerHost() = default;
+
+  // Ready work is queued; call performWorkUntilDeadline soon.
+  virtual void requestHostCallback() = 0;
+
+  // The earliest delayed task is due in delayMs; call performWorkUntilDeadline
+  // once it has elapsed. Replaces any previously requested timeout.
+  virtual void requestHostTimeout(double delayMs) = 0;
+
+  virtual void cancelHostTimeout() = 0;
+};
+
 class Scheduler {
 public:
   virtual ~Scheduler() = default;
@@ -57,6 +76,36 @@ public:
   virtual bool shouldYield() const = 0;
 
   virtual double now() const = 0;
+
+  // Host integration: runs queued work for one time slice. Returns true while
+  // more work is ready and the host should call again.
+  virtual bool performWorkUntilDeadline() {
+    return false;
+  }
+
+  // Drains every queued and delayed task without yielding. Delayed tasks run
+  // in start-time order as if their delays had elapsed. Intended for tests and
+  // fully synchronous hosts.
+  virtual void flushAllTasks() {}
+
+  // Attaches the event loop that drives this scheduler, or detaches it when
+  // host is nullptr. Schedulers without host integration ignore it.
+  virtual void setHost(SchedulerHost* host) {
+    (void)host;
+  }
+
+  // The attached event loop, or nullptr. A host that detaches itself checks
+  // this first, so it never detaches a host that replaced it.
+  virtual SchedulerHost* host() const {
+    return nullptr;
+  }
+
+  // Copies per-priority latency metrics into out. Returns false when the
+  // backend does not record metrics.
+  virtual bool snapshotMetrics(SchedulerMetricsSnapshot& out) const {
+    (void)out;
+    return false;
+  }
 };
 
 } // namespace react
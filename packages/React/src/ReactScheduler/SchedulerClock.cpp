@@ -0,0 +1,95 @@
+#include "ReactScheduler/SchedulerClock.h"
+
+#include <chrono>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define REACT_SCHEDULER_HAS_TSC 1
+#else
+#define REACT_SCHEDULER_HAS_TSC 0
+#endif
+
+namespace react {
+
+namespace {
+
+double steadyNowMs() {
+  const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(sinceEpoch).count();
+}
+
+#if REACT_SCHEDULER_HAS_TSC
+
+inline uint64_t readTsc() {
+  return __rdtsc();
+}
+
+bool detectInvariantTsc() {
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007u) {
+    return false;
+  }
+  __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+  // CPUID.80000007H:EDX[8] - TSC runs at a constant rate in all C/P-states
+  return (edx & (1u << 8)) != 0;
+}
+
+// Spins for ~2ms the first time the TSC source is requested.
+double calibrateMsPerTick() {
+  constexpr double kCalibrationMs = 2.0;
+  const double startMs = steadyNowMs();
+  const uint64_t startTicks = readTsc();
+  double endMs = startMs;
+  uint64_t endTicks = startTicks;
+  while (endMs - startMs < kCalibrationMs) {
+    endMs = steadyNowMs();
+    endTicks = readTsc();
+  }
+  return endTicks > startTicks ? (endMs - startMs) / static_cast<double>(endTicks - startTicks) : 0.0;
+}
+
+double tscMsPerTick() {
+  static const double msPerTick = detectInvariantTsc() ? calibrateMsPerTick() : 0.0;
+  return msPerTick;
+}
+
+#endif
+
+} // namespace
+
+SchedulerClock::SchedulerClock(SchedulerClockSource requested)
+  : source_(SchedulerClockSource::SteadyClock) {
+#if REACT_SCHEDULER_HAS_TSC
+  if (requested == SchedulerClockSource::Tsc) {
+    msPerTick_ = tscMsPerTick();
+    if (msPerTick_ > 0.0) {
+      source_ = SchedulerClockSource::Tsc;
+    }
+  }
+#else
+  (void)requested;
+#endif
+}
+
+double SchedulerClock::nowMs() const {
+#if REACT_SCHEDULER_HAS_TSC
+  if (source_ == SchedulerClockSource::Tsc) {
+    return static_cast<double>(readTsc()) * msPerTick_;
+  }
+#endif
+  return steadyNowMs();
+}
+
+bool SchedulerClock::isTscAvailable() {
+#if REACT_SCHEDULER_HAS_TSC
+  return tscMsPerTick() > 0.0;
+#else
+  return false;
+#endif
+}
+
+} // namespace react
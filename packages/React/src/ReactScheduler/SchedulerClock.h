@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace react {
+
+enum class SchedulerClockSource : uint8_t {
+  SteadyClock,
+  // Calibrated invariant TSC on x86-64; falls back to SteadyClock elsewhere
+  Tsc,
+};
+
+/**
+ * Monotonic millisecond clock used by shouldYield
+ *
+ * Only differences between readings are meaningful; the epoch is arbitrary
+ * and differs between sources. The TSC source converts raw rdtsc ticks with a
+ * ratio calibrated once per process against steady_clock, and is only used
+ * when the CPU reports an invariant TSC.
+ */
+class SchedulerClock {
+public:
+  explicit SchedulerClock(SchedulerClockSource requested = SchedulerClockSource::SteadyClock);
+
+  // The source actually in use after any fallback
+  SchedulerClockSource source() const {
+    return source_;
+  }
+
+  double nowMs() const;
+
+  static bool isTscAvailable();
+
+private:
+  SchedulerClockSource source_;
+  double msPerTick_{0.0};
+};
+
+} // namespace react
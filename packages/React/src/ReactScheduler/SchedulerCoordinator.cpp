@@ -0,0 +1,608 @@
+#include "ReactScheduler/SchedulerCoordinator.h"
+#include "ReactScheduler/SchedulerPriorities.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace react {
+
+// CoordinatedScheduler
+
+CoordinatedScheduler::CoordinatedScheduler(SchedulerCoordinator* coordinator, uint64_t clientId)
+  : coordinator_(coordinator), clientId_(clientId) {
+}
+
+CoordinatedScheduler::~CoordinatedScheduler() {
+  if (coordinator_ != nullptr) {
+    coordinator_->detachClient(clientId_);
+  }
+}
+
+TaskHandle CoordinatedScheduler::scheduleTask(
+    SchedulerPriority priority,
+    Task task,
+    const TaskOptions& options) {
+  if (coordinator_ == nullptr) {
+    return TaskHandle{};
+  }
+  return coordinator_->scheduleTask(clientId_, priority, std::move(task), options);
+}
+
+void CoordinatedScheduler::cancelTask(TaskHandle handle) {
+  if (coordinator_ != nullptr) {
+    coordinator_->cancelTask(clientId_, handle);
+  }
+}
+
+SchedulerPriority CoordinatedScheduler::getCurrentPriorityLevel() const {
+  return currentPriorityLevel_;
+}
+
+SchedulerPriority CoordinatedScheduler::runWithPriority(
+    SchedulerPriority priority,
+    const std::function<void()>& fn) {
+  if (!isValidPriority(priority)) {
+    priority = SchedulerPriority::NormalPriority;
+  }
+
+  const SchedulerPriority previousPriority = currentPriorityLevel_;
+  currentPriorityLevel_ = priority;
+  try {
+    fn();
+  } catch (...) {
+    currentPriorityLevel_ = previousPriority;
+    throw;
+  }
+  currentPriorityLevel_ = previousPriority;
+  return previousPriority;
+}
+
+bool CoordinatedScheduler::shouldYield() const {
+  return coordinator_ != nullptr && coordinator_->shouldYield();
+}
+
+double CoordinatedScheduler::now() const {
+  return coordinator_ != nullptr ? coordinator_->now() : 0.0;
+}
+
+bool CoordinatedScheduler::performWorkUntilDeadline() {
+  return coordinator_ != nullptr && coordinator_->performWorkUntilDeadline();
+}
+
+void CoordinatedScheduler::flushAllTasks() {
+  if (coordinator_ != nullptr) {
+    coordinator_->flushClient(clientId_);
+  }
+}
+
+void CoordinatedScheduler::setHost(SchedulerHost* host) {
+  if (coordinator_ != nullptr) {
+    coordinator_->setHost(host);
+  }
+}
+
+SchedulerHost* CoordinatedScheduler::host() const {
+  return coordinator_ != nullptr ? coordinator_->host() : nullptr;
+}
+
+// SchedulerCoordinator
+
+namespace {
+
+constexpr uint64_t kClientSlotMask = 0xFFFFFFFFu;
+
+uint64_t makeClientId(uint32_t generation, size_t slot) {
+  return (uint64_t{generation} << 32) | (static_cast<uint64_t>(slot) + 1);
+}
+
+} // namespace
+
+SchedulerCoordinator::SchedulerCoordinator(double quotaWindowMs)
+  : quotaWindowMs_(quotaWindowMs > 0.0 ? quotaWindowMs : 100.0),
+    baseTime_(std::chrono::steady_clock::now()) {
+}
+
+SchedulerCoordinator::~SchedulerCoordinator() {
+  for (const auto& client : clients_) {
+    if (client->facade != nullptr) {
+      client->facade->coordinator_ = nullptr;
+    }
+  }
+}
+
+std::shared_ptr<CoordinatedScheduler> SchedulerCoordinator::createClient(const SchedulerClientOptions& options) {
+  size_t slot = 0;
+  if (!freeClientSlots_.empty()) {
+    slot = freeClientSlots_.back();
+    freeClientSlots_.pop_back();
+    const uint32_t generation = clients_[slot]->generation;
+    clients_[slot] = std::make_unique<Client>();
+    clients_[slot]->generation = generation;
+  } else {
+    slot = clients_.size();
+    clients_.push_back(std::make_unique<Client>());
+  }
+
+  Client& client = *clients_[slot];
+  const uint64_t clientId = makeClientId(client.generation, slot);
+  client.options = options;
+  if (!(client.options.weight > 0.0)) {
+    client.options.weight = 1.0;
+  }
+  client.virtualTime = virtualClock_;
+
+  std::shared_ptr<CoordinatedScheduler> facade(new CoordinatedScheduler(this, clientId));
+  client.facade = facade.get();
+  return facade;
+}
+
+SchedulerCoordinator::Client* SchedulerCoordinator::clientFor(uint64_t clientId) {
+  const uint64_t slot = clientId & kClientSlotMask;
+  if (slot == 0 || slot > clients_.size()) {
+    return nullptr;
+  }
+  Client* client = clients_[slot - 1].get();
+  if (client->facade == nullptr || client->generation != static_cast<uint32_t>(clientId >> 32)) {
+    return nullptr;
+  }
+  return client;
+}
+
+void SchedulerCoordinator::detachClient(uint64_t clientId) {
+  Client* client = clientFor(clientId);
+  if (client == nullptr) {
+    return;
+  }
+
+  releaseQueuedTasks(*client);
+  markIdle(*client);
+  client->facade = nullptr;
+  ++client->generation;
+  freeClientSlots_.push_back(static_cast<uint32_t>((clientId & kClientSlotMask) - 1));
+}
+
+void SchedulerCoordinator::releaseQueuedTasks(Client& client) {
+  while (SchedulerTask* task = client.taskQueue.pop()) {
+    task->isQueued = false;
+    if (task != currentTask_) {
+      taskPool_.release(task);
+    }
+  }
+
+  while (SchedulerTask* task = client.timerQueue.pop()) {
+    taskPool_.release(task);
+  }
+  timerClients_.remove(&client);
+}
+
+TaskHandle SchedulerCoordinator::scheduleTask(
+    uint64_t clientId,
+    SchedulerPriority priority,
+    Task callback,
+    const TaskOptions& options) {
+  Client* client = clientFor(clientId);
+  if (client == nullptr) {
+    return TaskHandle{};
+  }
+
+  const double currentTime = now();
+  const double startTime = options.delayMs > 0.0 ? currentTime + options.delayMs : currentTime;
+  const double timeout = options.timeoutMs > 0.0 ? options.timeoutMs : priorityToTimeout(priority);
+
+  SchedulerTask* task = taskPool_.acquire();
+  task->id = nextTaskId_++;
+  task->callback = std::move(callback);
+  task->priorityLevel = isValidPriority(priority) ? priority : SchedulerPriority::NormalPriority;
+  task->startTime = startTime;
+  task->expirationTime = startTime + timeout;
+  task->ownerId = clientId;
+
+  if (startTime > currentTime) {
+    const double previousFirstStart =
+        timerClients_.empty() ? std::numeric_limits<double>::infinity() : timerClients_.peek()->sortIndex;
+    task->sortIndex = startTime;
+    client->timerQueue.push(task);
+    syncTimerKey(*client);
+    if (startTime < previousFirstStart) {
+      requestHostTimeout(currentTime);
+    }
+  } else {
+    task->sortIndex = task->expirationTime;
+    enqueue(*client, task);
+    requestHostCallback();
+  }
+  return task->handle;
+}
+
+void SchedulerCoordinator::cancelTask(uint64_t clientId, TaskHandle handle) {
+  SchedulerTask* task = taskPool_.get(handle);
+  // A client may only cancel its own tasks
+  if (task == nullptr || task->ownerId != clientId) {
+    return;
+  }
+  Client* client = clientFor(clientId);
+  if (client == nullptr) {
+    return;
+  }
+
+  task->callback = nullptr;
+  if (task->isQueued) {
+    client->taskQueue.remove(task);
+    task->isQueued = false;
+    if (client->taskQueue.empty()) {
+      markIdle(*client);
+    }
+  } else if (client->timerQueue.remove(task)) {
+    syncTimerKey(*client);
+  }
+
+  // The running task is released once its callback returns
+  if (task != currentTask_) {
+    taskPool_.release(task);
+  }
+}
+
+void SchedulerCoordinator::enqueue(Client& client, SchedulerTask* task) {
+  client.taskQueue.push(task);
+  task->isQueued = true;
+  markReady(client);
+}
+
+void SchedulerCoordinator::markReady(Client& client) {
+  if (client.readyIndex != SIZE_MAX) {
+    return;
+  }
+  // A client returning from idle must not bank credit from its quiet period
+  client.virtualTime = std::max(client.virtualTime, virtualClock_);
+  client.readyIndex = readyClients_.size();
+  readyClients_.push_back(&client);
+}
+
+void SchedulerCoordinator::markIdle(Client& client) {
+  if (client.readyIndex == SIZE_MAX) {
+    return;
+  }
+  Client* last = readyClients_.back();
+  readyClients_[client.readyIndex] = last;
+  last->readyIndex = client.readyIndex;
+  readyClients_.pop_back();
+  client.readyIndex = SIZE_MAX;
+}
+
+void SchedulerCoordinator::syncTimerKey(Client& client) {
+  const SchedulerTask* first = client.timerQueue.peek();
+  if (first == nullptr) {
+    timerClients_.remove(&client);
+    return;
+  }
+  client.sortIndex = first->startTime;
+  client.id = first->id;
+  if (!timerClients_.update(&client)) {
+    timerClients_.push(&client);
+  }
+}
+
+void SchedulerCoordinator::promoteTimer(Client& client) {
+  SchedulerTask* timer = client.timerQueue.pop();
+  timer->sortIndex = timer->expirationTime;
+  enqueue(client, timer);
+  syncTimerKey(client);
+}
+
+void SchedulerCoordinator::advanceTimers(double currentTime) {
+  Client* client = timerClients_.peek();
+  while (client != nullptr && client->sortIndex <= currentTime) {
+    promoteTimer(*client);
+    client = timerClients_.peek();
+  }
+}
+
+void SchedulerCoordinator::refreshQuotaWindow(double currentTime) {
+  if (currentTime - quotaWindowStart_ < quotaWindowMs_) {
+    return;
+  }
+  quotaWindowStart_ = currentTime;
+  for (const auto& client : clients_) {
+    client->quotaUsedMs = 0.0;
+  }
+}
+
+SchedulerCoordinator::Client* SchedulerCoordinator::pickClient(double currentTime) {
+  if (readyClients_.empty()) {
+    return nullptr;
+  }
+  refreshQuotaWindow(currentTime);
+
+  Client* expired = nullptr;
+  Client* best = nullptr;
+  Client* bestThrottled = nullptr;
+
+  // Orders the clients' next tasks by priority, then weighted run time, then
+  // expiration
+  const auto isBetter = [](const Client* candidate, const Client* current) {
+    if (current == nullptr) {
+      return true;
+    }
+    const SchedulerTask* a = candidate->taskQueue.peek();
+    const SchedulerTask* b = current->taskQueue.peek();
+    if (a->priorityLevel != b->priorityLevel) {
+      return isHigherPriority(a->priorityLevel, b->priorityLevel);
+    }
+    if (candidate->virtualTime != current->virtualTime) {
+      return candidate->virtualTime < current->virtualTime;
+    }
+    return a->expirationTime < b->expirationTime;
+  };
+
+  for (Client* client : readyClients_) {
+    const SchedulerTask* head = client->taskQueue.peek();
+    if (head->expirationTime <= currentTime &&
+        (expired == nullptr || head->expirationTime < expired->taskQueue.peek()->expirationTime)) {
+      expired = client;
+    }
+
+    const bool throttled = client->options.quotaMs > 0.0 && client->quotaUsedMs >= client->options.quotaMs;
+    if (throttled) {
+      if (isBetter(client, bestThrottled)) {
+        bestThrottled = client;
+      }
+    } else if (isBetter(client, best)) {
+      best = client;
+    }
+  }
+
+  // Expired work always runs so no runtime can be starved outright
+  if (expired != nullptr) {
+    return expired;
+  }
+  if (best == nullptr) {
+    // Everyone with work is over quota; stay work-conserving
+    return bestThrottled;
+  }
+  if (bestThrottled != nullptr) {
+    for (Client* client : readyClients_) {
+      if (client->options.quotaMs > 0.0 && client->quotaUsedMs >= client->options.quotaMs) {
+        ++client->throttledSkips;
+      }
+    }
+  }
+  return best;
+}
+
+void SchedulerCoordinator::runTask(Client& client, SchedulerTask* task) {
+  client.taskQueue.remove(task);
+  task->isQueued = false;
+  if (client.taskQueue.empty()) {
+    markIdle(client);
+  }
+  virtualClock_ = std::max(virtualClock_, client.virtualTime);
+
+  const uint64_t clientId = task->ownerId;
+  Task callback = std::move(task->callback);
+  task->callback = nullptr;
+  if (!callback) {
+    taskPool_.release(task);
+    return;
+  }
+
+  CoordinatedScheduler* facade = client.facade;
+  const SchedulerPriority previousPriority = facade->currentPriorityLevel_;
+  facade->currentPriorityLevel_ = task->priorityLevel;
+  currentTask_ = task;
+  const double runStart = now();
+
+  // The callback may destroy its own runtime (and so the client); look the
+  // client up again afterwards instead of holding on to it
+  const auto finish = [&]() {
+    currentTask_ = nullptr;
+    taskPool_.release(task);
+    Client* owner = clientFor(clientId);
+    if (owner == nullptr) {
+      return;
+    }
+    owner->facade->currentPriorityLevel_ = previousPriority;
+    const double elapsed = now() - runStart;
+    ++owner->tasksRun;
+    owner->runTimeMs += elapsed;
+    owner->quotaUsedMs += elapsed;
+    owner->virtualTime += elapsed / owner->options.weight;
+  };
+
+  try {
+    callback();
+  } catch (...) {
+    finish();
+    throw;
+  }
+  finish();
+}
+
+bool SchedulerCoordinator::performWorkUntilDeadline() {
+  if (isPerformingWork_) {
+    return false;
+  }
+
+  double currentTime = now();
+  needsPaint_ = false;
+  startTime_ = currentTime;
+  isPerformingWork_ = true;
+
+  try {
+    advanceTimers(currentTime);
+    while (Client* client = pickClient(currentTime)) {
+      SchedulerTask* task = client->taskQueue.peek();
+      if (task->expirationTime > currentTime && shouldYield()) {
+        break;
+      }
+      runTask(*client, task);
+      currentTime = now();
+      advanceTimers(currentTime);
+    }
+  } catch (...) {
+    isPerformingWork_ = false;
+    throw;
+  }
+  isPerformingWork_ = false;
+
+  if (hasReadyWork()) {
+    return true;
+  }
+  if (!timerClients_.empty()) {
+    requestHostTimeout(currentTime);
+  }
+  return false;
+}
+
+void SchedulerCoordinator::flushAllTasks() {
+  if (isPerformingWork_) {
+    return;
+  }
+
+  const double previousStartTime = startTime_;
+  startTime_ = -1.0;
+  isPerformingWork_ = true;
+  try {
+    while (true) {
+      needsPaint_ = false;
+      double currentTime = now();
+      if (readyClients_.empty()) {
+        const Client* firstTimer = timerClients_.peek();
+        if (firstTimer == nullptr) {
+          break;
+        }
+        // Treat the earliest delay as elapsed
+        currentTime = std::max(currentTime, firstTimer->sortIndex);
+      }
+      advanceTimers(currentTime);
+      if (Client* client = pickClient(currentTime)) {
+        runTask(*client, client->taskQueue.peek());
+      }
+    }
+  } catch (...) {
+    isPerformingWork_ = false;
+    startTime_ = previousStartTime;
+    throw;
+  }
+  isPerformingWork_ = false;
+  startTime_ = previousStartTime;
+}
+
+void SchedulerCoordinator::flushClient(uint64_t clientId) {
+  if (isPerformingWork_) {
+    return;
+  }
+
+  const double previousStartTime = startTime_;
+  startTime_ = -1.0;
+  isPerformingWork_ = true;
+  try {
+    while (Client* client = clientFor(clientId)) {
+      needsPaint_ = false;
+      advanceTimers(now());
+      if (SchedulerTask* task = client->taskQueue.peek()) {
+        runTask(*client, task);
+        continue;
+      }
+      if (client->timerQueue.empty()) {
+        break;
+      }
+
+      // Only this client's delays are treated as elapsed
+      promoteTimer(*client);
+    }
+  } catch (...) {
+    isPerformingWork_ = false;
+    startTime_ = previousStartTime;
+    throw;
+  }
+  isPerformingWork_ = false;
+  startTime_ = previousStartTime;
+}
+
+bool SchedulerCoordinator::shouldYield() const {
+  if (needsPaint_) {
+    return true;
+  }
+  if (startTime_ < 0.0) {
+    return false;
+  }
+  return now() - startTime_ >= frameInterval_;
+}
+
+double SchedulerCoordinator::now() const {
+  const auto elapsed = std::chrono::steady_clock::now() - baseTime_;
+  return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+void SchedulerCoordinator::forceFrameRate(double fps) {
+  if (fps < 0.0 || fps > 125.0) {
+    return;
+  }
+  frameInterval_ = fps > 0.0 ? 1000.0 / fps : 5.0;
+}
+
+void SchedulerCoordinator::requestPaint() {
+  needsPaint_ = true;
+}
+
+void SchedulerCoordinator::setHost(SchedulerHost* host) {
+  host_ = host;
+  if (host_ == nullptr) {
+    return;
+  }
+  if (hasReadyWork()) {
+    host_->requestHostCallback();
+  }
+  if (!timerClients_.empty()) {
+    requestHostTimeout(now());
+  }
+}
+
+SchedulerHost* SchedulerCoordinator::host() const {
+  return host_;
+}
+
+void SchedulerCoordinator::requestHostCallback() {
+  if (host_ != nullptr && !isPerformingWork_) {
+    host_->requestHostCallback();
+  }
+}
+
+void SchedulerCoordinator::requestHostTimeout(double currentTime) {
+  const Client* firstTimer = timerClients_.peek();
+  if (host_ != nullptr && firstTimer != nullptr) {
+    host_->requestHostTimeout(std::max(firstTimer->sortIndex - currentTime, 0.0));
+  }
+}
+
+bool SchedulerCoordinator::hasReadyWork() const {
+  return !readyClients_.empty();
+}
+
+size_t SchedulerCoordinator::clientCount() const {
+  return clients_.size() - freeClientSlots_.size();
+}
+
+std::vector<SchedulerCoordinator::ClientStats> SchedulerCoordinator::clientStats() const {
+  std::vector<ClientStats> stats;
+  stats.reserve(clientCount());
+  for (size_t index = 0; index < clients_.size(); ++index) {
+    const Client& client = *clients_[index];
+    if (client.facade == nullptr) {
+      continue;
+    }
+    ClientStats entry;
+    entry.clientId = makeClientId(client.generation, index);
+    entry.name = client.options.name;
+    entry.weight = client.options.weight;
+    entry.tasksRun = client.tasksRun;
+    entry.runTimeMs = client.runTimeMs;
+    entry.throttledSkips = client.throttledSkips;
+    entry.pendingTasks = client.taskQueue.size();
+    entry.pendingTimers = client.timerQueue.size();
+    stats.push_back(std::move(entry));
+  }
+  return stats;
+}
+
+} // namespace react
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "ReactScheduler/Scheduler.h"
+#include "ReactScheduler/SchedulerIndexedMinHeap.h"
+#include "ReactScheduler/SchedulerTaskPool.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace react {
+
+class SchedulerCoordinator;
+
+struct SchedulerClientOptions {
+  std::string name;
+  // Share of contended time relative to other clients
+  double weight{1.0};
+  // Run time allowed per quota window; 0 means unlimited
+  double quotaMs{0.0};
+};
+
+/**
+ * Per-runtime Scheduler backed by a SchedulerCoordinator
+ *
+ * Implements the regular Scheduler interface, so it plugs into
+ * ReactRuntime::setScheduler. Tasks go into the client's own queues inside
+ * the coordinator; running them (performWorkUntilDeadline) drives the whole
+ * coordinator, while flushAllTasks only drains this client. Destroying the
+ * client cancels whatever it still has queued.
+ */
+class CoordinatedScheduler : public Scheduler {
+public:
+  ~CoordinatedScheduler() override;
+
+  TaskHandle scheduleTask(
+    SchedulerPriority priority,
+    Task task,
+    const TaskOptions& options = {}) override;
+
+  void cancelTask(TaskHandle handle) override;
+
+  SchedulerPriority getCurrentPriorityLevel() const override;
+
+  SchedulerPriority runWithPriority(
+    SchedulerPriority priority,
+    const std::function<void()>& fn) override;
+
+  bool shouldYield() const override;
+
+  double now() const override;
+
+  bool performWorkUntilDeadline() override;
+  void flushAllTasks() override;
+  void setHost(SchedulerHost* host) override;
+  SchedulerHost* host() const override;
+
+  uint64_t clientId() const {
+    return clientId_;
+  }
+
+private:
+  friend class SchedulerCoordinator;
+
+  CoordinatedScheduler(SchedulerCoordinator* coordinator, uint64_t clientId);
+
+  SchedulerCoordinator* coordinator_;
+  uint64_t clientId_;
+  SchedulerPriority currentPriorityLevel_{SchedulerPriority::NormalPriority};
+};
+
+/**
+ * Process-level scheduler shared by many ReactRuntime instances
+ *
+ * Each runtime gets a CoordinatedScheduler client. Every slice the
+ * coordinator picks the next task across all clients:
+ * 1. Expired tasks first, earliest expiration across clients
+ * 2. Otherwise the highest priority among the clients' next tasks, so input
+ *    work in one runtime goes ahead of idle work in another
+ * 3. Ties go to the client with the least weighted run time (weighted fair
+ *    queueing: run time is charged as elapsed / weight)
+ * Clients with a quota that used it up in the current window are skipped
+ * while any other client has ready work. The slice budget (frame interval)
+ * is global, so all runtimes together stay within one frame.
+ *
+ * Selection scans the clients that have ready work, which is cheap for
+ * hundreds of runtimes. Delayed tasks wait in a timer heap per client, and
+ * the clients with timers sit in one heap keyed by their earliest timer, so
+ * flushing or detaching a client never walks other clients' timers.
+ *
+ * Client ids encode (generation << 32) | (slot + 1) like task handles: a
+ * slot freed by a destroyed client is reused with a new generation, so work
+ * that finishes after its client went away never charges the slot's next
+ * occupant. The coordinator must outlive its clients' use; clients left over
+ * at destruction are detached and become inert.
+ */
+class SchedulerCoordinator {
+public:
+  struct ClientStats {
+    uint64_t clientId{0};
+    std::string name;
+    double weight{1.0};
+    uint64_t tasksRun{0};
+    double runTimeMs{0.0};
+    uint64_t throttledSkips{0};
+    size_t pendingTasks{0};
+    size_t pendingTimers{0};
+  };
+
+  explicit SchedulerCoordinator(double quotaWindowMs = 100.0);
+  ~SchedulerCoordinator();
+
+  SchedulerCoordinator(const SchedulerCoordinator&) = delete;
+  SchedulerCoordinator& operator=(const SchedulerCoordinator&) = delete;
+
+  std::shared_ptr<CoordinatedScheduler> createClient(const SchedulerClientOptions& options = {});
+
+  // Runs one global slice across all clients; true while work remains
+  bool performWorkUntilDeadline();
+
+  // Drains every client without yielding, treating delays as elapsed
+  void flushAllTasks();
+
+  bool shouldYield() const;
+  double now() const;
+  void forceFrameRate(double fps);
+  void requestPaint();
+
+  void setHost(SchedulerHost* host);
+  SchedulerHost* host() const;
+
+  size_t clientCount() const;
+  std::vector<ClientStats> clientStats() const;
+
+private:
+  friend class CoordinatedScheduler;
+
+  // The HeapNode key mirrors the client's earliest timer while it has any
+  struct Client : HeapNode {
+    CoordinatedScheduler* facade{nullptr};
+    uint32_t generation{1};
+    SchedulerClientOptions options;
+    SchedulerIndexedMinHeap<SchedulerTask> taskQueue;
+    SchedulerIndexedMinHeap<SchedulerTask> timerQueue;
+    double virtualTime{0.0};
+    double quotaUsedMs{0.0};
+    size_t readyIndex{SIZE_MAX};
+    uint64_t tasksRun{0};
+    double runTimeMs{0.0};
+    uint64_t throttledSkips{0};
+  };
+
+  TaskHandle scheduleTask(uint64_t clientId, SchedulerPriority priority, Task task, const TaskOptions& options);
+  void cancelTask(uint64_t clientId, TaskHandle handle);
+  void detachClient(uint64_t clientId);
+  Client* clientFor(uint64_t clientId);
+
+  void enqueue(Client& client, SchedulerTask* task);
+  void markReady(Client& client);
+  void markIdle(Client& client);
+  void syncTimerKey(Client& client);
+  void promoteTimer(Client& client);
+  void advanceTimers(double currentTime);
+  void releaseQueuedTasks(Client& client);
+  Client* pickClient(double currentTime);
+  void runTask(Client& client, SchedulerTask* task);
+  void flushClient(uint64_t clientId);
+  void refreshQuotaWindow(double currentTime);
+  void requestHostCallback();
+  void requestHostTimeout(double currentTime);
+  bool hasReadyWork() const;
+
+  std::vector<std::unique_ptr<Client>> clients_;
+  std::vector<uint32_t> freeClientSlots_;
+  std::vector<Client*> readyClients_;
+  SchedulerIndexedMinHeap<Client> timerClients_;
+  SchedulerTaskPool taskPool_;
+  SchedulerTask* currentTask_{nullptr};
+
+  uint64_t nextTaskId_{1};
+  double virtualClock_{0.0};
+  double quotaWindowMs_;
+  double quotaWindowStart_{0.0};
+  double frameInterval_{5.0};
+  double startTime_{-1.0};
+  bool needsPaint_{false};
+  bool isPerformingWork_{false};
+  SchedulerHost* host_{nullptr};
+  std::chrono::steady_clock::time_point baseTime_;
+};
+
+} // namespace react
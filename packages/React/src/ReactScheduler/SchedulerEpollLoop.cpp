@@ -0,0 +1,250 @@
+#include "ReactScheduler/SchedulerEpollLoop.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace react {
+
+namespace {
+
+constexpr int64_t kNanosPerSecond = 1000000000;
+// About 31 years; keeps the nanosecond deadline well inside int64_t
+constexpr double kMaxDelayMs = 1e12;
+
+[[noreturn]] void throwErrno(const char* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+void closeFd(int& fd) {
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+void watch(int epollFd, int fd) {
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+    throwErrno("SchedulerEpollLoop: epoll_ctl failed");
+  }
+}
+
+} // namespace
+
+SchedulerEpollLoop::SchedulerEpollLoop(std::shared_ptr<Scheduler> scheduler)
+  : scheduler_(std::move(scheduler)) {
+  if (!scheduler_) {
+    throw std::invalid_argument("SchedulerEpollLoop: scheduler must not be null");
+  }
+  try {
+    epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) {
+      throwErrno("SchedulerEpollLoop: epoll_create1 failed");
+    }
+    timerFd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd_ < 0) {
+      throwErrno("SchedulerEpollLoop: timerfd_create failed");
+    }
+    eventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd_ < 0) {
+      throwErrno("SchedulerEpollLoop: eventfd failed");
+    }
+    watch(epollFd_, timerFd_);
+    watch(epollFd_, eventFd_);
+  } catch (...) {
+    closeFd(eventFd_);
+    closeFd(timerFd_);
+    closeFd(epollFd_);
+    throw;
+  }
+
+  // May immediately request a callback or timeout for already queued work
+  scheduler_->setHost(this);
+}
+
+SchedulerEpollLoop::~SchedulerEpollLoop() {
+  // The scheduler may be shared, and another loop may have attached since
+  if (scheduler_->host() == this) {
+    scheduler_->setHost(nullptr);
+  }
+  closeFd(eventFd_);
+  closeFd(timerFd_);
+  closeFd(epollFd_);
+}
+
+void SchedulerEpollLoop::run() {
+  loop(false);
+}
+
+void SchedulerEpollLoop::runUntilIdle() {
+  loop(true);
+}
+
+void SchedulerEpollLoop::stop() {
+  stopRequested_.store(true, std::memory_order_release);
+  signal();
+}
+
+void SchedulerEpollLoop::post(Task fn) {
+  if (!fn) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(postedMutex_);
+    posted_.push_back(std::move(fn));
+  }
+  signal();
+}
+
+void SchedulerEpollLoop::requestHostCallback() {
+  // Always called on the loop thread (or before the loop runs), so the flag
+  // is picked up on the next iteration without a wakeup
+  callbackRequested_ = true;
+}
+
+void SchedulerEpollLoop::requestHostTimeout(double delayMs) {
+  armTimer(delayMs);
+}
+
+void SchedulerEpollLoop::cancelHostTimeout() {
+  if (!timeoutArmed_) {
+    return;
+  }
+  itimerspec disarm{};
+  ::timerfd_settime(timerFd_, 0, &disarm, nullptr);
+  timeoutArmed_ = false;
+}
+
+void SchedulerEpollLoop::loop(bool untilIdle) {
+  while (!stopRequested_.load(std::memory_order_acquire)) {
+    drainPosted();
+
+    if (callbackRequested_) {
+      callbackRequested_ = false;
+      ++stats_.slices;
+      bool hasMoreWork = false;
+      try {
+        hasMoreWork = scheduler_->performWorkUntilDeadline();
+      } catch (...) {
+        // The scheduler keeps the remaining work queued; resume it next run
+        callbackRequested_ = true;
+        throw;
+      }
+      callbackRequested_ = callbackRequested_ || hasMoreWork;
+
+      // Yield to due timers and posted work between slices
+      waitForEvents(0);
+      continue;
+    }
+
+    if (untilIdle && !timeoutArmed_) {
+      std::lock_guard<std::mutex> lock(postedMutex_);
+      if (posted_.empty()) {
+        break;
+      }
+      continue;
+    }
+
+    ++stats_.blockingWaits;
+    waitForEvents(-1);
+  }
+
+  stopRequested_.store(false, std::memory_order_release);
+}
+
+void SchedulerEpollLoop::drainPosted() {
+  {
+    std::lock_guard<std::mutex> lock(postedMutex_);
+    if (posted_.empty()) {
+      return;
+    }
+    running_.swap(posted_);
+  }
+
+  for (size_t i = 0; i < running_.size(); ++i) {
+    try {
+      running_[i]();
+    } catch (...) {
+      // Requeue what has not run yet, ahead of anything posted meanwhile
+      std::lock_guard<std::mutex> lock(postedMutex_);
+      posted_.insert(
+          posted_.begin(),
+          std::make_move_iterator(running_.begin() + static_cast<std::ptrdiff_t>(i) + 1),
+          std::make_move_iterator(running_.end()));
+      running_.clear();
+      throw;
+    }
+  }
+  running_.clear();
+}
+
+void SchedulerEpollLoop::waitForEvents(int timeoutMs) {
+  epoll_event events[2];
+  int count = 0;
+  do {
+    count = ::epoll_wait(epollFd_, events, 2, timeoutMs);
+  } while (count < 0 && errno == EINTR);
+  if (count < 0) {
+    throwErrno("SchedulerEpollLoop: epoll_wait failed");
+  }
+
+  for (int i = 0; i < count; ++i) {
+    uint64_t value = 0;
+    if (events[i].data.fd == timerFd_) {
+      if (::read(timerFd_, &value, sizeof(value)) > 0) {
+        ++stats_.timerWakeups;
+        timeoutArmed_ = false;
+        // performWorkUntilDeadline moves due timers into the task queue
+        callbackRequested_ = true;
+      }
+    } else if (events[i].data.fd == eventFd_) {
+      if (::read(eventFd_, &value, sizeof(value)) > 0) {
+        ++stats_.eventWakeups;
+      }
+    }
+  }
+}
+
+void SchedulerEpollLoop::armTimer(double delayMs) {
+  if (std::isnan(delayMs) || delayMs >= kMaxDelayMs) {
+    // Effectively never; leave the timer disarmed
+    cancelHostTimeout();
+    return;
+  }
+
+  timespec now{};
+  ::clock_gettime(CLOCK_MONOTONIC, &now);
+
+  // A zero it_value disarms the timer, so due timeouts fire 1ns from now
+  const int64_t delayNs = delayMs > 0.0 ? static_cast<int64_t>(std::ceil(delayMs * 1e6)) : 1;
+  const int64_t deadline = static_cast<int64_t>(now.tv_sec) * kNanosPerSecond + now.tv_nsec + delayNs;
+
+  itimerspec spec{};
+  spec.it_value.tv_sec = static_cast<time_t>(deadline / kNanosPerSecond);
+  spec.it_value.tv_nsec = static_cast<long>(deadline % kNanosPerSecond);
+  if (::timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+    throwErrno("SchedulerEpollLoop: timerfd_settime failed");
+  }
+  timeoutArmed_ = true;
+}
+
+void SchedulerEpollLoop::signal() {
+  const uint64_t one = 1;
+  // EAGAIN means the counter is already non-zero, which wakes the loop anyway
+  (void)!::write(eventFd_, &one, sizeof(one));
+}
+
+} // namespace react
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ReactScheduler/Scheduler.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace react {
+
+/**
+ * Linux host event loop for a Scheduler, built on epoll, timerfd and eventfd
+ *
+ * Attaches itself as the scheduler's SchedulerHost and drives
+ * performWorkUntilDeadline without a JS engine's event loop:
+ * - Host callbacks run slice after slice, polling the fds between slices so
+ *   timers and posted work interleave with long renders
+ * - Host timeouts arm a CLOCK_MONOTONIC timerfd at the exact deadline
+ * - When nothing is ready the loop blocks in epoll_wait, so an idle loop uses
+ *   no CPU
+ *
+ * The scheduler is single-threaded: other threads hand work to the loop with
+ * post(), which wakes it through an eventfd. stop() and post() are the only
+ * thread-safe members.
+ *
+ * The loop shares ownership of its scheduler, so a runtime swapping in a new
+ * backend (ReactRuntime::setScheduler) cannot free the one being driven.
+ */
+class SchedulerEpollLoop : public SchedulerHost {
+public:
+  struct Stats {
+    uint64_t slices{0};
+    uint64_t timerWakeups{0};
+    uint64_t eventWakeups{0};
+    uint64_t blockingWaits{0};
+  };
+
+  explicit SchedulerEpollLoop(std::shared_ptr<Scheduler> scheduler);
+  ~SchedulerEpollLoop() override;
+
+  SchedulerEpollLoop(const SchedulerEpollLoop&) = delete;
+  SchedulerEpollLoop& operator=(const SchedulerEpollLoop&) = delete;
+
+  /**
+   * Run until stop() is called, sleeping whenever no work is due
+   */
+  void run();
+
+  /**
+   * Run until no task, timer or posted callback is left, then return
+   */
+  void runUntilIdle();
+
+  /**
+   * Ask a running loop to return after the current slice (thread-safe)
+   */
+  void stop();
+
+  /**
+   * Run fn on the loop thread before the next slice (thread-safe)
+   */
+  void post(Task fn);
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  // SchedulerHost
+  void requestHostCallback() override;
+  void requestHostTimeout(double delayMs) override;
+  void cancelHostTimeout() override;
+
+private:
+  void loop(bool untilIdle);
+  void drainPosted();
+  void waitForEvents(int timeoutMs);
+  void armTimer(double delayMs);
+  void signal();
+
+  std::shared_ptr<Scheduler> scheduler_;
+  int epollFd_{-1};
+  int timerFd_{-1};
+  int eventFd_{-1};
+
+  bool callbackRequested_{false};
+  bool timeoutArmed_{false};
+  std::atomic<bool> stopRequested_{false};
+
+  std::mutex postedMutex_;
+  std::vector<Task> posted_;
+  std::vector<Task> running_;
+
+  Stats stats_{};
+};
+
+} // namespace react
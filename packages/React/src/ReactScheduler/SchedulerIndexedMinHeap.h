@@ -0,0 +1,265 @@
+#pragma once
+
+#include "ReactScheduler/SchedulerMinHeap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace react {
+
+/**
+ * Indexed d-ary min-heap for Scheduler tasks
+ *
+ * Orders nodes exactly like SchedulerMinHeap (sortIndex, then id) but:
+ * - Stores sortIndex/id inline next to the node pointer so comparisons never
+ *   dereference the node
+ * - Uses a 4-ary layout by default, which halves the tree depth and keeps the
+ *   children of a slot within a single cache line
+ * - Writes each node's position back into HeapNode::heapIndex so arbitrary
+ *   nodes can be removed or re-keyed in O(log n) without tombstones
+ *
+ * T must derive from HeapNode (or expose id, sortIndex and heapIndex).
+ */
+template<typename T, std::size_t Arity = 4>
+class SchedulerIndexedMinHeap {
+  static_assert(Arity >= 2, "SchedulerIndexedMinHeap requires an arity of at least 2");
+
+private:
+  struct Entry {
+    double sortIndex;
+    uint64_t id;
+    T* node;
+  };
+
+  std::vector<Entry> heap_;
+
+  static bool less(const Entry& a, const Entry& b) {
+    if (a.sortIndex != b.sortIndex) {
+      return a.sortIndex < b.sortIndex;
+    }
+    return a.id < b.id;
+  }
+
+  void place(size_t index, const Entry& entry) {
+    heap_[index] = entry;
+    entry.node->heapIndex = index;
+  }
+
+  void siftUp(size_t index) {
+    const Entry entry = heap_[index];
+    while (index > 0) {
+      const size_t parentIndex = (index - 1) / Arity;
+      if (!less(entry, heap_[parentIndex])) {
+        break;
+      }
+      place(index, heap_[parentIndex]);
+      index = parentIndex;
+    }
+    place(index, entry);
+  }
+
+  void siftDown(size_t index) {
+    const size_t length = heap_.size();
+    const Entry entry = heap_[index];
+
+    while (true) {
+      const size_t firstChild = index * Arity + 1;
+      if (firstChild >= length) {
+        break;
+      }
+
+      const size_t lastChild = firstChild + Arity < length ? firstChild + Arity : length;
+      size_t smallest = firstChild;
+      for (size_t child = firstChild + 1; child < lastChild; ++child) {
+        if (less(heap_[child], heap_[smallest])) {
+          smallest = child;
+        }
+      }
+
+      if (!less(heap_[smallest], entry)) {
+        break;
+      }
+      place(index, heap_[smallest]);
+      index = smallest;
+    }
+    place(index, entry);
+  }
+
+  // Restores the heap property for a slot whose key may have moved either way.
+  void fix(size_t index) {
+    if (index > 0 && less(heap_[index], heap_[(index - 1) / Arity])) {
+      siftUp(index);
+    } else {
+      siftDown(index);
+    }
+  }
+
+  T* removeAt(size_t index) {
+    T* removed = heap_[index].node;
+    const size_t lastIndex = heap_.size() - 1;
+    if (index != lastIndex) {
+      place(index, heap_[lastIndex]);
+      heap_.pop_back();
+      fix(index);
+    } else {
+      heap_.pop_back();
+    }
+    removed->heapIndex = kInvalidHeapIndex;
+    return removed;
+  }
+
+public:
+  SchedulerIndexedMinHeap() = default;
+
+  // Non-copyable but movable
+  SchedulerIndexedMinHeap(const SchedulerIndexedMinHeap&) = delete;
+  SchedulerIndexedMinHeap& operator=(const SchedulerIndexedMinHeap&) = delete;
+  SchedulerIndexedMinHeap(SchedulerIndexedMinHeap&&) = default;
+  SchedulerIndexedMinHeap& operator=(SchedulerIndexedMinHeap&&) = default;
+
+  /**
+   * Push a new node onto the heap
+   * The node's current id/sortIndex are captured as its key
+   */
+  void push(T* node) {
+    if (node == nullptr || node->heapIndex != kInvalidHeapIndex) {
+      return;
+    }
+
+    heap_.push_back(Entry{node->sortIndex, node->id, node});
+    siftUp(heap_.size() - 1);
+  }
+
+  /**
+   * Push a batch of nodes
+   * Appends everything first and rebuilds bottom-up when the batch is larger
+   * than the existing heap, otherwise sifts each new node up
+   */
+  template<typename Iterator>
+  void pushAll(Iterator first, Iterator last) {
+    const size_t previousSize = heap_.size();
+    for (; first != last; ++first) {
+      T* node = *first;
+      if (node == nullptr || node->heapIndex != kInvalidHeapIndex) {
+        continue;
+      }
+      heap_.push_back(Entry{node->sortIndex, node->id, node});
+      node->heapIndex = heap_.size() - 1;
+    }
+
+    const size_t added = heap_.size() - previousSize;
+    if (added == 0) {
+      return;
+    }
+    if (heap_.size() == 1) {
+      heap_[0].node->heapIndex = 0;
+    } else if (added > previousSize) {
+      for (size_t index = (heap_.size() - 2) / Arity + 1; index-- > 0;) {
+        siftDown(index);
+      }
+    } else {
+      for (size_t index = previousSize; index < heap_.size(); ++index) {
+        siftUp(index);
+      }
+    }
+  }
+
+  /**
+   * Peek at the minimum element without removing it
+   * Returns nullptr if heap is empty
+   */
+  T* peek() const {
+    return heap_.empty() ? nullptr : heap_[0].node;
+  }
+
+  /**
+   * Remove and return the minimum element
+   * Returns nullptr if heap is empty
+   */
+  T* pop() {
+    if (heap_.empty()) {
+      return nullptr;
+    }
+    return removeAt(0);
+  }
+
+  /**
+   * Remove an arbitrary node in O(log n)
+   * Returns false if the node is not queued in this heap
+   */
+  bool remove(T* node) {
+    if (!contains(node)) {
+      return false;
+    }
+    removeAt(node->heapIndex);
+    return true;
+  }
+
+  /**
+   * Re-key a queued node after its sortIndex changed
+   * Returns false if the node is not queued in this heap
+   */
+  bool update(T* node) {
+    if (!contains(node)) {
+      return false;
+    }
+    Entry& entry = heap_[node->heapIndex];
+    entry.sortIndex = node->sortIndex;
+    entry.id = node->id;
+    fix(node->heapIndex);
+    return true;
+  }
+
+  /**
+   * Check whether the node currently lives in this heap
+   */
+  bool contains(const T* node) const {
+    return node != nullptr && node->heapIndex < heap_.size() &&
+        heap_[node->heapIndex].node == node;
+  }
+
+  /**
+   * Check if the heap is empty
+   */
+  bool empty() const {
+    return heap_.empty();
+  }
+
+  /**
+   * Get the current size of the heap
+   */
+  size_t size() const {
+    return heap_.size();
+  }
+
+  /**
+   * Pre-size the backing storage for bursts of tasks
+   */
+  void reserve(size_t capacity) {
+    heap_.reserve(capacity);
+  }
+
+  /**
+   * Visit every queued node in heap (not sorted) order
+   * The heap must not be modified during the walk
+   */
+  template<typename Fn>
+  void forEach(Fn&& fn) const {
+    for (const Entry& entry : heap_) {
+      fn(entry.node);
+    }
+  }
+
+  /**
+   * Clear all elements from the heap, detaching every node
+   */
+  void clear() {
+    for (const Entry& entry : heap_) {
+      entry.node->heapIndex = kInvalidHeapIndex;
+    }
+    heap_.clear();
+  }
+};
+
+} // namespace react
@@ -0,0 +1,98 @@
+#include "ReactScheduler/SchedulerMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace react {
+
+namespace {
+
+inline size_t highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - static_cast<size_t>(__builtin_clzll(value));
+#else
+  size_t bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+} // namespace
+
+size_t SchedulerLatencyHistogram::bucketFor(uint64_t micros) {
+  if (micros < kSubBuckets) {
+    return static_cast<size_t>(micros);
+  }
+  const size_t shift = highestBit(micros) - kSubBucketBits;
+  if (shift > kMaxShift) {
+    return kBucketCount - 1;
+  }
+  const size_t subBucket = static_cast<size_t>(micros >> shift) & (kSubBuckets - 1);
+  return (shift + 1) * kSubBuckets + subBucket;
+}
+
+uint64_t SchedulerLatencyHistogram::bucketUpperBound(size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const size_t shift = index / kSubBuckets - 1;
+  const uint64_t subBucket = index % kSubBuckets;
+  return ((kSubBuckets + subBucket + 1) << shift) - 1;
+}
+
+void SchedulerLatencyHistogram::record(double valueMs) {
+  const double micros = valueMs > 0.0 ? std::round(valueMs * 1000.0) : 0.0;
+  const uint64_t value = micros >= 1.8e19 ? UINT64_MAX : static_cast<uint64_t>(micros);
+  ++buckets_[bucketFor(value)];
+  ++count_;
+  minMicros_ = std::min(minMicros_, value);
+  maxMicros_ = std::max(maxMicros_, value);
+  sumMs_ += std::max(valueMs, 0.0);
+}
+
+double SchedulerLatencyHistogram::minMs() const {
+  return count_ == 0 ? 0.0 : static_cast<double>(minMicros_) / 1000.0;
+}
+
+double SchedulerLatencyHistogram::maxMs() const {
+  return static_cast<double>(maxMicros_) / 1000.0;
+}
+
+double SchedulerLatencyHistogram::meanMs() const {
+  return count_ == 0 ? 0.0 : sumMs_ / static_cast<double>(count_);
+}
+
+double SchedulerLatencyHistogram::percentileMs(double quantile) const {
+  if (count_ == 0) {
+    return 0.0;
+  }
+  const double clamped = std::clamp(quantile, 0.0, 1.0);
+  const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t index = 0; index < kBucketCount; ++index) {
+    seen += buckets_[index];
+    if (seen >= rank) {
+      // Never report beyond the largest value actually recorded
+      return static_cast<double>(std::min(bucketUpperBound(index), maxMicros_)) / 1000.0;
+    }
+  }
+  return maxMs();
+}
+
+void SchedulerLatencyHistogram::merge(const SchedulerLatencyHistogram& other) {
+  for (size_t index = 0; index < kBucketCount; ++index) {
+    buckets_[index] += other.buckets_[index];
+  }
+  count_ += other.count_;
+  minMicros_ = std::min(minMicros_, other.minMicros_);
+  maxMicros_ = std::max(maxMicros_, other.maxMicros_);
+  sumMs_ += other.sumMs_;
+}
+
+void SchedulerLatencyHistogram::reset() {
+  *this = SchedulerLatencyHistogram{};
+}
+
+} // namespace react
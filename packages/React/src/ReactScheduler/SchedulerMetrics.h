@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ReactScheduler/Scheduler.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace react {
+
+/**
+ * Log-linear latency histogram (HDR-style)
+ *
+ * Values are recorded in whole microseconds. Each power of two is split into
+ * 8 linear sub-buckets, so any recorded value is reported within 12.5% while
+ * the whole range from 1us to days fits in a few hundred fixed counters.
+ * Recording is a couple of bit operations and an increment; nothing
+ * allocates.
+ */
+class SchedulerLatencyHistogram {
+public:
+  static constexpr size_t kSubBucketBits = 3;
+  static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+  static constexpr size_t kMaxShift = 40;
+  static constexpr size_t kBucketCount = (kMaxShift + 2) * kSubBuckets;
+
+  void record(double valueMs);
+
+  uint64_t count() const {
+    return count_;
+  }
+
+  double minMs() const;
+  double maxMs() const;
+  double meanMs() const;
+
+  // Upper bound of the bucket holding the given quantile (0..1)
+  double percentileMs(double quantile) const;
+
+  void merge(const SchedulerLatencyHistogram& other);
+  void reset();
+
+private:
+  static size_t bucketFor(uint64_t micros);
+  static uint64_t bucketUpperBound(size_t index);
+
+  std::array<uint64_t, kBucketCount> buckets_{};
+  uint64_t count_{0};
+  uint64_t minMicros_{UINT64_MAX};
+  uint64_t maxMicros_{0};
+  double sumMs_{0.0};
+};
+
+/**
+ * Latency and starvation counters for one SchedulerPriority
+ * - queueWait: from a task's startTime (after any delay) until it starts
+ * - runTime: how long its callback ran
+ * - expirationOverrun: how far past expirationTime it started, recorded only
+ *   for tasks that expired before running
+ * ImmediatePriority tasks have no timeout and are due the moment they are
+ * queued, so only tasks with a positive timeout count towards
+ * expiredBeforeRun.
+ */
+struct SchedulerPriorityMetrics {
+  SchedulerLatencyHistogram queueWait;
+  SchedulerLatencyHistogram runTime;
+  SchedulerLatencyHistogram expirationOverrun;
+  uint64_t tasksRun{0};
+  uint64_t expiredBeforeRun{0};
+  uint64_t tasksCancelled{0};
+};
+
+struct SchedulerMetricsSnapshot {
+  std::array<SchedulerPriorityMetrics, 6> priorities{};
+
+  const SchedulerPriorityMetrics& forPriority(SchedulerPriority priority) const {
+    return priorities[static_cast<size_t>(priority)];
+  }
+};
+
+class SchedulerMetrics {
+public:
+  void recordRun(
+      SchedulerPriority priority,
+      double startTime,
+      double expirationTime,
+      double runStart,
+      double runEnd) {
+    SchedulerPriorityMetrics& metrics = data_.priorities[static_cast<size_t>(priority)];
+    ++metrics.tasksRun;
+    metrics.queueWait.record(runStart - startTime);
+    metrics.runTime.record(runEnd - runStart);
+    if (expirationTime > startTime && runStart > expirationTime) {
+      ++metrics.expiredBeforeRun;
+      metrics.expirationOverrun.record(runStart - expirationTime);
+    }
+  }
+
+  void recordCancel(SchedulerPriority priority) {
+    ++data_.priorities[static_cast<size_t>(priority)].tasksCancelled;
+  }
+
+  const SchedulerMetricsSnapshot& data() const {
+    return data_;
+  }
+
+  void reset() {
+    data_ = SchedulerMetricsSnapshot{};
+  }
+
+private:
+  SchedulerMetricsSnapshot data_{};
+};
+
+} // namespace react
@@ -1,19 +1,23 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace react {
 
+inline constexpr std::size_t kInvalidHeapIndex = static_cast<std::size_t>(-1);
+
 /**
- * Node interface for SchedulerMinHeap
- * Must provide id and sortIndex for comparison
+ * Node interface for SchedulerMinHeap and SchedulerIndexedMinHeap
+ * Must provide id and sortIndex for comparison. heapIndex is maintained by
+ * SchedulerIndexedMinHeap and stays kInvalidHeapIndex while the node is not
+ * queued. Intentionally non-virtual so nodes stay trivially laid out.
  */
 struct HeapNode {
   uint64_t id{0};
   double sortIndex{0.0};
-  
-  virtual ~HeapNode() = default;
+  std::size_t heapIndex{kInvalidHeapIndex};
 };
 
 /**
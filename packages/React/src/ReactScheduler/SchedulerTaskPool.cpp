@@ -0,0 +1,86 @@
+#include "ReactScheduler/SchedulerTaskPool.h"
+
+namespace react {
+
+SchedulerTask* SchedulerTaskPool::acquire() {
+  if (freeHead_ == kNoFreeSlot) {
+    growBlock();
+  }
+
+  SchedulerTask& task = slotAt(freeHead_);
+  freeHead_ = task.nextFree;
+  task.nextFree = kNoFreeSlot;
+  task.inUse = true;
+  task.handle = TaskHandle{(static_cast<uint64_t>(task.generation) << 32) | (static_cast<uint64_t>(task.slotIndex) + 1)};
+
+  ++stats_.acquireCount;
+  ++stats_.liveCount;
+  if (stats_.liveCount > stats_.peakLiveCount) {
+    stats_.peakLiveCount = stats_.liveCount;
+  }
+  return &task;
+}
+
+void SchedulerTaskPool::release(SchedulerTask* task) {
+  if (task == nullptr || !task->inUse) {
+    return;
+  }
+
+  // Drop captured state now rather than when the slot is next reused
+  task->callback = nullptr;
+  task->heapIndex = kInvalidHeapIndex;
+  task->timerPrev = nullptr;
+  task->timerNext = nullptr;
+  task->timerSlot = kNoTimerSlot;
+  task->ownerId = 0;
+  task->isQueued = false;
+  task->inUse = false;
+  task->handle = TaskHandle{};
+  task->generation = (task->generation + 1) & kGenerationMask;
+  if (task->generation == 0) {
+    task->generation = 1;
+  }
+
+  task->nextFree = freeHead_;
+  freeHead_ = task->slotIndex;
+
+  ++stats_.releaseCount;
+  --stats_.liveCount;
+}
+
+SchedulerTask* SchedulerTaskPool::get(TaskHandle handle) const {
+  const uint64_t slot = handle.id & 0xffffffffu;
+  if (slot == 0 || slot > stats_.capacity) {
+    return nullptr;
+  }
+
+  SchedulerTask& task = slotAt(static_cast<uint32_t>(slot - 1));
+  if (!task.inUse || task.generation != static_cast<uint32_t>(handle.id >> 32)) {
+    return nullptr;
+  }
+  return &task;
+}
+
+void SchedulerTaskPool::reserve(size_t capacity) {
+  while (stats_.capacity < capacity) {
+    growBlock();
+  }
+}
+
+void SchedulerTaskPool::growBlock() {
+  const uint32_t base = static_cast<uint32_t>(stats_.capacity);
+  blocks_.push_back(std::make_unique<SchedulerTask[]>(kBlockSize));
+  SchedulerTask* block = blocks_.back().get();
+
+  // Thread the new slots onto the free list so the lowest index is used first
+  for (size_t i = kBlockSize; i-- > 0;) {
+    block[i].slotIndex = base + static_cast<uint32_t>(i);
+    block[i].nextFree = freeHead_;
+    freeHead_ = block[i].slotIndex;
+  }
+
+  ++stats_.blockCount;
+  stats_.capacity += kBlockSize;
+}
+
+} // namespace react
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ReactScheduler/Scheduler.h"
+#include "ReactScheduler/SchedulerMinHeap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace react {
+
+inline constexpr uint16_t kNoTimerSlot = UINT16_MAX;
+
+/**
+ * Internal task representation for the scheduler
+ * id/sortIndex/heapIndex come from HeapNode and are kept inline in the heap.
+ * HeapNode::id is a monotonically increasing sequence used for FIFO ordering;
+ * handle is the generation-checked TaskHandle given out to callers.
+ * timerPrev/timerNext/timerSlot are intrusive links owned by
+ * SchedulerTimerWheel while the task waits there.
+ * ownerId identifies the SchedulerCoordinator client that scheduled the task.
+ */
+struct SchedulerTask : public HeapNode {
+  Task callback;
+  SchedulerPriority priorityLevel{SchedulerPriority::NormalPriority};
+  double startTime{0.0};
+  double expirationTime{0.0};
+  TaskHandle handle{};
+  uint32_t generation{1};
+  uint32_t slotIndex{0};
+  uint32_t nextFree{0};
+  uint64_t ownerId{0};
+  SchedulerTask* timerPrev{nullptr};
+  SchedulerTask* timerNext{nullptr};
+  uint16_t timerSlot{kNoTimerSlot};
+  bool isQueued{false};
+  bool inUse{false};
+};
+
+/**
+ * Fixed-block slab pool for SchedulerTask
+ *
+ * Tasks live in blocks of kBlockSize slots that are never moved or freed
+ * while the pool is alive, so task pointers stay stable. Released slots go
+ * onto an intrusive free list and are reused LIFO, which keeps steady-state
+ * scheduling allocation-free once the pool has grown to the peak backlog.
+ *
+ * TaskHandle ids encode (generation << 32) | (slot index + 1). The generation
+ * is bumped on every release, so a handle to a finished task never resolves
+ * to the slot's next occupant. Bit 63 stays clear because the root scheduler
+ * reserves it for act queue callbacks.
+ */
+class SchedulerTaskPool {
+public:
+  static constexpr size_t kBlockShift = 8;
+  static constexpr size_t kBlockSize = size_t{1} << kBlockShift;
+
+  struct Stats {
+    size_t blockCount{0};
+    size_t capacity{0};
+    size_t liveCount{0};
+    size_t peakLiveCount{0};
+    uint64_t acquireCount{0};
+    uint64_t releaseCount{0};
+  };
+
+  SchedulerTaskPool() = default;
+
+  // Non-copyable, non-movable: handed-out task pointers refer into the blocks
+  SchedulerTaskPool(const SchedulerTaskPool&) = delete;
+  SchedulerTaskPool& operator=(const SchedulerTaskPool&) = delete;
+
+  /**
+   * Take a free slot, growing by one block when the free list is empty
+   * The returned task has a fresh handle and default-initialized fields
+   */
+  SchedulerTask* acquire();
+
+  /**
+   * Return a slot to the free list and invalidate its handle
+   */
+  void release(SchedulerTask* task);
+
+  /**
+   * Resolve a handle in O(1); returns nullptr for stale or unknown handles
+   */
+  SchedulerTask* get(TaskHandle handle) const;
+
+  /**
+   * Grow the pool up front so the first burst does not allocate
+   */
+  void reserve(size_t capacity);
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  static constexpr uint32_t kNoFreeSlot = UINT32_MAX;
+  static constexpr uint32_t kGenerationMask = 0x7fffffffu;
+
+  SchedulerTask& slotAt(uint32_t index) const {
+    return blocks_[index >> kBlockShift][index & (kBlockSize - 1)];
+  }
+
+  void growBlock();
+
+  std::vector<std::unique_ptr<SchedulerTask[]>> blocks_;
+  uint32_t freeHead_{kNoFreeSlot};
+  Stats stats_{};
+};
+
+} // namespace react
@@ -0,0 +1,154 @@
+#include "ReactScheduler/SchedulerTimeSlice.h"
+
+#include <algorithm>
+
+namespace react {
+
+void SchedulerSliceController::configure(const SchedulerSliceConfig& config, double frameIntervalMs) {
+  config_ = config;
+  config_.minSliceMs = std::max(config_.minSliceMs, 0.0);
+  config_.maxSliceMs = std::max(config_.maxSliceMs, config_.minSliceMs);
+  config_.growFactor = std::max(config_.growFactor, 1.0);
+  config_.shrinkFactor = std::clamp(config_.shrinkFactor, 0.0, 1.0);
+  config_.unitCostSmoothing = std::clamp(config_.unitCostSmoothing, 0.0, 1.0);
+
+  frameIntervalMs_ = frameIntervalMs;
+  adaptiveBudget_ = clampBudget(frameIntervalMs);
+  sliceBudget_ = config_.adaptive ? adaptiveBudget_ : frameIntervalMs_;
+  stats_.currentBudgetMs = sliceBudget_;
+}
+
+double SchedulerSliceController::clampBudget(double budgetMs) const {
+  return std::clamp(budgetMs, config_.minSliceMs, config_.maxSliceMs);
+}
+
+double SchedulerSliceController::beginSlice(bool inputPending, bool paintPending) {
+  sliceUnits_ = 0;
+  sliceYieldReason_ = SchedulerYieldReason::None;
+
+  if (!config_.adaptive) {
+    sliceBudget_ = frameIntervalMs_;
+  } else if (inputPending || paintPending) {
+    sliceBudget_ = config_.minSliceMs;
+  } else {
+    const double unitFloor = stats_.averageUnitCostMs * config_.minUnitsPerSlice;
+    sliceBudget_ = clampBudget(std::max(adaptiveBudget_, unitFloor));
+  }
+
+  stats_.currentBudgetMs = sliceBudget_;
+  return sliceBudget_;
+}
+
+void SchedulerSliceController::noteYield(SchedulerYieldReason reason, double overshootMs) {
+  if (sliceYieldReason_ != SchedulerYieldReason::None) {
+    return;
+  }
+  sliceYieldReason_ = reason;
+
+  switch (reason) {
+    case SchedulerYieldReason::Budget:
+      ++stats_.budgetYields;
+      stats_.totalOvershootMs += overshootMs;
+      stats_.maxOvershootMs = std::max(stats_.maxOvershootMs, overshootMs);
+      break;
+    case SchedulerYieldReason::Paint:
+      ++stats_.paintYields;
+      break;
+    case SchedulerYieldReason::Input:
+      ++stats_.inputYields;
+      break;
+    case SchedulerYieldReason::None:
+      break;
+  }
+}
+
+void SchedulerSliceController::endSlice(double durationMs, bool hasMoreWork) {
+  ++stats_.sliceCount;
+  stats_.unitCount += sliceUnits_;
+  stats_.totalSliceMs += durationMs;
+  stats_.lastSliceMs = durationMs;
+  stats_.lastSliceBudgetMs = sliceBudget_;
+  stats_.lastSliceUnits = sliceUnits_;
+  stats_.lastYieldReason = sliceYieldReason_;
+
+  if (sliceUnits_ > 0) {
+    const double unitCost = durationMs / static_cast<double>(sliceUnits_);
+    stats_.averageUnitCostMs = stats_.averageUnitCostMs == 0.0
+        ? unitCost
+        : stats_.averageUnitCostMs + config_.unitCostSmoothing * (unitCost - stats_.averageUnitCostMs);
+  }
+
+  if (!config_.adaptive) {
+    return;
+  }
+
+  switch (sliceYieldReason_) {
+    case SchedulerYieldReason::Paint:
+    case SchedulerYieldReason::Input:
+      adaptiveBudget_ = clampBudget(adaptiveBudget_ * config_.shrinkFactor);
+      break;
+    case SchedulerYieldReason::Budget:
+      if (hasMoreWork) {
+        adaptiveBudget_ = clampBudget(adaptiveBudget_ * config_.growFactor);
+      }
+      break;
+    case SchedulerYieldReason::None:
+      break;
+  }
+  stats_.currentBudgetMs = adaptiveBudget_;
+}
+
+void SchedulerSliceController::resetStats() {
+  const double currentBudget = stats_.currentBudgetMs;
+  stats_ = SchedulerSliceStats{};
+  stats_.currentBudgetMs = currentBudget;
+}
+
+void SchedulerYieldSampler::configure(const SchedulerYieldCheckConfig& config) {
+  config_ = config;
+  config_.maxStride = std::max<uint32_t>(config_.maxStride, 1);
+  config_.maxOvershootMs = std::max(config_.maxOvershootMs, 0.0);
+  stats_.stride = 1;
+  checksSinceSample_ = 0;
+}
+
+void SchedulerYieldSampler::onSample(double nowMs, double remainingMs) {
+  ++stats_.samples;
+  if (!config_.sampled) {
+    return;
+  }
+
+  if (checksSinceSample_ > 0) {
+    const double cost = (nowMs - lastSampleMs_) / static_cast<double>(checksSinceSample_);
+    // Smooth over a few samples; a single slow unit should not collapse the stride
+    stats_.checkCostMs = stats_.checkCostMs == 0.0 ? cost : stats_.checkCostMs + 0.25 * (cost - stats_.checkCostMs);
+  }
+  lastSampleMs_ = nowMs;
+  checksSinceSample_ = 0;
+
+  // Sample again before either the overshoot bound or the deadline is hit
+  planStride(std::min(config_.maxOvershootMs, std::max(remainingMs, 0.0)));
+}
+
+void SchedulerYieldSampler::beginSlice(double startMs) {
+  lastSampleMs_ = startMs;
+  checksSinceSample_ = 0;
+  // Reuse the cost learned in earlier slices instead of starting at 1
+  planStride(config_.maxOvershootMs);
+}
+
+void SchedulerYieldSampler::planStride(double windowMs) {
+  double stride = stats_.checkCostMs > 0.0 ? windowMs / stats_.checkCostMs : 1.0;
+  stride = std::clamp(stride, 1.0, static_cast<double>(config_.maxStride));
+  stats_.stride = static_cast<uint32_t>(stride);
+}
+
+void SchedulerYieldSampler::resetStats() {
+  const uint32_t stride = stats_.stride;
+  const double checkCost = stats_.checkCostMs;
+  stats_ = Stats{};
+  stats_.stride = stride;
+  stats_.checkCostMs = checkCost;
+}
+
+} // namespace react
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "ReactScheduler/SchedulerClock.h"
+
+#include <cstdint>
+
+namespace react {
+
+/**
+ * Time-slice policy for ReactScheduler::shouldYield
+ *
+ * Fixed mode (the default) yields after the frame interval set through
+ * forceFrameRate. Adaptive mode starts from the same interval and then:
+ * - Narrows the slice (down to minSliceMs) when a slice had to yield for a
+ *   paint request or for queued input-priority work
+ * - Widens it (up to maxSliceMs) while slices keep running out of budget
+ *   with more work left and nothing else is waiting
+ * - Never plans a slice shorter than minUnitsPerSlice units of work at the
+ *   measured average unit cost, so expensive units are not yielded after
+ *   every single one
+ * Slices that start with paint or input pressure pending use minSliceMs.
+ */
+struct SchedulerSliceConfig {
+  bool adaptive{false};
+  double minSliceMs{2.0};
+  double maxSliceMs{16.0};
+  double growFactor{1.25};
+  double shrinkFactor{0.5};
+  double minUnitsPerSlice{4.0};
+  // Weight of the newest slice in the average unit cost
+  double unitCostSmoothing{0.25};
+};
+
+enum class SchedulerYieldReason : uint8_t {
+  None,
+  Budget,
+  Paint,
+  Input,
+};
+
+/**
+ * Counters describing recent slices, for tuning the policy
+ * A unit is one shouldYield() check inside a slice, which the work loop
+ * performs once per unit of work.
+ */
+struct SchedulerSliceStats {
+  uint64_t sliceCount{0};
+  uint64_t unitCount{0};
+  uint64_t budgetYields{0};
+  uint64_t paintYields{0};
+  uint64_t inputYields{0};
+  double currentBudgetMs{0.0};
+  double averageUnitCostMs{0.0};
+  double totalSliceMs{0.0};
+  double totalOvershootMs{0.0};
+  double maxOvershootMs{0.0};
+  double lastSliceMs{0.0};
+  double lastSliceBudgetMs{0.0};
+  uint64_t lastSliceUnits{0};
+  SchedulerYieldReason lastYieldReason{SchedulerYieldReason::None};
+};
+
+class SchedulerSliceController {
+public:
+  void configure(const SchedulerSliceConfig& config, double frameIntervalMs);
+
+  const SchedulerSliceConfig& config() const {
+    return config_;
+  }
+
+  // Picks the budget for a slice that is about to start
+  double beginSlice(bool inputPending, bool paintPending);
+
+  void recordUnit() {
+    ++sliceUnits_;
+  }
+
+  // Only the first yield of a slice is recorded
+  void noteYield(SchedulerYieldReason reason, double overshootMs);
+
+  void endSlice(double durationMs, bool hasMoreWork);
+
+  double budget() const {
+    return sliceBudget_;
+  }
+
+  const SchedulerSliceStats& stats() const {
+    return stats_;
+  }
+
+  void resetStats();
+
+private:
+  double clampBudget(double budgetMs) const;
+
+  SchedulerSliceConfig config_{};
+  double frameIntervalMs_{5.0};
+  double adaptiveBudget_{5.0};
+  double sliceBudget_{5.0};
+  uint64_t sliceUnits_{0};
+  SchedulerYieldReason sliceYieldReason_{SchedulerYieldReason::None};
+  SchedulerSliceStats stats_{};
+};
+
+/**
+ * How shouldYield reads the clock
+ *
+ * By default every check reads the clock. With sampled checks only every
+ * stride-th check does; the stride is re-derived at each sample from the
+ * measured cost per check so that one stride of work stays under
+ * maxOvershootMs, and it shrinks as the slice deadline approaches.
+ */
+struct SchedulerYieldCheckConfig {
+  bool sampled{false};
+  SchedulerClockSource clock{SchedulerClockSource::SteadyClock};
+  uint32_t maxStride{256};
+  double maxOvershootMs{0.05};
+};
+
+class SchedulerYieldSampler {
+public:
+  struct Stats {
+    uint64_t checks{0};
+    uint64_t samples{0};
+    uint32_t stride{1};
+    double checkCostMs{0.0};
+  };
+
+  void configure(const SchedulerYieldCheckConfig& config);
+
+  void beginSlice(double startMs);
+
+  // Counts a check; true when this check should read the clock
+  bool shouldSample() {
+    ++stats_.checks;
+    return !config_.sampled || ++checksSinceSample_ >= stats_.stride;
+  }
+
+  // Re-plans the stride after reading the clock
+  void onSample(double nowMs, double remainingMs);
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  void resetStats();
+
+private:
+  void planStride(double windowMs);
+
+  SchedulerYieldCheckConfig config_{};
+  double lastSampleMs_{0.0};
+  uint32_t checksSinceSample_{0};
+  Stats stats_{};
+};
+
+} // namespace react
@@ -0,0 +1,250 @@
+#include "ReactScheduler/SchedulerTimerWheel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace react {
+
+namespace {
+
+constexpr uint64_t kSlotMask = SchedulerTimerWheel::kSlotsPerLevel - 1;
+
+inline uint64_t levelSpan(size_t level) {
+  return uint64_t{1} << (SchedulerTimerWheel::kSlotBits * level);
+}
+
+inline int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(value);
+#else
+  int count = 0;
+  while ((value & 1u) == 0) {
+    value >>= 1;
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// Rotates the occupancy bitmap so bit k maps to the k-th slot after start.
+inline uint64_t rotateFrom(uint64_t bits, uint64_t start) {
+  start &= kSlotMask;
+  return start == 0 ? bits : (bits >> start) | (bits << (SchedulerTimerWheel::kSlotsPerLevel - start));
+}
+
+} // namespace
+
+SchedulerTimerWheel::SchedulerTimerWheel(double tickMs, double currentTime)
+  : tickMs_(tickMs > 0.0 ? tickMs : 1.0), currentTick_(0) {
+  currentTick_ = tickFor(currentTime);
+}
+
+uint64_t SchedulerTimerWheel::tickFor(double time) const {
+  if (!(time > 0.0)) {
+    return 0;
+  }
+  const double tick = std::floor(time / tickMs_);
+  constexpr double kMaxTick = 9.0e18;
+  return tick >= kMaxTick ? static_cast<uint64_t>(kMaxTick) : static_cast<uint64_t>(tick);
+}
+
+void SchedulerTimerWheel::insert(SchedulerTask* task) {
+  if (task == nullptr || task->timerSlot != kNoTimerSlot) {
+    return;
+  }
+  place(task);
+}
+
+bool SchedulerTimerWheel::remove(SchedulerTask* task) {
+  if (task == nullptr || task->timerSlot == kNoTimerSlot) {
+    return false;
+  }
+  unlink(task);
+  return true;
+}
+
+void SchedulerTimerWheel::place(SchedulerTask* task) {
+  // Already-due tasks land in the current tick and expire on the next advance
+  const uint64_t expiryTick = std::max(tickFor(task->startTime), currentTick_);
+  const uint64_t delta = expiryTick - currentTick_;
+
+  for (size_t level = 0; level < kLevels; ++level) {
+    if (delta < levelSpan(level + 1)) {
+      const uint64_t index = (expiryTick >> (kSlotBits * level)) & kSlotMask;
+      link(static_cast<uint16_t>(level * kSlotsPerLevel + index), task);
+      return;
+    }
+  }
+  link(kOverflowSlot, task);
+}
+
+void SchedulerTimerWheel::link(uint16_t slotId, SchedulerTask* task) {
+  Slot& slot = slots_[slotId];
+  task->timerPrev = nullptr;
+  task->timerNext = slot.head;
+  if (slot.head != nullptr) {
+    slot.head->timerPrev = task;
+  }
+  slot.head = task;
+  task->timerSlot = slotId;
+  if (slotId != kOverflowSlot) {
+    occupied_[slotId / kSlotsPerLevel] |= uint64_t{1} << (slotId % kSlotsPerLevel);
+  }
+  ++size_;
+}
+
+void SchedulerTimerWheel::unlink(SchedulerTask* task) {
+  const uint16_t slotId = task->timerSlot;
+  Slot& slot = slots_[slotId];
+  if (task->timerPrev != nullptr) {
+    task->timerPrev->timerNext = task->timerNext;
+  } else {
+    slot.head = task->timerNext;
+  }
+  if (task->timerNext != nullptr) {
+    task->timerNext->timerPrev = task->timerPrev;
+  }
+  if (slot.head == nullptr && slotId != kOverflowSlot) {
+    occupied_[slotId / kSlotsPerLevel] &= ~(uint64_t{1} << (slotId % kSlotsPerLevel));
+  }
+  task->timerPrev = nullptr;
+  task->timerNext = nullptr;
+  task->timerSlot = kNoTimerSlot;
+  --size_;
+}
+
+void SchedulerTimerWheel::cascadeSlot(uint16_t slotId) {
+  Slot& slot = slots_[slotId];
+  SchedulerTask* node = slot.head;
+  if (node == nullptr) {
+    return;
+  }
+
+  slot.head = nullptr;
+  if (slotId != kOverflowSlot) {
+    occupied_[slotId / kSlotsPerLevel] &= ~(uint64_t{1} << (slotId % kSlotsPerLevel));
+  }
+
+  while (node != nullptr) {
+    SchedulerTask* next = node->timerNext;
+    node->timerPrev = nullptr;
+    node->timerNext = nullptr;
+    node->timerSlot = kNoTimerSlot;
+    --size_;
+    place(node);
+    node = next;
+  }
+}
+
+void SchedulerTimerWheel::cascade(uint64_t tick) {
+  // Re-place from the highest level down so tasks can fall through several
+  // levels at a shared boundary
+  if ((tick & (levelSpan(kLevels) - 1)) == 0) {
+    cascadeSlot(kOverflowSlot);
+  }
+  for (size_t level = kLevels - 1; level >= 1; --level) {
+    if ((tick & (levelSpan(level) - 1)) == 0) {
+      const uint64_t index = (tick >> (kSlotBits * level)) & kSlotMask;
+      cascadeSlot(static_cast<uint16_t>(level * kSlotsPerLevel + index));
+    }
+  }
+}
+
+void SchedulerTimerWheel::expireSlot(
+    size_t index,
+    double currentTime,
+    bool wholeTick,
+    std::vector<SchedulerTask*>& expired) {
+  Slot& slot = slots_[index];
+  SchedulerTask* node = slot.head;
+  while (node != nullptr) {
+    SchedulerTask* next = node->timerNext;
+    if (wholeTick || node->startTime <= currentTime) {
+      unlink(node);
+      expired.push_back(node);
+    }
+    node = next;
+  }
+}
+
+void SchedulerTimerWheel::advance(double currentTime, std::vector<SchedulerTask*>& expired) {
+  const uint64_t nowTick = tickFor(currentTime);
+
+  while (currentTick_ < nowTick) {
+    if (size_ == 0) {
+      currentTick_ = nowTick;
+      return;
+    }
+
+    // Every task in the current tick is due: its startTime precedes nowTick
+    const uint64_t index = currentTick_ & kSlotMask;
+    if ((occupied_[0] >> index) & 1u) {
+      expireSlot(index, currentTime, true, expired);
+    }
+
+    // Jump to the next occupied level 0 tick in this rotation, or to the
+    // rotation boundary where higher levels cascade
+    uint64_t next = (currentTick_ | kSlotMask) + 1;
+    const uint64_t later = index == kSlotMask ? 0 : occupied_[0] & (~uint64_t{0} << (index + 1));
+    if (later != 0) {
+      next = (currentTick_ & ~kSlotMask) + static_cast<uint64_t>(countTrailingZeros(later));
+    }
+    currentTick_ = std::min(next, nowTick);
+    if ((currentTick_ & kSlotMask) == 0) {
+      cascade(currentTick_);
+    }
+  }
+
+  // The current tick is only partially elapsed; check exact start times
+  const uint64_t index = currentTick_ & kSlotMask;
+  if ((occupied_[0] >> index) & 1u) {
+    expireSlot(index, currentTime, false, expired);
+  }
+}
+
+double SchedulerTimerWheel::nextExpiryTime() const {
+  if (size_ == 0) {
+    return -1.0;
+  }
+
+  double earliest = INFINITY;
+
+  // Level 0 holds individual ticks; report the exact earliest start time
+  const uint64_t level0 = rotateFrom(occupied_[0], currentTick_);
+  if (level0 != 0) {
+    const uint64_t tick = currentTick_ + static_cast<uint64_t>(countTrailingZeros(level0));
+    for (SchedulerTask* node = slots_[tick & kSlotMask].head; node != nullptr; node = node->timerNext) {
+      earliest = std::min(earliest, node->startTime);
+    }
+  }
+
+  // Higher levels hold whole rotations; their slot start is a lower bound.
+  // Slot k after the current one covers the k-th next rotation at that level.
+  for (size_t level = 1; level < kLevels; ++level) {
+    if (occupied_[level] == 0) {
+      continue;
+    }
+    const uint64_t block = currentTick_ >> (kSlotBits * level);
+    const uint64_t rotated = rotateFrom(occupied_[level], block + 1);
+    const uint64_t startBlock = block + 1 + static_cast<uint64_t>(countTrailingZeros(rotated));
+    earliest = std::min(earliest, static_cast<double>(startBlock << (kSlotBits * level)) * tickMs_);
+  }
+
+  if (slots_[kOverflowSlot].head != nullptr) {
+    const uint64_t span = levelSpan(kLevels);
+    const uint64_t boundary = (currentTick_ / span + 1) * span;
+    earliest = std::min(earliest, static_cast<double>(boundary) * tickMs_);
+  }
+
+  return earliest;
+}
+
+void SchedulerTimerWheel::clear() {
+  for (uint16_t slotId = 0; slotId <= kOverflowSlot; ++slotId) {
+    while (slots_[slotId].head != nullptr) {
+      unlink(slots_[slotId].head);
+    }
+  }
+}
+
+} // namespace react
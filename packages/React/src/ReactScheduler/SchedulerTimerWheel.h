@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ReactScheduler/SchedulerTaskPool.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace react {
+
+/**
+ * Hierarchical timer wheel for delayed Scheduler tasks
+ *
+ * Four levels of 64 slots each, with a configurable tick (1ms by default):
+ *   level 0: 64 ticks, level 1: 4096 ticks, level 2: 262144 ticks,
+ *   level 3: 16.7M ticks (~4.6 hours at 1ms). Anything further out waits in
+ *   an overflow list that is re-placed every level 3 rotation.
+ *
+ * Tasks are linked into slots through intrusive SchedulerTask fields, so
+ * insert and cancel are O(1) and never allocate. advance() walks only
+ * occupied level 0 slots (via an occupancy bitmap), cascades higher slots
+ * when their boundary is crossed, and hands every due task back in one batch.
+ * A task is reported due only once its exact startTime has been reached.
+ */
+class SchedulerTimerWheel {
+public:
+  static constexpr size_t kLevels = 4;
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlotsPerLevel = size_t{1} << kSlotBits;
+
+  explicit SchedulerTimerWheel(double tickMs = 1.0, double currentTime = 0.0);
+
+  // Non-copyable: slots hold intrusive links into pooled tasks
+  SchedulerTimerWheel(const SchedulerTimerWheel&) = delete;
+  SchedulerTimerWheel& operator=(const SchedulerTimerWheel&) = delete;
+
+  /**
+   * Insert a task keyed by its startTime in O(1)
+   */
+  void insert(SchedulerTask* task);
+
+  /**
+   * Unlink a pending task in O(1); returns false if it is not in the wheel
+   */
+  bool remove(SchedulerTask* task);
+
+  /**
+   * Move the wheel to currentTime and append every task whose startTime is
+   * <= currentTime to expired (in no particular order)
+   */
+  void advance(double currentTime, std::vector<SchedulerTask*>& expired);
+
+  /**
+   * Earliest time at which advance() may return a task, or a negative value
+   * when the wheel is empty. Exact for tasks within the level 0 window and a
+   * lower bound (slot start) for tasks further out.
+   */
+  double nextExpiryTime() const;
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  void clear();
+
+private:
+  static constexpr uint16_t kOverflowSlot = kLevels * kSlotsPerLevel;
+
+  struct Slot {
+    SchedulerTask* head{nullptr};
+  };
+
+  uint64_t tickFor(double time) const;
+  void place(SchedulerTask* task);
+  void link(uint16_t slotId, SchedulerTask* task);
+  void unlink(SchedulerTask* task);
+  void cascade(uint64_t tick);
+  void cascadeSlot(uint16_t slotId);
+  void expireSlot(size_t index, double currentTime, bool wholeTick, std::vector<SchedulerTask*>& expired);
+
+  double tickMs_;
+  uint64_t currentTick_;
+  size_t size_{0};
+  std::array<Slot, kLevels * kSlotsPerLevel + 1> slots_{};
+  std::array<uint64_t, kLevels> occupied_{};
+};
+
+} // namespace react
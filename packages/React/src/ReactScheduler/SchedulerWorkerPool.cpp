@@ -0,0 +1,279 @@
+#include "ReactScheduler/SchedulerWorkerPool.h"
+#include "ReactScheduler/SchedulerPriorities.h"
+
+#include <algorithm>
+
+namespace react {
+
+namespace {
+
+thread_local const SchedulerWorkerPool* currentPool = nullptr;
+thread_local size_t currentWorkerIndex = SIZE_MAX;
+
+} // namespace
+
+// SchedulerWorkerPool
+
+SchedulerWorkerPool::SchedulerWorkerPool(size_t threadCount) {
+  const size_t count = threadCount > 0 ? threadCount : defaultThreadCount();
+  workers_.reserve(count);
+  for (size_t index = 0; index < count; ++index) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  // Start threads only once every worker exists, since they steal from each other
+  for (size_t index = 0; index < count; ++index) {
+    workers_[index]->thread = std::thread([this, index]() { workerLoop(index); });
+  }
+}
+
+SchedulerWorkerPool::~SchedulerWorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    stopping_.store(true);
+  }
+  sleepCondition_.notify_all();
+  for (const auto& worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+size_t SchedulerWorkerPool::defaultThreadCount() {
+  const size_t hardwareThreads = std::thread::hardware_concurrency();
+  return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+size_t SchedulerWorkerPool::queueIndex(SchedulerPriority priority) {
+  if (!isValidPriority(priority) || priority == SchedulerPriority::NoPriority) {
+    priority = SchedulerPriority::NormalPriority;
+  }
+  return static_cast<size_t>(priority);
+}
+
+bool SchedulerWorkerPool::isWorkerThread() const {
+  return currentPool == this;
+}
+
+void SchedulerWorkerPool::submit(SchedulerPriority priority, Job job) {
+  if (!job) {
+    return;
+  }
+
+  const size_t queue = queueIndex(priority);
+  const size_t target = isWorkerThread() ? currentWorkerIndex
+                                         : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+  Worker& worker = *workers_[target];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queues[queue].push_back(std::move(job));
+    queued_[queue].fetch_add(1);
+    queuedTotal_.fetch_add(1);
+  }
+  submitted_.fetch_add(1, std::memory_order_relaxed);
+  wakeWorker();
+}
+
+void SchedulerWorkerPool::wakeWorker() {
+  // Pairs with the sleepers_ increment in workerLoop: either the worker sees
+  // the new job before sleeping or we see it asleep here
+  if (sleepers_.load() == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+  }
+  sleepCondition_.notify_one();
+}
+
+bool SchedulerWorkerPool::popLocal(size_t self, size_t queue, Job& out) {
+  Worker& worker = *workers_[self];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  auto& jobs = worker.queues[queue];
+  if (jobs.empty()) {
+    return false;
+  }
+  out = std::move(jobs.back());
+  jobs.pop_back();
+  queued_[queue].fetch_sub(1);
+  queuedTotal_.fetch_sub(1);
+  return true;
+}
+
+bool SchedulerWorkerPool::steal(size_t self, size_t queue, Job& out) {
+  const size_t count = workers_.size();
+  const size_t start = self < count ? self + 1 : nextWorker_.load(std::memory_order_relaxed);
+  for (size_t offset = 0; offset < count; ++offset) {
+    const size_t victim = (start + offset) % count;
+    if (victim == self) {
+      continue;
+    }
+
+    Worker& worker = *workers_[victim];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    auto& jobs = worker.queues[queue];
+    if (jobs.empty()) {
+      continue;
+    }
+    out = std::move(jobs.front());
+    jobs.pop_front();
+    queued_[queue].fetch_sub(1);
+    queuedTotal_.fetch_sub(1);
+    if (self < count) {
+      workers_[self]->stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+  return false;
+}
+
+bool SchedulerWorkerPool::takeJob(size_t self, Job& out) {
+  for (size_t queue = 0; queue < kQueueCount; ++queue) {
+    if (queued_[queue].load(std::memory_order_relaxed) == 0) {
+      continue;
+    }
+    if (self < workers_.size() && popLocal(self, queue, out)) {
+      return true;
+    }
+    if (steal(self, queue, out)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SchedulerWorkerPool::runPendingJob() {
+  const size_t self = isWorkerThread() ? currentWorkerIndex : SIZE_MAX;
+  Job job;
+  if (!takeJob(self, job)) {
+    return false;
+  }
+  job();
+  if (self < workers_.size()) {
+    workers_[self]->executed.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    executedByCallers_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+void SchedulerWorkerPool::workerLoop(size_t index) {
+  currentPool = this;
+  currentWorkerIndex = index;
+  Worker& worker = *workers_[index];
+
+  while (true) {
+    Job job;
+    if (takeJob(index, job)) {
+      job();
+      worker.executed.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleepers_.fetch_add(1);
+    sleepCondition_.wait(lock, [this]() { return queuedTotal_.load() > 0 || stopping_.load(); });
+    sleepers_.fetch_sub(1);
+    // Drain whatever is still queued before exiting
+    if (stopping_.load() && queuedTotal_.load() == 0) {
+      break;
+    }
+  }
+
+  currentPool = nullptr;
+  currentWorkerIndex = SIZE_MAX;
+}
+
+SchedulerWorkerPool::Stats SchedulerWorkerPool::stats() const {
+  Stats stats;
+  stats.threadCount = workers_.size();
+  stats.submitted = submitted_.load(std::memory_order_relaxed);
+  stats.executed = executedByCallers_.load(std::memory_order_relaxed);
+  for (const auto& worker : workers_) {
+    stats.executed += worker->executed.load(std::memory_order_relaxed);
+    stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+// SchedulerWorkGroup
+
+SchedulerWorkGroup::SchedulerWorkGroup(SchedulerWorkerPool& pool, SchedulerPriority priority)
+  : pool_(pool), priority_(priority), state_(std::make_shared<State>()) {
+}
+
+SchedulerWorkGroup::~SchedulerWorkGroup() {
+  try {
+    wait();
+  } catch (...) {
+  }
+}
+
+void SchedulerWorkGroup::run(SchedulerWorkerPool::Job job) {
+  run(priority_, std::move(job));
+}
+
+void SchedulerWorkGroup::run(SchedulerPriority priority, SchedulerWorkerPool::Job job) {
+  if (!job) {
+    return;
+  }
+
+  state_->pending.fetch_add(1);
+  pool_.submit(priority, [state = state_, job = std::move(job)]() {
+    try {
+      job();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!state->error) {
+        state->error = std::current_exception();
+      }
+    }
+    if (state->pending.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->condition.notify_all();
+    }
+  });
+}
+
+void SchedulerWorkGroup::parallelFor(
+    size_t count,
+    size_t grainSize,
+    const std::function<void(size_t, size_t)>& fn) {
+  if (count == 0) {
+    return;
+  }
+
+  // A few chunks per thread lets stealing even out uneven chunks
+  const size_t targetChunks = pool_.threadCount() * 4;
+  const size_t chunkSize = std::max<size_t>({grainSize, 1, (count + targetChunks - 1) / targetChunks});
+  auto shared = std::make_shared<std::function<void(size_t, size_t)>>(fn);
+  for (size_t begin = 0; begin < count; begin += chunkSize) {
+    const size_t end = std::min(count, begin + chunkSize);
+    run([shared, begin, end]() { (*shared)(begin, end); });
+  }
+}
+
+void SchedulerWorkGroup::wait() {
+  while (state_->pending.load() > 0) {
+    if (pool_.runPendingJob()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->condition.wait(lock, [this]() { return state_->pending.load() == 0; });
+  }
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    std::swap(error, state_->error);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+size_t SchedulerWorkGroup::pending() const {
+  return state_->pending.load();
+}
+
+} // namespace react
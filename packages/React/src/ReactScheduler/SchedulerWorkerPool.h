@@ -0,0 +1,150 @@
+#pragma once
+
+#include "ReactScheduler/Scheduler.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace react {
+
+/**
+ * Work-stealing thread pool for reconciler work that does not touch the JS
+ * runtime (native prop diffs, host tree construction, layout serialization)
+ *
+ * Every worker owns one deque per priority level. Jobs submitted from a
+ * worker go onto its own deques and are taken back LIFO, so fork/join work
+ * stays cache-warm; jobs submitted from other threads are spread round-robin.
+ * Idle workers steal FIFO from the others. Each worker always takes the
+ * highest priority job it can find, looking at its own deques before
+ * stealing.
+ *
+ * Jobs must not throw; use SchedulerWorkGroup to get exceptions (and
+ * results) back on the joining thread. The destructor runs every job that is
+ * still queued before joining the workers.
+ */
+class SchedulerWorkerPool {
+public:
+  using Job = std::function<void()>;
+
+  struct Stats {
+    size_t threadCount{0};
+    uint64_t submitted{0};
+    uint64_t executed{0};
+    uint64_t stolen{0};
+  };
+
+  // 0 picks defaultThreadCount()
+  explicit SchedulerWorkerPool(size_t threadCount = 0);
+  ~SchedulerWorkerPool();
+
+  SchedulerWorkerPool(const SchedulerWorkerPool&) = delete;
+  SchedulerWorkerPool& operator=(const SchedulerWorkerPool&) = delete;
+
+  void submit(SchedulerPriority priority, Job job);
+
+  // Runs one queued job on the calling thread; false if none was found.
+  // Joining threads use this to help instead of blocking.
+  bool runPendingJob();
+
+  size_t threadCount() const {
+    return workers_.size();
+  }
+
+  // True on one of this pool's worker threads
+  bool isWorkerThread() const;
+
+  Stats stats() const;
+
+  // One worker per hardware thread, leaving one for the JS thread
+  static size_t defaultThreadCount();
+
+private:
+  static constexpr size_t kQueueCount = static_cast<size_t>(SchedulerPriority::IdlePriority) + 1;
+
+  struct alignas(64) Worker {
+    std::mutex mutex;
+    std::array<std::deque<Job>, kQueueCount> queues;
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};
+    std::thread thread;
+  };
+
+  static size_t queueIndex(SchedulerPriority priority);
+
+  void workerLoop(size_t index);
+  bool takeJob(size_t self, Job& out);
+  bool popLocal(size_t self, size_t queue, Job& out);
+  bool steal(size_t self, size_t queue, Job& out);
+  void wakeWorker();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Jobs queued per priority, so lookups can skip empty levels
+  std::array<std::atomic<size_t>, kQueueCount> queued_{};
+  std::atomic<size_t> queuedTotal_{0};
+  std::atomic<size_t> nextWorker_{0};
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> executedByCallers_{0};
+
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCondition_;
+  std::atomic<size_t> sleepers_{0};
+  std::atomic<bool> stopping_{false};
+};
+
+/**
+ * Fork/join scope over a SchedulerWorkerPool
+ *
+ * run() offloads jobs and wait() joins them, executing queued jobs on the
+ * waiting thread meanwhile, so waiting from a worker never deadlocks. The
+ * first exception thrown by a job is rethrown from wait(). The destructor
+ * waits as well, but drops any exception.
+ */
+class SchedulerWorkGroup {
+public:
+  explicit SchedulerWorkGroup(
+    SchedulerWorkerPool& pool,
+    SchedulerPriority priority = SchedulerPriority::NormalPriority);
+  ~SchedulerWorkGroup();
+
+  SchedulerWorkGroup(const SchedulerWorkGroup&) = delete;
+  SchedulerWorkGroup& operator=(const SchedulerWorkGroup&) = delete;
+
+  void run(SchedulerWorkerPool::Job job);
+  void run(SchedulerPriority priority, SchedulerWorkerPool::Job job);
+
+  // Splits [0, count) into chunks of at least grainSize and calls
+  // fn(begin, end) for each chunk on the pool
+  void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn);
+
+  void wait();
+
+  size_t pending() const;
+
+  SchedulerWorkerPool& pool() const {
+    return pool_;
+  }
+
+private:
+  struct State {
+    std::atomic<size_t> pending{0};
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::exception_ptr error;
+  };
+
+  SchedulerWorkerPool& pool_;
+  SchedulerPriority priority_;
+  std::shared_ptr<State> state_;
+};
+
+} // namespace react
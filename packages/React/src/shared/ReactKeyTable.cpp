@@ -0,0 +1,147 @@
+#include "shared/ReactKeyTable.h"
+
+#include <deque>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace react {
+
+namespace {
+
+struct Entry {
+  std::string string;
+  std::uint32_t refs{0};
+  bool interned{false};
+};
+
+struct KeyTable {
+  // Deque elements never move, so the views in `ids` stay valid. Slot 0
+  // holds the empty string for NoReactKey.
+  std::deque<Entry> entries{Entry{}};
+  std::unordered_map<std::string_view, ReactKeyId> ids;
+  std::vector<ReactKeyId> freeSlots;
+  // Entries whose count dropped to zero since the last sweep; may repeat
+  std::vector<ReactKeyId> unheld;
+};
+
+// Null once the thread's table is gone, so keys released by objects that
+// outlive it (thread-exit or static destruction) are ignored
+thread_local KeyTable* currentTable = nullptr;
+
+struct KeyTableOwner {
+  std::unique_ptr<KeyTable> table{std::make_unique<KeyTable>()};
+
+  KeyTableOwner() {
+    currentTable = table.get();
+  }
+
+  ~KeyTableOwner() {
+    currentTable = nullptr;
+  }
+};
+
+KeyTable& keyTable() {
+  thread_local KeyTableOwner owner;
+  return *owner.table;
+}
+
+Entry* findEntry(ReactKeyId id) noexcept {
+  KeyTable* table = currentTable;
+  if (table == nullptr || id >= table->entries.size()) {
+    return nullptr;
+  }
+  return &table->entries[id];
+}
+
+} // namespace
+
+void retainReactKey(ReactKeyId id) noexcept {
+  if (Entry* entry = findEntry(id)) {
+    ++entry->refs;
+  }
+}
+
+void releaseReactKey(ReactKeyId id) noexcept {
+  Entry* entry = findEntry(id);
+  if (entry != nullptr && entry->refs != 0 && --entry->refs == 0) {
+    currentTable->unheld.push_back(id);
+  }
+}
+
+ReactKey internReactKey(std::string_view key) {
+  if (key.empty()) {
+    return ReactKey();
+  }
+
+  KeyTable& table = keyTable();
+  auto iter = table.ids.find(key);
+  if (iter != table.ids.end()) {
+    return ReactKey(iter->second);
+  }
+
+  ReactKeyId id = NoReactKey;
+  if (!table.freeSlots.empty()) {
+    id = table.freeSlots.back();
+    table.freeSlots.pop_back();
+    table.entries[id].string.assign(key);
+  } else {
+    if (table.entries.size() > std::numeric_limits<ReactKeyId>::max()) {
+      throw std::length_error("React key table is full");
+    }
+    id = static_cast<ReactKeyId>(table.entries.size());
+    table.entries.push_back(Entry{std::string(key)});
+  }
+  Entry& entry = table.entries[id];
+  entry.interned = true;
+  table.ids.emplace(std::string_view(entry.string), id);
+  return ReactKey(id);
+}
+
+ReactKey internReactKey(facebook::jsi::Runtime& runtime, const facebook::jsi::Value& key) {
+  if (key.isString()) {
+    return internReactKey(key.getString(runtime).utf8(runtime));
+  }
+  if (key.isNumber()) {
+    std::ostringstream out;
+    out << key.getNumber();
+    return internReactKey(out.str());
+  }
+  return ReactKey();
+}
+
+const std::string& reactKeyString(ReactKeyId id) {
+  KeyTable& table = keyTable();
+  if (id >= table.entries.size() || (id != NoReactKey && !table.entries[id].interned)) {
+    throw std::out_of_range("Unknown React key id");
+  }
+  return table.entries[id].string;
+}
+
+std::size_t sweepReactKeys() {
+  KeyTable& table = keyTable();
+  std::size_t freed = 0;
+  for (ReactKeyId id : table.unheld) {
+    Entry& entry = table.entries[id];
+    if (entry.refs != 0 || !entry.interned) {
+      continue;
+    }
+    table.ids.erase(std::string_view(entry.string));
+    entry.string.clear();
+    entry.string.shrink_to_fit();
+    entry.interned = false;
+    table.freeSlots.push_back(id);
+    ++freed;
+  }
+  table.unheld.clear();
+  return freed;
+}
+
+std::size_t internedReactKeyCount() {
+  return keyTable().ids.size();
+}
+
+} // namespace react
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "jsi/jsi.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace react {
+
+/**
+ * Per-thread intern table for element and fiber keys
+ *
+ * Each distinct key string maps to a 32-bit id, so the reconciler compares
+ * and hashes keys as integers. Key bytes are hashed once, when an element is
+ * created, and never again during reconciliation. The empty string maps to
+ * NoReactKey, which is the same as "no key".
+ *
+ * Entries are reference counted by the ReactKey handles that fibers and
+ * elements hold. An entry nobody holds stays interned until the next
+ * sweepReactKeys(), which the fiber reclamation task runs once a commit's
+ * garbage is gone, so the table tracks the keys of live trees rather than
+ * every key the process has seen.
+ */
+using ReactKeyId = std::uint32_t;
+
+// Lifetime rule: an id names its string only while a ReactKey holds it, or
+// until the next sweep once none does. A bare ReactKeyId is a borrowed view;
+// after a sweep its slot may be reused for another string. Ids belong to the
+// thread that interned them, which is the thread a runtime renders on.
+inline constexpr ReactKeyId NoReactKey = 0;
+
+void retainReactKey(ReactKeyId id) noexcept;
+void releaseReactKey(ReactKeyId id) noexcept;
+
+/**
+ * Counted reference to an interned key
+ *
+ * Converts to its ReactKeyId, so it compares and hashes like the raw id.
+ * NoReactKey costs nothing to copy or drop.
+ */
+class ReactKey {
+public:
+  ReactKey() noexcept = default;
+
+  // Takes a reference on an id already interned on this thread
+  explicit ReactKey(ReactKeyId id) noexcept
+    : id_(id) {
+    retain(id_);
+  }
+
+  ReactKey(const ReactKey& other) noexcept
+    : ReactKey(other.id_) {}
+
+  ReactKey(ReactKey&& other) noexcept
+    : id_(std::exchange(other.id_, NoReactKey)) {}
+
+  ~ReactKey() {
+    release(id_);
+  }
+
+  ReactKey& operator=(const ReactKey& other) noexcept {
+    ReactKey(other).swap(*this);
+    return *this;
+  }
+
+  ReactKey& operator=(ReactKey&& other) noexcept {
+    ReactKey(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  [[nodiscard]] ReactKeyId id() const noexcept {
+    return id_;
+  }
+
+  operator ReactKeyId() const noexcept {
+    return id_;
+  }
+
+  void swap(ReactKey& other) noexcept {
+    std::swap(id_, other.id_);
+  }
+
+private:
+  static void retain(ReactKeyId id) noexcept {
+    if (id != NoReactKey) {
+      retainReactKey(id);
+    }
+  }
+
+  static void release(ReactKeyId id) noexcept {
+    if (id != NoReactKey) {
+      releaseReactKey(id);
+    }
+  }
+
+  ReactKeyId id_{NoReactKey};
+};
+
+ReactKey internReactKey(std::string_view key);
+
+// Interns a JS key value: strings as-is, numbers in their decimal form, and
+// everything else (undefined, null, ...) as NoReactKey.
+ReactKey internReactKey(facebook::jsi::Runtime& runtime, const facebook::jsi::Value& key);
+
+// The string behind an id; empty for NoReactKey
+const std::string& reactKeyString(ReactKeyId id);
+
+// Frees the entries no ReactKey holds and returns how many it freed. Must not
+// run while a caller relies on a bare id it does not hold a ReactKey for.
+std::size_t sweepReactKeys();
+
+// Entries in this thread's table, including unheld ones not yet swept
+std::size_t internedReactKeyCount();
+
+} // namespace react
@@ -0,0 +1,148 @@
+#include "ReactDOM/client/ReactDOMChildList.h"
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactReconciler/ReactHostConfig.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "TestRuntime.h"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+std::shared_ptr<ReactDOMInstance> makeText(HostInterface& hostInterface, jsi::Runtime& runtime, const std::string& text) {
+  auto instance = hostInterface.createHostTextInstance(runtime, text);
+  instance->setKey(text);
+  return instance;
+}
+
+std::string order(const ReactDOMChildList& list) {
+  std::string out;
+  for (const auto& child : list) {
+    out += child->getKey();
+  }
+  return out;
+}
+
+bool testListLinksInOrder() {
+  TestRuntime runtime;
+  HostInterface hostInterface;
+  auto a = makeText(hostInterface, runtime, "a");
+  auto b = makeText(hostInterface, runtime, "b");
+  auto c = makeText(hostInterface, runtime, "c");
+  auto d = makeText(hostInterface, runtime, "d");
+
+  ReactDOMChildList list;
+  assert(list.empty() && list.begin() == list.end());
+  list.push_back(a);
+  list.push_back(c);
+  list.insert(c.get(), b);
+  list.insert(a.get(), d);
+  assert(order(list) == "dabc");
+  assert(list.size() == 4);
+  assert(list.front() == d && list.back() == c && list[2] == b);
+
+  // Re-inserting moves rather than duplicates
+  list.insert(nullptr, d);
+  assert(order(list) == "abcd" && list.size() == 4);
+
+  list.erase(*a);
+  list.erase(*d);
+  assert(order(list) == "bc" && list.back() == c);
+  assert(!list.contains(*a) && list.contains(*b));
+  list.erase(*a);
+  assert(list.size() == 2);
+
+  ReactDOMChildList other;
+  other.push_back(b);
+  assert(order(list) == "c" && order(other) == "b");
+  ReactDOMChildList::detach(*b);
+  assert(other.empty());
+  return true;
+}
+
+bool testHostInterfaceMovesChildrenBetweenParents() {
+  TestRuntime runtime;
+  HostInterface hostInterface;
+  jsi::Object props(runtime);
+  auto left = hostInterface.createHostInstance(runtime, "ul", props);
+  auto right = hostInterface.createHostInstance(runtime, "ul", props);
+  auto leftComponent = std::dynamic_pointer_cast<ReactDOMComponent>(left);
+  auto rightComponent = std::dynamic_pointer_cast<ReactDOMComponent>(right);
+
+  auto a = makeText(hostInterface, runtime, "a");
+  auto b = makeText(hostInterface, runtime, "b");
+  hostInterface.appendHostChild(left, a);
+  hostInterface.appendHostChild(left, b);
+  hostInterface.insertHostChildBefore(right, b, nullptr);
+  assert(order(leftComponent->children) == "a" && order(rightComponent->children) == "b");
+  assert(b->getParent() == right);
+
+  hostInterface.insertHostChildBefore(right, a, b);
+  assert(leftComponent->children.empty() && order(rightComponent->children) == "ab");
+
+  hostInterface.removeHostChild(right, a);
+  assert(order(rightComponent->children) == "b" && !a->getParent());
+  return true;
+}
+
+bool testHydrationCursorFollowsSiblingLinks() {
+  TestRuntime runtime;
+  auto hostInterface = std::make_shared<HostInterface>();
+  ReactRuntime reactRuntime;
+  reactRuntime.setHostInterface(hostInterface);
+  jsi::Object props(runtime);
+  auto container = hostInterface->createHostInstance(runtime, "tbody", props);
+  auto emptyRow = hostInterface->createHostInstance(runtime, "tr", props);
+  assert(hostconfig::getFirstHydratableChildWithinContainer(reactRuntime, container.get()) == nullptr);
+  assert(hostconfig::getFirstHydratableChild(reactRuntime, emptyRow) == nullptr);
+
+  std::vector<std::shared_ptr<ReactDOMInstance>> rows;
+  for (const char* key : {"a", "b", "c"}) {
+    rows.push_back(makeText(*hostInterface, runtime, key));
+    hostInterface->appendHostChild(container, rows.back());
+  }
+  hostInterface->removeHostChild(container, rows[1]);
+
+  void* cursor = hostconfig::getFirstHydratableChildWithinContainer(reactRuntime, container.get());
+  assert(cursor == rows[0].get());
+  assert(hostconfig::getFirstHydratableChild(reactRuntime, container) == cursor);
+  cursor = hostconfig::getNextHydratableSibling(reactRuntime, cursor);
+  assert(cursor == rows[2].get());
+  assert(rows[2]->previousSibling() == rows[0].get());
+  assert(hostconfig::getNextHydratableSibling(reactRuntime, cursor) == nullptr);
+  assert(rows[1]->nextSibling() == nullptr && rows[1]->previousSibling() == nullptr);
+  return true;
+}
+
+bool testLongListFreesIteratively() {
+  TestRuntime runtime;
+  HostInterface hostInterface;
+  jsi::Object props(runtime);
+  ReactDOMInstanceRef last;
+  {
+    auto parent = staticRefCast<ReactDOMComponent>(hostInterface.createHostInstanceRef(runtime, "ul", props));
+    for (std::size_t index = 0; index < 200000; ++index) {
+      last = hostInterface.createHostTextInstanceRef(runtime, "x");
+      parent->children.push_back(last);
+    }
+    assert(parent->children.size() == 200000 && last->refCount() == 2);
+  }
+  assert(last->refCount() == 1 && last->parent() == nullptr && last->previousSibling() == nullptr);
+  return true;
+}
+
+} // namespace
+
+bool runReactDOMChildListTests() {
+  return testListLinksInOrder() && testHostInterfaceMovesChildrenBetweenParents() &&
+      testHydrationCursorFollowsSiblingLinks() && testLongListFreesIteratively();
+}
+
+} // namespace react::test
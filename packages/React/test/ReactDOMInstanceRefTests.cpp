@@ -0,0 +1,115 @@
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactDOM/client/ReactDOMInstanceRef.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "TestRuntime.h"
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+namespace react::test {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+// Counts its destructions so tests can see when a handle frees it
+class ProbeInstance final : public ReactDOMInstance {
+public:
+  explicit ProbeInstance(int& destroyed)
+    : destroyed_(destroyed) {}
+
+  ~ProbeInstance() override {
+    ++destroyed_;
+  }
+
+  bool isTextInstance() const override {
+    return false;
+  }
+
+  std::string debugDescription() const override {
+    return "probe";
+  }
+
+private:
+  int& destroyed_;
+};
+
+bool testHandleFreesOnLastRelease() {
+  int destroyed = 0;
+  {
+    auto first = makeReactDOMRef<ProbeInstance>(destroyed);
+    assert(first->refCount() == 1);
+    ReactDOMInstanceRef second = first;
+    ReactDOMInstanceRef third = std::move(second);
+    assert(!second && third == first && first->refCount() == 2);
+    first.reset();
+    assert(destroyed == 0 && third->refCount() == 1);
+  }
+  assert(destroyed == 1);
+
+  // Instances not made through a handle are counted but never deleted
+  ProbeInstance onStack(destroyed);
+  {
+    ReactDOMInstanceRef handle(&onStack);
+    assert(onStack.refCount() == 1);
+  }
+  assert(onStack.refCount() == 0 && destroyed == 1);
+  return true;
+}
+
+bool testSharedPtrViewsHoldOneReference() {
+  int destroyed = 0;
+  std::shared_ptr<ReactDOMInstance> view;
+  {
+    auto handle = makeReactDOMRef<ProbeInstance>(destroyed);
+    view = handle;
+    std::shared_ptr<ReactDOMInstance> copy = view;
+    assert(handle->refCount() == 2 && copy == handle && handle == view);
+
+    // Back to a handle without a new control block
+    ReactDOMRef<ProbeInstance> fromView = dynamicRefCast<ProbeInstance>(ReactDOMInstanceRef(view));
+    assert(fromView == handle && handle->refCount() == 3);
+  }
+  assert(destroyed == 0 && view->refCount() == 1);
+  view.reset();
+  assert(destroyed == 1);
+  return true;
+}
+
+bool testParentFollowsTheTree() {
+  TestRuntime runtime;
+  HostInterface hostInterface;
+  jsi::Object props(runtime);
+  auto left = hostInterface.createHostInstanceRef(runtime, "ul", props);
+  auto right = hostInterface.createHostInstanceRef(runtime, "ul", props);
+  auto child = hostInterface.createHostTextInstanceRef(runtime, "a");
+  assert(child->parent() == nullptr && !child->getParent());
+
+  hostInterface.appendHostChild(left, child);
+  assert(child->parent() == left.get() && child->refCount() == 2);
+  hostInterface.insertHostChildBefore(right, child, nullptr);
+  assert(child->parent() == right.get() && child->refCount() == 2);
+  assert(child->getParent() == right);
+
+  // The shared_ptr adapters move the instance through the same list
+  child->setParent(left.share());
+  assert(child->parent() == left.get());
+  assert(staticRefCast<ReactDOMComponent>(right)->children.empty());
+  child->clearParent();
+  assert(child->parent() == nullptr && child->refCount() == 1);
+
+  // A parent going away drops its children's back-pointers with it
+  hostInterface.appendHostChild(right, child);
+  right.reset();
+  assert(child->parent() == nullptr && child->refCount() == 1);
+  return true;
+}
+
+} // namespace
+
+bool runReactDOMInstanceRefTests() {
+  return testHandleFreesOnLastRelease() && testSharedPtrViewsHoldOneReference() && testParentFollowsTheTree();
+}
+
+} // namespace react::test
@@ -0,0 +1,173 @@
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactDOM/client/ReactDOMPropertyPayload.h"
+#include "ReactReconciler/ReactHostConfig.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "TestRuntime.h"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace react::test {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+jsi::Value makeString(jsi::Runtime& runtime, const char* text) {
+  return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+}
+
+bool testInternedNamesAreStable() {
+  const PropId className = internPropName("className");
+  assert(internPropName("className") == className);
+  assert(internPropName("title") != className);
+  assert(propNameString(className) == "className");
+  return true;
+}
+
+bool testSnapshotOrdersByPropId() {
+  TestRuntime runtime;
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "zIndex", 3.0);
+  props.setProperty(runtime, "alt", makeString(runtime, "logo"));
+  props.setProperty(runtime, "hidden", true);
+  props.setProperty(runtime, "style", jsi::Object(runtime));
+
+  PropSnapshot snapshot = PropSnapshot::fromObject(runtime, props);
+  assert(snapshot.size() == 4);
+  for (std::size_t index = 1; index < snapshot.size(); ++index) {
+    assert(snapshot.entries()[index - 1].id < snapshot.entries()[index].id);
+  }
+
+  const PropValue* alt = snapshot.find("alt");
+  assert(alt != nullptr && alt->kind == PropValue::Kind::String && alt->string == "logo");
+  assert(snapshot.find("zIndex")->number == 3.0);
+  assert(snapshot.find("hidden")->boolean);
+  assert(snapshot.find("style")->kind == PropValue::Kind::Object);
+  assert(snapshot.find("missing") == nullptr);
+  return true;
+}
+
+bool testDiffEmitsSetsAndRemovals() {
+  TestRuntime runtime;
+  jsi::Object style(runtime);
+  jsi::Object prevProps(runtime);
+  prevProps.setProperty(runtime, "className", makeString(runtime, "old"));
+  prevProps.setProperty(runtime, "title", makeString(runtime, "same"));
+  prevProps.setProperty(runtime, "tabIndex", 1.0);
+  prevProps.setProperty(runtime, "opacity", std::numeric_limits<double>::quiet_NaN());
+  prevProps.setProperty(runtime, "style", style);
+  prevProps.setProperty(runtime, "onClick", jsi::Object(runtime));
+
+  jsi::Object nextProps(runtime);
+  nextProps.setProperty(runtime, "className", makeString(runtime, "new"));
+  nextProps.setProperty(runtime, "title", makeString(runtime, "same"));
+  nextProps.setProperty(runtime, "opacity", std::numeric_limits<double>::quiet_NaN());
+  nextProps.setProperty(runtime, "style", style);
+  nextProps.setProperty(runtime, "onClick", jsi::Object(runtime));
+  nextProps.setProperty(runtime, "disabled", false);
+
+  PropUpdatePayload payload;
+  assert(diffPropSnapshots(
+      runtime, PropSnapshot::fromObject(runtime, prevProps), PropSnapshot::fromObject(runtime, nextProps), payload));
+  // className changed, tabIndex went away, a new handler object, disabled
+  // was added; the same style object and NaN opacity are unchanged
+  assert(payload.operationCount() == 4);
+
+  PropSnapshot applied = PropSnapshot::fromObject(runtime, prevProps);
+  applyPropUpdatePayload(payload, applied);
+  assert(applied.size() == 6);
+  assert(applied.find("className")->string == "new");
+  assert(applied.find("tabIndex") == nullptr);
+  assert(applied.find("disabled")->kind == PropValue::Kind::Bool);
+  assert(!applied.find("disabled")->boolean);
+  assert(std::isnan(applied.find("opacity")->number));
+
+  PropUpdatePayload unchanged;
+  assert(!diffPropSnapshots(runtime, applied, PropSnapshot::fromObject(runtime, nextProps), unchanged));
+  assert(unchanged.empty() && unchanged.bytes().empty());
+  return true;
+}
+
+bool testComponentAppliesPayloadWithoutJsi() {
+  TestRuntime runtime;
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "className", makeString(runtime, "chip"));
+  props.setProperty(runtime, "tabIndex", 0.0);
+  auto component = makeReactDOMRef<ReactDOMComponent>("span", runtime, props);
+
+  PropSnapshot next = component->getPropSnapshot();
+  next.set(internPropName("className"), PropValue::fromJsi(runtime, makeString(runtime, "card")));
+  next.erase(internPropName("tabIndex"));
+
+  PropUpdatePayload payload;
+  assert(diffPropSnapshots(runtime, component->getPropSnapshot(), next, payload));
+  component->applyPropUpdate(payload);
+  assert(component->getPropSnapshot().size() == 1);
+
+  // The JS view catches up on the next read
+  const auto& view = component->getProps();
+  assert(view.size() == 1);
+  assert(view.at("className").getString(runtime).utf8(runtime) == "card");
+  return true;
+}
+
+bool testLegacyPayloadShapeIsUnchanged() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  jsi::Object prevProps(runtime);
+  prevProps.setProperty(runtime, "className", makeString(runtime, "old"));
+  prevProps.setProperty(runtime, "title", makeString(runtime, "gone"));
+  jsi::Object nextProps(runtime);
+  nextProps.setProperty(runtime, "className", makeString(runtime, "new"));
+
+  jsi::Value payload = hostconfig::prepareUpdate(
+      reactRuntime, runtime, jsi::Value(runtime, prevProps), jsi::Value(runtime, nextProps), false);
+  assert(payload.isObject());
+  jsi::Object payloadObject = payload.getObject(runtime);
+  jsi::Object attributes = payloadObject.getProperty(runtime, "attributes").getObject(runtime);
+  assert(attributes.getProperty(runtime, "className").getString(runtime).utf8(runtime) == "new");
+  jsi::Array removed = payloadObject.getProperty(runtime, "removedAttributes").getObject(runtime).getArray(runtime);
+  assert(removed.size(runtime) == 1);
+  assert(removed.getValueAtIndex(runtime, 0).getString(runtime).utf8(runtime) == "title");
+
+  jsi::Value same = hostconfig::prepareUpdate(
+      reactRuntime, runtime, jsi::Value(runtime, nextProps), jsi::Value(runtime, nextProps), false);
+  assert(same.isUndefined());
+  return true;
+}
+
+bool testHostInterfaceCommitsNativePayload() {
+  TestRuntime runtime;
+  auto hostInterface = std::make_shared<HostInterface>();
+  ReactRuntime reactRuntime;
+  reactRuntime.setHostInterface(hostInterface);
+
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "id", makeString(runtime, "row-1"));
+  auto instance = hostInterface->createHostInstance(runtime, "li", props);
+  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+
+  jsi::Object nextProps(runtime);
+  nextProps.setProperty(runtime, "id", makeString(runtime, "row-2"));
+  PropUpdatePayload payload;
+  assert(hostconfig::prepareUpdate(
+      reactRuntime, runtime, component->getPropSnapshot(), PropSnapshot::fromObject(runtime, nextProps), payload));
+  hostconfig::commitUpdate(reactRuntime, instance, payload);
+  assert(component->getPropSnapshot().find("id")->string == "row-2");
+  return true;
+}
+
+} // namespace
+
+bool runReactDOMPropertyPayloadTests() {
+  return testInternedNamesAreStable() && testSnapshotOrdersByPropId() && testDiffEmitsSetsAndRemovals() &&
+      testComponentAppliesPayloadWithoutJsi() && testLegacyPayloadShapeIsUnchanged() &&
+      testHostInterfaceCommitsNativePayload();
+}
+
+} // namespace react::test
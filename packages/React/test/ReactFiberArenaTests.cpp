@@ -0,0 +1,235 @@
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberArena.h"
+#include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberRootPool.h"
+#include "ReactReconciler/ReactFiberRootScheduleIndex.h"
+#include "ReactReconciler/ReactFiberWorkLoop.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "TestRuntime.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+bool testAllocateAndReuse() {
+  FiberArena arena;
+  std::vector<FiberNode*> fibers;
+  for (size_t index = 0; index < FiberArena::kFibersPerSlab + 10; ++index) {
+    fibers.push_back(arena.allocate());
+  }
+  assert(arena.stats().liveFibers == FiberArena::kFibersPerSlab + 10);
+  assert(arena.stats().slabCount == 2);
+  assert(arena.owns(fibers.front()));
+  assert(arena.owns(fibers.back()));
+
+  // Fibers of the same slab are laid out back to back
+  assert(fibers[1] == fibers[0] + 1);
+
+  FiberNode* released = fibers[5];
+  assert(arena.release(released));
+  assert(!arena.owns(released));
+  // Double release and foreign fibers are rejected
+  assert(!arena.release(released));
+  FiberNode heapFiber;
+  assert(!arena.release(&heapFiber));
+  assert(!arena.owns(&heapFiber));
+
+  FiberNode* reused = arena.allocate();
+  assert(reused == released);
+  assert(reused->tag == WorkTag::IndeterminateComponent);
+  assert(reused->getKey().empty());
+  assert(arena.stats().reuses == 1);
+  assert(arena.stats().peakLiveFibers == FiberArena::kFibersPerSlab + 10);
+
+  arena.releaseAll();
+  assert(arena.stats().liveFibers == 0);
+  assert(arena.stats().slabCount == 0);
+  assert(!arena.owns(fibers.front()));
+  assert(arena.stats().peakLiveFibers == FiberArena::kFibersPerSlab + 10);
+  return true;
+}
+
+bool testCreateFiberUsesScopedArena() {
+  FiberArena arena;
+  FiberNode* heapFiber = createFiber(WorkTag::HostComponent);
+  assert(!arena.owns(heapFiber));
+  delete heapFiber;
+
+  {
+    FiberArenaScope scope(&arena);
+    assert(currentFiberArena() == &arena);
+
+    FiberNode* current = createFiber(WorkTag::HostComponent, nullptr, "key", ConcurrentMode);
+    current->ensureDependencies();
+    assert(arena.owns(current));
+    assert(current->getKey() == "key");
+
+    // Alternates come from the same arena
+    FiberNode* workInProgress = createWorkInProgress(current, nullptr);
+    assert(arena.owns(workInProgress));
+    assert(workInProgress->alternate == current);
+
+    {
+      FiberArenaScope nested(nullptr);
+      FiberNode* unscoped = createFiber(WorkTag::HostText);
+      assert(!arena.owns(unscoped));
+      delete unscoped;
+    }
+    assert(currentFiberArena() == &arena);
+    assert(arena.stats().liveFibers == 2);
+  }
+  assert(currentFiberArena() == nullptr);
+  return true;
+}
+
+bool testRootUnmountReleasesEverything() {
+  FiberRoot root{};
+  FiberArena& arena = ensureRootFiberArena(root);
+  assert(&ensureRootFiberArena(root) == &arena);
+
+  {
+    FiberArenaScope scope(root.fiberArena.get());
+    root.current = createHostRootFiber(RootTag::ConcurrentRoot, false);
+    FiberNode* previous = nullptr;
+    for (int index = 0; index < 1000; ++index) {
+      FiberNode* fiber = createFiber(WorkTag::HostComponent);
+      fiber->returnFiber = root.current;
+      if (previous == nullptr) {
+        root.current->child = fiber;
+      } else {
+        previous->sibling = fiber;
+      }
+      previous = fiber;
+    }
+  }
+  assert(arena.stats().liveFibers == 1001);
+
+  releaseRootFibers(root);
+  assert(root.current == nullptr);
+  assert(arena.stats().liveFibers == 0);
+  assert(arena.stats().peakLiveFibers == 1001);
+  return true;
+}
+
+bool testResetKeepsSlabs() {
+  FiberArena arena;
+  std::vector<FiberNode*> fibers;
+  for (size_t index = 0; index < FiberArena::kFibersPerSlab * 2; ++index) {
+    fibers.push_back(arena.allocate());
+  }
+  arena.reset();
+  assert(arena.stats().liveFibers == 0);
+  assert(arena.stats().slabCount == 2);
+  assert(!arena.owns(fibers.front()));
+
+  // Refilling walks the kept slabs before growing
+  std::vector<FiberNode*> refilled;
+  for (size_t index = 0; index < FiberArena::kFibersPerSlab * 2; ++index) {
+    refilled.push_back(arena.allocate());
+  }
+  assert(arena.stats().slabCount == 2);
+  assert(arena.owns(refilled.back()));
+  arena.allocate();
+  assert(arena.stats().slabCount == 3);
+  return true;
+}
+
+bool testRootPoolRecycles() {
+  FiberRootPool pool(1);
+  int container = 0;
+  std::unique_ptr<FiberRoot> root = pool.acquire(RootTag::ConcurrentRoot, false, &container);
+  assert(pool.stats().misses == 1);
+  assert(root->current != nullptr && root->current->tag == WorkTag::HostRoot);
+  assert(root->current->stateNode == root.get());
+  assert(root->containerInfo == &container);
+  assert(root->fiberArena->owns(root->current));
+
+  // Leave state behind that a fresh root must not see
+  {
+    FiberArenaScope scope(root->fiberArena.get());
+    root->current->child = createFiber(WorkTag::HostComponent);
+  }
+  RootScheduleIndex index;
+  index.add(*root);
+  markRootUpdated(*root, SyncLane);
+  ConcurrentUpdate update{};
+  markHiddenUpdate(*root, &update, TransitionLane1);
+
+  FiberRoot* const recycled = root.get();
+  FiberArena* const arena = root->fiberArena.get();
+  pool.release(std::move(root));
+  assert(pool.pooledRoots() == 1);
+  assert(index.empty());
+
+  std::unique_ptr<FiberRoot> reused = pool.acquire(RootTag::LegacyRoot, false, nullptr);
+  assert(reused.get() == recycled);
+  assert(reused->fiberArena.get() == arena);
+  assert(arena->stats().liveFibers == 1);
+  assert(reused->tag == RootTag::LegacyRoot);
+  assert(reused->pendingLanes == NoLanes);
+  assert(reused->hiddenUpdates.empty());
+  assert(reused->scheduleIndex == nullptr);
+  assert(reused->current->child == nullptr);
+  assert(pool.stats().hits == 1 && pool.stats().misses == 1);
+
+  // Past capacity, released roots are destroyed
+  std::unique_ptr<FiberRoot> extra = pool.acquire(RootTag::ConcurrentRoot, false, nullptr);
+  pool.release(std::move(reused));
+  pool.release(std::move(extra));
+  assert(pool.pooledRoots() == 1);
+  assert(pool.stats().releases == 3 && pool.stats().discards == 1);
+
+  pool.setCapacity(0);
+  assert(pool.pooledRoots() == 0);
+  return true;
+}
+
+bool testRuntimeRootsRenderIntoTheirArena() {
+  TestRuntime jsRuntime;
+  ReactRuntime runtime;
+  int container = 0;
+  std::unique_ptr<FiberRoot> root = runtime.createFiberRoot(RootTag::ConcurrentRoot, false, &container);
+  FiberArena* const arena = root->fiberArena.get();
+  assert(arena != nullptr && arena->owns(root->current));
+
+  root->pendingLanes = DefaultLane;
+  const RootExitStatus exitStatus = renderRootSync(runtime, jsRuntime, *root, DefaultLane, false);
+  assert(exitStatus == RootExitStatus::Completed);
+  assert(arena->owns(root->current->alternate));
+  assert(arena->stats().liveFibers == 2);
+
+  // Unmounting abandons a render of the root before recycling it
+  {
+    FiberArenaScope scope(arena);
+    prepareFreshStack(runtime, *root, DefaultLane);
+  }
+  assert(getWorkInProgressRoot(runtime) == root.get());
+  FiberRoot* const unmounted = root.get();
+  runtime.unmountFiberRoot(std::move(root));
+  assert(getWorkInProgressRoot(runtime) == nullptr);
+  assert(arena->stats().liveFibers == 0);
+  assert(runtime.rootPool().pooledRoots() == 1);
+
+  std::unique_ptr<FiberRoot> next = runtime.createFiberRoot(RootTag::LegacyRoot, false, nullptr);
+  assert(next.get() == unmounted && next->fiberArena.get() == arena);
+  assert(runtime.rootPool().stats().hits == 1);
+
+  // A full pool frees the root's fibers in bulk instead
+  runtime.rootPool().setCapacity(0);
+  runtime.unmountFiberRoot(std::move(next));
+  assert(runtime.rootPool().stats().discards == 1);
+  return true;
+}
+
+} // namespace
+
+bool runReactFiberArenaTests() {
+  return testAllocateAndReuse() && testCreateFiberUsesScopedArena() && testRootUnmountReleasesEverything() &&
+      testResetKeepsSlabs() && testRootPoolRecycles() && testRuntimeRootsRenderIntoTheirArena();
+}
+
+} // namespace react::test
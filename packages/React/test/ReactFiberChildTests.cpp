@@ -0,0 +1,198 @@
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberChild.h"
+#include "ReactReconciler/ReactFiberFlags.h"
+#include "ReactReconciler/ReactFiberTypeDescriptor.h"
+#include "ReactRuntime/ReactJSXRuntime.h"
+#include "TestRuntime.h"
+#include "shared/ReactSymbols.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+jsi::Array makeKeyedChildren(TestRuntime& runtime, const std::vector<std::string>& keys) {
+  jsi::Array children = runtime.makeArray(keys.size());
+  for (std::size_t index = 0; index < keys.size(); ++index) {
+    auto element = jsx::jsx(
+        runtime,
+        jsi::Value(runtime, jsi::String::createFromUtf8(runtime, "li")),
+        jsi::Value(runtime, jsi::Object(runtime)),
+        jsi::Value(runtime, jsi::String::createFromUtf8(runtime, keys[index])));
+    children.setValueAtIndex(runtime, index, jsx::createJsxHostValue(runtime, element));
+  }
+  return children;
+}
+
+struct ChildUpdate {
+  FiberNode* firstChild{nullptr};
+  FiberNode* workInProgress{nullptr};
+};
+
+ChildUpdate mountChildren(TestRuntime& runtime, const std::vector<std::string>& keys) {
+  ChildUpdate mounted;
+  mounted.workInProgress = createFiber(WorkTag::HostComponent);
+  const jsi::Value children(runtime, makeKeyedChildren(runtime, keys));
+  mounted.firstChild = mountChildFibers(nullptr, runtime, *mounted.workInProgress, children, DefaultLane);
+  return mounted;
+}
+
+ChildUpdate updateChildren(TestRuntime& runtime, FiberNode* currentFirstChild, const std::vector<std::string>& keys) {
+  ChildUpdate updated;
+  updated.workInProgress = createFiber(WorkTag::HostComponent);
+  const jsi::Value children(runtime, makeKeyedChildren(runtime, keys));
+  updated.firstChild =
+      reconcileChildFibers(nullptr, runtime, currentFirstChild, *updated.workInProgress, children, DefaultLane);
+  return updated;
+}
+
+std::vector<std::string> keysOf(FiberNode* child) {
+  std::vector<std::string> keys;
+  for (; child != nullptr; child = child->sibling) {
+    keys.push_back(child->getKey());
+  }
+  return keys;
+}
+
+std::vector<std::string> placedKeysOf(FiberNode* child) {
+  std::vector<std::string> keys;
+  for (; child != nullptr; child = child->sibling) {
+    if ((child->flags & Placement) != 0) {
+      keys.push_back(child->getKey());
+    }
+  }
+  return keys;
+}
+
+std::vector<std::string> deletedKeysOf(const FiberNode& workInProgress) {
+  std::vector<std::string> keys;
+  for (FiberNode* deleted : workInProgress.getDeletions()) {
+    keys.push_back(deleted->getKey());
+  }
+  return keys;
+}
+
+bool allReused(FiberNode* child) {
+  for (; child != nullptr; child = child->sibling) {
+    if (child->alternate == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+using Keys = std::vector<std::string>;
+
+bool testUnchangedAndRemoveFromEnd() {
+  TestRuntime runtime;
+  ChildUpdate mounted = mountChildren(runtime, {"a", "b", "c", "d"});
+
+  ChildUpdate unchanged = updateChildren(runtime, mounted.firstChild, {"a", "b", "c", "d"});
+  assert((keysOf(unchanged.firstChild) == Keys{"a", "b", "c", "d"}));
+  assert(allReused(unchanged.firstChild));
+  assert(placedKeysOf(unchanged.firstChild).empty());
+  assert(deletedKeysOf(*unchanged.workInProgress).empty());
+
+  ChildUpdate truncated = updateChildren(runtime, mounted.firstChild, {"a", "b"});
+  assert((keysOf(truncated.firstChild) == Keys{"a", "b"}));
+  assert(placedKeysOf(truncated.firstChild).empty());
+  assert((deletedKeysOf(*truncated.workInProgress) == Keys{"c", "d"}));
+  return true;
+}
+
+bool testAppendAndPrepend() {
+  TestRuntime runtime;
+  ChildUpdate mounted = mountChildren(runtime, {"a", "b"});
+
+  ChildUpdate appended = updateChildren(runtime, mounted.firstChild, {"a", "b", "c"});
+  assert((keysOf(appended.firstChild) == Keys{"a", "b", "c"}));
+  assert((placedKeysOf(appended.firstChild) == Keys{"c"}));
+  assert(deletedKeysOf(*appended.workInProgress).empty());
+
+  ChildUpdate prepended = updateChildren(runtime, mounted.firstChild, {"z", "a", "b"});
+  assert((keysOf(prepended.firstChild) == Keys{"z", "a", "b"}));
+  assert(prepended.firstChild->sibling->alternate != nullptr);
+  assert((placedKeysOf(prepended.firstChild) == Keys{"z"}));
+  assert(deletedKeysOf(*prepended.workInProgress).empty());
+  return true;
+}
+
+bool testReorderAndReplace() {
+  TestRuntime runtime;
+  ChildUpdate mounted = mountChildren(runtime, {"a", "b", "c", "d"});
+
+  // Only the children that moved left of an already placed one are placed
+  ChildUpdate reversed = updateChildren(runtime, mounted.firstChild, {"d", "c", "b", "a"});
+  assert((keysOf(reversed.firstChild) == Keys{"d", "c", "b", "a"}));
+  assert(allReused(reversed.firstChild));
+  assert((placedKeysOf(reversed.firstChild) == Keys{"c", "b", "a"}));
+  assert(deletedKeysOf(*reversed.workInProgress).empty());
+
+  ChildUpdate replaced = updateChildren(runtime, mounted.firstChild, {"a", "x", "c"});
+  assert((keysOf(replaced.firstChild) == Keys{"a", "x", "c"}));
+  assert((placedKeysOf(replaced.firstChild) == Keys{"x"}));
+  const Keys deleted = deletedKeysOf(*replaced.workInProgress);
+  assert(deleted.size() == 2);
+  assert((deleted == Keys{"b", "d"} || deleted == Keys{"d", "b"}));
+  return true;
+}
+
+bool testTypeDescriptorsAreCached() {
+  TestRuntime runtime;
+  const jsi::Value div(runtime, jsi::String::createFromUtf8(runtime, "div"));
+  const jsi::Value otherDiv(runtime, jsi::String::createFromUtf8(runtime, "div"));
+  const FiberTypeDescriptorPtr host = describeElementType(runtime, div);
+  assert(host->tag == WorkTag::HostComponent);
+  assert(host->isHostComponent);
+  assert(host->hostType == "div");
+  assert(describeElementType(runtime, otherDiv) == host);
+
+  // Component types are keyed by identity, not by shape
+  jsi::Object component(runtime);
+  component.setProperty(runtime, "displayName", jsi::String::createFromUtf8(runtime, "Row"));
+  const jsi::Value componentType(runtime, component);
+  const FiberTypeDescriptorPtr described = describeElementType(runtime, componentType);
+  assert(described->tag == WorkTag::FunctionComponent);
+  assert(!described->isHostComponent);
+  assert(described->displayName == "Row");
+  assert(describeElementType(runtime, componentType) == described);
+
+  jsi::Object lookalike(runtime);
+  lookalike.setProperty(runtime, "displayName", jsi::String::createFromUtf8(runtime, "Row"));
+  assert(describeElementType(runtime, jsi::Value(runtime, lookalike)) != described);
+  return true;
+}
+
+bool testSymbolTypesMatchByIdentity() {
+  TestRuntime runtime;
+  runtime.installSymbolRegistry();
+  const jsi::Value fragment(runtime, resolveSymbol(runtime, REACT_FRAGMENT_TYPE));
+  const jsi::Value suspense(runtime, resolveSymbol(runtime, REACT_SUSPENSE_TYPE));
+  assert(describeElementType(runtime, fragment)->tag == WorkTag::Fragment);
+  assert(describeElementType(runtime, suspense)->tag == WorkTag::SuspenseComponent);
+
+  // Same text as Symbol.for("react.fragment"), but a different symbol
+  const jsi::Value impostor(runtime, runtime.createSymbol("react.fragment"));
+  assert(impostor.getSymbol(runtime).toString(runtime) == "Symbol(react.fragment)");
+  assert(describeElementType(runtime, impostor)->tag == WorkTag::FunctionComponent);
+
+  // Unknown types share one descriptor that outlives the call
+  const FiberTypeDescriptorPtr unknown = describeElementType(runtime, jsi::Value::undefined());
+  assert(describeElementType(runtime, jsi::Value(42)) == unknown);
+  assert(unknown->tag == WorkTag::FunctionComponent);
+  return true;
+}
+
+} // namespace
+
+bool runReactFiberChildTests() {
+  return testUnchangedAndRemoveFromEnd() && testAppendAndPrepend() && testReorderAndReplace() &&
+      testTypeDescriptorsAreCached() && testSymbolTypesMatchByIdentity();
+}
+
+} // namespace react::test
@@ -70,8 +70,8 @@ bool runReactFiberConcurrentUpdatesRuntimeTests() {
   finishQueueingConcurrentUpdates();
 
   const auto index = laneToIndex(TransitionLane1);
-  const auto& hiddenSlot = rootState.hiddenUpdates[index];
-  if (hiddenSlot.has_value()) {
+  const auto* hiddenSlot = rootState.hiddenUpdates.find(index);
+  if (hiddenSlot != nullptr) {
     bool containsUpdate = false;
     for (auto* entry : *hiddenSlot) {
       if (entry == &hiddenUpdate) {
@@ -0,0 +1,108 @@
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberKeyMap.h"
+#include "shared/ReactKeyTable.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+bool testInternTable() {
+  assert(internReactKey("") == NoReactKey);
+  assert(reactKeyString(NoReactKey).empty());
+
+  const ReactKey first = internReactKey("key-table-first");
+  const std::size_t count = internedReactKeyCount();
+  assert(first != NoReactKey);
+  assert(internReactKey(std::string("key-table-first")) == first);
+  assert(internedReactKeyCount() == count);
+  assert(reactKeyString(first) == "key-table-first");
+
+  const ReactKey second = internReactKey("key-table-second");
+  assert(second != first);
+  assert(reactKeyString(second) == "key-table-second");
+  return true;
+}
+
+bool testUnheldKeysAreSwept() {
+  sweepReactKeys();
+  const std::size_t baseline = internedReactKeyCount();
+  ReactKeyId droppedId = NoReactKey;
+  {
+    FiberNode* fiber = createFiber(WorkTag::HostComponent, nullptr, "key-table-fiber");
+    droppedId = fiber->key;
+    ReactKey copy = fiber->key;
+    delete fiber;
+
+    // Still held by the copy
+    assert(sweepReactKeys() == 0);
+    assert(reactKeyString(copy) == "key-table-fiber");
+  }
+  // Unheld but not yet swept: re-interning finds the same id
+  assert(internedReactKeyCount() == baseline + 1);
+  assert(internReactKey("key-table-fiber") == droppedId);
+
+  assert(sweepReactKeys() == 1);
+  assert(internedReactKeyCount() == baseline);
+
+  // The freed slot is reused for the next new key
+  const ReactKey reused = internReactKey("key-table-reused");
+  assert(reused == droppedId);
+  assert(reactKeyString(reused) == "key-table-reused");
+  return true;
+}
+
+bool testKeyedAndIndexSlotsAreDistinct() {
+  FiberKeyMap map;
+  map.reset(4);
+  FiberNode keyed;
+  FiberNode indexed;
+
+  // Key id 3 and index 3 must never collide
+  map.insert(FiberKeyMap::keyedSlot(3), &keyed);
+  map.insert(FiberKeyMap::indexSlot(3), &indexed);
+  assert(map.size() == 2);
+
+  assert(map.take(FiberKeyMap::indexSlot(3)) == &indexed);
+  assert(map.take(FiberKeyMap::indexSlot(3)) == nullptr);
+  assert(map.take(FiberKeyMap::keyedSlot(3)) == &keyed);
+  assert(map.size() == 0);
+  return true;
+}
+
+bool testTakeKeepsProbeRunsIntact() {
+  FiberKeyMap map;
+  map.reset(0);
+  std::vector<FiberNode> fibers(1000);
+  for (std::size_t index = 0; index < fibers.size(); ++index) {
+    map.insert(FiberKeyMap::indexSlot(index), &fibers[index]);
+  }
+  assert(map.size() == fibers.size());
+
+  // Remove every other entry, then every remaining one must still be found
+  for (std::size_t index = 0; index < fibers.size(); index += 2) {
+    assert(map.take(FiberKeyMap::indexSlot(index)) == &fibers[index]);
+  }
+  std::size_t remaining = 0;
+  map.forEach([&](FiberNode*) { ++remaining; });
+  assert(remaining == fibers.size() / 2);
+  for (std::size_t index = 1; index < fibers.size(); index += 2) {
+    assert(map.take(FiberKeyMap::indexSlot(index)) == &fibers[index]);
+  }
+  assert(map.size() == 0);
+
+  map.reset(8);
+  assert(map.take(FiberKeyMap::indexSlot(1)) == nullptr);
+  return true;
+}
+
+} // namespace
+
+bool runReactFiberKeyMapTests() {
+  return testInternTable() && testUnheldKeysAreSwept() && testKeyedAndIndexSlotsAreDistinct() && testTakeKeepsProbeRunsIntact();
+}
+
+} // namespace react::test
@@ -2,6 +2,7 @@
 #include "shared/ReactFeatureFlags.h"
 
 #include <cassert>
+#include <vector>
 
 namespace react::test {
 
@@ -130,7 +131,7 @@ bool runReactFiberLaneRuntimeTests() {
     finishRoot.expirationTimes[retryIndex] = 42;
     ConcurrentUpdate hidden{};
     hidden.lane = RetryLane1 | OffscreenLane;
-    finishRoot.hiddenUpdates[retryIndex] = std::vector<ConcurrentUpdate*>{&hidden};
+    finishRoot.hiddenUpdates.emplace(retryIndex) = std::vector<ConcurrentUpdate*>{&hidden};
 
     markRootFinished(finishRoot, RetryLane1, SyncLane, NoLane, NoLanes, RetryLane1);
 
@@ -141,7 +142,8 @@ bool runReactFiberLaneRuntimeTests() {
     assert(finishRoot.shellSuspendCounter == 0);
     assert(finishRoot.entanglements[retryIndex] == NoLanes);
     assert(finishRoot.expirationTimes[retryIndex] == NoTimestamp);
-    assert(!finishRoot.hiddenUpdates[retryIndex].has_value());
+    assert(!finishRoot.hiddenUpdates.contains(retryIndex));
+    assert(finishRoot.hiddenUpdates.empty());
     assert(hidden.lane == RetryLane1);
   }
 
@@ -161,9 +163,9 @@ bool runReactFiberLaneRuntimeTests() {
     ConcurrentUpdate update{};
     markHiddenUpdate(hiddenRoot, &update, DefaultLane);
     const auto index = laneToIndex(DefaultLane);
-    assert(hiddenRoot.hiddenUpdates[index].has_value());
-    assert(hiddenRoot.hiddenUpdates[index]->size() == 1);
-    assert(hiddenRoot.hiddenUpdates[index]->at(0) == &update);
+    assert(hiddenRoot.hiddenUpdates.lanes() == DefaultLane);
+    assert(hiddenRoot.hiddenUpdates.find(index)->size() == 1);
+    assert(hiddenRoot.hiddenUpdates.find(index)->at(0) == &update);
     assert(update.lane == (DefaultLane | OffscreenLane));
   }
 
@@ -193,7 +195,53 @@ bool runReactFiberLaneRuntimeTests() {
     const auto transitions = getTransitionsForLanes(transitionRoot, TransitionLane2);
     assert(transitions.empty());
     clearTransitionsForLanes(transitionRoot, TransitionLane2);
-    assert(!transitionRoot.transitionLanes[laneToIndex(TransitionLane2)].has_value());
+    assert(!transitionRoot.transitionLanes.contains(laneToIndex(TransitionLane2)));
+  }
+
+  {
+    // Entries stay ordered by lane regardless of insertion order
+    SparseLaneMap<int> sparse;
+    sparse.emplace(laneToIndex(IdleLane)) = 3;
+    sparse.emplace(laneToIndex(SyncLane)) = 1;
+    sparse.emplace(laneToIndex(DefaultLane)) = 2;
+    assert(sparse.lanes() == (SyncLane | DefaultLane | IdleLane));
+    std::vector<int> visited;
+    sparse.forEach([&](std::size_t index, int value) {
+      assert(index == laneToIndex(value == 1 ? SyncLane : value == 2 ? DefaultLane : IdleLane));
+      visited.push_back(value);
+    });
+    assert((visited == std::vector<int>{1, 2, 3}));
+    sparse.erase(laneToIndex(DefaultLane));
+    assert(sparse.find(laneToIndex(DefaultLane)) == nullptr);
+    assert(*sparse.find(laneToIndex(IdleLane)) == 3);
+    sparse.erase(laneToIndex(SyncLane));
+    sparse.erase(laneToIndex(IdleLane));
+    assert(sparse.empty() && sparse.heapBytes() == 0);
+
+    SmallSet<int, 2> small;
+    assert(small.insert(1) && small.insert(2) && !small.insert(1));
+    assert(small.heapBytes() == 0);
+    assert(small.insert(3) && small.size() == 3 && small.contains(1) && small.contains(3));
+    assert(small.erase(1) && !small.contains(1) && small.size() == 2);
+    small.clear();
+    assert(small.empty() && small.insert(4) && small.contains(4));
+  }
+
+  {
+    // A fresh root owns nothing beyond its own footprint
+    FiberRoot idleRoot;
+    const auto idleUsage = getFiberRootMemoryUsage(idleRoot);
+    assert(idleUsage.totalBytes() == sizeof(FiberRoot));
+
+    ConcurrentUpdate update{};
+    markRootUpdated(idleRoot, TransitionLane1);
+    markHiddenUpdate(idleRoot, &update, TransitionLane1);
+    const auto busyUsage = getFiberRootMemoryUsage(idleRoot);
+    assert(busyUsage.hiddenUpdateBytes > 0);
+    assert(busyUsage.totalBytes() > idleUsage.totalBytes());
+
+    markRootFinished(idleRoot, TransitionLane1, NoLanes, NoLane, NoLanes, NoLanes);
+    assert(getFiberRootMemoryUsage(idleRoot).totalBytes() == sizeof(FiberRoot));
   }
 
   return true;
@@ -0,0 +1,271 @@
+#include "ReactReconciler/ReactFiber.h"
+#include "ReactReconciler/ReactFiberArena.h"
+#include "ReactReconciler/ReactFiberConcurrentUpdates.h"
+#include "ReactReconciler/ReactFiberFlags.h"
+#include "ReactReconciler/ReactFiberHookTypes.h"
+#include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberReclaim.h"
+#include "ReactReconciler/ReactFiberWorkLoopState.h"
+#include "ReactReconciler/ReactHostConfig.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "TestRuntime.h"
+
+#include <cassert>
+#include <memory>
+
+namespace react::test {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+jsi::Value* cloneString(TestRuntime& jsRuntime, const char* text) {
+  return new jsi::Value(jsRuntime, jsi::String::createFromUtf8(jsRuntime, text));
+}
+
+// A function component with one state hook, a pending update, two effects
+// and a host text child, plus its alternate
+FiberNode* mountComponent(TestRuntime& jsRuntime, FiberNode& parent, std::weak_ptr<HookQueue>& queueOut) {
+  FiberNode* fiber = createFiber(WorkTag::FunctionComponent, cloneString(jsRuntime, "props"));
+  fiber->memoizedProps = fiber->pendingProps;
+  auto* type = cloneString(jsRuntime, "Row");
+  fiber->type = type;
+  fiber->elementType = type;
+  fiber->returnFiber = &parent;
+
+  auto* hook = new Hook();
+  hook->memoizedState = std::make_unique<jsi::Value>(1.0);
+  hook->queue = std::make_shared<HookQueue>();
+  hook->queue->fiber = fiber;
+  auto* update = new HookUpdate();
+  update->next = update;
+  hook->queue->pending = update;
+  fiber->memoizedState = hook;
+  queueOut = hook->queue;
+
+  auto* updateQueue = new FunctionComponentUpdateQueue();
+  auto* first = new Effect();
+  auto* second = new Effect();
+  first->next = second;
+  second->next = first;
+  updateQueue->lastEffect = second;
+  hook->memoizedEffect = second;
+  fiber->updateQueue = updateQueue;
+
+  FiberNode* text = createFiber(WorkTag::HostText, cloneString(jsRuntime, "text"));
+  text->memoizedProps = text->pendingProps;
+  text->stateNode = new hostconfig::HostInstance();
+  text->returnFiber = fiber;
+  fiber->child = text;
+
+  // The alternate shares props, type, hooks and effects with the fiber
+  createWorkInProgress(fiber, fiber->pendingProps);
+  return fiber;
+}
+
+void deleteChild(FiberNode& hostRoot, FiberNode& parent, FiberNode& child) {
+  parent.child = nullptr;
+  parent.addDeletion(&child);
+  parent.flags |= ChildDeletion;
+  hostRoot.subtreeFlags |= ChildDeletion;
+}
+
+bool testDeletedSubtreeIsReclaimed() {
+  TestRuntime jsRuntime;
+  ReactRuntime runtime;
+  FiberRoot root;
+  FiberArena& arena = ensureRootFiberArena(root);
+  FiberArenaScope scope(&arena);
+
+  FiberNode* hostRoot = createFiber(WorkTag::HostRoot);
+  FiberNode* parent = createFiber(WorkTag::HostComponent);
+  hostRoot->child = parent;
+  parent->returnFiber = hostRoot;
+
+  std::weak_ptr<HookQueue> queue;
+  FiberNode* component = mountComponent(jsRuntime, *parent, queue);
+  parent->child = component;
+  assert(arena.stats().liveFibers == 5);
+
+  deleteChild(*hostRoot, *parent, *component);
+  detachDeletedFibers(runtime, root, *hostRoot);
+
+  const FiberReclaimQueue& reclaimQueue = runtime.workLoopState().fiberReclaimQueue;
+  assert(parent->getDeletions().empty());
+  assert(component->returnFiber == nullptr);
+  assert(component->alternate->returnFiber == nullptr);
+  assert(reclaimQueue.pendingSubtrees() == 1);
+  assert(reclaimQueue.isTaskScheduled());
+  // Nothing is freed until the idle task runs
+  assert(arena.stats().liveFibers == 5);
+  assert(!queue.expired());
+
+  runtime.flushAllTasksForTest();
+  assert(reclaimQueue.empty());
+  assert(!reclaimQueue.isTaskScheduled());
+  assert(arena.stats().liveFibers == 2);
+  assert(queue.expired());
+
+  const FiberReclaimQueue::Stats& stats = reclaimQueue.stats();
+  assert(stats.batches == 1);
+  assert(stats.reclaimedFibers == 3);
+  // Component props and type, text props; each freed once
+  assert(stats.reclaimedValues == 3);
+  assert(stats.reclaimedHooks == 1);
+  assert(stats.reclaimedEffects == 2);
+  return true;
+}
+
+bool testAbandonedWorkIsReclaimed() {
+  TestRuntime jsRuntime;
+  ReactRuntime runtime;
+  FiberRoot root;
+  FiberArena& arena = ensureRootFiberArena(root);
+  FiberArenaScope scope(&arena);
+
+  FiberNode* currentRoot = createFiber(WorkTag::HostRoot);
+  FiberNode* committed = createFiber(WorkTag::HostComponent);
+  FiberNode* untouched = createFiber(WorkTag::HostComponent);
+  FiberNode* untouchedChild = createFiber(WorkTag::HostComponent);
+  currentRoot->child = committed;
+  committed->returnFiber = currentRoot;
+  committed->sibling = untouched;
+  untouched->returnFiber = currentRoot;
+  untouched->child = untouchedChild;
+  untouchedChild->returnFiber = untouched;
+  root.current = currentRoot;
+
+  // The interrupted render cloned both children, bailed out of the second
+  // one's list and mounted a subtree under the first plus a new sibling
+  FiberNode* rootWorkInProgress = createWorkInProgress(currentRoot, nullptr);
+  FiberNode* clone = createWorkInProgress(committed, nullptr);
+  FiberNode* untouchedClone = createWorkInProgress(untouched, nullptr);
+  FiberNode* mounted = createFiber(WorkTag::HostComponent, cloneString(jsRuntime, "mounted"));
+  FiberNode* mountedChild = createFiber(WorkTag::HostText, cloneString(jsRuntime, "child"));
+  FiberNode* appended = createFiber(WorkTag::HostComponent, cloneString(jsRuntime, "appended"));
+  rootWorkInProgress->child = clone;
+  clone->returnFiber = rootWorkInProgress;
+  clone->sibling = untouchedClone;
+  untouchedClone->sibling = appended;
+  clone->child = mounted;
+  mounted->returnFiber = clone;
+  mounted->child = mountedChild;
+  mountedChild->returnFiber = mounted;
+  assert(untouchedClone->child == untouchedChild);
+  assert(arena.stats().liveFibers == 10);
+
+  detachAbandonedWork(runtime, root);
+  const FiberReclaimQueue& reclaimQueue = runtime.workLoopState().fiberReclaimQueue;
+  assert(reclaimQueue.pendingSubtrees() == 2);
+  assert(rootWorkInProgress->child == committed);
+  assert(clone->child == nullptr);
+
+  runtime.flushAllTasksForTest();
+  assert(reclaimQueue.stats().reclaimedFibers == 3);
+  assert(reclaimQueue.stats().reclaimedValues == 3);
+  assert(arena.stats().liveFibers == 7);
+  assert(arena.owns(untouchedChild));
+  assert(arena.owns(untouchedClone));
+  return true;
+}
+
+bool testBulkFreedArenaEntriesAreDropped() {
+  FiberReclaimQueue reclaimQueue;
+  auto arena = std::make_shared<FiberArena>();
+  {
+    FiberArenaScope scope(arena.get());
+    FiberNode* fiber = createFiber(WorkTag::HostComponent);
+    fiber->child = createFiber(WorkTag::HostComponent);
+    reclaimQueue.enqueue(*fiber, arena);
+  }
+
+  // Reset destroys the queued fibers itself
+  arena->reset();
+  reclaimQueue.reclaimAll();
+  assert(reclaimQueue.empty());
+  assert(reclaimQueue.stats().staleSubtrees == 1);
+  assert(reclaimQueue.stats().reclaimedFibers == 0);
+  assert(arena->stats().liveFibers == 0);
+  return true;
+}
+
+bool testBackedOffTaskRetriesOnTheNextCommit() {
+  TestRuntime jsRuntime;
+  ReactRuntime runtime;
+  FiberRoot root;
+  FiberArena& arena = ensureRootFiberArena(root);
+  FiberArenaScope scope(&arena);
+
+  FiberNode* hostRoot = createFiber(WorkTag::HostRoot);
+  FiberNode* parent = createFiber(WorkTag::HostComponent);
+  hostRoot->child = parent;
+  parent->returnFiber = hostRoot;
+
+  std::weak_ptr<HookQueue> queue;
+  FiberNode* component = mountComponent(jsRuntime, *parent, queue);
+  parent->child = component;
+  deleteChild(*hostRoot, *parent, *component);
+  detachDeletedFibers(runtime, root, *hostRoot);
+
+  // An update still being queued makes the task back off
+  enqueueConcurrentRenderForLane(parent, DefaultLane);
+  runtime.flushAllTasksForTest();
+  const FiberReclaimQueue& reclaimQueue = runtime.workLoopState().fiberReclaimQueue;
+  assert(reclaimQueue.pendingSubtrees() == 1);
+  assert(!reclaimQueue.isTaskScheduled());
+  finishQueueingConcurrentUpdates();
+
+  // The next commit deletes nothing but still gets the subtree freed
+  detachDeletedFibers(runtime, root, *hostRoot);
+  assert(reclaimQueue.isTaskScheduled());
+  runtime.flushAllTasksForTest();
+  assert(reclaimQueue.empty());
+  assert(arena.stats().liveFibers == 2);
+  assert(queue.expired());
+  return true;
+}
+
+bool testMountUnmountCyclesStayFlat() {
+  constexpr int kCycles = 20000;
+  constexpr int kCyclesPerIdle = 50;
+
+  TestRuntime jsRuntime;
+  ReactRuntime runtime;
+  FiberRoot root;
+  FiberArena& arena = ensureRootFiberArena(root);
+  FiberArenaScope scope(&arena);
+
+  FiberNode* hostRoot = createFiber(WorkTag::HostRoot);
+  FiberNode* parent = createFiber(WorkTag::HostComponent);
+  hostRoot->child = parent;
+  parent->returnFiber = hostRoot;
+
+  for (int cycle = 0; cycle < kCycles; ++cycle) {
+    std::weak_ptr<HookQueue> queue;
+    FiberNode* component = mountComponent(jsRuntime, *parent, queue);
+    parent->child = component;
+    deleteChild(*hostRoot, *parent, *component);
+    detachDeletedFibers(runtime, root, *hostRoot);
+    if ((cycle + 1) % kCyclesPerIdle == 0) {
+      runtime.flushAllTasksForTest();
+    }
+  }
+
+  const FiberReclaimQueue::Stats& stats = runtime.workLoopState().fiberReclaimQueue.stats();
+  assert(stats.reclaimedFibers == static_cast<std::uint64_t>(kCycles) * 3);
+  assert(arena.stats().liveFibers == 2);
+  // Freed slots are reused, so the arena never grows past one batch
+  assert(arena.stats().peakLiveFibers <= 2 + kCyclesPerIdle * 3);
+  assert(arena.stats().slabCount == 1);
+  return true;
+}
+
+} // namespace
+
+bool runReactFiberReclaimTests() {
+  return testDeletedSubtreeIsReclaimed() && testAbandonedWorkIsReclaimed() &&
+      testBulkFreedArenaEntriesAreDropped() && testBackedOffTaskRetriesOnTheNextCommit() &&
+      testMountUnmountCyclesStayFlat();
+}
+
+} // namespace react::test
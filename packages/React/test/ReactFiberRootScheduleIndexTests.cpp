@@ -0,0 +1,142 @@
+#include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberRootScheduleIndex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+bool hasRoot(const std::vector<FiberRoot*>& roots, const FiberRoot& root) {
+  return std::find(roots.begin(), roots.end(), &root) != roots.end();
+}
+
+std::vector<FiberRoot*> rootsWith(const RootScheduleIndex& index, Lanes lanes) {
+  std::vector<FiberRoot*> roots;
+  index.collectRootsWithPendingLanes(lanes, roots);
+  return roots;
+}
+
+} // namespace
+
+bool runReactFiberRootScheduleIndexTests() {
+  {
+    // Lane helpers keep a registered root's lane classes current
+    RootScheduleIndex index;
+    FiberRoot root;
+    index.add(root);
+    assert(index.contains(root) && index.size() == 1);
+    assert(!index.hasRootsWithPendingLanes(SyncLane));
+
+    markRootUpdated(root, SyncLane);
+    assert(hasRoot(rootsWith(index, SyncLane), root));
+    assert(rootsWith(index, TransitionLane3).empty());
+
+    markRootUpdated(root, TransitionLane1);
+    assert(hasRoot(rootsWith(index, TransitionLane3), root));
+
+    markRootFinished(root, SyncLane | TransitionLane1, NoLanes, NoLane, NoLanes, NoLanes);
+    assert(!index.hasRootsWithPendingLanes(SyncLane | TransitionLanes));
+
+    index.remove(root);
+    assert(!index.contains(root) && index.empty());
+    assert(root.scheduleIndex == nullptr);
+    markRootUpdated(root, SyncLane);
+    assert(!index.hasRootsWithPendingLanes(SyncLane));
+  }
+
+  {
+    // Only roots with matching work are visited, however many are idle
+    RootScheduleIndex index;
+    std::vector<std::unique_ptr<FiberRoot>> roots;
+    for (int count = 0; count < 200; ++count) {
+      roots.push_back(std::make_unique<FiberRoot>());
+      index.add(*roots.back());
+    }
+    markRootUpdated(*roots[7], SyncLane);
+    markRootUpdated(*roots[130], SyncLane);
+    markRootUpdated(*roots[64], DefaultLane);
+    const std::vector<FiberRoot*> syncRoots = rootsWith(index, SyncLane);
+    assert((syncRoots == std::vector<FiberRoot*>{roots[7].get(), roots[130].get()}));
+    assert(rootsWith(index, SyncLane | DefaultLane).size() == 3);
+
+    // Freed slots are reused
+    index.remove(*roots[7]);
+    FiberRoot late;
+    index.add(late);
+    assert(late.scheduleSlot == 7);
+    assert(index.size() == 200);
+  }
+
+  {
+    // Dirty roots are handed out once
+    RootScheduleIndex index;
+    FiberRoot first;
+    FiberRoot second;
+    index.add(first);
+    index.add(second);
+    std::vector<FiberRoot*> dirty;
+    index.takeDirtyRoots(dirty);
+    assert(dirty.size() == 2);
+
+    dirty.clear();
+    index.takeDirtyRoots(dirty);
+    assert(dirty.empty());
+
+    markRootUpdated(second, DefaultLane);
+    index.takeDirtyRoots(dirty);
+    assert((dirty == std::vector<FiberRoot*>{&second}));
+  }
+
+  {
+    // A root left pointing at a reset index is treated as unregistered
+    RootScheduleIndex index;
+    FiberRoot root;
+    index.add(root);
+    index = RootScheduleIndex{};
+    assert(!index.contains(root));
+    markRootUpdated(root, SyncLane);
+    assert(!index.hasRootsWithPendingLanes(SyncLane));
+    index.add(root);
+    assert(hasRoot(rootsWith(index, SyncLane), root));
+  }
+
+  {
+    // A root whose lane comes due is marked without any change to its lanes
+    RootScheduleIndex index;
+    FiberRoot root;
+    FiberRoot idle;
+    index.add(root);
+    index.add(idle);
+    markRootUpdated(root, DefaultLane);
+    markStarvedLanesAsExpired(root, 0);
+    const int expirationTime = root.expirationTimes[laneToIndex(DefaultLane)];
+    std::vector<FiberRoot*> dirty;
+    index.takeDirtyRoots(dirty);
+
+    dirty.clear();
+    index.markExpiringRoots(expirationTime - 1);
+    index.takeDirtyRoots(dirty);
+    assert(dirty.empty());
+
+    index.markExpiringRoots(expirationTime);
+    index.takeDirtyRoots(dirty);
+    assert((dirty == std::vector<FiberRoot*>{&root}));
+
+    // Once expired, the lane no longer brings the root back
+    markStarvedLanesAsExpired(root, expirationTime);
+    assert(includesSomeLane(root.expiredLanes, DefaultLane));
+    dirty.clear();
+    index.takeDirtyRoots(dirty);
+    index.markExpiringRoots(expirationTime * 2);
+    index.takeDirtyRoots(dirty);
+    assert(dirty.empty());
+  }
+
+  return true;
+}
+
+} // namespace react::test
@@ -6,7 +6,10 @@
 
 #include <cassert>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace react::test {
 
@@ -24,13 +27,87 @@ void initializeReactInternals(facebook::jsi::Runtime& jsRuntime, facebook::jsi::
   rt.global().setProperty(rt, "React", reactModule);
 }
 
-} // namespace
+// Holds tasks until the test runs them, on a clock the test moves
+class ManualScheduler : public Scheduler {
+public:
+  TaskHandle scheduleTask(SchedulerPriority priority, Task task, const TaskOptions& options) override {
+    (void)options;
+    tasks.push_back({priority, std::move(task)});
+    return TaskHandle{tasks.size()};
+  }
+
+  void cancelTask(TaskHandle handle) override {
+    (void)handle;
+  }
+
+  SchedulerPriority getCurrentPriorityLevel() const override {
+    return SchedulerPriority::NormalPriority;
+  }
+
+  SchedulerPriority runWithPriority(SchedulerPriority priority, const std::function<void()>& fn) override {
+    (void)priority;
+    fn();
+    return SchedulerPriority::NormalPriority;
+  }
+
+  bool shouldYield() const override {
+    return false;
+  }
+
+  double now() const override {
+    return time;
+  }
+
+  // Runs the root schedule passes queued so far; root work stays queued
+  void runImmediateTasks() {
+    std::vector<std::pair<SchedulerPriority, Task>> queued;
+    queued.swap(tasks);
+    for (auto& entry : queued) {
+      if (entry.first == SchedulerPriority::ImmediatePriority) {
+        entry.second();
+      } else {
+        tasks.push_back(std::move(entry));
+      }
+    }
+  }
+
+  double time{1000.0};
+  std::vector<std::pair<SchedulerPriority, Task>> tasks;
+};
+
+// A pass triggered by one root must still expire another root's starved
+// lanes, even though nothing about that root changed
+bool testStarvedRootExpiresWithoutBeingDirty() {
+  ReactRuntime runtime;
+  auto scheduler = std::make_shared<ManualScheduler>();
+  runtime.setScheduler(scheduler);
+  test::TestRuntime jsRuntime;
+  facebook::jsi::Object internals(jsRuntime);
+  initializeReactInternals(jsRuntime, internals);
 
-extern Lanes scheduleTaskForRootDuringMicrotask(
-  ReactRuntime& runtime,
-  facebook::jsi::Runtime& jsRuntime,
-  FiberRoot& root,
-  int currentTime);
+  FiberRoot starving{};
+  starving.tag = RootTag::ConcurrentRoot;
+  markRootUpdated(starving, DefaultLane);
+  ensureRootIsScheduled(runtime, jsRuntime, starving);
+  scheduler->runImmediateTasks();
+  const int expirationTime = starving.expirationTimes[laneToIndex(DefaultLane)];
+  assert(expirationTime != NoTimestamp);
+  assert(starving.expiredLanes == NoLanes);
+
+  scheduler->time = expirationTime + 1;
+  FiberRoot busy{};
+  busy.tag = RootTag::ConcurrentRoot;
+  markRootUpdated(busy, TransitionLane1);
+  ensureRootIsScheduled(runtime, jsRuntime, busy);
+  scheduler->runImmediateTasks();
+  assert(includesSomeLane(starving.expiredLanes, DefaultLane));
+
+  // The roots go away before the runtime
+  runtime.rootSchedulerState().scheduledRoots = RootScheduleIndex{};
+  return true;
+}
+
+} // namespace
 
 bool runReactFiberRootSchedulerTests() {
   ReactRuntime runtime;
@@ -44,7 +121,7 @@ bool runReactFiberRootSchedulerTests() {
 
   const int currentTime = static_cast<int>(runtime.now());
 
-  const Lanes scheduledLanes = scheduleTaskForRootDuringMicrotask(runtime, jsRuntime, root, currentTime);
+  const Lanes scheduledLanes = scheduleTaskForRootDuringMicrotaskForTesting(runtime, jsRuntime, root, currentTime);
   assert(scheduledLanes != NoLanes);
   assert(root.callbackNode);
   assert(root.callbackPriority == getHighestPriorityLane(root.pendingLanes));
@@ -52,14 +129,14 @@ bool runReactFiberRootSchedulerTests() {
 
   const TaskHandle initialHandle = root.callbackNode;
 
-  facebook::jsi::Array actQueue = jsRuntime.createArray(0);
+  facebook::jsi::Array actQueue = jsRuntime.makeArray(0);
   const std::string actQueueProp(ReactSharedInternalsKeys::kActQueue);
   internals.setProperty(
     jsRuntime,
     actQueueProp.c_str(),
     facebook::jsi::Value(jsRuntime, actQueue));
 
-  const Lanes rescheduledLanes = scheduleTaskForRootDuringMicrotask(runtime, jsRuntime, root, currentTime);
+  const Lanes rescheduledLanes = scheduleTaskForRootDuringMicrotaskForTesting(runtime, jsRuntime, root, currentTime);
   assert(rescheduledLanes != NoLanes);
   assert(root.callbackNode);
   assert(root.callbackPriority == getHighestPriorityLane(root.pendingLanes));
@@ -68,7 +145,7 @@ bool runReactFiberRootSchedulerTests() {
   assert((root.callbackNode.id & kActCallbackBit) != 0);
   assert(!runtime.rootSchedulerState().actCallbacks.empty());
 
-  return true;
+  return testStarvedRootExpiresWithoutBeingDirty();
 }
 
 } // namespace react::test
@@ -1,10 +1,16 @@
 #include "ReactReconciler/ReactFiber.h"
 #include "ReactReconciler/ReactFiberFlags.h"
 #include "ReactReconciler/ReactFiberLane.h"
+#include "ReactReconciler/ReactFiberNewContext.h"
+#include "ReactReconciler/ReactFiberStack.h"
 #include "ReactReconciler/ReactRootTags.h"
+#include "TestRuntime.h"
 
 #include <cassert>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace react::test {
 
@@ -19,9 +25,21 @@ void clearAlternateLinks(FiberNode* a, FiberNode* b) {
   }
 }
 
+// Reads a context the way a rendering component does, which leaves a real
+// dependency list on the fiber
+void readTestContext(facebook::jsi::Runtime& runtime, FiberNode& fiber) {
+  facebook::jsi::Object context(runtime);
+  context.setProperty(runtime, "_currentValue", 1);
+  prepareToReadContext(fiber, DefaultLane);
+  readContext(runtime, fiber, facebook::jsi::Value(runtime, context));
+  resetContextDependencies();
+}
+
 } // namespace
 
 bool runReactFiberRuntimeTests() {
+  TestRuntime jsRuntime;
+
   {
     FiberNode* hostRoot = createHostRootFiber(RootTag::ConcurrentRoot, true);
     assert(hostRoot != nullptr);
@@ -34,14 +52,13 @@ bool runReactFiberRuntimeTests() {
 
   {
     FiberNode* fiber = createFiber(WorkTag::FunctionComponent, reinterpret_cast<void*>(0x1), "no-alternate", ConcurrentMode);
-    auto dependencies = std::make_unique<FiberNode::Dependencies>();
-    dependencies->lanes = DefaultLane;
-    dependencies->firstContext = reinterpret_cast<void*>(0x2);
-    fiber->dependencies = std::move(dependencies);
+    readTestContext(jsRuntime, *fiber);
+    fiber->getDependencies()->lanes = DefaultLane;
+    assert(fiber->getDependencies()->firstContext != nullptr);
 
     resetWorkInProgress(fiber, DefaultLane);
 
-    assert(fiber->dependencies == nullptr);
+    assert(fiber->getDependencies() == nullptr);
     delete fiber;
   }
 
@@ -50,33 +67,34 @@ bool runReactFiberRuntimeTests() {
     current->memoizedProps = reinterpret_cast<void*>(0x2);
   current->memoizedState = reinterpret_cast<void*>(0x3);
   current->updateQueue = reinterpret_cast<void*>(0x4);
-  auto dependencies = std::make_unique<FiberNode::Dependencies>();
-  dependencies->lanes = DefaultLane;
-  dependencies->firstContext = reinterpret_cast<void*>(0x5);
-  current->dependencies = std::move(dependencies);
+  readTestContext(jsRuntime, *current);
+  current->getDependencies()->lanes = DefaultLane;
+  void* const currentContexts = current->getDependencies()->firstContext;
+  assert(currentContexts != nullptr);
     current->lanes = DefaultLane;
     current->childLanes = DefaultLane;
     current->flags = LayoutStatic;
     current->ref = reinterpret_cast<void*>(0x6);
-    current->refCleanup = reinterpret_cast<void*>(0x7);
+    current->setRefCleanup(reinterpret_cast<void*>(0x7));
 
     FiberNode* work = createWorkInProgress(current, reinterpret_cast<void*>(0x8));
     assert(work != nullptr);
     assert(work->pendingProps == reinterpret_cast<void*>(0x8));
     assert(work->ref == current->ref);
-    assert(work->refCleanup == current->refCleanup);
+    assert(work->getRefCleanup() == current->getRefCleanup());
   assert(work->memoizedProps == current->memoizedProps);
-  assert(work->dependencies != nullptr);
-  assert(work->dependencies->lanes == DefaultLane);
-  assert(work->dependencies->firstContext == reinterpret_cast<void*>(0x5));
+  assert(work->getDependencies() != nullptr);
+  assert(work->getDependencies()->lanes == DefaultLane);
+  assert(work->getDependencies()->firstContext != nullptr);
+  assert(work->getDependencies()->firstContext != currentContexts);
 
     work->flags |= Update;
     work->memoizedProps = reinterpret_cast<void*>(0x9);
     work->memoizedState = reinterpret_cast<void*>(0xA);
     work->updateQueue = reinterpret_cast<void*>(0xB);
-  work->dependencies->lanes = SyncLane;
-  work->dependencies->firstContext = reinterpret_cast<void*>(0xC);
-    work->deletions.push_back(current);
+  work->getDependencies()->lanes = SyncLane;
+  readTestContext(jsRuntime, *work);
+    work->addDeletion(current);
 
     resetWorkInProgress(work, DefaultLane);
 
@@ -84,11 +102,12 @@ bool runReactFiberRuntimeTests() {
     assert(work->memoizedProps == current->memoizedProps);
   assert(work->memoizedState == current->memoizedState);
   assert(work->updateQueue == current->updateQueue);
-  assert(work->dependencies != nullptr);
-  assert(work->dependencies->lanes == DefaultLane);
-  assert(work->dependencies->firstContext == reinterpret_cast<void*>(0x5));
+  assert(work->getDependencies() != nullptr);
+  assert(work->getDependencies()->lanes == DefaultLane);
+  assert(work->getDependencies()->firstContext != nullptr);
+  assert(work->getDependencies()->firstContext != currentContexts);
     assert(work->child == current->child);
-    assert(work->deletions.empty());
+    assert(work->getDeletions().empty());
     assert((work->flags & Update) == 0);
     assert((work->flags & LayoutStatic) == LayoutStatic);
 
@@ -97,6 +116,95 @@ bool runReactFiberRuntimeTests() {
     delete current;
   }
 
+  {
+    // Cold storage stays unallocated until a non-default value is written
+    FiberNode* fiber = createFiber(WorkTag::HostComponent, nullptr, std::string{}, ConcurrentMode);
+    assert(fiber->cold == nullptr);
+    assert(fiber->getKey().empty());
+    assert(fiber->getDeletions().empty());
+    assert(fiber->getUpdatePayload() == nullptr);
+    assert(fiber->getDependencies() == nullptr);
+    assert(fiber->getRefCleanup() == nullptr);
+    fiber->clearDeletions();
+    fiber->setRefCleanup(nullptr);
+    assert(fiber->cold == nullptr);
+
+    FiberNode* work = createWorkInProgress(fiber, nullptr);
+    assert(work->cold == nullptr);
+
+    // Keys are interned ids in the hot record
+    FiberNode* keyed = createFiber(WorkTag::HostComponent, nullptr, "keyed", ConcurrentMode);
+    assert(keyed->cold == nullptr);
+    assert(keyed->key == internReactKey("keyed"));
+    assert(keyed->getKey() == "keyed");
+    keyed->addDeletion(fiber);
+    assert(keyed->cold != nullptr);
+    assert(keyed->getDeletions().size() == 1);
+
+    clearAlternateLinks(fiber, work);
+    delete keyed;
+    delete work;
+    delete fiber;
+  }
+
+  {
+    // Host prop snapshots follow memoizedProps to the alternate; the update
+    // payload does not
+    FiberNode* current = createFiber(WorkTag::HostComponent, nullptr, std::string{}, ConcurrentMode);
+    assert(current->getPropSnapshot() == nullptr && current->cold == nullptr);
+    auto snapshot = std::make_shared<const PropSnapshot>();
+    current->setPropSnapshot(snapshot);
+    PropUpdatePayload payload;
+    payload.appendRemove(internPropName("title"));
+    current->setUpdatePayload(std::make_unique<PropUpdatePayload>(payload));
+
+    FiberNode* work = createWorkInProgress(current, nullptr);
+    assert(work->getPropSnapshot() == snapshot);
+    assert(work->getUpdatePayload() == nullptr);
+    assert(current->getUpdatePayload()->operationCount() == 1);
+
+    work->setPropSnapshot(std::make_shared<const PropSnapshot>());
+    assert(current->getPropSnapshot() == snapshot);
+    resetWorkInProgress(work, DefaultLane);
+    assert(work->getPropSnapshot() == snapshot);
+
+    clearAlternateLinks(current, work);
+    resetWorkInProgress(work, DefaultLane);
+    assert(work->getPropSnapshot() == nullptr);
+    delete work;
+    delete current;
+  }
+
+  {
+    // Each cursor restores its own values, in LIFO order, and reuses slots
+    FiberNode outer;
+    FiberNode inner;
+    auto transitions = createCursor<std::optional<std::vector<int>>>(std::nullopt);
+    auto lanes = createCursor<Lanes>(NoLanes);
+
+    push(transitions, std::optional<std::vector<int>>{std::vector<int>{1}}, &outer);
+    push(lanes, DefaultLane, &outer);
+    push(transitions, std::optional<std::vector<int>>{std::vector<int>{1, 2}}, &inner);
+    assert(transitions.current->size() == 2);
+    assert(lanes.current == DefaultLane);
+
+    pop(transitions, &inner);
+    assert(transitions.current->size() == 1);
+    pop(lanes, &outer);
+    assert(lanes.current == NoLanes);
+    pop(transitions, &outer);
+    assert(!transitions.current.has_value());
+
+    // Popping an empty cursor keeps its current value
+    pop(lanes, &outer);
+    assert(lanes.current == NoLanes);
+
+    push(transitions, std::optional<std::vector<int>>{}, &outer);
+    pop(transitions, &outer);
+    assert(transitions.previousValues.size() == 2);
+    assert(transitions.depth == 0);
+  }
+
   return true;
 }
 
@@ -1,12 +1,16 @@
 #include "ReactReconciler/ReactFiberHydrationContext_ext.h"
 #include "ReactReconciler/ReactFiberWorkLoop.h"
+#include "ReactReconciler/ReactRootTags.h"
+#include "ReactReconciler/ReactWakeable.h"
 #include "ReactRuntime/ReactRuntime.h"
 #include "ReactRuntime/ReactHostInterface.h"
+#include "shared/ReactSharedInternals.h"
 #include "TestRuntime.h"
 
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -62,6 +66,26 @@ void resetState(ReactRuntime& runtime) {
   clearPendingRenderPhaseUpdates(runtime);
 }
 
+// Function components resolve the hooks dispatcher through the global React
+// module, as they would with the react package loaded
+void installReactGlobal(facebook::jsi::Runtime& rt) {
+  facebook::jsi::Object reactModule(rt);
+  facebook::jsi::Object internals(rt);
+  const std::string exportName(ReactSharedInternalsKeys::kExportName);
+  reactModule.setProperty(rt, exportName.c_str(), facebook::jsi::Value(rt, internals));
+  rt.global().setProperty(rt, "React", reactModule);
+}
+
+// A thenable that never settles, so a render that throws it stays suspended
+class PendingWakeable final : public Wakeable {
+public:
+  void then(std::function<void()> /*onFulfilled*/, std::function<void()> /*onRejected*/) override {
+    ++listenerCount;
+  }
+
+  int listenerCount{0};
+};
+
 class RecordingHostInterface : public HostInterface {
 public:
   void handleHydrationError(const HydrationErrorInfo& info) override {
@@ -76,6 +100,7 @@ public:
 bool runReactFiberWorkLoopStateTests() {
   ReactRuntime runtime;
   TestRuntime jsRuntime;
+  installReactGlobal(jsRuntime);
   auto recordingHost = std::make_shared<RecordingHostInterface>();
   runtime.setHostInterface(recordingHost);
   std::vector<std::string> callbackMessages;
@@ -641,11 +666,13 @@ bool runReactFiberWorkLoopStateTests() {
   suspendedChild->returnFiber = suspendedCurrent;
   suspendedChild->flags = static_cast<FiberFlags>(suspendedChild->flags | Incomplete);
   suspendedRoot.current = suspendedCurrent;
+  suspendedRoot.tag = RootTag::ConcurrentRoot;
+  PendingWakeable suspendedData;
 
   prepareFreshStack(runtime, suspendedRoot, DefaultLane);
   setWorkInProgressFiber(runtime, suspendedChild);
   setWorkInProgressSuspendedReason(runtime, SuspendedReason::SuspendedOnData);
-  setWorkInProgressThrownValue(runtime, reinterpret_cast<void*>(0x8));
+  setWorkInProgressThrownValue(runtime, &suspendedData);
   setWorkInProgressRootExitStatus(runtime, RootExitStatus::InProgress);
   setWorkInProgressRootDidSkipSuspendedSiblings(runtime, false);
 
@@ -656,6 +683,7 @@ bool runReactFiberWorkLoopStateTests() {
   assert(getWorkInProgressThrownValue(runtime) == nullptr);
   assert(getWorkInProgressFiber(runtime) == nullptr);
   assert(getWorkInProgressRoot(runtime) == nullptr);
+  assert(suspendedData.listenerCount == 1);
 
   if (FiberNode* suspendedWorkInProgress = suspendedCurrent->alternate) {
     suspendedWorkInProgress->child = nullptr;
@@ -673,6 +701,8 @@ bool runReactFiberWorkLoopStateTests() {
 
   // throwAndUnwindWorkLoop should mark skipped siblings and unwind to the shell.
   FiberRoot throwRoot{};
+  throwRoot.tag = RootTag::ConcurrentRoot;
+  PendingWakeable thrownData;
   FiberNode* throwParent = createFiber(WorkTag::HostRoot);
   FiberNode* throwChild = createFiber(WorkTag::FunctionComponent);
   throwChild->returnFiber = throwParent;
@@ -688,7 +718,7 @@ bool runReactFiberWorkLoopStateTests() {
     jsRuntime,
     throwRoot,
     *throwChild,
-    nullptr,
+    &thrownData,
     SuspendedReason::SuspendedOnData);
   assert(getWorkInProgressRootDidSkipSuspendedSiblings(runtime));
   assert(getWorkInProgressRootExitStatus(runtime) == RootExitStatus::SuspendedAtTheShell);
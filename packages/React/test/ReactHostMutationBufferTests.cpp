@@ -0,0 +1,277 @@
+#include "ReactDOM/client/ReactDOMComponent.h"
+#include "ReactRuntime/ReactHostInterface.h"
+#include "ReactRuntime/ReactHostMutationBuffer.h"
+#include "ReactRuntime/ReactJSXRuntime.h"
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactRuntime/ReactWasmLayout.h"
+#include "ReactScheduler/SchedulerWorkerPool.h"
+#include "TestRuntime.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace react {
+extern uint8_t* __wasm_memory_buffer;
+}
+
+namespace react::test {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+jsi::Value makeString(jsi::Runtime& runtime, const std::string& text) {
+  return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+}
+
+std::shared_ptr<ReactDOMComponent> asComponent(const std::shared_ptr<ReactDOMInstance>& instance) {
+  return std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+}
+
+// <ul> with one keyed <li> per entry, each holding its key as text
+jsx::WasmSerializedLayout buildList(TestRuntime& runtime, const std::vector<std::string>& keys) {
+  auto items = runtime.makeArray(keys.size());
+  for (std::size_t index = 0; index < keys.size(); ++index) {
+    jsi::Object itemProps(runtime);
+    itemProps.setProperty(runtime, "className", makeString(runtime, "item-" + keys[index]));
+    itemProps.setProperty(runtime, "children", makeString(runtime, keys[index]));
+    auto item = jsx::jsx(runtime, makeString(runtime, "li"), jsi::Value(runtime, itemProps), makeString(runtime, keys[index]));
+    items.setValueAtIndex(runtime, index, jsx::createJsxHostValue(runtime, item));
+  }
+  jsi::Object listProps(runtime);
+  listProps.setProperty(runtime, "children", jsi::Value(runtime, items));
+  auto list = jsx::jsxs(runtime, makeString(runtime, "ul"), jsi::Value(runtime, listProps));
+  return jsx::serializeToWasm(runtime, *list);
+}
+
+std::string describeItems(const std::shared_ptr<ReactDOMComponent>& root) {
+  std::string out;
+  auto list = asComponent(root->children.front());
+  for (const auto& child : list->children) {
+    out += child->getKey();
+  }
+  return out;
+}
+
+bool testRecordingDefersUntilFlush() {
+  TestRuntime runtime;
+  auto hostInterface = std::make_shared<HostInterface>();
+  ReactRuntime reactRuntime;
+  reactRuntime.setHostInterface(hostInterface);
+
+  jsi::Object props(runtime);
+  auto parent = asComponent(reactRuntime.createInstance(runtime, "div", props));
+
+  reactRuntime.beginRecordingMutations();
+  assert(reactRuntime.isRecordingMutations());
+  auto first = reactRuntime.createTextInstance(runtime, "a");
+  auto second = reactRuntime.createTextInstance(runtime, "b");
+  auto third = reactRuntime.createTextInstance(runtime, "c");
+  reactRuntime.appendChild(parent, first);
+  reactRuntime.appendChild(parent, third);
+  reactRuntime.insertBefore(parent, second, third);
+  reactRuntime.removeChild(parent, first);
+  reactRuntime.commitTextUpdate(third, "c", "z");
+  assert(parent->children.empty());
+  assert(asComponent(third)->getTextContent() == "c");
+
+  reactRuntime.flushRecordedMutations();
+  assert(!reactRuntime.isRecordingMutations());
+  assert(parent->children.size() == 2);
+  assert(parent->children[0] == second && parent->children[1] == third);
+  assert(second->getParent() == parent);
+  assert(!first->getParent());
+  assert(asComponent(third)->getTextContent() == "z");
+  return true;
+}
+
+bool testBufferEncodesTypedCommands() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  reactRuntime.beginRecordingMutations();
+
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "className", makeString(runtime, "row"));
+  auto row = reactRuntime.createInstance(runtime, "li", props);
+  auto label = reactRuntime.createTextInstance(runtime, "label");
+  reactRuntime.appendChild(row, label);
+
+  jsi::Object nextProps(runtime);
+  nextProps.setProperty(runtime, "title", makeString(runtime, "t"));
+  reactRuntime.commitUpdate(runtime, row, props, nextProps, jsi::Object(runtime));
+
+  auto buffer = reactRuntime.takeRecordedMutations();
+  assert(buffer && buffer->commandCount() == 4 && buffer->instanceCount() == 2);
+
+  std::vector<HostMutationBuffer::Op> ops;
+  HostMutationBuffer::Command command;
+  for (std::size_t offset = 0; offset < buffer->bytes().size();) {
+    offset = buffer->decode(offset, command);
+    ops.push_back(command.op);
+    if (command.op == HostMutationBuffer::Op::Create) {
+      assert(command.text == "li" && buffer->instance(command.target) == row);
+    }
+    if (command.op == HostMutationBuffer::Op::Append) {
+      assert(buffer->instance(command.child) == label);
+    }
+  }
+  assert((ops == std::vector<HostMutationBuffer::Op>{
+      HostMutationBuffer::Op::Create,
+      HostMutationBuffer::Op::CreateText,
+      HostMutationBuffer::Op::Append,
+      HostMutationBuffer::Op::ReplaceProps}));
+
+  // The wire form names props instead of using this process's ids
+  const std::vector<std::uint8_t> wire = buffer->serialize();
+  std::uint32_t commandCount = 0;
+  std::memcpy(&commandCount, wire.data(), sizeof(commandCount));
+  assert(commandCount == 4);
+  const std::string text(wire.begin(), wire.end());
+  assert(text.find("className") != std::string::npos);
+  assert(text.find("title") != std::string::npos);
+  assert(text.find("label") != std::string::npos);
+
+  HostInterface hostInterface;
+  hostInterface.applyMutations(*buffer);
+  auto rowComponent = asComponent(row);
+  assert(rowComponent->children.size() == 1);
+  assert(rowComponent->getPropSnapshot().size() == 1);
+  assert(rowComponent->getPropSnapshot().find("title")->string == "t");
+  return true;
+}
+
+bool testSerializationRunsOnWorkerPool() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  reactRuntime.setWorkerPool(std::make_shared<SchedulerWorkerPool>(1));
+
+  // Park the pool's only worker so the serialization has to queue behind it
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<bool> parked{false};
+  reactRuntime.offload(SchedulerPriority::UserBlockingPriority, [released, &parked]() {
+    parked = true;
+    released.wait();
+  });
+  while (!parked) {
+    std::this_thread::yield();
+  }
+
+  reactRuntime.beginRecordingMutations();
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "className", makeString(runtime, "row"));
+  auto row = reactRuntime.createInstance(runtime, "li", props);
+  reactRuntime.appendChild(row, reactRuntime.createTextInstance(runtime, "label"));
+
+  std::future<std::vector<std::uint8_t>> wire = reactRuntime.serializeRecordedMutations();
+  assert(!reactRuntime.isRecordingMutations());
+  // Nothing ran on this thread: the job is still waiting for the worker
+  assert(wire.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+  release.set_value();
+  const std::vector<std::uint8_t> bytes = wire.get();
+  std::uint32_t commandCount = 0;
+  std::memcpy(&commandCount, bytes.data(), sizeof(commandCount));
+  assert(commandCount == 3);
+  const std::string text(bytes.begin(), bytes.end());
+  assert(text.find("className") != std::string::npos);
+  assert(text.find("label") != std::string::npos);
+
+  // Joining releases the buffer, and with it its hold on the instances
+  const std::uint32_t heldWhileSerializing = row->refCount();
+  reactRuntime.joinOffloadedWork();
+  assert(row->refCount() == heldWhileSerializing - 1);
+  return true;
+}
+
+bool testSerializationReadsOnlyTheBuffer() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  reactRuntime.setWorkerPool(std::make_shared<SchedulerWorkerPool>(1));
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<bool> parked{false};
+  reactRuntime.offload(SchedulerPriority::UserBlockingPriority, [released, &parked]() {
+    parked = true;
+    released.wait();
+  });
+  while (!parked) {
+    std::this_thread::yield();
+  }
+
+  reactRuntime.beginRecordingMutations();
+  jsi::Object props(runtime);
+  props.setProperty(runtime, "className", makeString(runtime, "row"));
+  auto row = reactRuntime.createInstance(runtime, "li", props);
+  std::future<std::vector<std::uint8_t>> wire = reactRuntime.serializeRecordedMutations();
+
+  // Updating the instance before the worker gets to it neither races with
+  // the serialization nor leaks into its Create command
+  PropUpdatePayload payload;
+  payload.appendSet(internPropName("className"), PropValue::fromJsi(runtime, makeString(runtime, "card")));
+  reactRuntime.commitPropUpdate(row, payload);
+  assert(asComponent(row)->getPropSnapshot().find("className")->string == "card");
+
+  release.set_value();
+  const std::vector<std::uint8_t> bytes = wire.get();
+  const std::string text(bytes.begin(), bytes.end());
+  assert(text.find("row") != std::string::npos);
+  assert(text.find("card") == std::string::npos);
+  reactRuntime.joinOffloadedWork();
+  return true;
+}
+
+bool testRecordedRenderMatchesDirectRender() {
+  TestRuntime runtime;
+  auto hostInterface = std::make_shared<HostInterface>();
+  ReactRuntime direct;
+  direct.setHostInterface(hostInterface);
+  ReactRuntime recorded;
+  recorded.setHostInterface(hostInterface);
+
+  jsi::Object rootProps(runtime);
+  auto directRoot = asComponent(hostInterface->createHostInstance(runtime, "__root", rootProps));
+  auto recordedRoot = asComponent(hostInterface->createHostInstance(runtime, "__root", rootProps));
+
+  const std::vector<std::vector<std::string>> passes{
+      {"a", "b", "c", "d"},
+      {"d", "a", "c", "e"},
+      {"e", "c"},
+      {"c", "f", "e", "a"},
+  };
+  for (const auto& keys : passes) {
+    auto layout = buildList(runtime, keys);
+    react::__wasm_memory_buffer = layout.buffer.data();
+    direct.renderRootSync(runtime, layout.rootOffset, directRoot);
+
+    recorded.beginRecordingMutations();
+    recorded.renderRootSync(runtime, layout.rootOffset, recordedRoot);
+    recorded.flushRecordedMutations();
+
+    std::string expected;
+    for (const auto& key : keys) {
+      expected += key;
+    }
+    assert(describeItems(directRoot) == expected);
+    assert(describeItems(recordedRoot) == expected);
+  }
+  react::__wasm_memory_buffer = nullptr;
+  return true;
+}
+
+} // namespace
+
+bool runReactHostMutationBufferTests() {
+  return testRecordingDefersUntilFlush() && testBufferEncodesTypedCommands() && testSerializationRunsOnWorkerPool() &&
+      testSerializationReadsOnlyTheBuffer() && testRecordedRenderMatchesDirectRender();
+}
+
+} // namespace react::test
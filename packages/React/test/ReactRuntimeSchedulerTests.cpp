@@ -0,0 +1,134 @@
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactScheduler/ReactScheduler.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+class RecordingScheduler : public Scheduler {
+public:
+  TaskHandle scheduleTask(SchedulerPriority priority, Task task, const TaskOptions& options) override {
+    (void)options;
+    priorities.push_back(priority);
+    tasks.push_back(std::move(task));
+    return TaskHandle{tasks.size()};
+  }
+
+  void cancelTask(TaskHandle handle) override {
+    cancelled.push_back(handle);
+  }
+
+  SchedulerPriority getCurrentPriorityLevel() const override {
+    return SchedulerPriority::LowPriority;
+  }
+
+  SchedulerPriority runWithPriority(SchedulerPriority priority, const std::function<void()>& fn) override {
+    (void)priority;
+    fn();
+    return SchedulerPriority::LowPriority;
+  }
+
+  bool shouldYield() const override {
+    return true;
+  }
+
+  double now() const override {
+    return 42.0;
+  }
+
+  std::vector<SchedulerPriority> priorities;
+  std::vector<Task> tasks;
+  std::vector<TaskHandle> cancelled;
+};
+
+bool testRuntimeSchedulerRespectsPriority() {
+  ReactRuntime runtime;
+  std::vector<int> order;
+  SchedulerPriority observedPriority = SchedulerPriority::NoPriority;
+
+  runtime.scheduleTask(SchedulerPriority::NormalPriority, [&]() { order.push_back(1); }, TaskOptions{20.0, 0.0});
+  runtime.scheduleTask(SchedulerPriority::ImmediatePriority, [&]() {
+    order.push_back(2);
+    observedPriority = runtime.getCurrentPriorityLevel();
+  });
+  runtime.scheduleTask(SchedulerPriority::UserBlockingPriority, [&]() { order.push_back(3); });
+
+  runtime.flushAllTasksForTest();
+
+  const std::vector<int> expected{2, 3, 1};
+  assert(order == expected);
+  assert(observedPriority == SchedulerPriority::ImmediatePriority);
+  assert(runtime.getCurrentPriorityLevel() == SchedulerPriority::NormalPriority);
+
+  return true;
+}
+
+bool testRuntimeSchedulerCancellation() {
+  ReactRuntime runtime;
+  int callCount = 0;
+
+  const TaskHandle handle = runtime.scheduleTask(
+    SchedulerPriority::NormalPriority, [&]() { ++callCount; }, TaskOptions{50.0, 0.0});
+  runtime.cancelTask(handle);
+  runtime.flushAllTasksForTest();
+  assert(callCount == 0);
+
+  runtime.scheduleTask(SchedulerPriority::ImmediatePriority, [&]() { ++callCount; });
+  runtime.flushAllTasksForTest();
+  assert(callCount == 1);
+
+  return true;
+}
+
+bool testRuntimePerformWorkUntilDeadline() {
+  ReactRuntime runtime;
+  int callCount = 0;
+
+  assert(!runtime.performWorkUntilDeadline());
+
+  for (int i = 0; i < 100; ++i) {
+    runtime.scheduleTask(SchedulerPriority::UserBlockingPriority, [&]() { ++callCount; });
+  }
+
+  while (runtime.performWorkUntilDeadline()) {
+  }
+  assert(callCount == 100);
+
+  return true;
+}
+
+bool testRuntimeUsesInjectedScheduler() {
+  ReactRuntime runtime;
+  auto recording = std::make_shared<RecordingScheduler>();
+  runtime.setScheduler(recording);
+
+  const TaskHandle handle = runtime.scheduleTask(SchedulerPriority::NoPriority, []() {});
+  assert(handle.id == 1);
+  assert(recording->priorities.size() == 1);
+  assert(recording->priorities[0] == SchedulerPriority::NormalPriority);
+
+  runtime.cancelTask(handle);
+  assert(recording->cancelled.size() == 1 && recording->cancelled[0] == handle);
+  assert(runtime.shouldYield());
+  assert(runtime.now() == 42.0);
+  assert(runtime.getCurrentPriorityLevel() == SchedulerPriority::LowPriority);
+  assert(&runtime.scheduler() == recording.get());
+
+  runtime.setScheduler(nullptr);
+  assert(dynamic_cast<ReactScheduler*>(&runtime.scheduler()) != nullptr);
+
+  return true;
+}
+
+} // namespace
+
+bool runReactRuntimeSchedulerTests() {
+  return testRuntimeSchedulerRespectsPriority() && testRuntimeSchedulerCancellation() &&
+      testRuntimePerformWorkUntilDeadline() && testRuntimeUsesInjectedScheduler();
+}
+
+} // namespace react::test
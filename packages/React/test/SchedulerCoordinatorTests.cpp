@@ -0,0 +1,224 @@
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactScheduler/SchedulerCoordinator.h"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+void spinFor(const SchedulerCoordinator& coordinator, double ms) {
+  const double start = coordinator.now();
+  while (coordinator.now() - start < ms) {
+  }
+}
+
+const SchedulerCoordinator::ClientStats* findStats(
+    const std::vector<SchedulerCoordinator::ClientStats>& stats,
+    uint64_t clientId) {
+  for (const auto& entry : stats) {
+    if (entry.clientId == clientId) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+bool testPriorityAcrossClients() {
+  SchedulerCoordinator coordinator;
+  auto background = coordinator.createClient({"background"});
+  auto foreground = coordinator.createClient({"foreground"});
+  assert(coordinator.clientCount() == 2);
+
+  std::vector<std::string> order;
+  background->scheduleTask(SchedulerPriority::IdlePriority, [&order]() { order.push_back("idle"); });
+  background->scheduleTask(SchedulerPriority::NormalPriority, [&order]() { order.push_back("normal"); });
+  foreground->scheduleTask(SchedulerPriority::UserBlockingPriority, [&order]() { order.push_back("input"); });
+  foreground->scheduleTask(SchedulerPriority::LowPriority, [&background, &order]() {
+    order.push_back("low");
+    assert(background->getCurrentPriorityLevel() == SchedulerPriority::NormalPriority);
+  });
+
+  while (coordinator.performWorkUntilDeadline()) {
+  }
+
+  const std::vector<std::string> expected{"input", "normal", "low", "idle"};
+  assert(order == expected);
+  return true;
+}
+
+bool testWeightedFairness() {
+  SchedulerCoordinator coordinator;
+  auto heavy = coordinator.createClient({"heavy", 3.0});
+  auto light = coordinator.createClient({"light", 1.0});
+
+  // Each client keeps rescheduling 0.2ms chunks of normal-priority work
+  const double chunkMs = 0.2;
+  std::function<void()> heavyChunk;
+  std::function<void()> lightChunk;
+  heavyChunk = [&]() {
+    spinFor(coordinator, chunkMs);
+    heavy->scheduleTask(SchedulerPriority::NormalPriority, heavyChunk, TaskOptions{0.0, 1e6});
+  };
+  lightChunk = [&]() {
+    spinFor(coordinator, chunkMs);
+    light->scheduleTask(SchedulerPriority::NormalPriority, lightChunk, TaskOptions{0.0, 1e6});
+  };
+  heavy->scheduleTask(SchedulerPriority::NormalPriority, heavyChunk, TaskOptions{0.0, 1e6});
+  light->scheduleTask(SchedulerPriority::NormalPriority, lightChunk, TaskOptions{0.0, 1e6});
+
+  for (int slice = 0; slice < 8; ++slice) {
+    assert(coordinator.performWorkUntilDeadline());
+  }
+
+  const auto stats = coordinator.clientStats();
+  const auto* heavyStats = findStats(stats, heavy->clientId());
+  const auto* lightStats = findStats(stats, light->clientId());
+  assert(heavyStats != nullptr && lightStats != nullptr);
+  assert(lightStats->tasksRun > 0);
+  const double ratio = heavyStats->runTimeMs / lightStats->runTimeMs;
+  assert(ratio > 2.0 && ratio < 4.5);
+  assert(heavyStats->pendingTasks == 1 && lightStats->pendingTasks == 1);
+  return true;
+}
+
+bool testQuotaThrottlesButStaysWorkConserving() {
+  SchedulerCoordinator coordinator(1000.0);
+  auto greedy = coordinator.createClient({"greedy", 1.0, 1.0});
+  auto polite = coordinator.createClient({"polite"});
+
+  std::vector<std::string> order;
+  greedy->scheduleTask(SchedulerPriority::UserBlockingPriority, [&]() {
+    spinFor(coordinator, 1.5);
+    order.push_back("greedy-1");
+  });
+  greedy->scheduleTask(SchedulerPriority::UserBlockingPriority, [&order]() { order.push_back("greedy-2"); });
+  polite->scheduleTask(SchedulerPriority::NormalPriority, [&order]() { order.push_back("polite"); });
+
+  // Over quota, greedy's higher priority work waits behind polite's
+  coordinator.flushAllTasks();
+  const std::vector<std::string> expected{"greedy-1", "polite", "greedy-2"};
+  assert(order == expected);
+
+  const auto stats = coordinator.clientStats();
+  assert(findStats(stats, greedy->clientId())->throttledSkips == 1);
+  assert(findStats(stats, greedy->clientId())->tasksRun == 2);
+  return true;
+}
+
+bool testDelayedAndCancelledTasks() {
+  SchedulerCoordinator coordinator;
+  auto first = coordinator.createClient();
+  auto second = coordinator.createClient();
+
+  int ran = 0;
+  const TaskHandle cancelled = first->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran += 100; });
+  // Handles belong to the client that scheduled them
+  second->cancelTask(cancelled);
+  first->cancelTask(cancelled);
+
+  first->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran += 1; }, TaskOptions{50.0, 0.0});
+  second->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran += 10; }, TaskOptions{50.0, 0.0});
+  assert(!coordinator.performWorkUntilDeadline());
+  assert(ran == 0);
+
+  // A client flush only pulls in its own delayed work
+  second->flushAllTasks();
+  assert(ran == 10);
+  assert(findStats(coordinator.clientStats(), first->clientId())->pendingTimers == 1);
+
+  coordinator.flushAllTasks();
+  assert(ran == 11);
+  return true;
+}
+
+bool testClientDestructionCancelsWork() {
+  SchedulerCoordinator coordinator;
+  auto survivor = coordinator.createClient({"survivor"});
+  auto doomed = coordinator.createClient({"doomed"});
+
+  int ran = 0;
+  doomed->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran += 100; });
+  doomed->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran += 100; }, TaskOptions{10.0, 0.0});
+  survivor->scheduleTask(SchedulerPriority::NormalPriority, [&]() {
+    ran += 1;
+    // Tearing a runtime down from inside another runtime's task
+    doomed.reset();
+  }, TaskOptions{0.0, 0.01});
+
+  coordinator.flushAllTasks();
+  assert(ran == 1);
+  assert(coordinator.clientCount() == 1);
+
+  // The freed slot is reused
+  auto replacement = coordinator.createClient({"replacement"});
+  assert(coordinator.clientCount() == 2);
+  replacement->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran += 2; });
+  coordinator.flushAllTasks();
+  assert(ran == 3);
+  return true;
+}
+
+bool testReusedSlotIsNotChargedForStaleWork() {
+  SchedulerCoordinator coordinator;
+  auto doomed = coordinator.createClient({"doomed"});
+  const uint64_t doomedId = doomed->clientId();
+  std::shared_ptr<CoordinatedScheduler> replacement;
+
+  // The task tears its own runtime down and a new one takes the freed slot
+  // before the coordinator books the task's run time
+  doomed->scheduleTask(SchedulerPriority::NormalPriority, [&]() {
+    doomed.reset();
+    replacement = coordinator.createClient({"replacement"});
+  });
+  coordinator.flushAllTasks();
+
+  assert(replacement->clientId() != doomedId);
+  const auto clientStats = coordinator.clientStats();
+  const auto* stats = findStats(clientStats, replacement->clientId());
+  assert(stats != nullptr && stats->tasksRun == 0 && stats->runTimeMs == 0.0);
+
+  // Delayed work flushes in start order, one client at a time
+  std::vector<int> order;
+  for (int delay = 5; delay > 0; --delay) {
+    replacement->scheduleTask(
+        SchedulerPriority::NormalPriority, [&order, delay]() { order.push_back(delay); }, TaskOptions{delay * 10.0, 0.0});
+  }
+  assert(findStats(coordinator.clientStats(), replacement->clientId())->pendingTimers == 5);
+  replacement->flushAllTasks();
+  assert((order == std::vector<int>{1, 2, 3, 4, 5}));
+  assert(findStats(coordinator.clientStats(), replacement->clientId())->pendingTimers == 0);
+  return true;
+}
+
+bool testRuntimesShareCoordinator() {
+  SchedulerCoordinator coordinator;
+  ReactRuntime runtimeA;
+  ReactRuntime runtimeB;
+  runtimeA.setScheduler(coordinator.createClient({"a"}));
+  runtimeB.setScheduler(coordinator.createClient({"b"}));
+
+  std::vector<std::string> order;
+  runtimeA.scheduleTask(SchedulerPriority::IdlePriority, [&order]() { order.push_back("a-idle"); });
+  runtimeB.scheduleTask(SchedulerPriority::ImmediatePriority, [&order]() { order.push_back("b-sync"); });
+
+  // Either runtime's pump drives both
+  while (runtimeA.performWorkUntilDeadline()) {
+  }
+  const std::vector<std::string> expected{"b-sync", "a-idle"};
+  assert(order == expected);
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerCoordinatorTests() {
+  return testPriorityAcrossClients() && testWeightedFairness() && testQuotaThrottlesButStaysWorkConserving() &&
+      testDelayedAndCancelledTasks() && testClientDestructionCancelsWork() && testReusedSlotIsNotChargedForStaleWork() &&
+      testRuntimesShareCoordinator();
+}
+
+} // namespace react::test
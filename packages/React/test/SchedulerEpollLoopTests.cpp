@@ -0,0 +1,147 @@
+#if defined(__linux__)
+
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerEpollLoop.h"
+
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+bool testLoopRunsReadyWorkUntilIdle() {
+  auto scheduler = std::make_shared<ReactScheduler>();
+  std::vector<int> order;
+  // Work queued before the loop attaches is picked up as well
+  scheduler->scheduleTask(SchedulerPriority::NormalPriority, [&order]() { order.push_back(2); });
+
+  SchedulerEpollLoop loop(scheduler);
+  scheduler->scheduleTask(SchedulerPriority::ImmediatePriority, [&order]() { order.push_back(1); });
+  loop.runUntilIdle();
+
+  assert((order == std::vector<int>{1, 2}));
+  assert(loop.stats().slices >= 1);
+  assert(loop.stats().blockingWaits == 0);
+  assert(scheduler->pendingTaskCount() == 0);
+
+  return true;
+}
+
+bool testLoopSleepsUntilTimerIsDue() {
+  auto scheduler = std::make_shared<ReactScheduler>();
+  SchedulerEpollLoop loop(scheduler);
+
+  std::vector<int> order;
+  double ranAt = -1.0;
+  const double scheduledAt = scheduler->now();
+  scheduler->scheduleTask(
+      SchedulerPriority::NormalPriority,
+      [&]() {
+        order.push_back(2);
+        ranAt = scheduler->now();
+      },
+      TaskOptions{20.0, 0.0});
+  scheduler->scheduleTask(
+      SchedulerPriority::NormalPriority, [&order]() { order.push_back(1); }, TaskOptions{5.0, 0.0});
+  const TaskHandle cancelled = scheduler->scheduleTask(
+      SchedulerPriority::NormalPriority, [&order]() { order.push_back(99); }, TaskOptions{10.0, 0.0});
+  scheduler->cancelTask(cancelled);
+
+  loop.runUntilIdle();
+
+  assert((order == std::vector<int>{1, 2}));
+  assert(ranAt - scheduledAt >= 20.0);
+  // One blocking wait per timer rather than a busy spin
+  assert(loop.stats().timerWakeups >= 2);
+  assert(loop.stats().blockingWaits <= loop.stats().timerWakeups + 1);
+
+  return true;
+}
+
+bool testPostWakesLoopFromAnotherThread() {
+  auto scheduler = std::make_shared<ReactScheduler>();
+  SchedulerEpollLoop loop(scheduler);
+
+  int runs = 0;
+  std::thread producer([&]() {
+    for (int i = 0; i < 3; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      loop.post([&]() {
+        scheduler->scheduleTask(SchedulerPriority::UserBlockingPriority, [&runs]() { ++runs; });
+      });
+    }
+    loop.post([&loop]() { loop.stop(); });
+  });
+
+  loop.run();
+  producer.join();
+
+  // stop() lets the current iteration finish; drain whatever is left
+  loop.runUntilIdle();
+  assert(runs == 3);
+  assert(loop.stats().eventWakeups >= 1);
+
+  return true;
+}
+
+bool testDestroyedLoopKeepsItsReplacementAttached() {
+  auto scheduler = std::make_shared<ReactScheduler>();
+  auto first = std::make_unique<SchedulerEpollLoop>(scheduler);
+  SchedulerEpollLoop second(scheduler);
+  assert(scheduler->host() == &second);
+
+  first.reset();
+  assert(scheduler->host() == &second);
+
+  bool ran = false;
+  scheduler->scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran = true; });
+  second.runUntilIdle();
+  assert(ran);
+  return true;
+}
+
+bool testLoopDrivesReactRuntime() {
+  ReactRuntime runtime;
+  SchedulerEpollLoop loop(runtime.sharedScheduler());
+
+  bool ran = false;
+  runtime.scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran = true; }, TaskOptions{1.0, 0.0});
+  loop.runUntilIdle();
+  assert(ran);
+
+  // Swapping the backend leaves the loop driving the scheduler it attached to
+  bool ranAfterSwap = false;
+  runtime.scheduler().scheduleTask(SchedulerPriority::NormalPriority, [&ranAfterSwap]() { ranAfterSwap = true; });
+  runtime.setScheduler(std::make_shared<ReactScheduler>());
+  loop.runUntilIdle();
+  assert(ranAfterSwap);
+
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerEpollLoopTests() {
+  return testLoopRunsReadyWorkUntilIdle() && testLoopSleepsUntilTimerIsDue() &&
+      testPostWakesLoopFromAnotherThread() && testDestroyedLoopKeepsItsReplacementAttached() &&
+      testLoopDrivesReactRuntime();
+}
+
+} // namespace react::test
+
+#else
+
+namespace react::test {
+
+bool runSchedulerEpollLoopTests() {
+  return true;
+}
+
+} // namespace react::test
+
+#endif
@@ -0,0 +1,131 @@
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerMetrics.h"
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+namespace react::test {
+
+namespace {
+
+void spinFor(const ReactScheduler& scheduler, double ms) {
+  const double start = scheduler.now();
+  while (scheduler.now() - start < ms) {
+  }
+}
+
+bool withinRelative(double actual, double expected, double tolerance) {
+  return std::fabs(actual - expected) <= expected * tolerance;
+}
+
+bool testHistogramPercentiles() {
+  SchedulerLatencyHistogram histogram;
+  assert(histogram.percentileMs(0.5) == 0.0);
+
+  // 1..1000us, uniformly
+  for (int micros = 1; micros <= 1000; ++micros) {
+    histogram.record(micros / 1000.0);
+  }
+  assert(histogram.count() == 1000);
+  assert(histogram.minMs() == 0.001);
+  assert(histogram.maxMs() == 1.0);
+  assert(withinRelative(histogram.meanMs(), 0.5005, 1e-9));
+  assert(withinRelative(histogram.percentileMs(0.5), 0.5, 0.125));
+  assert(withinRelative(histogram.percentileMs(0.99), 0.99, 0.125));
+  assert(histogram.percentileMs(1.0) == 1.0);
+
+  // Very large and negative values are clamped instead of overflowing
+  SchedulerLatencyHistogram extremes;
+  extremes.record(-5.0);
+  extremes.record(1e15);
+  assert(extremes.count() == 2);
+  assert(extremes.minMs() == 0.0);
+  assert(extremes.percentileMs(1.0) > 1e9);
+
+  histogram.merge(extremes);
+  assert(histogram.count() == 1002);
+  histogram.reset();
+  assert(histogram.count() == 0);
+
+  return true;
+}
+
+bool testSchedulerRecordsPerPriorityLatency() {
+  ReactScheduler scheduler;
+  assert(!scheduler.metricsEnabled());
+  SchedulerMetricsSnapshot snapshot;
+  assert(!scheduler.snapshotMetrics(snapshot));
+  scheduler.setMetricsEnabled(true);
+
+  // A render task, and an input task that has to wait behind it: the render's
+  // tighter timeout sorts it first
+  scheduler.scheduleTask(
+      SchedulerPriority::NormalPriority, [&scheduler]() { spinFor(scheduler, 3.0); }, TaskOptions{0.0, 0.01});
+  scheduler.scheduleTask(
+      SchedulerPriority::UserBlockingPriority, []() {}, TaskOptions{0.0, 1.0});
+  const TaskHandle cancelled = scheduler.scheduleTask(SchedulerPriority::LowPriority, []() {});
+  scheduler.cancelTask(cancelled);
+  scheduler.scheduleTask(SchedulerPriority::ImmediatePriority, []() {});
+  scheduler.flushAllTasks();
+
+  assert(scheduler.snapshotMetrics(snapshot));
+
+  const SchedulerPriorityMetrics& normal = snapshot.forPriority(SchedulerPriority::NormalPriority);
+  assert(normal.tasksRun == 1);
+  assert(normal.runTime.minMs() >= 2.5);
+
+  // The input task expires while the render runs
+  const SchedulerPriorityMetrics& input = snapshot.forPriority(SchedulerPriority::UserBlockingPriority);
+  assert(input.tasksRun == 1);
+  assert(input.expiredBeforeRun == 1);
+  assert(input.queueWait.maxMs() >= 2.5);
+  assert(input.expirationOverrun.count() == 1);
+
+  // Immediate tasks are due when queued; running them is not starvation
+  assert(snapshot.forPriority(SchedulerPriority::ImmediatePriority).tasksRun == 1);
+  assert(snapshot.forPriority(SchedulerPriority::ImmediatePriority).expiredBeforeRun == 0);
+  assert(snapshot.forPriority(SchedulerPriority::LowPriority).tasksCancelled == 1);
+  assert(snapshot.forPriority(SchedulerPriority::LowPriority).tasksRun == 0);
+
+  scheduler.resetMetrics();
+  assert(scheduler.snapshotMetrics(snapshot));
+  assert(snapshot.forPriority(SchedulerPriority::NormalPriority).tasksRun == 0);
+
+  scheduler.setMetricsEnabled(false);
+  assert(!scheduler.snapshotMetrics(snapshot));
+
+  return true;
+}
+
+bool testRuntimeExposesSchedulerMetrics() {
+  ReactRuntime runtime;
+  SchedulerMetricsSnapshot snapshot;
+  assert(!runtime.snapshotSchedulerMetrics(snapshot));
+
+  auto measured = std::make_shared<ReactScheduler>();
+  measured->setMetricsEnabled(true);
+  runtime.setScheduler(measured);
+  bool ran = false;
+  runtime.scheduleTask(SchedulerPriority::UserBlockingPriority, [&ran]() { ran = true; });
+  runtime.flushAllTasksForTest();
+  assert(ran);
+
+  assert(runtime.snapshotSchedulerMetrics(snapshot));
+  assert(snapshot.forPriority(SchedulerPriority::UserBlockingPriority).tasksRun == 1);
+
+  runtime.setScheduler(nullptr);
+  assert(!runtime.snapshotSchedulerMetrics(snapshot));
+
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerMetricsTests() {
+  return testHistogramPercentiles() && testSchedulerRecordsPerPriorityLatency() &&
+      testRuntimeExposesSchedulerMetrics();
+}
+
+} // namespace react::test
@@ -0,0 +1,154 @@
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerIndexedMinHeap.h"
+#include "ReactScheduler/SchedulerMinHeap.h"
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+struct TestHeapNode : HeapNode {
+  TestHeapNode(uint64_t nodeId, double index) {
+    id = nodeId;
+    sortIndex = index;
+  }
+};
+
+bool testIndexedHeapOrdering() {
+  std::vector<TestHeapNode> nodes;
+  nodes.reserve(64);
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(0, 15);
+  for (uint64_t i = 0; i < 64; ++i) {
+    nodes.emplace_back(i + 1, static_cast<double>(dist(rng)));
+  }
+
+  SchedulerIndexedMinHeap<TestHeapNode> indexed;
+  SchedulerMinHeap<TestHeapNode> binary;
+  for (auto& node : nodes) {
+    indexed.push(&node);
+    binary.push(&node);
+  }
+  assert(indexed.size() == nodes.size());
+
+  // Both heaps must agree on (sortIndex, id) order, including FIFO ties.
+  while (!binary.empty()) {
+    TestHeapNode* expected = binary.pop();
+    TestHeapNode* actual = indexed.pop();
+    assert(actual == expected);
+    assert(actual->heapIndex == kInvalidHeapIndex);
+  }
+  assert(indexed.empty());
+  assert(indexed.pop() == nullptr);
+
+  return true;
+}
+
+bool testIndexedHeapRemoveAndUpdate() {
+  std::vector<TestHeapNode> nodes;
+  nodes.reserve(32);
+  for (uint64_t i = 0; i < 32; ++i) {
+    nodes.emplace_back(i + 1, static_cast<double>((i * 7) % 32));
+  }
+
+  SchedulerIndexedMinHeap<TestHeapNode> heap;
+  for (auto& node : nodes) {
+    heap.push(&node);
+    assert(heap.contains(&node));
+  }
+
+  // Pushing a node that is already queued is a no-op.
+  heap.push(&nodes[0]);
+  assert(heap.size() == nodes.size());
+
+  for (size_t i = 0; i < nodes.size(); i += 3) {
+    assert(heap.remove(&nodes[i]));
+    assert(!heap.contains(&nodes[i]));
+    assert(!heap.remove(&nodes[i]));
+  }
+
+  nodes[1].sortIndex = -1.0;
+  assert(heap.update(&nodes[1]));
+  assert(heap.peek() == &nodes[1]);
+
+  nodes[1].sortIndex = 100.0;
+  assert(heap.update(&nodes[1]));
+
+  double previous = -1.0;
+  size_t popped = 0;
+  while (TestHeapNode* node = heap.pop()) {
+    assert(node->sortIndex >= previous);
+    previous = node->sortIndex;
+    ++popped;
+  }
+  assert(popped == nodes.size() - (nodes.size() + 2) / 3);
+  assert(previous == 100.0);
+
+  return true;
+}
+
+bool testSchedulerCancelRemovesTasks() {
+  ReactScheduler scheduler;
+  std::vector<int> order;
+
+  scheduler.scheduleTask(SchedulerPriority::NormalPriority, [&]() { order.push_back(3); });
+  const TaskHandle cancelled = scheduler.scheduleTask(SchedulerPriority::UserBlockingPriority, [&]() { order.push_back(99); });
+  scheduler.scheduleTask(SchedulerPriority::ImmediatePriority, [&]() { order.push_back(1); });
+  scheduler.scheduleTask(SchedulerPriority::UserBlockingPriority, [&]() { order.push_back(2); });
+  const TaskHandle delayed = scheduler.scheduleTask(
+    SchedulerPriority::NormalPriority, [&]() { order.push_back(100); }, TaskOptions{60000.0, 0.0});
+
+  assert(scheduler.pendingTaskCount() == 4);
+  assert(scheduler.pendingTimerCount() == 1);
+
+  scheduler.cancelTask(cancelled);
+  scheduler.cancelTask(delayed);
+  assert(scheduler.pendingTaskCount() == 3);
+  assert(scheduler.pendingTimerCount() == 0);
+
+  // Cancelling twice or cancelling an unknown handle is harmless.
+  scheduler.cancelTask(cancelled);
+  scheduler.cancelTask(TaskHandle{12345});
+
+  scheduler.startMessageLoop();
+  while (scheduler.performWorkUntilDeadline()) {
+  }
+
+  const std::vector<int> expected{1, 2, 3};
+  assert(order == expected);
+  assert(scheduler.pendingTaskCount() == 0);
+
+  return true;
+}
+
+bool testSchedulerTaskCanCancelItself() {
+  ReactScheduler scheduler;
+  TaskHandle self{};
+  int runs = 0;
+  self = scheduler.scheduleTask(SchedulerPriority::ImmediatePriority, [&]() {
+    ++runs;
+    scheduler.cancelTask(self);
+  });
+
+  scheduler.startMessageLoop();
+  while (scheduler.performWorkUntilDeadline()) {
+  }
+
+  assert(runs == 1);
+  assert(scheduler.pendingTaskCount() == 0);
+
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerMinHeapTests() {
+  return testIndexedHeapOrdering() && testIndexedHeapRemoveAndUpdate() &&
+      testSchedulerCancelRemovesTasks() && testSchedulerTaskCanCancelItself();
+}
+
+} // namespace react::test
@@ -0,0 +1,109 @@
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerTaskPool.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+bool testPoolHandlesAreGenerationChecked() {
+  SchedulerTaskPool pool;
+
+  SchedulerTask* first = pool.acquire();
+  const TaskHandle firstHandle = first->handle;
+  assert(firstHandle);
+  assert((firstHandle.id & (1ull << 63)) == 0);
+  assert(pool.get(firstHandle) == first);
+
+  pool.release(first);
+  assert(pool.get(firstHandle) == nullptr);
+
+  // The freed slot is reused, but the old handle must not resolve to it.
+  SchedulerTask* second = pool.acquire();
+  assert(second == first);
+  assert(second->handle != firstHandle);
+  assert(pool.get(second->handle) == second);
+  assert(pool.get(firstHandle) == nullptr);
+
+  assert(pool.get(TaskHandle{}) == nullptr);
+  assert(pool.get(TaskHandle{0xffffffffull}) == nullptr);
+
+  pool.release(second);
+  pool.release(second);
+  assert(pool.stats().liveCount == 0);
+  assert(pool.stats().acquireCount == 2);
+  assert(pool.stats().releaseCount == 2);
+
+  return true;
+}
+
+bool testPoolGrowsByBlocks() {
+  SchedulerTaskPool pool;
+  std::vector<SchedulerTask*> tasks;
+  const size_t count = SchedulerTaskPool::kBlockSize * 2 + 1;
+  for (size_t i = 0; i < count; ++i) {
+    tasks.push_back(pool.acquire());
+  }
+  assert(pool.stats().blockCount == 3);
+  assert(pool.stats().peakLiveCount == count);
+
+  for (SchedulerTask* task : tasks) {
+    assert(pool.get(task->handle) == task);
+    pool.release(task);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    pool.acquire();
+  }
+  assert(pool.stats().blockCount == 3);
+
+  return true;
+}
+
+bool testSchedulerReusesPooledTasks() {
+  ReactScheduler scheduler;
+  int runs = 0;
+
+  auto scheduleBurst = [&]() {
+    std::vector<TaskHandle> handles;
+    for (int i = 0; i < 600; ++i) {
+      handles.push_back(scheduler.scheduleTask(SchedulerPriority::NormalPriority, [&runs]() { ++runs; }));
+    }
+    for (size_t i = 0; i < handles.size(); i += 2) {
+      scheduler.cancelTask(handles[i]);
+    }
+    scheduler.flushAllTasks();
+    return handles;
+  };
+
+  const std::vector<TaskHandle> firstBurst = scheduleBurst();
+  const size_t blocksAfterWarmup = scheduler.taskPoolStats().blockCount;
+  assert(runs == 300);
+  assert(scheduler.taskPoolStats().liveCount == 0);
+
+  scheduleBurst();
+  assert(runs == 600);
+  assert(scheduler.taskPoolStats().blockCount == blocksAfterWarmup);
+
+  // Handles from the first burst are stale and must not cancel new tasks.
+  bool ran = false;
+  scheduler.scheduleTask(SchedulerPriority::NormalPriority, [&ran]() { ran = true; });
+  for (const TaskHandle& handle : firstBurst) {
+    scheduler.cancelTask(handle);
+  }
+  scheduler.flushAllTasks();
+  assert(ran);
+
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerTaskPoolTests() {
+  return testPoolHandlesAreGenerationChecked() && testPoolGrowsByBlocks() &&
+      testSchedulerReusesPooledTasks();
+}
+
+} // namespace react::test
@@ -0,0 +1,242 @@
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerTimeSlice.h"
+
+#include <cassert>
+
+namespace react::test {
+
+namespace {
+
+SchedulerSliceConfig adaptiveConfig() {
+  SchedulerSliceConfig config;
+  config.adaptive = true;
+  config.minSliceMs = 2.0;
+  config.maxSliceMs = 10.0;
+  config.growFactor = 2.0;
+  config.shrinkFactor = 0.5;
+  return config;
+}
+
+bool testFixedSliceKeepsFrameInterval() {
+  SchedulerSliceController controller;
+  controller.configure(SchedulerSliceConfig{}, 5.0);
+
+  for (int i = 0; i < 3; ++i) {
+    assert(controller.beginSlice(true, true) == 5.0);
+    controller.recordUnit();
+    controller.noteYield(SchedulerYieldReason::Budget, 0.5);
+    controller.endSlice(5.5, true);
+  }
+  assert(controller.stats().sliceCount == 3);
+  assert(controller.stats().budgetYields == 3);
+  assert(controller.stats().totalOvershootMs == 1.5);
+  assert(controller.stats().lastSliceUnits == 1);
+
+  return true;
+}
+
+bool testAdaptiveSliceWidensAndNarrows() {
+  SchedulerSliceController controller;
+  controller.configure(adaptiveConfig(), 4.0);
+
+  // Long render with nothing else waiting: 4 -> 8 -> 10 (max)
+  assert(controller.beginSlice(false, false) == 4.0);
+  controller.noteYield(SchedulerYieldReason::Budget, 0.0);
+  controller.endSlice(4.0, true);
+  assert(controller.beginSlice(false, false) == 8.0);
+  controller.noteYield(SchedulerYieldReason::Budget, 0.0);
+  controller.endSlice(8.0, true);
+  assert(controller.beginSlice(false, false) == 10.0);
+
+  // A paint request halves it; later yields in the same slice are ignored
+  controller.noteYield(SchedulerYieldReason::Paint, 0.0);
+  controller.noteYield(SchedulerYieldReason::Budget, 3.0);
+  controller.endSlice(3.0, true);
+  assert(controller.stats().paintYields == 1);
+  assert(controller.stats().lastYieldReason == SchedulerYieldReason::Paint);
+  assert(controller.beginSlice(false, false) == 5.0);
+  controller.endSlice(1.0, false);
+
+  // Pending input or paint pins the next slice to the minimum
+  assert(controller.beginSlice(true, false) == 2.0);
+  controller.endSlice(1.0, false);
+  assert(controller.beginSlice(false, true) == 2.0);
+  controller.endSlice(1.0, false);
+
+  // Running out of work keeps the learned budget
+  assert(controller.beginSlice(false, false) == 5.0);
+
+  return true;
+}
+
+bool testAdaptiveSliceFitsExpensiveUnits() {
+  SchedulerSliceController controller;
+  SchedulerSliceConfig config = adaptiveConfig();
+  config.unitCostSmoothing = 1.0;
+  controller.configure(config, 2.0);
+
+  // Two units took 2ms each: plan room for minUnitsPerSlice (4) of them
+  controller.beginSlice(false, false);
+  controller.recordUnit();
+  controller.recordUnit();
+  controller.endSlice(4.0, false);
+  assert(controller.stats().averageUnitCostMs == 2.0);
+  assert(controller.beginSlice(false, false) == 8.0);
+
+  return true;
+}
+
+void spinFor(const ReactScheduler& scheduler, double ms) {
+  const double start = scheduler.now();
+  while (scheduler.now() - start < ms) {
+  }
+}
+
+bool testSchedulerYieldsToInputInAdaptiveMode() {
+  ReactScheduler scheduler;
+  scheduler.setSliceConfig(adaptiveConfig());
+
+  bool inputRan = false;
+  bool yieldedEarly = false;
+  scheduler.scheduleTask(SchedulerPriority::NormalPriority, [&]() {
+    scheduler.scheduleTask(SchedulerPriority::UserBlockingPriority, [&inputRan]() { inputRan = true; });
+    const double start = scheduler.now();
+    while (!scheduler.shouldYield()) {
+      spinFor(scheduler, 0.05);
+    }
+    yieldedEarly = scheduler.now() - start < scheduler.sliceStats().currentBudgetMs;
+  });
+  assert(scheduler.pendingTaskCount(SchedulerPriority::NormalPriority) == 1);
+
+  while (scheduler.performWorkUntilDeadline()) {
+  }
+
+  assert(inputRan);
+  assert(yieldedEarly);
+  const SchedulerSliceStats& stats = scheduler.sliceStats();
+  assert(stats.inputYields == 1);
+  assert(stats.unitCount > 1);
+  assert(stats.averageUnitCostMs > 0.0);
+  assert(scheduler.pendingTaskCount(SchedulerPriority::UserBlockingPriority) == 0);
+
+  return true;
+}
+
+bool testSchedulerGrowsSliceForLongRender() {
+  ReactScheduler scheduler;
+  scheduler.setSliceConfig(adaptiveConfig());
+
+  // Each task renders until told to yield, like a concurrent root
+  int remaining = 3;
+  Task render;
+  render = [&]() {
+    while (!scheduler.shouldYield()) {
+      spinFor(scheduler, 0.05);
+    }
+    if (--remaining > 0) {
+      scheduler.scheduleTask(SchedulerPriority::NormalPriority, render);
+    }
+  };
+  scheduler.scheduleTask(SchedulerPriority::NormalPriority, render);
+
+  while (scheduler.performWorkUntilDeadline()) {
+  }
+
+  const SchedulerSliceStats& stats = scheduler.sliceStats();
+  assert(stats.budgetYields == 3);
+  assert(stats.currentBudgetMs == 10.0);
+  assert(stats.lastSliceBudgetMs == 10.0);
+
+  scheduler.resetSliceStats();
+  assert(scheduler.sliceStats().sliceCount == 0);
+  assert(scheduler.sliceStats().currentBudgetMs == 10.0);
+
+  return true;
+}
+
+bool testYieldSamplerBoundsStride() {
+  SchedulerYieldSampler sampler;
+  SchedulerYieldCheckConfig config;
+  config.sampled = true;
+  config.maxStride = 64;
+  config.maxOvershootMs = 0.05;
+  sampler.configure(config);
+
+  // No cost measured yet: the first check reads the clock
+  sampler.beginSlice(0.0);
+  assert(sampler.shouldSample());
+  sampler.onSample(0.001, 5.0);
+  assert(sampler.stats().checkCostMs == 0.001);
+  assert(sampler.stats().stride == 50);
+
+  for (int i = 0; i < 49; ++i) {
+    assert(!sampler.shouldSample());
+  }
+  assert(sampler.shouldSample());
+
+  // Close to the deadline the stride shrinks so the deadline is not overrun
+  sampler.onSample(0.051, 0.01);
+  assert(sampler.stats().stride == 10);
+  sampler.onSample(0.051 + 0.01, 0.0);
+  assert(sampler.stats().stride == 1);
+
+  // Very cheap checks are capped at maxStride; the next slice reuses the cost
+  sampler.configure(config);
+  sampler.beginSlice(0.0);
+  sampler.shouldSample();
+  sampler.onSample(0.000001, 5.0);
+  assert(sampler.stats().stride == 64);
+  sampler.beginSlice(1.0);
+  assert(sampler.stats().stride == 64);
+  assert(sampler.stats().samples == 4);
+
+  return true;
+}
+
+bool testSchedulerSampledYieldChecks() {
+  ReactScheduler scheduler;
+  SchedulerYieldCheckConfig config;
+  config.sampled = true;
+  config.clock = SchedulerClockSource::Tsc;
+  scheduler.setYieldCheckConfig(config);
+  assert(scheduler.yieldClockSource() == (SchedulerClock::isTscAvailable() ? SchedulerClockSource::Tsc
+                                                                           : SchedulerClockSource::SteadyClock));
+
+  double elapsed = 0.0;
+  scheduler.scheduleTask(SchedulerPriority::NormalPriority, [&]() {
+    const double start = scheduler.now();
+    volatile uint64_t sink = 0;
+    while (!scheduler.shouldYield()) {
+      sink = sink + 1;
+    }
+    elapsed = scheduler.now() - start;
+  });
+  while (scheduler.performWorkUntilDeadline()) {
+  }
+
+  const SchedulerYieldSampler::Stats& stats = scheduler.yieldCheckStats();
+  // The slice started just before the task did
+  assert(elapsed + 0.5 >= scheduler.sliceStats().lastSliceBudgetMs);
+  assert(stats.samples > 0);
+  assert(stats.samples * 2 < stats.checks);
+  assert(scheduler.sliceStats().budgetYields == 1);
+
+  const SchedulerClock clock(SchedulerClockSource::Tsc);
+  const double first = clock.nowMs();
+  spinFor(scheduler, 1.0);
+  const double second = clock.nowMs();
+  assert(second - first >= 0.5 && second - first < 50.0);
+
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerTimeSliceTests() {
+  return testFixedSliceKeepsFrameInterval() && testAdaptiveSliceWidensAndNarrows() &&
+      testAdaptiveSliceFitsExpensiveUnits() && testSchedulerYieldsToInputInAdaptiveMode() &&
+      testSchedulerGrowsSliceForLongRender() && testYieldSamplerBoundsStride() &&
+      testSchedulerSampledYieldChecks();
+}
+
+} // namespace react::test
@@ -0,0 +1,158 @@
+#include "ReactScheduler/ReactScheduler.h"
+#include "ReactScheduler/SchedulerIndexedMinHeap.h"
+#include "ReactScheduler/SchedulerTaskPool.h"
+#include "ReactScheduler/SchedulerTimerWheel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+SchedulerTask* makeTimer(SchedulerTaskPool& pool, double startTime) {
+  SchedulerTask* task = pool.acquire();
+  task->startTime = startTime;
+  task->sortIndex = startTime;
+  return task;
+}
+
+bool testWheelExpiresAtExactStartTime() {
+  SchedulerTaskPool pool;
+  SchedulerTimerWheel wheel;
+  std::vector<SchedulerTask*> expired;
+
+  SchedulerTask* early = makeTimer(pool, 3.5);
+  SchedulerTask* late = makeTimer(pool, 40.0);
+  wheel.insert(early);
+  wheel.insert(late);
+  assert(wheel.size() == 2);
+  assert(wheel.nextExpiryTime() == 3.5);
+
+  // Same tick, but before the start time
+  wheel.advance(3.2, expired);
+  assert(expired.empty());
+
+  wheel.advance(3.5, expired);
+  assert(expired.size() == 1 && expired[0] == early);
+  assert(early->timerSlot == kNoTimerSlot);
+  assert(wheel.nextExpiryTime() == 40.0);
+
+  expired.clear();
+  wheel.advance(39.99, expired);
+  assert(expired.empty());
+  wheel.advance(100.0, expired);
+  assert(expired.size() == 1 && expired[0] == late);
+  assert(wheel.empty());
+  assert(wheel.nextExpiryTime() < 0.0);
+
+  return true;
+}
+
+bool testWheelCascadesAcrossLevels() {
+  SchedulerTaskPool pool;
+  SchedulerTimerWheel wheel;
+  std::vector<SchedulerTask*> expired;
+
+  // One timer per level plus one in the overflow list
+  const std::vector<double> startTimes{10.0, 1000.0, 100000.0, 5000000.0, 20000000.0};
+  for (double startTime : startTimes) {
+    wheel.insert(makeTimer(pool, startTime));
+  }
+  assert(wheel.size() == startTimes.size());
+
+  for (double startTime : startTimes) {
+    // Nothing may fire early, even when the wheel jumps straight to a boundary
+    wheel.advance(startTime - 0.5, expired);
+    assert(expired.empty());
+    assert(wheel.nextExpiryTime() <= startTime);
+
+    wheel.advance(startTime, expired);
+    assert(expired.size() == 1);
+    assert(expired[0]->startTime == startTime);
+    expired.clear();
+  }
+  assert(wheel.empty());
+
+  return true;
+}
+
+bool testWheelMatchesHeapOrderUnderChurn() {
+  SchedulerTaskPool pool;
+  SchedulerTimerWheel wheel;
+  SchedulerIndexedMinHeap<SchedulerTask> reference;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> delays(0.0, 20000.0);
+  std::vector<SchedulerTask*> live;
+
+  uint64_t nextId = 1;
+  for (int i = 0; i < 2000; ++i) {
+    SchedulerTask* task = makeTimer(pool, delays(rng));
+    task->id = nextId++;
+    wheel.insert(task);
+    reference.push(task);
+    live.push_back(task);
+  }
+
+  // Cancel every third timer from both structures
+  for (size_t i = 0; i < live.size(); i += 3) {
+    assert(wheel.remove(live[i]));
+    assert(!wheel.remove(live[i]));
+    reference.remove(live[i]);
+  }
+  assert(wheel.size() == reference.size());
+
+  std::vector<SchedulerTask*> expired;
+  for (double now = 0.0; now < 20000.0 + 37.25; now += 37.25) {
+    expired.clear();
+    wheel.advance(now, expired);
+
+    std::vector<SchedulerTask*> due;
+    while (reference.peek() != nullptr && reference.peek()->startTime <= now) {
+      due.push_back(reference.pop());
+    }
+    std::sort(expired.begin(), expired.end());
+    std::sort(due.begin(), due.end());
+    assert(expired == due);
+  }
+  assert(wheel.empty() && reference.empty());
+
+  return true;
+}
+
+bool testSchedulerWithTimerWheel() {
+  ReactScheduler scheduler(SchedulerTimerQueue::TimerWheel);
+  assert(scheduler.timerQueueKind() == SchedulerTimerQueue::TimerWheel);
+
+  std::vector<int> order;
+  scheduler.scheduleTask(
+      SchedulerPriority::NormalPriority, [&order]() { order.push_back(3); }, TaskOptions{300.0, 0.0});
+  const TaskHandle cancelled = scheduler.scheduleTask(
+      SchedulerPriority::NormalPriority, [&order]() { order.push_back(99); }, TaskOptions{150.0, 0.0});
+  scheduler.scheduleTask(
+      SchedulerPriority::NormalPriority, [&order]() { order.push_back(2); }, TaskOptions{100.0, 0.0});
+  scheduler.scheduleTask(SchedulerPriority::NormalPriority, [&order]() { order.push_back(1); });
+  assert(scheduler.pendingTimerCount() == 3);
+  assert(scheduler.pendingTaskCount() == 1);
+
+  scheduler.cancelTask(cancelled);
+  assert(scheduler.pendingTimerCount() == 2);
+
+  scheduler.flushAllTasks();
+  assert((order == std::vector<int>{1, 2, 3}));
+  assert(scheduler.pendingTimerCount() == 0);
+  assert(scheduler.taskPoolStats().liveCount == 0);
+
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerTimerWheelTests() {
+  return testWheelExpiresAtExactStartTime() && testWheelCascadesAcrossLevels() &&
+      testWheelMatchesHeapOrderUnderChurn() && testSchedulerWithTimerWheel();
+}
+
+} // namespace react::test
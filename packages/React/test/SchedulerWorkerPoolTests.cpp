@@ -0,0 +1,209 @@
+#include "ReactRuntime/ReactRuntime.h"
+#include "ReactScheduler/SchedulerWorkerPool.h"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+bool testParallelForCoversRange() {
+  SchedulerWorkerPool pool(4);
+  assert(pool.threadCount() == 4);
+  assert(!pool.isWorkerThread());
+
+  std::vector<int> hits(10000, 0);
+  SchedulerWorkGroup group(pool);
+  group.parallelFor(hits.size(), 64, [&hits](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      hits[index] += 1;
+    }
+  });
+  group.wait();
+  assert(group.pending() == 0);
+  for (int hit : hits) {
+    assert(hit == 1);
+  }
+
+  const SchedulerWorkerPool::Stats stats = pool.stats();
+  assert(stats.threadCount == 4);
+  assert(stats.submitted > 1);
+  return true;
+}
+
+bool testExceptionsRethrownOnWait() {
+  SchedulerWorkerPool pool(2);
+  SchedulerWorkGroup group(pool);
+  std::atomic<int> completed{0};
+  for (int index = 0; index < 8; ++index) {
+    group.run([index, &completed]() {
+      if (index == 3) {
+        throw std::runtime_error("job failed");
+      }
+      completed.fetch_add(1);
+    });
+  }
+
+  bool threw = false;
+  try {
+    group.wait();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  assert(threw);
+  // The other jobs still ran, and the error is reported only once
+  assert(completed.load() == 7);
+  group.wait();
+  return true;
+}
+
+size_t fibonacci(SchedulerWorkerPool& pool, size_t n) {
+  if (n < 12) {
+    return n < 2 ? n : fibonacci(pool, n - 1) + fibonacci(pool, n - 2);
+  }
+  size_t left = 0;
+  SchedulerWorkGroup group(pool);
+  group.run([&pool, &left, n]() { left = fibonacci(pool, n - 1); });
+  const size_t right = fibonacci(pool, n - 2);
+  group.wait();
+  return left + right;
+}
+
+bool testNestedJoinsDoNotDeadlock() {
+  // Far more nested joins than threads; waiting workers have to help
+  SchedulerWorkerPool pool(2);
+  size_t result = 0;
+  SchedulerWorkGroup group(pool);
+  group.run([&pool, &result]() { result = fibonacci(pool, 20); });
+  group.wait();
+  assert(result == 6765);
+  return true;
+}
+
+bool testIdleWorkersSteal() {
+  SchedulerWorkerPool pool(2);
+  std::atomic<int> done{0};
+  std::atomic<bool> sawOtherThread{false};
+
+  SchedulerWorkGroup group(pool);
+  group.run([&]() {
+    // Queue onto this worker's own deques, then block without helping so
+    // only the other worker can run them
+    const std::thread::id owner = std::this_thread::get_id();
+    SchedulerWorkGroup inner(pool);
+    for (int index = 0; index < 16; ++index) {
+      inner.run([&, owner]() {
+        if (std::this_thread::get_id() != owner) {
+          sawOtherThread.store(true);
+        }
+        done.fetch_add(1);
+      });
+    }
+    while (done.load() < 16) {
+      std::this_thread::yield();
+    }
+  });
+  // Not wait(): this thread would help and take the jobs itself
+  while (group.pending() > 0) {
+    std::this_thread::yield();
+  }
+
+  assert(sawOtherThread.load());
+  assert(pool.stats().stolen >= 16);
+  return true;
+}
+
+bool testHigherPriorityJobsRunFirst() {
+  SchedulerWorkerPool pool(1);
+  std::atomic<bool> release{false};
+  std::mutex orderMutex;
+  std::vector<SchedulerPriority> order;
+
+  SchedulerWorkGroup group(pool);
+  // Hold the only worker so the queue fills up behind it
+  std::atomic<bool> started{false};
+  group.run(SchedulerPriority::ImmediatePriority, [&]() {
+    started.store(true);
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started.load()) {
+    std::this_thread::yield();
+  }
+
+  const auto record = [&](SchedulerPriority priority) {
+    return [&orderMutex, &order, priority]() {
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order.push_back(priority);
+    };
+  };
+  group.run(SchedulerPriority::IdlePriority, record(SchedulerPriority::IdlePriority));
+  group.run(SchedulerPriority::NormalPriority, record(SchedulerPriority::NormalPriority));
+  group.run(SchedulerPriority::UserBlockingPriority, record(SchedulerPriority::UserBlockingPriority));
+  group.run(SchedulerPriority::LowPriority, record(SchedulerPriority::LowPriority));
+
+  release.store(true);
+  // Let the worker drain the queue alone; a helping wait() would race it
+  while (group.pending() > 0) {
+    std::this_thread::yield();
+  }
+
+  const std::vector<SchedulerPriority> expected{
+    SchedulerPriority::UserBlockingPriority,
+    SchedulerPriority::NormalPriority,
+    SchedulerPriority::LowPriority,
+    SchedulerPriority::IdlePriority,
+  };
+  assert(order == expected);
+  return true;
+}
+
+bool testRuntimeOffloadJoinsBeforeCommit() {
+  auto pool = std::make_shared<SchedulerWorkerPool>(2);
+  ReactRuntime first;
+  ReactRuntime second;
+  first.setWorkerPool(pool);
+  second.setWorkerPool(pool);
+  assert(&first.workerPool() == &second.workerPool());
+
+  std::atomic<int> total{0};
+  for (int index = 0; index < 32; ++index) {
+    first.offload(SchedulerPriority::NormalPriority, [&total]() { total.fetch_add(1); });
+    second.offload(SchedulerPriority::UserBlockingPriority, [&total]() { total.fetch_add(100); });
+  }
+  first.joinOffloadedWork();
+  second.joinOffloadedWork();
+  assert(total.load() == 32 * 101);
+
+  first.offload(SchedulerPriority::NormalPriority, []() { throw std::logic_error("offload failed"); });
+  bool threw = false;
+  try {
+    first.joinOffloadedWork();
+  } catch (const std::logic_error&) {
+    threw = true;
+  }
+  assert(threw);
+
+  // Swapping pools joins what is still in flight on the old one
+  first.offload(SchedulerPriority::NormalPriority, [&total]() { total.fetch_add(1); });
+  first.setWorkerPool(nullptr);
+  assert(total.load() == 32 * 101 + 1);
+  assert(first.workerPool().threadCount() == SchedulerWorkerPool::defaultThreadCount());
+  return true;
+}
+
+} // namespace
+
+bool runSchedulerWorkerPoolTests() {
+  return testParallelForCoversRange() && testExceptionsRethrownOnWait() && testNestedJoinsDoNotDeadlock() &&
+      testIdleWorkersSteal() && testHigherPriorityJobsRunFirst() && testRuntimeOffloadJoinsBeforeCommit();
+}
+
+} // namespace react::test
@@ -1,27 +1,86 @@
+#include <cstdio>
 #include <cstdlib>
+#include <exception>
 
 namespace react::test {
 bool runUpdateQueueTests();
 bool runReactFiberLaneRuntimeTests();
 bool runReactFiberConcurrentUpdatesRuntimeTests();
 bool runReactFiberRuntimeTests();
+bool runReactFiberArenaTests();
+bool runReactFiberKeyMapTests();
+bool runReactFiberRootScheduleIndexTests();
+bool runReactFiberReclaimTests();
+bool runReactFiberChildTests();
 bool runReactFiberWorkLoopStateTests();
 bool runReactFiberAsyncActionTests();
 bool runReactFiberRootSchedulerTests();
 bool runReactJSXRuntimeTests();
 bool runReactRuntimeHostInterfaceTests();
+bool runReactDOMPropertyPayloadTests();
+bool runReactHostMutationBufferTests();
+bool runReactDOMChildListTests();
+bool runReactDOMInstanceRefTests();
+bool runSchedulerMinHeapTests();
+bool runSchedulerTaskPoolTests();
+bool runSchedulerTimerWheelTests();
+bool runSchedulerEpollLoopTests();
+bool runSchedulerTimeSliceTests();
+bool runSchedulerWorkerPoolTests();
+bool runSchedulerCoordinatorTests();
+bool runSchedulerMetricsTests();
+bool runReactRuntimeSchedulerTests();
 }
 
+namespace {
+
+// One suite throwing must not keep the ones after it from running
+bool runSuite(const char* name, bool (*suite)()) {
+  try {
+    if (suite()) {
+      return true;
+    }
+    std::fprintf(stderr, "FAILED %s\n", name);
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "FAILED %s: %s\n", name, error.what());
+  } catch (...) {
+    std::fprintf(stderr, "FAILED %s: unknown exception\n", name);
+  }
+  return false;
+}
+
+} // namespace
+
+#define RUN_SUITE(name) runSuite(#name, &react::test::name)
+
 int main() {
     bool allPassed = true;
-    allPassed &= react::test::runUpdateQueueTests();
-    allPassed &= react::test::runReactFiberLaneRuntimeTests();
-    allPassed &= react::test::runReactFiberConcurrentUpdatesRuntimeTests();
-    allPassed &= react::test::runReactFiberRuntimeTests();
-    allPassed &= react::test::runReactFiberWorkLoopStateTests();
-    allPassed &= react::test::runReactFiberAsyncActionTests();
-    allPassed &= react::test::runReactFiberRootSchedulerTests();
-    allPassed &= react::test::runReactJSXRuntimeTests();
-    allPassed &= react::test::runReactRuntimeHostInterfaceTests();
+    allPassed &= RUN_SUITE(runUpdateQueueTests);
+    allPassed &= RUN_SUITE(runReactFiberLaneRuntimeTests);
+    allPassed &= RUN_SUITE(runReactFiberConcurrentUpdatesRuntimeTests);
+    allPassed &= RUN_SUITE(runReactFiberRuntimeTests);
+    allPassed &= RUN_SUITE(runReactFiberArenaTests);
+    allPassed &= RUN_SUITE(runReactFiberKeyMapTests);
+    allPassed &= RUN_SUITE(runReactFiberRootScheduleIndexTests);
+    allPassed &= RUN_SUITE(runReactFiberReclaimTests);
+    allPassed &= RUN_SUITE(runReactFiberChildTests);
+    allPassed &= RUN_SUITE(runReactFiberWorkLoopStateTests);
+    allPassed &= RUN_SUITE(runReactFiberAsyncActionTests);
+    allPassed &= RUN_SUITE(runReactFiberRootSchedulerTests);
+    allPassed &= RUN_SUITE(runReactJSXRuntimeTests);
+    allPassed &= RUN_SUITE(runReactRuntimeHostInterfaceTests);
+    allPassed &= RUN_SUITE(runReactDOMPropertyPayloadTests);
+    allPassed &= RUN_SUITE(runReactHostMutationBufferTests);
+    allPassed &= RUN_SUITE(runReactDOMChildListTests);
+    allPassed &= RUN_SUITE(runReactDOMInstanceRefTests);
+    allPassed &= RUN_SUITE(runSchedulerMinHeapTests);
+    allPassed &= RUN_SUITE(runSchedulerTaskPoolTests);
+    allPassed &= RUN_SUITE(runSchedulerTimerWheelTests);
+    allPassed &= RUN_SUITE(runSchedulerEpollLoopTests);
+    allPassed &= RUN_SUITE(runSchedulerTimeSliceTests);
+    allPassed &= RUN_SUITE(runSchedulerWorkerPoolTests);
+    allPassed &= RUN_SUITE(runSchedulerMetricsTests);
+    allPassed &= RUN_SUITE(runSchedulerCoordinatorTests);
+    allPassed &= RUN_SUITE(runReactRuntimeSchedulerTests);
     return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
 }
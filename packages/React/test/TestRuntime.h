@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace react::test {
@@ -19,7 +20,34 @@ class TestRuntime : public Runtime {
     return createArray(length);
   }
 
-  ~TestRuntime() override = default;
+  ~TestRuntime() override {
+    for (auto& entry : runtimeData_) {
+      entry.second.second(entry.second.first);
+    }
+  }
+
+  // A symbol no other symbol equals, like Symbol(description)
+  Symbol createSymbol(const std::string& description) {
+    return make<Symbol>(new SymbolValue(std::make_shared<std::string>(description)));
+  }
+
+  // Installs a global Symbol whose Symbol.for returns one symbol per key
+  void installSymbolRegistry() {
+    Object symbolObject(*this);
+    auto forFunction = createFunctionFromHostFunction(
+        createPropNameIDFromAscii("for", 3),
+        1,
+        [this](Runtime& runtime, const Value&, const Value* args, size_t count) -> Value {
+          const std::string key = count > 0 && args[0].isString() ? args[0].getString(runtime).utf8(runtime) : "undefined";
+          auto& description = symbolRegistry_[key];
+          if (!description) {
+            description = std::make_shared<std::string>(key);
+          }
+          return Value(runtime, make<Symbol>(new SymbolValue(description)));
+        });
+    symbolObject.setProperty(*this, "for", forFunction);
+    global().setProperty(*this, "Symbol", symbolObject);
+  }
 
   Value evaluateJavaScript(
       const std::shared_ptr<const Buffer>&,
@@ -58,16 +86,29 @@ class TestRuntime : public Runtime {
 
  protected:
   void setRuntimeDataImpl(
-      const UUID&,
-      const void*,
-      void (*)(const void*)) override {}
+      const UUID& uuid,
+      const void* data,
+      void (*deleter)(const void*)) override {
+    auto iter = runtimeData_.find(uuid);
+    if (iter != runtimeData_.end()) {
+      iter->second.second(iter->second.first);
+      iter->second = {data, deleter};
+      return;
+    }
+    runtimeData_.emplace(uuid, std::make_pair(data, deleter));
+  }
 
-  const void* getRuntimeDataImpl(const UUID&) override {
-    return nullptr;
+  const void* getRuntimeDataImpl(const UUID& uuid) override {
+    auto iter = runtimeData_.find(uuid);
+    return iter != runtimeData_.end() ? iter->second.first : nullptr;
   }
 
-  PointerValue* cloneSymbol(const PointerValue*) override {
-    throw JSINativeException("Symbols not supported in TestRuntime");
+  PointerValue* cloneSymbol(const PointerValue* pv) override {
+    const auto* symbolValue = static_cast<const SymbolValue*>(pv);
+    if (!symbolValue) {
+      return nullptr;
+    }
+    return new SymbolValue(symbolValue->description);
   }
 
   PointerValue* cloneBigInt(const PointerValue*) override {
@@ -127,8 +168,12 @@ class TestRuntime : public Runtime {
     return utf8(lhs) == utf8(rhs);
   }
 
-  std::string symbolToString(const Symbol&) override {
-    throw JSINativeException("Symbols not supported in TestRuntime");
+  std::string symbolToString(const Symbol& symbol) override {
+    const auto* value = static_cast<const SymbolValue*>(Runtime::getPointerValue(symbol));
+    if (!value || !value->description) {
+      return "Symbol()";
+    }
+    return "Symbol(" + *value->description + ")";
   }
 
   BigInt createBigIntFromInt64(int64_t) override {
@@ -188,8 +233,12 @@ class TestRuntime : public Runtime {
     return data ? data->hostObject : nullptr;
   }
 
-  HostFunctionType& getHostFunction(const Function&) override {
-    throw JSINativeException("Host functions not supported in TestRuntime");
+  HostFunctionType& getHostFunction(const Function& function) override {
+    auto data = getObjectData(function);
+    if (!data || !data->hostFunction) {
+      throw JSINativeException("Not a host function");
+    }
+    return *data->hostFunction;
   }
 
   bool hasNativeState(const Object& obj) override {
@@ -291,8 +340,9 @@ class TestRuntime : public Runtime {
     return false;
   }
 
-  bool isFunction(const Object&) const override {
-    return false;
+  bool isFunction(const Object& object) const override {
+    auto data = getObjectData(object);
+    return data && data->hostFunction != nullptr;
   }
 
   bool isHostObject(const Object& object) const override {
@@ -300,8 +350,9 @@ class TestRuntime : public Runtime {
     return data && data->hostObject != nullptr;
   }
 
-  bool isHostFunction(const Function&) const override {
-    return false;
+  bool isHostFunction(const Function& function) const override {
+    auto data = getObjectData(function);
+    return data && data->hostFunction != nullptr;
   }
 
   Array getPropertyNames(const Object& object) override {
@@ -393,16 +444,22 @@ class TestRuntime : public Runtime {
   Function createFunctionFromHostFunction(
       const PropNameID&,
       unsigned int,
-      HostFunctionType) override {
-    throw JSINativeException("Host functions not supported in TestRuntime");
+      HostFunctionType function) override {
+    auto data = std::make_shared<ObjectData>();
+    data->hostFunction = std::make_shared<HostFunctionType>(std::move(function));
+    return make<Function>(new ObjectValue(std::move(data)));
   }
 
   Value call(
-      const Function&,
-      const Value&,
-      const Value*,
-      size_t) override {
-    throw JSINativeException("Function call not supported in TestRuntime");
+      const Function& function,
+      const Value& thisValue,
+      const Value* args,
+      size_t count) override {
+    auto data = getObjectData(function);
+    if (!data || !data->hostFunction) {
+      throw JSINativeException("Only host functions can be called in TestRuntime");
+    }
+    return (*data->hostFunction)(baseRuntime(), thisValue, args, count);
   }
 
   Value callAsConstructor(
@@ -418,8 +475,13 @@ class TestRuntime : public Runtime {
 
   void popScope(ScopeState*) override {}
 
-  bool strictEquals(const Symbol&, const Symbol&) const override {
-    throw JSINativeException("Symbols not supported in TestRuntime");
+  bool strictEquals(const Symbol& a, const Symbol& b) const override {
+    const auto* valueA = static_cast<const SymbolValue*>(Runtime::getPointerValue(a));
+    const auto* valueB = static_cast<const SymbolValue*>(Runtime::getPointerValue(b));
+    if (!valueA || !valueB) {
+      return valueA == valueB;
+    }
+    return valueA->description == valueB->description;
   }
 
   bool strictEquals(const BigInt&, const BigInt&) const override {
@@ -492,6 +554,15 @@ class TestRuntime : public Runtime {
     std::shared_ptr<std::string> data;
   };
 
+  // Symbols are equal when they share a description object
+  struct SymbolValue : PointerValue {
+    explicit SymbolValue(std::shared_ptr<std::string> description) : description(std::move(description)) {}
+    void invalidate() noexcept override {
+      description.reset();
+    }
+    std::shared_ptr<std::string> description;
+  };
+
   struct PropNameIDValue : PointerValue {
     explicit PropNameIDValue(std::shared_ptr<std::string> name) : name(std::move(name)) {}
     void invalidate() noexcept override {
@@ -504,6 +575,7 @@ class TestRuntime : public Runtime {
     std::unordered_map<std::string, std::shared_ptr<Value>> props;
     std::shared_ptr<HostObject> hostObject;
     std::shared_ptr<NativeState> nativeState;
+    std::shared_ptr<HostFunctionType> hostFunction;
     bool isArray{false};
     std::vector<std::shared_ptr<Value>> elements;
   };
@@ -582,6 +654,8 @@ class TestRuntime : public Runtime {
   }
 
   std::shared_ptr<ObjectData> globalObjectData_;
+  std::unordered_map<std::string, std::shared_ptr<std::string>> symbolRegistry_;
+  std::unordered_map<UUID, std::pair<const void*, void (*)(const void*)>, UUID::Hash> runtimeData_;
 };
 
 } // namespace react::test